@@ -55,7 +55,7 @@ namespace Toolbox {
                 // Step 3: Calculate the magnitude of the normalized point and normalize the point
                 // to ensure it lies within the unit sphere.
                 float magnitude =
-                    std::sqrtf(local_point.x * local_point.x + local_point.y * local_point.y +
+                    std::sqrt(local_point.x * local_point.x + local_point.y * local_point.y +
                                local_point.z * local_point.z);
 
                 local_point.x /= magnitude;
@@ -95,7 +95,7 @@ namespace Toolbox {
 
                 // The point is inside the spheroid if the sum of the squares of its normalized
                 // coordinates is less than or equal to 1.
-                return std::sqrtf((inv_point.x * inv_point.x + inv_point.y * inv_point.y +
+                return std::sqrt((inv_point.x * inv_point.x + inv_point.y * inv_point.y +
                                    inv_point.z * inv_point.z)) <= 1.0f;
             }
         }
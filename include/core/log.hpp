@@ -1,7 +1,11 @@
 #pragma once
 
+#include <atomic>
+#include <filesystem>
 #include <format>
+#include <fstream>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <stacktrace>
 #include <string>
@@ -19,6 +23,11 @@ namespace Toolbox::Log {
         REPORT_DEBUG
     };
 
+    // Messages are logged from any thread without locking. They wait in
+    // a bounded queue until the UI thread flushes them into the history,
+    // which keeps only the newest `capacity()` messages. Messages logged
+    // while the queue is full wait in a locked overflow instead, and only
+    // once that fills too are they dropped and reported on the next flush.
     class AppLogger {
     public:
         struct LogMessage {
@@ -29,8 +38,12 @@ namespace Toolbox::Log {
 
         using log_callback_t = std::function<void(const LogMessage &)>;
 
+        static constexpr size_t c_queue_capacity    = 4096;  // Must be a power of two
+        static constexpr size_t c_overflow_capacity = 65536;
+        static constexpr size_t c_default_capacity  = 5000;
+
     protected:
-        AppLogger()             = default;
+        AppLogger();
         AppLogger(AppLogger &&) = default;
 
     public:
@@ -40,11 +53,16 @@ namespace Toolbox::Log {
 
         void pushStack() { m_indentation++; }
         void popStack() {
-            if (m_indentation > 0)
-                m_indentation--;
+            size_t indentation = m_indentation.load();
+            while (indentation > 0 &&
+                   !m_indentation.compare_exchange_weak(indentation, indentation - 1)) {
+            }
         }
 
-        void clear() { m_messages.clear(); }
+        void clear() {
+            m_history.clear();
+            m_history_start = 0;
+        }
 
         void log(const std::string &message) { log(ReportLevel::REPORT_LOG, message); }
 
@@ -71,16 +89,70 @@ namespace Toolbox::Log {
 
         void log(ReportLevel level, const std::string &message);
 
+        // Moves the queued messages into the history, passing each to the
+        // callback and the log file. Only the UI thread may flush, the
+        // history and callback are never touched by any other thread.
+        void flush();
+
+        // Applies the history capacity and log file of the current settings
+        // profile. Called by the UI thread whenever those may have changed,
+        // so flushing doesn't have to look them up every frame.
+        void refreshSettings();
+
         void setLogCallback(log_callback_t cb) { m_log_callback = cb; }
 
-        [[nodiscard]] const std::vector<LogMessage> &messages() const { return m_messages; }
+        [[nodiscard]] size_t capacity() const { return m_history_capacity; }
+        void setCapacity(size_t capacity);
+
+        // Every flushed message is also appended to the file, so messages
+        // that fall out of the history are kept. An empty path closes it.
+        bool setLogFile(const std::filesystem::path &path);
+        [[nodiscard]] const std::filesystem::path &logFile() const { return m_log_file_path; }
+
+        // Oldest message first
+        [[nodiscard]] size_t messageCount() const { return m_history.size(); }
+        [[nodiscard]] const LogMessage &message(size_t index) const {
+            return m_history[(m_history_start + index) % m_history.size()];
+        }
 
     private:
-        std::mutex m_write_mutex;
-        size_t m_max_trace                 = 8;
-        size_t m_indentation               = 0;
-        std::vector<LogMessage> m_messages = {};
-        log_callback_t m_log_callback      = [](const LogMessage &) {};
+        struct QueueSlot {
+            std::atomic<size_t> m_sequence;
+            LogMessage m_message;
+        };
+
+        bool pushMessage(LogMessage &&message);
+        bool popMessage(LogMessage &message);
+
+        // Takes what doesn't fit in the queue, as happens when lots are
+        // logged before the UI loop first flushes
+        void pushOverflow(LogMessage &&message);
+
+        void appendHistory(LogMessage &&message);
+
+        size_t m_max_trace                = 8;
+        std::atomic<size_t> m_indentation = 0;
+
+        std::unique_ptr<QueueSlot[]> m_queue;
+        std::atomic<size_t> m_queue_write = 0;
+        size_t m_queue_read               = 0;
+        std::atomic<size_t> m_dropped     = 0;
+
+        // Once set, messages keep going to the overflow until the next flush
+        // so they stay in order
+        std::mutex m_overflow_mutex;
+        std::vector<LogMessage> m_overflow;
+        std::atomic<bool> m_overflowing = false;
+
+        // Ring buffer once full, `m_history_start` is the oldest message
+        std::vector<LogMessage> m_history = {};
+        size_t m_history_start            = 0;
+        size_t m_history_capacity         = c_default_capacity;
+
+        std::filesystem::path m_log_file_path;
+        std::ofstream m_log_file;
+
+        log_callback_t m_log_callback = [](const LogMessage &) {};
     };
 
 }  // namespace Toolbox::Log
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "core/memory.hpp"
+
+namespace Toolbox {
+
+    // Fixed set of worker threads, each with its own task queue.
+    //
+    // Tasks submitted from a worker go to the back of that worker's queue
+    // and are taken LIFO while they're still hot in its cache; other tasks
+    // are spread round robin. Workers that run dry steal from the front of
+    // the other queues, so an uneven batch doesn't leave cores idle.
+    //
+    // Tasks must not block on other queued tasks, as every worker could
+    // end up waiting on work that none of them is free to start.
+    class ThreadPool {
+    public:
+        // A `thread_count` of 0 uses every hardware thread
+        explicit ThreadPool(size_t thread_count = 0);
+        ThreadPool(const ThreadPool &) = delete;
+        ~ThreadPool();
+
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        // Shared pool sized to the hardware
+        static ThreadPool &instance();
+
+        [[nodiscard]] size_t threadCount() const { return m_workers.size(); }
+
+        // True on this pool's workers, which must run nested work inline
+        // rather than wait on it
+        [[nodiscard]] bool isWorkerThread() const;
+
+        template <typename _Fn> std::future<std::invoke_result_t<_Fn>> submit(_Fn &&fn) {
+            using result_t = std::invoke_result_t<_Fn>;
+
+            // std::function needs a copyable target
+            auto task = make_referable<std::packaged_task<result_t()>>(std::forward<_Fn>(fn));
+            std::future<result_t> future = task->get_future();
+            push([task]() { (*task)(); });
+            return future;
+        }
+
+    private:
+        struct WorkQueue {
+            std::mutex m_mutex;
+            std::deque<std::function<void()>> m_tasks;
+        };
+
+        void push(std::function<void()> &&task);
+        bool pop(size_t index, std::function<void()> &task);
+        void workerLoop(size_t index);
+
+        std::vector<ScopePtr<WorkQueue>> m_queues;
+        std::vector<std::thread> m_workers;
+        std::atomic<size_t> m_next_queue = 0;
+
+        // Counted before a task is queued, so a worker never
+        // goes to sleep while work it could take is in flight
+        std::mutex m_sleep_mutex;
+        std::condition_variable m_condition;
+        size_t m_pending = 0;
+        bool m_stopping  = false;
+    };
+
+}  // namespace Toolbox
\ No newline at end of file
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "core/memory.hpp"
+#include "core/types.hpp"
+#include "image/imagehandle.hpp"
+
+namespace Toolbox::Dolphin {
+
+    class DolphinHookManager;
+
+    // Streams the external framebuffer of the game into a texture.
+    //
+    // Two textures are kept and updated in place, alternating between
+    // frames so the one being written isn't the one still being drawn.
+    // A frame whose bytes match the last one is neither converted nor
+    // uploaded.
+    class XFBCapture {
+    public:
+        XFBCapture() = default;
+
+        // The texture holding the latest frame, or an invalid handle when
+        // the framebuffer couldn't be read. The textures are kept through
+        // frames that can't be read, so capturing resumes without
+        // recreating them.
+        const ImageHandle &capture(DolphinHookManager &manager, u32 xfb_start, int xfb_width,
+                                   int xfb_height);
+
+        // Returned while there is no frame to capture
+        [[nodiscard]] const ImageHandle &noImage() const { return m_no_image; }
+
+        void reset();
+
+    private:
+        std::vector<u8> m_xfb_data;
+        std::vector<u8> m_xfb_read;
+        Buffer m_rgba_data;
+
+        std::array<ImageHandle, 2> m_images;
+        size_t m_image_index = 0;
+
+        ImageHandle m_no_image;
+    };
+
+}  // namespace Toolbox::Dolphin
\ No newline at end of file
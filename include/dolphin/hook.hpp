@@ -8,6 +8,7 @@
 #include "core/core.hpp"
 #include "core/error.hpp"
 #include "core/memory.hpp"
+#include "dolphin/transaction.hpp"
 #include "image/imagehandle.hpp"
 #include "platform/process.hpp"
 
@@ -15,7 +16,7 @@
 
 #ifdef TOOLBOX_PLATFORM_WINDOWS
 #include <Windows.h>
-#elif TOOLBOX_PLATFORM_LINUX
+#elif defined(TOOLBOX_PLATFORM_LINUX)
 #endif
 
 using namespace Toolbox;
@@ -68,20 +69,24 @@ namespace Toolbox::Dolphin {
         Result<void> startProcess();
         Result<void> stopProcess();
 
-        bool isHooked() const { return m_mem_view && Platform::IsExProcessRunning(m_proc_info); }
+        bool isHooked() const { return m_mem_handle && Platform::IsExProcessRunning(m_proc_info); }
 
         Result<bool> hook();
         Result<bool> unhook();
         Result<bool> refresh();
 
+        // Null while hooked when Dolphin's memory could not be mapped and is
+        // only reachable through readBytes, writeBytes and transferSpans
         void *getMemoryView() const { return isHooked() ? m_mem_view : nullptr; }
-        size_t getMemorySize() const { return isHooked() ? 0x1800000 : 0; }
+        size_t getMemorySize() const { return getMemoryView() ? 0x1800000 : 0; }
 
         Result<void> readBytes(char *buf, u32 address, size_t size);
         Result<void> writeBytes(const char *buf, u32 address, size_t size);
 
-        ImageHandle captureXFBAsTexture(int width, int height, u32 xfb_start, int xfb_width,
-                                        int xfb_height);
+        // Copies every span under one lock, the writes before the reads.
+        // Nothing is copied if any span is out of bounds.
+        Result<void> transferSpans(std::span<const MemorySpan> writes,
+                                   std::span<const MemorySpan> reads);
 
     private:
         Platform::ProcessInformation m_proc_info;
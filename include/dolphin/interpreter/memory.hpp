@@ -1,29 +1,130 @@
 #pragma once
 
-#include "core/memory.hpp"
-#include "instructions/forms.hpp"
+#include <cstring>
+#include <utility>
+#include <vector>
 
-using namespace Toolbox;
+#include "core/core.hpp"
+#include "core/memory.hpp"
+#include "core/types.hpp"
 
 namespace Toolbox::Interpreter {
 
+    // Paged view over the emulated physical memory.
+    //
+    // Pages read through to a backing view (usually Dolphin's shared memory)
+    // and are only copied into private storage the first time they are
+    // written. This lets an interpreter run against a "snapshot" of the game
+    // while paying for a page table instead of a full 24 MiB copy.
+    //
+    // Pages holding decoded code can be protected, which removes them from
+    // the write table. The first store to such a page then takes the slow
+    // path, which records it and lifts the protection, so keeping track of
+    // code costs nothing on writes to data pages.
     class MemoryStorage {
     public:
+        static constexpr size_t c_page_shift = 12;
+        static constexpr size_t c_page_size  = 1 << c_page_shift;
+        static constexpr size_t c_page_mask  = c_page_size - 1;
+
         MemoryStorage() = default;
+        MemoryStorage(const MemoryStorage &other) { other.copyTo(*this); }
+        MemoryStorage(MemoryStorage &&other) noexcept = default;
+        ~MemoryStorage()                              = default;
+
+        MemoryStorage &operator=(const MemoryStorage &other) {
+            if (this != &other)
+                other.copyTo(*this);
+            return *this;
+        }
+        MemoryStorage &operator=(MemoryStorage &&other) noexcept = default;
+
+        // Zero filled memory owned entirely by this storage
+        void initialize(size_t size);
+
+        // Reads and writes go directly to the view
+        void attach(void *view, size_t size);
+
+        // Reads go to the view until a page is written, at which
+        // point the page is copied and owned by this storage
+        void overlay(const void *view, size_t size);
+
+        void reset();
+
+        bool isAttachedTo(const void *view) const { return m_attached && m_view == view; }
+
+        size_t size() const { return m_size; }
+        size_t privatePageCount() const { return m_private_pages.size(); }
 
-        bool initialize(size_t storage_size = 0x1800000) { return m_buffer.alloc(storage_size); }
-        Buffer &buffer() { return m_buffer; }
+        template <typename T> T get(size_t ofs) const {
+            T value;
+            const size_t page_ofs = ofs & c_page_mask;
+            if (page_ofs + sizeof(T) <= c_page_size) [[likely]] {
+                std::memcpy(&value, m_read_pages[ofs >> c_page_shift] + page_ofs, sizeof(T));
+            } else {
+                readBytes(reinterpret_cast<char *>(&value), ofs, sizeof(T));
+            }
+            return value;
+        }
 
-        void process(const PPC::XForm &instr);
-        void process(const PPC::XLForm &instr);
-        void process(const PPC::XForm &instr);
-        void process(const PPC::XForm &instr);
+        template <typename T> void set(size_t ofs, const T &value) {
+            const size_t page_ofs = ofs & c_page_mask;
+            if (page_ofs + sizeof(T) <= c_page_size) [[likely]] {
+                std::memcpy(writablePage(ofs >> c_page_shift) + page_ofs, &value, sizeof(T));
+            } else {
+                writeBytes(reinterpret_cast<const char *>(&value), ofs, sizeof(T));
+            }
+        }
 
+        void readBytes(char *buf, size_t ofs, size_t size) const;
+        void writeBytes(const char *buf, size_t ofs, size_t size);
+        void fill(size_t ofs, u8 value, size_t size);
+
+        void protectCodePage(size_t page);
+
+        bool hasCodeWrites() const { return !m_code_writes.empty(); }
+
+        // Pages written since they were protected, in the order of the first write
+        std::vector<size_t> takeCodeWrites() { return std::exchange(m_code_writes, {}); }
+
+        operator bool() const { return m_size != 0; }
+
+    protected:
+        void copyTo(MemoryStorage &other) const;
+        void buildPageTables(const u8 *view, bool writable);
+
+        u8 *writablePage(size_t page) {
+            u8 *page_ptr = m_write_pages[page];
+            if (page_ptr) [[likely]]
+                return page_ptr;
+            return acquireWritablePage(page);
+        }
+
+        u8 *acquireWritablePage(size_t page);
+        u8 *privatizePage(size_t page);
 
     private:
+        u8 *m_view      = nullptr;
+        size_t m_size   = 0;
+        bool m_attached = false;
 
+        std::vector<const u8 *> m_read_pages;
+        std::vector<u8 *> m_write_pages;
+        std::vector<ScopePtr<u8[]>> m_private_pages;
 
-        Buffer m_buffer;
+        // The write table entries of protected pages are parked here
+        std::vector<bool> m_code_pages;
+        std::vector<u8 *> m_code_write_pages;
+        std::vector<size_t> m_code_writes;
     };
 
-}  // namespace Toolbox::Interpreter
\ No newline at end of file
+    inline bool MemoryContainsVAddress(const MemoryStorage &storage, u32 address) {
+        return address >= 0x80000000 && static_cast<size_t>(address - 0x80000000) < storage.size();
+    }
+
+    // Addresses that went below 0 wrapped around and are rejected as well
+    inline bool MemoryContainsPAddress(const MemoryStorage &storage, u32 address) {
+        return static_cast<size_t>(address) < storage.size();
+    }
+
+}  // namespace Toolbox::Interpreter
@@ -3,6 +3,7 @@
 #include "core/core.hpp"
 #include "core/memory.hpp"
 
+#include "memory.hpp"
 #include "registers.hpp"
 #include "serial.hpp"
 
@@ -50,14 +51,6 @@ namespace Toolbox::Interpreter {
         HINT_STREAM_DESCRIPT = 8,
     };
 
-    inline bool MemoryContainsVAddress(const Buffer &buffer, u32 address) {
-        return address >= 0x80000000 && address < 0x80000000 + buffer.size();
-    }
-
-    inline bool MemoryContainsPAddress(const Buffer &buffer, s32 address) {
-        return address >= 0 && address < buffer.size();
-    }
-
     inline bool IsRegValid(u8 reg) { return reg < 32; }
 
     class SystemProcessor {
@@ -76,13 +69,13 @@ namespace Toolbox::Interpreter {
     private:
         // Storage control
 
-        void icbi(u8 ra, u8 rb, Buffer &storage) {}
-        void dcbi(u8 ra, u8 rb, Buffer &storage) {}
-        void dcbt(u8 ra, u8 rb, DataCacheHintType th, Buffer &storage) {}
-        void dcbf(u8 ra, u8 rb, bool l, Buffer &storage) {}
-        void dcbtst(u8 ra, u8 rb, Buffer &storage) {}
-        void dcbz(u8 ra, u8 rb, Buffer &storage) {}
-        void dcbst(u8 ra, u8 rb, Buffer &storage) {}
+        void icbi(u8 ra, u8 rb, MemoryStorage &storage) {}
+        void dcbi(u8 ra, u8 rb, MemoryStorage &storage) {}
+        void dcbt(u8 ra, u8 rb, DataCacheHintType th, MemoryStorage &storage) {}
+        void dcbf(u8 ra, u8 rb, bool l, MemoryStorage &storage) {}
+        void dcbtst(u8 ra, u8 rb, MemoryStorage &storage) {}
+        void dcbz(u8 ra, u8 rb, MemoryStorage &storage) {}
+        void dcbst(u8 ra, u8 rb, MemoryStorage &storage) {}
 
         // Sync - order
 
@@ -170,54 +163,54 @@ namespace Toolbox::Interpreter {
 
     protected:
         // Memory
-        void lbz(u8 rt, s16 d, u8 ra, Buffer &storage);
-        void lbzu(u8 rt, s16 d, u8 ra, Buffer &storage);
-        void lbzx(u8 rt, u8 ra, u8 rb, Buffer &storage);
-        void lbzux(u8 rt, u8 ra, u8 rb, Buffer &storage);
-
-        void lhz(u8 rt, s16 d, u8 ra, Buffer &storage);
-        void lhzu(u8 rt, s16 d, u8 ra, Buffer &storage);
-        void lhzx(u8 rt, u8 ra, u8 rb, Buffer &storage);
-        void lhzux(u8 rt, u8 ra, u8 rb, Buffer &storage);
-        void lha(u8 rt, s16 d, u8 ra, Buffer &storage);
-        void lhau(u8 rt, s16 d, u8 ra, Buffer &storage);
-        void lhax(u8 rt, u8 ra, u8 rb, Buffer &storage);
-        void lhaux(u8 rt, u8 ra, u8 rb, Buffer &storage);
-
-        void lwz(u8 rt, s16 d, u8 ra, Buffer &storage);
-        void lwzu(u8 rt, s16 d, u8 ra, Buffer &storage);
-        void lwzx(u8 rt, u8 ra, u8 rb, Buffer &storage);
-        void lwzux(u8 rt, u8 ra, u8 rb, Buffer &storage);
-
-        void stb(u8 rs, s16 d, u8 ra, Buffer &storage);
-        void stbu(u8 rs, s16 d, u8 ra, Buffer &storage);
-        void stbx(u8 rs, u8 ra, u8 rb, Buffer &storage);
-        void stbux(u8 rs, u8 ra, u8 rb, Buffer &storage);
-
-        void sth(u8 rs, s16 d, u8 ra, Buffer &storage);
-        void sthu(u8 rs, s16 d, u8 ra, Buffer &storage);
-        void sthx(u8 rs, u8 ra, u8 rb, Buffer &storage);
-        void sthux(u8 rs, u8 ra, u8 rb, Buffer &storage);
-
-        void stw(u8 rs, s16 d, u8 ra, Buffer &storage);
-        void stwu(u8 rs, s16 d, u8 ra, Buffer &storage);
-        void stwx(u8 rs, u8 ra, u8 rb, Buffer &storage);
-        void stwux(u8 rs, u8 ra, u8 rb, Buffer &storage);
-
-        void lhbrx(u8 rt, u8 ra, u8 rb, Buffer &storage);
-        void lwbrx(u8 rt, u8 ra, u8 rb, Buffer &storage);
-
-        void sthbrx(u8 rs, u8 ra, u8 rb, Buffer &storage);
-        void stwbrx(u8 rs, u8 ra, u8 rb, Buffer &storage);
-
-        void lmw(u8 rt, s16 d, u8 ra, Buffer &storage);
-        void stmw(u8 rs, s16 d, u8 ra, Buffer &storage);
-
-        void lswi(u8 rt, u8 ra, u8 nb, Buffer &storage);
-        void lswx(u8 rt, u8 ra, u8 rb, Buffer &storage);
-
-        void stswi(u8 rt, u8 ra, u8 nb, Buffer &storage);
-        void stswx(u8 rt, u8 ra, u8 rb, Buffer &storage);
+        void lbz(u8 rt, s16 d, u8 ra, MemoryStorage &storage);
+        void lbzu(u8 rt, s16 d, u8 ra, MemoryStorage &storage);
+        void lbzx(u8 rt, u8 ra, u8 rb, MemoryStorage &storage);
+        void lbzux(u8 rt, u8 ra, u8 rb, MemoryStorage &storage);
+
+        void lhz(u8 rt, s16 d, u8 ra, MemoryStorage &storage);
+        void lhzu(u8 rt, s16 d, u8 ra, MemoryStorage &storage);
+        void lhzx(u8 rt, u8 ra, u8 rb, MemoryStorage &storage);
+        void lhzux(u8 rt, u8 ra, u8 rb, MemoryStorage &storage);
+        void lha(u8 rt, s16 d, u8 ra, MemoryStorage &storage);
+        void lhau(u8 rt, s16 d, u8 ra, MemoryStorage &storage);
+        void lhax(u8 rt, u8 ra, u8 rb, MemoryStorage &storage);
+        void lhaux(u8 rt, u8 ra, u8 rb, MemoryStorage &storage);
+
+        void lwz(u8 rt, s16 d, u8 ra, MemoryStorage &storage);
+        void lwzu(u8 rt, s16 d, u8 ra, MemoryStorage &storage);
+        void lwzx(u8 rt, u8 ra, u8 rb, MemoryStorage &storage);
+        void lwzux(u8 rt, u8 ra, u8 rb, MemoryStorage &storage);
+
+        void stb(u8 rs, s16 d, u8 ra, MemoryStorage &storage);
+        void stbu(u8 rs, s16 d, u8 ra, MemoryStorage &storage);
+        void stbx(u8 rs, u8 ra, u8 rb, MemoryStorage &storage);
+        void stbux(u8 rs, u8 ra, u8 rb, MemoryStorage &storage);
+
+        void sth(u8 rs, s16 d, u8 ra, MemoryStorage &storage);
+        void sthu(u8 rs, s16 d, u8 ra, MemoryStorage &storage);
+        void sthx(u8 rs, u8 ra, u8 rb, MemoryStorage &storage);
+        void sthux(u8 rs, u8 ra, u8 rb, MemoryStorage &storage);
+
+        void stw(u8 rs, s16 d, u8 ra, MemoryStorage &storage);
+        void stwu(u8 rs, s16 d, u8 ra, MemoryStorage &storage);
+        void stwx(u8 rs, u8 ra, u8 rb, MemoryStorage &storage);
+        void stwux(u8 rs, u8 ra, u8 rb, MemoryStorage &storage);
+
+        void lhbrx(u8 rt, u8 ra, u8 rb, MemoryStorage &storage);
+        void lwbrx(u8 rt, u8 ra, u8 rb, MemoryStorage &storage);
+
+        void sthbrx(u8 rs, u8 ra, u8 rb, MemoryStorage &storage);
+        void stwbrx(u8 rs, u8 ra, u8 rb, MemoryStorage &storage);
+
+        void lmw(u8 rt, s16 d, u8 ra, MemoryStorage &storage);
+        void stmw(u8 rs, s16 d, u8 ra, MemoryStorage &storage);
+
+        void lswi(u8 rt, u8 ra, u8 nb, MemoryStorage &storage);
+        void lswx(u8 rt, u8 ra, u8 rb, MemoryStorage &storage);
+
+        void stswi(u8 rt, u8 ra, u8 nb, MemoryStorage &storage);
+        void stswx(u8 rt, u8 ra, u8 rb, MemoryStorage &storage);
 
         // Math
 
@@ -302,8 +295,8 @@ namespace Toolbox::Interpreter {
 
         // External control
 
-        void eciwx(u8 rt, u8 ra, u8 rb, Buffer &storage);
-        void ecowx(u8 rs, u8 ra, u8 rb, Buffer &storage);
+        void eciwx(u8 rt, u8 ra, u8 rb, MemoryStorage &storage);
+        void ecowx(u8 rs, u8 ra, u8 rb, MemoryStorage &storage);
 
     private:
         Register::XER m_xer{};
@@ -329,27 +322,27 @@ namespace Toolbox::Interpreter {
     protected:
         // Memory
 
-        void lfs(u8 frt, s16 d, u8 ra, Register::GPR gpr[32], Buffer &storage);
-        void lfsu(u8 frt, s16 d, u8 ra, Register::GPR gpr[32], Buffer &storage);
-        void lfsx(u8 frt, u8 ra, u8 rb, Register::GPR gpr[32], Buffer &storage);
-        void lfsux(u8 frt, u8 ra, u8 rb, Register::GPR gpr[32], Buffer &storage);
+        void lfs(u8 frt, s16 d, u8 ra, Register::GPR gpr[32], MemoryStorage &storage);
+        void lfsu(u8 frt, s16 d, u8 ra, Register::GPR gpr[32], MemoryStorage &storage);
+        void lfsx(u8 frt, u8 ra, u8 rb, Register::GPR gpr[32], MemoryStorage &storage);
+        void lfsux(u8 frt, u8 ra, u8 rb, Register::GPR gpr[32], MemoryStorage &storage);
 
-        void lfd(u8 frt, s16 d, u8 ra, Register::GPR gpr[32], Buffer &storage);
-        void lfdu(u8 frt, s16 d, u8 ra, Register::GPR gpr[32], Buffer &storage);
-        void lfdx(u8 frt, u8 ra, u8 rb, Register::GPR gpr[32], Buffer &storage);
-        void lfdux(u8 frt, u8 ra, u8 rb, Register::GPR gpr[32], Buffer &storage);
+        void lfd(u8 frt, s16 d, u8 ra, Register::GPR gpr[32], MemoryStorage &storage);
+        void lfdu(u8 frt, s16 d, u8 ra, Register::GPR gpr[32], MemoryStorage &storage);
+        void lfdx(u8 frt, u8 ra, u8 rb, Register::GPR gpr[32], MemoryStorage &storage);
+        void lfdux(u8 frt, u8 ra, u8 rb, Register::GPR gpr[32], MemoryStorage &storage);
 
-        void stfs(u8 frs, s16 d, u8 ra, Register::GPR gpr[32], Buffer &storage);
-        void stfsu(u8 frs, s16 d, u8 ra, Register::GPR gpr[32], Buffer &storage);
-        void stfsx(u8 frs, u8 ra, u8 rb, Register::GPR gpr[32], Buffer &storage);
-        void stfsux(u8 frs, u8 ra, u8 rb, Register::GPR gpr[32], Buffer &storage);
+        void stfs(u8 frs, s16 d, u8 ra, Register::GPR gpr[32], MemoryStorage &storage);
+        void stfsu(u8 frs, s16 d, u8 ra, Register::GPR gpr[32], MemoryStorage &storage);
+        void stfsx(u8 frs, u8 ra, u8 rb, Register::GPR gpr[32], MemoryStorage &storage);
+        void stfsux(u8 frs, u8 ra, u8 rb, Register::GPR gpr[32], MemoryStorage &storage);
 
-        void stfd(u8 frs, s16 d, u8 ra, Register::GPR gpr[32], Buffer &storage);
-        void stfdu(u8 frs, s16 d, u8 ra, Register::GPR gpr[32], Buffer &storage);
-        void stfdx(u8 frs, u8 ra, u8 rb, Register::GPR gpr[32], Buffer &storage);
-        void stfdux(u8 frs, u8 ra, u8 rb, Register::GPR gpr[32], Buffer &storage);
+        void stfd(u8 frs, s16 d, u8 ra, Register::GPR gpr[32], MemoryStorage &storage);
+        void stfdu(u8 frs, s16 d, u8 ra, Register::GPR gpr[32], MemoryStorage &storage);
+        void stfdx(u8 frs, u8 ra, u8 rb, Register::GPR gpr[32], MemoryStorage &storage);
+        void stfdux(u8 frs, u8 ra, u8 rb, Register::GPR gpr[32], MemoryStorage &storage);
 
-        void stfiwx(u8 frs, u8 ra, u8 rb, Register::GPR gpr[32], Buffer &storage);
+        void stfiwx(u8 frs, u8 ra, u8 rb, Register::GPR gpr[32], MemoryStorage &storage);
 
         // Move
 
@@ -438,17 +431,22 @@ namespace Toolbox::Interpreter {
 
         // Paired-Single
 
-        void helperQuantize(Buffer &storage, u32 addr, u32 instI, u32 instRS, u32 instW);
-        void helperDequantize(Buffer &storage, u32 addr, u32 instI, u32 instRD, u32 instW);
-
-        void ps_l(u8 frt, s16 d, u8 i, u8 ra, u8 w, Register::GPR gpr[32], Buffer &storage);
-        void ps_lu(u8 frt, s16 d, u8 i, u8 ra, u8 w, Register::GPR gpr[32], Buffer &storage);
-        void ps_lx(u8 frt, u8 ix, u8 ra, u8 rb, u8 wx, Register::GPR gpr[32], Buffer &storage);
-        void ps_lux(u8 frt, u8 ix, u8 ra, u8 rb, u8 wx, Register::GPR gpr[32], Buffer &storage);
-        void ps_st(u8 frt, s16 d, u8 i, u8 ra, u8 w, Register::GPR gpr[32], Buffer &storage);
-        void ps_stu(u8 frt, s16 d, u8 i, u8 ra, u8 w, Register::GPR gpr[32], Buffer &storage);
-        void ps_stx(u8 frt, u8 ix, u8 ra, u8 rb, u8 wx, Register::GPR gpr[32], Buffer &storage);
-        void ps_stux(u8 frt, u8 ix, u8 ra, u8 rb, u8 wx, Register::GPR gpr[32], Buffer &storage);
+        void helperQuantize(MemoryStorage &storage, u32 addr, u32 instI, u32 instRS, u32 instW);
+        void helperDequantize(MemoryStorage &storage, u32 addr, u32 instI, u32 instRD, u32 instW);
+
+        void ps_l(u8 frt, s16 d, u8 i, u8 ra, u8 w, Register::GPR gpr[32], MemoryStorage &storage);
+        void ps_lu(u8 frt, s16 d, u8 i, u8 ra, u8 w, Register::GPR gpr[32], MemoryStorage &storage);
+        void ps_lx(u8 frt, u8 ix, u8 ra, u8 rb, u8 wx, Register::GPR gpr[32],
+                   MemoryStorage &storage);
+        void ps_lux(u8 frt, u8 ix, u8 ra, u8 rb, u8 wx, Register::GPR gpr[32],
+                    MemoryStorage &storage);
+        void ps_st(u8 frt, s16 d, u8 i, u8 ra, u8 w, Register::GPR gpr[32], MemoryStorage &storage);
+        void ps_stu(u8 frt, s16 d, u8 i, u8 ra, u8 w, Register::GPR gpr[32],
+                    MemoryStorage &storage);
+        void ps_stx(u8 frt, u8 ix, u8 ra, u8 rb, u8 wx, Register::GPR gpr[32],
+                    MemoryStorage &storage);
+        void ps_stux(u8 frt, u8 ix, u8 ra, u8 rb, u8 wx, Register::GPR gpr[32],
+                     MemoryStorage &storage);
 
         void ps_cmpo0(u8 bf, u8 fra, u8 frb, Register::CR &cr, Register::MSR &msr,
                       Register::SRR1 &srr1);
@@ -1,9 +1,13 @@
 #pragma once
 
-#include "core/threaded.hpp"
-#include "dolphin/process.hpp"
-#include "gui/settings.hpp"
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include "instructions/forms.hpp"
+#include "memory.hpp"
 #include "processor.hpp"
 #include "registers.hpp"
 
@@ -17,10 +21,31 @@ namespace Toolbox::Interpreter {
 
     class SystemDolphin {
     public:
-        SystemDolphin();
+        using instruction_handler_t = void (SystemDolphin::*)(u32 inst,
+                                                              Register::PC &next_instruction);
+
+        // An instruction fetched, byteswapped and resolved to the
+        // handler of its primary opcode
+        struct DecodedInstruction {
+            u32 m_inst;
+            instruction_handler_t m_handler;
+        };
+
+        // A straight-line run of instructions ending at a branch or page
+        // boundary. Blocks are dropped when their page is written through
+        // the storage or hit by icbi. Writes Dolphin makes to an attached
+        // view bypass the storage, so a block is also redecoded when its
+        // first word changed, and clearBlockCache drops everything when
+        // the game loads new code.
+        struct DecodedBlock {
+            u32 m_address;
+            std::vector<DecodedInstruction> m_instructions;
+        };
+
+        static constexpr size_t c_max_block_length  = 64;
+        static constexpr size_t c_max_cached_blocks = 8192;
 
-        // Use this when you want to evaluate directly upon Dolphin's memory
-        explicit SystemDolphin(const Dolphin::DolphinCommunicator &);
+        SystemDolphin();
 
         SystemDolphin(const SystemDolphin &);
         SystemDolphin(SystemDolphin &&) noexcept;
@@ -33,14 +58,32 @@ namespace Toolbox::Interpreter {
         Register::RegisterSnapshot evaluateFunction(u32 function_ptr, u8 gpr_argc, u32 *gpr_argv,
                                                     u8 fpr_argc, f64 *fpr_argv);
 
-        Buffer &getMemoryBuffer() { return m_storage; }
+        MemoryStorage &getMemoryStorage() { return m_storage; }
+
+        // Evaluate directly upon the given memory, writes included
         void setMemoryBuffer(void *buf, size_t size) {
-            if (m_storage.buf<void>() == buf)
+            if (m_storage.isAttachedTo(buf))
                 return;
-            m_storage.setBuf(buf, size);
+            m_storage.attach(buf, size);
+            m_block_cache.clear();
             m_evaluating = false;
         }
 
+        void clearBlockCache() {
+            m_block_cache.clear();
+            m_block_cache_invalidated = true;
+        }
+
+        // Fetches and decodes every instruction as it runs instead, like
+        // before there was a cache. For debugging and benchmarking.
+        void setBlockCacheEnabled(bool enabled) {
+            m_block_cache_enabled = enabled;
+            m_block_cache.clear();
+        }
+
+        size_t getBlockCacheHits() const { return m_block_cache_hits; }
+        size_t getBlockCacheMisses() const { return m_block_cache_misses; }
+
         bool isStackPointerValid() const {
             return m_fixed_proc.m_gpr[1] >= 0x80000000 && m_fixed_proc.m_gpr[1] < 0x81800000;
         }
@@ -53,11 +96,11 @@ namespace Toolbox::Interpreter {
         void onException(func_exception_cb cb) { m_system_exception_cb = cb; }
         void onInvalid(func_invalid_cb cb) { m_system_invalid_cb = cb; }
 
+        // Evaluate upon a copy-on-write overlay of the given memory. Pages
+        // are read through until written, so the memory must outlive this.
         void applyMemory(const void *buf, size_t size) {
-            if (!m_storage) {
-                m_storage.alloc(size);
-            }
-            std::memcpy(m_storage.buf<void>(), buf, size);
+            m_storage.overlay(buf, size);
+            m_block_cache.clear();
         }
 
         template <typename T> T read(u32 address) const {
@@ -79,24 +122,30 @@ namespace Toolbox::Interpreter {
         }
 
         void readBytes(char *buf, u32 address, size_t size) const {
-            const char *true_address = m_storage.buf<const char>() + (address & 0x7FFFFFFF);
-            memcpy(buf, true_address, size);
+            m_storage.readBytes(buf, address & 0x7FFFFFFF, size);
         }
 
         void writeBytes(const char *buf, u32 address, size_t size) {
-            char *true_address = m_storage.buf<char>() + (address & 0x7FFFFFFF);
-            memcpy(true_address, buf, size);
+            m_storage.writeBytes(buf, address & 0x7FFFFFFF, size);
         }
 
     protected:
         void evalLoop();
-        void evaluateInstruction();
+        void evaluateInstruction(const DecodedInstruction &instr);
+        template <Opcode _Op> void evaluateOp(u32 inst, Register::PC &next_instruction);
+        static instruction_handler_t GetHandler(Opcode opcode);
+
         Register::PC evaluatePairedSingleSubOp(u32 instr);
         Register::PC evaluateControlFlowSubOp(u32 instr);
         Register::PC evaluateFixedSubOp(u32 instr);
         Register::PC evaluateFloatSingleSubOp(u32 instr);
         Register::PC evaluateFloatSubOp(u32 instr);
 
+        const DecodedBlock *lookupBlock(u32 address);
+        DecodedBlock decodeBlock(u32 address, size_t max_length = c_max_block_length) const;
+        void invalidateBlocks(u32 address);
+        void invalidateWrittenBlocks();
+
         void internalReturnCB() {
             // If the LR matches the sentinel we know we've returned from
             // the function rather than a child function
@@ -154,7 +203,14 @@ namespace Toolbox::Interpreter {
         }
 
     private:
-        Buffer m_storage;
+        MemoryStorage m_storage;
+
+        std::unordered_map<u32, DecodedBlock> m_block_cache;
+        DecodedBlock m_uncached_block;
+        bool m_block_cache_enabled     = true;
+        bool m_block_cache_invalidated = false;
+        size_t m_block_cache_hits      = 0;
+        size_t m_block_cache_misses    = 0;
 
         BranchProcessor m_branch_proc;
         FixedPointProcessor m_fixed_proc;
@@ -34,26 +34,42 @@ namespace Toolbox::Dolphin {
 
         void signalHook() { m_hook_flag.store(true); }
 
+        // Types other than numbers go through their MemoryMapper
         template <typename T> Result<T, BaseError> read(u32 address) {
             T data;
 
-            auto result = DolphinHookManager::instance().readBytes(reinterpret_cast<char *>(&data),
-                                                                   address, sizeof(T));
-            if (!result) {
-                return std::unexpected(result.error());
+            if constexpr (std::is_arithmetic_v<T>) {
+                auto result = DolphinHookManager::instance().readBytes(
+                    reinterpret_cast<char *>(&data), address, sizeof(T));
+                if (!result) {
+                    return std::unexpected(result.error());
+                }
+                return *endian_swapped_t<T>(data);
+            } else {
+                MemoryTransaction transaction;
+                transaction.read(address, data);
+                auto result = transaction.commit(DolphinHookManager::instance());
+                if (!result) {
+                    return std::unexpected(result.error());
+                }
+                return data;
             }
-
-            return *endian_swapped_t<T>(data);
         }
 
         template <typename T> Result<void> write(u32 address, const T &value) {
-            T swapped_v = *endian_swapped_t<T>(value);
-            auto result = DolphinHookManager::instance().writeBytes(
-                reinterpret_cast<const char *>(std::addressof(swapped_v)), address, sizeof(T));
-            if (!result) {
-                return std::unexpected(result.error());
+            if constexpr (std::is_arithmetic_v<T>) {
+                T swapped_v = *endian_swapped_t<T>(value);
+                auto result = DolphinHookManager::instance().writeBytes(
+                    reinterpret_cast<const char *>(std::addressof(swapped_v)), address, sizeof(T));
+                if (!result) {
+                    return std::unexpected(result.error());
+                }
+                return {};
+            } else {
+                MemoryTransaction transaction;
+                transaction.write(address, value);
+                return transaction.commit(DolphinHookManager::instance());
             }
-            return {};
         }
 
         Result<void> readBytes(char *buf, u32 address, size_t size) {
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <span>
+#include <string_view>
+
+#include "core/core.hpp"
+#include "core/error.hpp"
+#include "dolphin/transaction.hpp"
+#include "platform/process.hpp"
+
+namespace Toolbox::Dolphin {
+
+    // Low level access to the memory Dolphin shares with other processes.
+    // The handle is opened by process and segment name and then mapped into
+    // a view. On Linux a handle may have no view, its memory is then only
+    // reachable through TransferProcessSpans.
+
+    // Returns the max ProcessID when no process has the name
+    Result<Platform::ProcessID, BaseError> FindProcessPID(std::string_view process_name);
+
+    Result<Platform::LowHandle, BaseError> OpenProcessMemory(Platform::ProcessID pid,
+                                                             std::string_view memory_name);
+    Result<void *, BaseError> OpenMemoryView(Platform::LowHandle memory_handle);
+
+    Result<void> CloseProcessMemory(Platform::LowHandle memory_handle);
+    Result<void> CloseMemoryView(Platform::LowHandle memory_handle, void *memory_view);
+
+    // Copies spans of game memory for handles without a view, the writes
+    // before the reads. The spans must already be bounds checked.
+    Result<void> TransferProcessSpans(Platform::LowHandle memory_handle,
+                                      std::span<const MemorySpan> writes,
+                                      std::span<const MemorySpan> reads);
+
+#ifdef TOOLBOX_PLATFORM_LINUX
+    // What OpenProcessMemory falls back to when the segment can't be
+    // reopened, a handle that reaches it through process_vm only
+    Result<Platform::LowHandle, BaseError> OpenRemoteProcessMemory(Platform::ProcessID pid,
+                                                                   std::string_view memory_name);
+#endif
+
+}  // namespace Toolbox::Dolphin
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <type_traits>
+#include <vector>
+
+#include "core/error.hpp"
+#include "core/types.hpp"
+#include "objlib/transform.hpp"
+
+namespace Toolbox::Dolphin {
+
+    class DolphinHookManager;
+    class MemoryTransaction;
+
+    // How a value is laid out in game memory. Numbers are stored as is in
+    // big endian, other types specialize this to read and write through
+    // a MemoryTransaction as a whole.
+    template <typename T> struct MemoryMapper {
+        static_assert(std::is_arithmetic_v<T>, "MemoryMapper has no layout for this type");
+
+        static void Read(MemoryTransaction &transaction, u32 address, T &out);
+        static void Write(MemoryTransaction &transaction, u32 address, const T &value);
+    };
+
+    // A range of game memory and the host bytes it is copied from or to
+    struct MemorySpan {
+        u32 m_address = 0;
+        u32 m_size    = 0;
+        char *m_data  = nullptr;
+    };
+
+    // Gathers reads and writes of game memory so they run together.
+    //
+    // Nothing touches memory until `commit`, which sorts the requests,
+    // merges the ranges that touch and copies every merged range once,
+    // all under a single lock. Writes land before reads, so a read sees
+    // the writes of its own transaction. Read destinations must outlive
+    // the commit. The buffers are kept between commits, so reusing a
+    // transaction saves reallocating them.
+    class MemoryTransaction {
+    public:
+        // Reads this close are merged into one span, reading the gap too
+        static constexpr u32 c_read_merge_gap = 32;
+
+        // Larger steps between requests start a new run when sorting
+        static constexpr u32 c_run_gap = 0x100;
+
+        MemoryTransaction() = default;
+
+        // A single request out of bounds fails the whole commit, so callers
+        // batching unrelated values should check their addresses first
+        [[nodiscard]] static bool IsInMemory(u32 address, u32 size) {
+            return address >= 0x80000000 &&
+                   static_cast<u64>(address - 0x80000000) + size <= 0x1800000;
+        }
+
+        template <typename T> void read(u32 address, T &out) {
+            MemoryMapper<T>::Read(*this, address, out);
+        }
+
+        template <typename T> void write(u32 address, const T &value) {
+            MemoryMapper<T>::Write(*this, address, value);
+        }
+
+        // The bytes are swapped per element of `element_size` to convert
+        // between the big endian game and the host
+        void readBytes(char *buf, u32 address, u32 size, u32 element_size = 1);
+        void writeBytes(const char *buf, u32 address, u32 size, u32 element_size = 1);
+
+        [[nodiscard]] bool empty() const { return m_reads.empty() && m_writes.empty(); }
+        void clear();
+
+        // Runs and clears the requests. Nothing is copied when a range
+        // is out of bounds or the game isn't hooked.
+        Result<void> commit(DolphinHookManager &manager);
+
+    private:
+        struct Request {
+            u32 m_address        = 0;
+            u32 m_size           = 0;
+            u32 m_element_size   = 1;
+            char *m_dest         = nullptr;  // Reads only
+            size_t m_data_offset = 0;        // Writes only, into the written bytes
+            size_t m_span_offset = 0;        // Into the span bytes
+        };
+
+        void buildSpans(std::vector<Request> &requests, u32 merge_gap,
+                        std::vector<MemorySpan> &spans, std::vector<char> &data);
+
+        std::vector<Request> m_reads;
+        std::vector<Request> m_writes;
+        std::vector<char> m_write_data;
+
+        std::vector<MemorySpan> m_read_spans;
+        std::vector<MemorySpan> m_write_spans;
+        std::vector<char> m_read_span_data;
+        std::vector<char> m_write_span_data;
+
+        // Scratch for buildSpans
+        std::vector<u64> m_sorted_runs;
+        std::vector<u64> m_sorted_requests;
+        std::vector<size_t> m_span_offsets;
+    };
+
+    template <typename T>
+    void MemoryMapper<T>::Read(MemoryTransaction &transaction, u32 address, T &out) {
+        transaction.readBytes(reinterpret_cast<char *>(&out), address, sizeof(T), sizeof(T));
+    }
+
+    template <typename T>
+    void MemoryMapper<T>::Write(MemoryTransaction &transaction, u32 address, const T &value) {
+        transaction.writeBytes(reinterpret_cast<const char *>(&value), address, sizeof(T),
+                               sizeof(T));
+    }
+
+    // JGeometry::TVec3<f32>
+    template <> struct MemoryMapper<glm::vec3> {
+        static_assert(sizeof(glm::vec3) == sizeof(f32) * 3);
+
+        static void Read(MemoryTransaction &transaction, u32 address, glm::vec3 &out) {
+            transaction.readBytes(reinterpret_cast<char *>(&out.x), address, sizeof(glm::vec3),
+                                  sizeof(f32));
+        }
+
+        static void Write(MemoryTransaction &transaction, u32 address, const glm::vec3 &value) {
+            transaction.writeBytes(reinterpret_cast<const char *>(&value.x), address,
+                                   sizeof(glm::vec3), sizeof(f32));
+        }
+    };
+
+    // The transform block of JDrama::TActor, which starts at 0x10 into the
+    // actor. The 8 bytes between the translation and the scale are skipped.
+    template <> struct MemoryMapper<Object::Transform> {
+        static constexpr u32 c_translation_offset = 0x0;
+        static constexpr u32 c_scale_offset       = 0x14;
+        static constexpr u32 c_rotation_offset    = 0x20;
+
+        static void Read(MemoryTransaction &transaction, u32 address, Object::Transform &out) {
+            transaction.read(address + c_translation_offset, out.m_translation);
+            transaction.read(address + c_scale_offset, out.m_scale);
+            transaction.read(address + c_rotation_offset, out.m_rotation);
+        }
+
+        static void Write(MemoryTransaction &transaction, u32 address,
+                          const Object::Transform &value) {
+            transaction.write(address + c_translation_offset, value.m_translation);
+            transaction.write(address + c_scale_offset, value.m_scale);
+            transaction.write(address + c_rotation_offset, value.m_rotation);
+        }
+    };
+
+}  // namespace Toolbox::Dolphin
\ No newline at end of file
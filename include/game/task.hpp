@@ -9,6 +9,7 @@
 #include "core/error.hpp"
 #include "core/memory.hpp"
 #include "core/types.hpp"
+#include "dolphin/capture.hpp"
 #include "dolphin/interpreter/system.hpp"
 #include "dolphin/process.hpp"
 #include "gui/scene/camera.hpp"
@@ -66,7 +67,14 @@ namespace Toolbox::Game {
         Result<void> setObjectTransform(RefPtr<PhysicalSceneObject> object,
                                         const Transform &transform);
 
-        ImageHandle captureXFBAsTexture(int width, int height);
+        // Queues the writes into `transaction` to commit many objects at
+        // once. The caller checks that the scene is loaded.
+        Result<void> setObjectTransform(RefPtr<PhysicalSceneObject> object,
+                                        const Transform &transform,
+                                        Dolphin::MemoryTransaction &transaction);
+
+        // The texture is reused, so it only holds until the next call
+        const ImageHandle &captureXFBAsTexture(int width, int height);
 
         ScopePtr<Interpreter::SystemDolphin> createInterpreter();
         ScopePtr<Interpreter::SystemDolphin> createInterpreterUnchecked();
@@ -117,10 +125,19 @@ namespace Toolbox::Game {
         void vectorForEach(u32 vector_ptr, u32 item_size,
                            std::function<void(DolphinCommunicator &, u32)> fn);
 
+        // Hooks through process_vm have no view for the game interpreter to
+        // evaluate upon, every evaluation must be skipped without one
+        bool hasGameMemory();
+
         bool checkForAcquiredStackFrameAndBuffer();
 
     private:
         Interpreter::SystemDolphin m_game_interpreter;
+        Dolphin::XFBCapture m_xfb_capture;
+
+        // Scene the interpreter's decoded blocks were cached in, 0xFF when unhooked
+        u8 m_interpreter_stage    = 0xFF;
+        u8 m_interpreter_scenario = 0xFF;
 
         std::queue<std::function<bool(Dolphin::DolphinCommunicator &)>> m_task_queue;
         std::unordered_map<UUID64, u32> m_actor_address_map;
@@ -26,11 +26,12 @@ namespace Toolbox::UI {
 
     class LoggingWindow final : public ImWindow {
     protected:
-        void appendMessageToPool(const Log::AppLogger::LogMessage &message);
+        void onMessageLogged(const Log::AppLogger::LogMessage &message);
+        [[nodiscard]] bool isMessageVisible(const Log::AppLogger::LogMessage &message) const;
 
     public:
         LoggingWindow(const std::string &name) : ImWindow(name) {
-            TOOLBOX_LOG_CALLBACK(TOOLBOX_BIND_EVENT_FN(LoggingWindow::appendMessageToPool));
+            TOOLBOX_LOG_CALLBACK(TOOLBOX_BIND_EVENT_FN(LoggingWindow::onMessageLogged));
             TOOLBOX_INFO("Logger successfully started!");
         }
         ~LoggingWindow() = default;
@@ -79,5 +80,8 @@ namespace Toolbox::UI {
         Log::ReportLevel m_logging_level = Log::ReportLevel::REPORT_INFO;
         uint32_t m_dock_space_id         = 0;
         bool m_scroll_requested          = false;
+
+        // Indices of the messages that pass the verbosity filter
+        std::vector<size_t> m_visible_messages = {};
     };
 }  // namespace Toolbox::UI
\ No newline at end of file
@@ -28,6 +28,8 @@ namespace Toolbox::UI {
 
         void loadBillboardTexture(std::filesystem::path imagePath, int textureIndex);
         void drawBillboards(Camera *camera);
+        // All billboards go out in one draw
+        [[nodiscard]] uint32_t getDrawCallCount() const { return m_billboards.empty() ? 0 : 1; }
 
         [[nodiscard]] bool initBillboardRenderer(int billboardResolution, int billboardImageCount);
 
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "core/types.hpp"
+
+namespace Toolbox::UI {
+
+    struct BVHBounds {
+        glm::vec3 m_min = glm::vec3(std::numeric_limits<float>::max());
+        glm::vec3 m_max = glm::vec3(std::numeric_limits<float>::lowest());
+
+        // Bounds of a local box after `transform` is applied to it
+        static BVHBounds FromBox(const glm::vec3 &min, const glm::vec3 &max,
+                                 const glm::mat4x4 &transform);
+        static BVHBounds FromSphere(const glm::vec3 &center, float radius);
+
+        void expand(const BVHBounds &other) {
+            m_min = glm::min(m_min, other.m_min);
+            m_max = glm::max(m_max, other.m_max);
+        }
+
+        [[nodiscard]] glm::vec3 center() const { return (m_min + m_max) * 0.5f; }
+
+        // Distance along the ray at which it enters the bounds, zero when
+        // it starts inside. Misses past `max_distance` don't count.
+        [[nodiscard]] bool intersectRay(const glm::vec3 &origin, const glm::vec3 &inv_direction,
+                                        float max_distance, float &distance) const;
+    };
+
+    // Bounding volume hierarchy over items identified by their index.
+    //
+    // Every leaf holds one item, so moving an item refits the bounds on
+    // its path to the root without rebuilding the tree. Refitting lets
+    // the tree degrade as items move far, which a build undoes.
+    class BoundingVolumeHierarchy {
+    public:
+        void build(const std::vector<BVHBounds> &bounds);
+        void refit(size_t item, const BVHBounds &bounds);
+        void clear();
+
+        [[nodiscard]] bool empty() const { return m_nodes.empty(); }
+        [[nodiscard]] size_t size() const { return m_leaves.size(); }
+
+        // Nearest item the ray hits closer than `distance`, which is then
+        // set to the hit. `intersect` is the exact test for an item whose
+        // bounds the ray enters, `bool(size_t item, float &distance)`.
+        template <typename IntersectT>
+        std::optional<size_t> raycast(const glm::vec3 &origin, const glm::vec3 &direction,
+                                      IntersectT &&intersect, float &distance) const;
+
+    private:
+        static constexpr u32 c_no_node = std::numeric_limits<u32>::max();
+
+        struct Node {
+            BVHBounds m_bounds;
+            u32 m_parent = c_no_node;
+            u32 m_left   = c_no_node;
+            u32 m_right  = c_no_node;
+            u32 m_item   = c_no_node;
+
+            [[nodiscard]] bool isLeaf() const { return m_item != c_no_node; }
+        };
+
+        u32 buildNode(const std::vector<BVHBounds> &bounds, std::vector<u32> &items, size_t begin,
+                      size_t end, u32 parent);
+
+        std::vector<Node> m_nodes;
+        std::vector<u32> m_leaves;
+    };
+
+    template <typename IntersectT>
+    std::optional<size_t> BoundingVolumeHierarchy::raycast(const glm::vec3 &origin,
+                                                           const glm::vec3 &direction,
+                                                           IntersectT &&intersect,
+                                                           float &distance) const {
+        if (m_nodes.empty()) {
+            return std::nullopt;
+        }
+
+        const glm::vec3 inv_direction = 1.0f / direction;
+
+        std::optional<size_t> nearest;
+        float nearest_distance = distance;
+
+        // Median splits keep the depth near log2 of the item count
+        struct Entry {
+            u32 m_node;
+            float m_distance;
+        } stack[64];
+        size_t depth = 0;
+
+        float root_distance;
+        if (!m_nodes[0].m_bounds.intersectRay(origin, inv_direction, nearest_distance,
+                                              root_distance)) {
+            return std::nullopt;
+        }
+        stack[depth++] = {0, root_distance};
+
+        while (depth > 0) {
+            Entry entry = stack[--depth];
+            if (entry.m_distance >= nearest_distance) {
+                continue;
+            }
+
+            const Node &node = m_nodes[entry.m_node];
+            if (node.isLeaf()) {
+                float item_distance;
+                if (intersect(static_cast<size_t>(node.m_item), item_distance) &&
+                    item_distance < nearest_distance) {
+                    nearest_distance = item_distance;
+                    nearest          = node.m_item;
+                }
+                continue;
+            }
+
+            float left_distance, right_distance;
+            bool hit_left  = m_nodes[node.m_left].m_bounds.intersectRay(
+                origin, inv_direction, nearest_distance, left_distance);
+            bool hit_right = m_nodes[node.m_right].m_bounds.intersectRay(
+                origin, inv_direction, nearest_distance, right_distance);
+
+            // The nearer child goes on top so it is searched first
+            if (hit_left && hit_right) {
+                if (left_distance < right_distance) {
+                    stack[depth++] = {node.m_right, right_distance};
+                    stack[depth++] = {node.m_left, left_distance};
+                } else {
+                    stack[depth++] = {node.m_left, left_distance};
+                    stack[depth++] = {node.m_right, right_distance};
+                }
+            } else if (hit_left) {
+                stack[depth++] = {node.m_left, left_distance};
+            } else if (hit_right) {
+                stack[depth++] = {node.m_right, right_distance};
+            }
+        }
+
+        if (nearest) {
+            distance = nearest_distance;
+        }
+        return nearest;
+    }
+
+}  // namespace Toolbox::UI
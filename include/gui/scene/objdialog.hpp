@@ -57,7 +57,7 @@ namespace Toolbox::UI {
         action_t m_on_accept;
         cancel_t m_on_reject;
 
-        std::vector<ScopePtr<Object::Template>> m_templates = {};
+        std::vector<RefPtr<const Object::Template>> m_templates = {};
     };
 
     class RenameObjDialog {
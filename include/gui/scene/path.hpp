@@ -19,9 +19,12 @@ namespace Toolbox::UI {
         uint32_t m_point_size;
     };
 
-    struct PathConnection {
-        PathPoint m_point;
-        std::vector<PathPoint> m_connections;
+    // One per connection, the line and arrowhead are built from it on the
+    // GPU and both take the source node's color
+    struct PathArrow {
+        glm::vec3 m_from;
+        glm::vec3 m_to;
+        glm::vec4 m_color;
     };
 
     class PathRenderer {
@@ -29,16 +32,44 @@ namespace Toolbox::UI {
         uint32_t m_mvp_uniform;
         uint32_t m_mode_uniform;
 
+        uint32_t m_line_program;
+        uint32_t m_line_mvp_uniform;
+        uint32_t m_line_size_uniform;
+
+        uint32_t m_arrow_program;
+        uint32_t m_arrow_mvp_uniform;
+        uint32_t m_arrow_eye_uniform;
+        uint32_t m_arrow_size_uniform;
+
         uint32_t m_vao, m_vbo;
+        uint32_t m_arrow_vao, m_arrow_vbo;
 
-        std::vector<PathConnection> m_path_connections;
+        // Where a node's data lives in the buffers, so moving it only
+        // rewrites those parts
+        struct NodeRange {
+            uint32_t m_point;
+            std::vector<uint32_t> m_arrows_from;
+            std::vector<uint32_t> m_arrows_to;
+        };
+
+        std::vector<PathPoint> m_points;
+        std::vector<PathArrow> m_arrows;
+        std::unordered_map<UUID64, NodeRange> m_node_ranges;
+
+        uint32_t m_draw_calls = 0;
 
     public:
         [[nodiscard]] bool initPathRenderer();
         void updateGeometry(const RailData &data,
                             std::unordered_map<UUID64, bool> visible_map);
+        // Only the node's position may have changed since updateGeometry,
+        // connection changes need a full update
+        void updateNode(const Rail::RailNode &node);
         void drawPaths(Camera *camera);
 
+        // Draw calls made by the last drawPaths
+        [[nodiscard]] uint32_t getDrawCallCount() const { return m_draw_calls; }
+
         PathRenderer();
         ~PathRenderer();
     };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <limits>
 #include <unordered_map>
 
 #include <imgui.h>
@@ -9,6 +10,7 @@
 #include "core/types.hpp"
 #include "core/time/timestep.hpp"
 #include "gui/scene/billboard.hpp"
+#include "gui/scene/bvh.hpp"
 #include "gui/scene/camera.hpp"
 #include "gui/scene/ImGuizmo.h"
 #include "scene/raildata.hpp"
@@ -21,6 +23,9 @@ namespace Toolbox::UI {
     namespace Render {
         bool CompileShader(const char *vertex_shader_src, const char *geometry_shader_src,
                            const char *fragment_shader_src, uint32_t &program_id_out);
+
+        // Milliseconds the last sort of the render packets took
+        f64 GetPacketSortTime();
     }
 
     class Renderer {
@@ -35,6 +40,14 @@ namespace Toolbox::UI {
             initializePaths(rail_data, visible_map);
         }
 
+        // Cheaper than updatePaths when only the node's position changed
+        void updatePathNode(const Rail::RailNode &node);
+
+        // Keeps culling and picking in step with the renderables passed to
+        // render, call after rebuilding them or with the one that was replaced
+        void updateRenderables(const std::vector<ISceneObject::RenderInfo> &renderables);
+        void updateRenderable(size_t index, const ISceneObject::RenderInfo &renderable);
+
         void markDirty() { m_is_view_dirty = true; }
 
         void getCameraTranslation(glm::vec3 &translation) { m_camera.getPos(translation); }
@@ -55,13 +68,20 @@ namespace Toolbox::UI {
         using selection_variant_t =
             std::variant<RefPtr<ISceneObject>, RefPtr<Rail::RailNode>, std::nullopt_t>;
 
-        selection_variant_t findSelection(std::vector<ISceneObject::RenderInfo> renderables,
-                                          std::vector<RefPtr<Rail::RailNode>> rail_nodes,
-                                          bool &should_reset);
+        // Picks among the objects and rail nodes last given to the renderer
+        selection_variant_t findSelection(bool &should_reset);
 
-        void render(std::vector<ISceneObject::RenderInfo> renderables, TimeStep delta_time);
+        void render(const std::vector<ISceneObject::RenderInfo> &renderables,
+                    TimeStep delta_time);
 
     protected:
+        struct SelectionBox {
+            RefPtr<ISceneObject> m_object;
+            glm::mat4x4 m_inv_transform;
+            glm::vec3 m_min, m_max;
+            BVHBounds m_bounds;
+        };
+
         void initializePaths(const RailData &rail_data,
                              std::unordered_map<UUID64, bool> visible_map);
         void initializeBillboards();
@@ -69,6 +89,20 @@ namespace Toolbox::UI {
         void viewportBegin();
         void viewportEnd();
 
+        struct RenderBounds {
+            BVHBounds m_bounds;
+            bool m_is_cullable;
+        };
+
+        // World bounds and selection box of a renderable, false for the
+        // box when it can't be clicked
+        static bool MakeRenderBounds(const ISceneObject::RenderInfo &renderable,
+                                     RenderBounds &bounds, SelectionBox &box);
+
+        // Models within the view and the render distance
+        void cullRenderables(const std::vector<ISceneObject::RenderInfo> &renderables,
+                             std::vector<RefPtr<J3DModelInstance>> &models);
+
     private:
         u32 m_fbo_id, m_tex_id, m_rbo_id;
 
@@ -77,6 +111,27 @@ namespace Toolbox::UI {
         bool m_is_view_manipulating = false;
         bool m_is_view_dirty        = true;
 
+        // Made by the last redraw of the view, model draws are counted per
+        // render packet
+        size_t m_draw_calls = 0;
+
+        std::vector<RenderBounds> m_render_bounds;
+        size_t m_visible_count = 0;
+        size_t m_culled_count  = 0;
+
+        // Clickable models and visible rail nodes, each in a BVH indexed
+        // the same as its vector. Renderables that can't be clicked map
+        // to c_not_selectable.
+        static constexpr size_t c_not_selectable = std::numeric_limits<size_t>::max();
+
+        std::vector<SelectionBox> m_selection_boxes;
+        std::vector<size_t> m_selection_box_indices;
+        BoundingVolumeHierarchy m_selection_box_bvh;
+
+        std::vector<RefPtr<Rail::RailNode>> m_selection_nodes;
+        std::unordered_map<UUID64, size_t> m_selection_node_indices;
+        BoundingVolumeHierarchy m_selection_node_bvh;
+
         BillboardRenderer m_billboard_renderer;
         PathRenderer m_path_renderer;
         Camera m_camera = {};
@@ -5,6 +5,8 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "core/memory.hpp"
@@ -85,8 +87,19 @@ namespace Toolbox::UI {
         void onRenderMenuBar() override;
         void onRenderBody(TimeStep delta_time) override;
 
+        // One visible line of the hierarchy view
+        struct HierarchyRow {
+            RefPtr<Object::ISceneObject> m_node;
+            size_t m_node_index;  // Index among its parent's children
+            size_t m_depth;
+            bool m_is_open;
+        };
+
         void renderHierarchy();
-        void renderTree(size_t node_index, RefPtr<Object::ISceneObject> node);
+        void buildHierarchyRows(std::vector<HierarchyRow> &rows, size_t node_index,
+                                RefPtr<Object::ISceneObject> node, size_t depth);
+        void renderTree(const std::vector<HierarchyRow> &rows);
+        void renderTreeNode(const HierarchyRow &row);
         void renderRailEditor();
         void renderScene(TimeStep delta_time);
         void renderDolphin(TimeStep delta_time);
@@ -103,6 +116,10 @@ namespace Toolbox::UI {
         static bool renderRailProperties(SceneWindow &window);
         static bool renderRailNodeProperties(SceneWindow &window);
 
+        void onObjectChanged(Object::ISceneObject &object, Object::ISceneObject::ChangeKind kind);
+        void rebuildRenderables();
+        void updateDirtyRenderables();
+
         void calcDolphinVPMatrix();
         void reassignAllActorPtrs(u32 param);
 
@@ -200,6 +217,17 @@ namespace Toolbox::UI {
         ContextMenu<std::vector<SelectionNodeInfo<Object::ISceneObject>>>
             m_hierarchy_multi_node_menu;
 
+        // The hierarchies flattened into the rows that pass the filter and
+        // sit under open groups. Rebuilt only when the filter, a group's
+        // open state or the structure of either hierarchy changes.
+        std::vector<HierarchyRow> m_hierarchy_rows           = {};
+        std::vector<HierarchyRow> m_table_rows               = {};
+        bool m_hierarchy_dirty                               = true;
+        std::unordered_set<ImGuiID> m_hierarchy_selected_ids = {};
+
+        // Groups whose open state differs from the default, roots start open
+        std::unordered_set<UUID64> m_toggled_groups = {};
+
         // Property editor
         std::function<bool(SceneWindow &)> m_properties_render_handler;
         std::vector<ScopePtr<IProperty>> m_selected_properties = {};
@@ -213,7 +241,12 @@ namespace Toolbox::UI {
         bool m_is_render_window_open = false;
         Renderer m_renderer;
         std::vector<ISceneObject::RenderInfo> m_renderables = {};
-        ResourceCache m_resource_cache;
+
+        // Indices into m_renderables, and the objects whose members changed
+        // since the last frame. Anything else that changes the hierarchy
+        // sets m_update_render_objs and rebuilds the whole list.
+        std::unordered_map<UUID64, size_t> m_renderable_indices               = {};
+        std::unordered_map<UUID64, RefPtr<ISceneObject>> m_dirty_renderables = {};
 
         // Docking facilities
         ImGuiID m_dock_space_id          = 0;
@@ -252,8 +285,9 @@ namespace Toolbox::UI {
         bool m_is_verify_open         = false;
 
         bool m_is_game_edit_mode = false;
+        Dolphin::MemoryTransaction m_game_edit_transaction;
+        std::unordered_set<UUID64> m_game_edit_failures = {};
 
-        ImageHandle m_dolphin_image;
         ImagePainter m_dolphin_painter;
 
         glm::mat4x4 m_dolphin_vp_mtx = {};
@@ -43,6 +43,7 @@ namespace Toolbox {
         float m_camera_sensitivity  = 1.0f;
         float m_near_plane          = 50.0f;
         float m_far_plane           = 500000.0f;
+        float m_render_distance     = 0.0f;  // Models further out are culled, 0 for no limit
 
         // Control
         KeyBind m_gizmo_translate_mode_keybind = KeyBind({KeyCode::KEY_D1});
@@ -54,6 +55,8 @@ namespace Toolbox {
         s64 m_dolphin_refresh_rate           = 100;  // In milliseconds
         bool m_is_template_cache_allowed     = true;
         bool m_log_to_cout_cerr              = false;
+        bool m_log_to_file                   = false;
+        s64 m_log_capacity                   = 5000;  // Messages kept in the log window
     };
 
     class SettingsManager {
@@ -24,6 +24,10 @@ namespace Toolbox {
         // Data should be a valid RED, RGB, or RGBA image as loaded by stbi
         ImageHandle(const Buffer &data, int channels, int dx, int dy);
 
+        // Replaces the pixels in place when the size and channels match,
+        // otherwise the texture is created again
+        void update(const Buffer &data, int channels, int dx, int dy);
+
         [[nodiscard]] bool isValid() const noexcept;
         std::pair<int, int> size() const { return {m_image_width, m_image_height}; }
 
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "core/types.hpp"
+
+namespace Toolbox {
+
+    // Converts `pixel_count` pixels of studio range YUV 4:2:2, stored as
+    // Y0 U Y1 V for every pair of pixels, to full range RGBA with opaque
+    // alpha. The math is 6 bit fixed point, run 16 pixels at a time with
+    // AVX2 or 8 with SSE2 when the build targets them.
+    void YUV422ToRGBA8(const u8 *yuv, u8 *rgba, size_t pixel_count);
+
+}  // namespace Toolbox
\ No newline at end of file
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "core/memory.hpp"
+#include "core/types.hpp"
+#include "errors.hpp"
+#include "member.hpp"
+#include "objlib/qualname.hpp"
+#include <limits>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Toolbox::Object {
+
+    // A member name parsed once into interned scope names and array
+    // indices, and hashed once, so looking it up again never has to
+    // touch the original string
+    class MemberPath {
+    public:
+        static constexpr u32 c_no_index = std::numeric_limits<u32>::max();
+
+        struct Scope {
+            u32 m_name_id       = 0;
+            u32 m_array_index   = c_no_index;
+            std::string_view m_name;
+
+            [[nodiscard]] bool operator==(const Scope &other) const {
+                return m_name_id == other.m_name_id && m_array_index == other.m_array_index;
+            }
+        };
+
+        struct Hash {
+            size_t operator()(const MemberPath &path) const { return path.hash(); }
+        };
+
+        MemberPath()                       = default;
+        MemberPath(const MemberPath &)     = default;
+        MemberPath(MemberPath &&) noexcept = default;
+        ~MemberPath()                      = default;
+
+        MemberPath &operator=(const MemberPath &)     = default;
+        MemberPath &operator=(MemberPath &&) noexcept = default;
+
+        // Each scope may end in an array specifier, `Name[2]`
+        static Result<MemberPath, MetaScopeError> FromName(const QualifiedName &name);
+
+        [[nodiscard]] bool empty() const { return m_scopes.empty(); }
+        [[nodiscard]] size_t depth() const { return m_scopes.size(); }
+        [[nodiscard]] size_t hash() const { return m_hash; }
+
+        [[nodiscard]] const Scope &operator[](size_t index) const { return m_scopes[index]; }
+
+        // Rebuilds the name the path was parsed from, for error reporting
+        [[nodiscard]] QualifiedName toQualifiedName() const;
+
+        [[nodiscard]] bool operator==(const MemberPath &other) const {
+            return m_hash == other.m_hash && m_scopes == other.m_scopes;
+        }
+
+    private:
+        std::vector<Scope> m_scopes;
+        size_t m_hash = 0;
+    };
+
+    // Where member paths resolve to within one object type. Every object
+    // of a type shares its template's member layout, so a path that was
+    // resolved once is afterwards a walk down known indices rather than
+    // a search by name on every object.
+    class MemberLayout {
+    public:
+        struct Entry {
+            // Index into the member list and size of that list per scope
+            std::vector<u32> m_indices;
+            std::vector<u32> m_counts;
+
+            // Offset of the member's first element within the member data,
+            // only known when nothing in front of it can change size
+            std::optional<size_t> m_offset;
+        };
+
+        MemberLayout()                     = default;
+        MemberLayout(const MemberLayout &) = delete;
+        ~MemberLayout()                    = default;
+
+        MemberLayout &operator=(const MemberLayout &) = delete;
+
+        // Layouts live as long as the program, the reference stays valid
+        static MemberLayout &ForType(std::string_view type);
+
+        // Entries are never replaced or removed, so the pointer stays valid
+        [[nodiscard]] const Entry *find(const MemberPath &path) const;
+        void insert(const MemberPath &path, const Entry &entry);
+
+    private:
+        mutable std::shared_mutex m_mutex;
+        std::unordered_map<MemberPath, Entry, MemberPath::Hash> m_entries;
+    };
+
+    // Resolves `path` against the top level `members` of an object or
+    // struct. Passing a layout caches the resolution for every other
+    // owner of the same type. A path that names no member resolves to
+    // nullptr, matching getMember.
+    MetaStruct::GetMemberT ResolveMember(const std::vector<RefPtr<MetaMember>> &members,
+                                         const MemberPath &path, MemberLayout *layout);
+
+    // Byte offset of element `index` of the member at `path`, counted
+    // from the start of the member data as the template lays it out
+    Result<size_t, MetaScopeError>
+    ResolveMemberOffset(const std::vector<RefPtr<MetaMember>> &members, const MemberPath &path,
+                        size_t index, MemberLayout *layout);
+
+    // Serialized size of element `index` of the member at `path`
+    Result<size_t, MetaScopeError>
+    ResolveMemberSize(const std::vector<RefPtr<MetaMember>> &members, const MemberPath &path,
+                      size_t index, MemberLayout *layout);
+
+}  // namespace Toolbox::Object
@@ -15,12 +15,12 @@
 namespace Toolbox::Object {
 
     class MetaMember;
+    class MemberPath;
 
     class MetaStruct : public ISerializable, public ISmartResource {
     public:
-        using MemberT      = RefPtr<MetaMember>;
-        using GetMemberT   = Result<MemberT, MetaScopeError>;
-        using CacheMemberT = std::unordered_map<std::string, MemberT>;
+        using MemberT    = RefPtr<MetaMember>;
+        using GetMemberT = Result<MemberT, MetaScopeError>;
 
         MetaStruct(std::string_view name) : m_name(name) {}
         MetaStruct(std::string_view name, std::vector<MetaMember> members);
@@ -34,12 +34,11 @@ namespace Toolbox::Object {
     public:
         [[nodiscard]] constexpr std::string_view name() const { return m_name; }
 
-        [[nodiscard]] constexpr std::vector<RefPtr<MetaMember>> members() const {
-            return m_members;
-        }
+        [[nodiscard]] const std::vector<RefPtr<MetaMember>> &members() const { return m_members; }
 
         [[nodiscard]] GetMemberT getMember(std::string_view name) const;
         [[nodiscard]] GetMemberT getMember(const QualifiedName &name) const;
+        [[nodiscard]] GetMemberT getMember(const MemberPath &path) const;
 
         [[nodiscard]] constexpr MetaStruct *parent() const { return m_parent; }
 
@@ -63,8 +62,6 @@ namespace Toolbox::Object {
         std::string m_name;
         std::vector<RefPtr<MetaMember>> m_members = {};
         MetaStruct *m_parent                               = nullptr;
-
-        mutable CacheMemberT m_member_cache;
     };
 
 }  // namespace Toolbox::Object
\ No newline at end of file
@@ -6,12 +6,15 @@
 #include "jsonlib.hpp"
 #include "objlib/transform.hpp"
 #include "serial.hpp"
+#include <array>
+#include <cstring>
 #include <expected>
 #include <functional>
 #include <glm/glm.hpp>
 #include <magic_enum.hpp>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <variant>
 
 #include "core/memory.hpp"
@@ -105,7 +108,7 @@ namespace Toolbox::Object {
     };
 
     template <typename T, bool comment = false>
-    static constexpr MetaType template_type_v = map_to_type_enum<T, comment>::value;
+    static constexpr MetaType template_type_v = map_to_type_enum<T>::value;
 
     template <MetaType T> struct meta_type_info {
         static constexpr std::string_view name = "unknown";
@@ -301,20 +304,16 @@ namespace Toolbox::Object {
         }
     }
 
+    // Values are stored inline in their serialized size, the largest being
+    // a transform, so only strings ever allocate
     class MetaValue : public ISerializable {
     public:
         MetaValue() = delete;
-        template <typename T> explicit MetaValue(T value) : m_value_buf() {
-            m_value_buf.alloc(128);
-            m_value_buf.initTo(0);
-            set<T>(value);
-        }
-        explicit MetaValue(MetaType type) : m_type(type), m_value_buf() {
-            m_value_buf.alloc(128);
-            m_value_buf.initTo(0);
+        template <typename T> explicit MetaValue(T value) { set<T>(value); }
+        explicit MetaValue(MetaType type) : m_type(type) {
             switch (type) {
             case MetaType::TRANSFORM:
-                m_value_buf.set<Transform>(0, Transform());
+                storeInline(Transform());
                 break;
             default:
                 break;
@@ -339,35 +338,20 @@ namespace Toolbox::Object {
         template <typename T> [[nodiscard]] Result<T, std::string> get() const {
             if (m_type != map_to_type_enum<T>::value)
                 return std::unexpected("Type record mismatch");
-            return m_value_buf.get<T>(0);
-        }
-
-        template <> [[nodiscard]] Result<std::string, std::string> get() const {
-            std::string out;
-            for (size_t i = 0; i < m_value_buf.size(); ++i) {
-                char ch = m_value_buf.get<char>(i);
-                if (ch == '\0')
-                    break;
-
-                out.push_back(ch);
+            if constexpr (std::is_same_v<T, std::string>) {
+                return m_string;
+            } else {
+                return loadInline<T>();
             }
-            return out;
         }
 
         template <typename T> bool set(const T &value) {
             m_type = map_to_type_enum<T>::value;
-            m_value_buf.set<T>(0, value);
-            return true;
-        }
-
-        template <> bool set(const std::string &value) {
-            m_type = MetaType::STRING;
-            if (value.size() > m_value_buf.size() + 1) {
-                m_value_buf.resize(static_cast<size_t>(value.size() * 1.5f));
-            }
-            m_value_buf.initTo('\0');
-            for (size_t i = 0; i < value.size(); ++i) {
-                m_value_buf.set<char>(i, value[i]);
+            if constexpr (std::is_same_v<T, std::string>) {
+                m_string = value;
+            } else {
+                m_string.clear();
+                storeInline(value);
             }
             return true;
         }
@@ -382,8 +366,42 @@ namespace Toolbox::Object {
         Result<void, SerialError> deserialize(Deserializer &in) override;
 
     private:
-        Buffer m_value_buf;
+        static constexpr size_t c_inline_size = meta_type_info<MetaType::TRANSFORM>::size;
+
+        // Colors are polymorphic, only their channels are kept
+        template <typename T> void storeInline(const T &value) {
+            m_inline.fill(0);
+            if constexpr (std::is_same_v<T, Color::RGB24>) {
+                m_inline[0] = value.m_r;
+                m_inline[1] = value.m_g;
+                m_inline[2] = value.m_b;
+            } else if constexpr (std::is_same_v<T, Color::RGBA32>) {
+                m_inline[0] = value.m_r;
+                m_inline[1] = value.m_g;
+                m_inline[2] = value.m_b;
+                m_inline[3] = value.m_a;
+            } else {
+                static_assert(std::is_trivially_copyable_v<T> && sizeof(T) <= c_inline_size,
+                              "Type can not be stored inline");
+                std::memcpy(m_inline.data(), &value, sizeof(T));
+            }
+        }
+
+        template <typename T> [[nodiscard]] T loadInline() const {
+            if constexpr (std::is_same_v<T, Color::RGB24>) {
+                return Color::RGB24(m_inline[0], m_inline[1], m_inline[2]);
+            } else if constexpr (std::is_same_v<T, Color::RGBA32>) {
+                return Color::RGBA32(m_inline[0], m_inline[1], m_inline[2], m_inline[3]);
+            } else {
+                T value;
+                std::memcpy(&value, m_inline.data(), sizeof(T));
+                return value;
+            }
+        }
+
         MetaType m_type = MetaType::UNKNOWN;
+        alignas(f64) std::array<u8, c_inline_size> m_inline = {};
+        std::string m_string;
     };
 
     inline Result<bool, MetaError> setMetaValue(RefPtr<MetaValue> meta_value, bool value,
@@ -4,6 +4,8 @@
 #include "nameref.hpp"
 #include "objlib/errors.hpp"
 #include "objlib/meta/member.hpp"
+#include "objlib/meta/memberpath.hpp"
+#include "objlib/resourcecache.hpp"
 #include "template.hpp"
 #include "transform.hpp"
 #include "unique.hpp"
@@ -15,6 +17,7 @@
 #include <boundbox.hpp>
 #include <expected>
 #include <filesystem>
+#include <functional>
 #include <stacktrace>
 #include <string>
 #include <unordered_map>
@@ -25,6 +28,8 @@ using namespace J3DAnimation;
 
 namespace Toolbox::Object {
 
+    struct RenderDataRequest;
+
     enum class AnimationType { BCK, BLK, BPK, BTP, BTK, BRK };
     constexpr std::optional<AnimationType> animationTypeFromPath(std::string_view path) {
         auto ext = path.substr(path.find_last_of('.'));
@@ -43,21 +48,6 @@ namespace Toolbox::Object {
         return {};
     }
 
-    using model_cache_t    = std::unordered_map<std::string, J3DModelData>;
-    using material_cache_t = std::unordered_map<std::string, J3DMaterialTable>;
-
-    struct ResourceCache {
-        model_cache_t m_model;
-        material_cache_t m_material;
-    };
-
-    namespace {
-        static ResourceCache s_resource_cache;
-    }
-
-    inline ResourceCache &getResourceCache() { return s_resource_cache; }
-    inline void clearResourceCache() { s_resource_cache = ResourceCache(); }
-
     // A scene object capable of performing in a rendered context and
     // holding modifiable and exotic values
     class ISceneObject : public ISerializable, public ISmartResource, public IUnique {
@@ -70,6 +60,15 @@ namespace Toolbox::Object {
             Transform m_transform;
         };
 
+        // What a change notification says happened to an object
+        enum class ChangeKind {
+            MEMBERS,     // A member value was edited
+            CHILDREN,    // A child was added, inserted or removed
+            PERFORMING,  // The object was shown or hidden
+        };
+
+        using change_cb_t = std::function<void(ISceneObject &object, ChangeKind kind)>;
+
         /* ABSTRACT INTERFACE */
         virtual ~ISceneObject() = default;
 
@@ -89,12 +88,15 @@ namespace Toolbox::Object {
         [[nodiscard]] virtual std::span<u8> getData() const = 0;
         [[nodiscard]] virtual size_t getDataSize() const    = 0;
 
-        [[nodiscard]] virtual bool hasMember(const QualifiedName &name) const                   = 0;
-        [[nodiscard]] virtual MetaStruct::GetMemberT getMember(const QualifiedName &name) const = 0;
-        [[nodiscard]] virtual std::vector<RefPtr<MetaMember>> getMembers() const                = 0;
-        [[nodiscard]] virtual size_t getMemberOffset(const QualifiedName &name,
-                                                     int index) const                           = 0;
-        [[nodiscard]] virtual size_t getMemberSize(const QualifiedName &name, int index) const  = 0;
+        [[nodiscard]] virtual MetaStruct::GetMemberT getMember(const MemberPath &path) const = 0;
+        [[nodiscard]] virtual std::vector<RefPtr<MetaMember>> getMembers() const             = 0;
+
+        // Offset and size of element `index` of a member within the
+        // member data, see ResolveMemberOffset
+        [[nodiscard]] virtual Result<size_t, MetaScopeError>
+        getMemberOffset(const MemberPath &path, size_t index) const = 0;
+        [[nodiscard]] virtual Result<size_t, MetaScopeError>
+        getMemberSize(const MemberPath &path, size_t index) const = 0;
 
         virtual Result<void, ObjectGroupError> addChild(RefPtr<ISceneObject> child)     = 0;
         virtual Result<void, ObjectGroupError> insertChild(size_t index,
@@ -127,6 +129,11 @@ namespace Toolbox::Object {
                                                        ResourceCache &resource_cache,
                                                        std::vector<J3DLight> &scene_lights) = 0;
 
+        // Syncs the model with the current members and returns what
+        // performScene would gather for this object alone. Lighting is
+        // left as the last performScene set it.
+        [[nodiscard]] virtual std::optional<RenderInfo> refreshRenderInfo() = 0;
+
         virtual void dump(std::ostream &out, size_t indention, size_t indention_width) const = 0;
 
     protected:
@@ -141,6 +148,14 @@ namespace Toolbox::Object {
             return getChild(QualifiedName(name));
         }
 
+        // Names are parsed on every call, hot paths should keep a MemberPath
+        [[nodiscard]] bool hasMember(const QualifiedName &name) const;
+        [[nodiscard]] MetaStruct::GetMemberT getMember(const QualifiedName &name) const;
+        [[nodiscard]] Result<size_t, MetaScopeError> getMemberOffset(const QualifiedName &name,
+                                                                     size_t index) const;
+        [[nodiscard]] Result<size_t, MetaScopeError> getMemberSize(const QualifiedName &name,
+                                                                   size_t index) const;
+
         [[nodiscard]] size_t getAnimationFrames(AnimationType type) const;
         [[nodiscard]] float getAnimationFrame(AnimationType type) const;
         void setAnimationFrame(size_t frame, AnimationType type);
@@ -151,8 +166,24 @@ namespace Toolbox::Object {
         virtual u32 getGamePtr() const   = 0;
         virtual void setGamePtr(u32 ptr) = 0;
 
+        // The callback hears about changes to this object and every
+        // descendant, it is usually installed on a hierarchy's root
+        void setChangeCallback(change_cb_t cb) { m_change_cb = std::move(cb); }
+
+        // Reports a change to every callback from here up to the root.
+        // Members are edited in place, so whoever edits one reports it.
+        void notifyChanged(ChangeKind kind);
+
         void dump(std::ostream &out, size_t indention) const { dump(out, indention, 2); }
         void dump(std::ostream &out) const { dump(out, 0, 2); }
+
+    protected:
+        // Shared by every object of this type
+        [[nodiscard]] MemberLayout &getMemberLayout() const;
+
+    private:
+        change_cb_t m_change_cb;
+        mutable MemberLayout *m_member_layout = nullptr;
     };
 
     class VirtualSceneObject : public ISceneObject {
@@ -225,11 +256,16 @@ namespace Toolbox::Object {
         std::span<u8> getData() const override;
         size_t getDataSize() const override;
 
-        bool hasMember(const QualifiedName &name) const override;
-        MetaStruct::GetMemberT getMember(const QualifiedName &name) const override;
+        using ISceneObject::getMember;
+        using ISceneObject::getMemberOffset;
+        using ISceneObject::getMemberSize;
+
+        MetaStruct::GetMemberT getMember(const MemberPath &path) const override;
         std::vector<RefPtr<MetaMember>> getMembers() const override { return m_members; }
-        size_t getMemberOffset(const QualifiedName &name, int index) const override;
-        size_t getMemberSize(const QualifiedName &name, int index) const override;
+        Result<size_t, MetaScopeError> getMemberOffset(const MemberPath &path,
+                                                       size_t index) const override;
+        Result<size_t, MetaScopeError> getMemberSize(const MemberPath &path,
+                                                     size_t index) const override;
 
         Result<void, ObjectGroupError> addChild(RefPtr<ISceneObject> child) override {
             ObjectGroupError err = {"Cannot add child to a non-group object.",
@@ -293,6 +329,8 @@ namespace Toolbox::Object {
                                                ResourceCache &resource_cache,
                                                std::vector<J3DLight> &scene_lights) override;
 
+        std::optional<RenderInfo> refreshRenderInfo() override { return {}; }
+
         u32 getGamePtr() const override { return m_game_ptr; }
         void setGamePtr(u32 ptr) override { m_game_ptr = ptr; }
 
@@ -343,8 +381,6 @@ namespace Toolbox::Object {
         mutable std::vector<u8> m_data;
         ISceneObject *m_parent = nullptr;
 
-        mutable MetaStruct::CacheMemberT m_member_cache;
-
         u32 m_game_ptr = 0;
     };
 
@@ -398,7 +434,7 @@ namespace Toolbox::Object {
 
         [[nodiscard]] bool getCanPerform() const { return true; }
         [[nodiscard]] bool getIsPerforming() const { return m_is_performing; }
-        void w(bool performing) { m_is_performing = performing; }
+        void setIsPerforming(bool performing);
 
         Result<void, ObjectError> performScene(float delta_time, bool animate,
                                                std::vector<RenderInfo> &renderables,
@@ -448,6 +484,10 @@ namespace Toolbox::Object {
         void setGroupSize(size_t size);
         void updateGroupSize();
 
+        // Appends the render data of every child to `requests` instead of loading it
+        Result<void, SerialError> deserializeDeferred(Deserializer &in,
+                                                      std::vector<RenderDataRequest> &requests);
+
     private:
         RefPtr<MetaMember> m_group_size;
         mutable std::vector<u8> m_data;
@@ -536,11 +576,16 @@ namespace Toolbox::Object {
         std::span<u8> getData() const override;
         size_t getDataSize() const override;
 
-        bool hasMember(const QualifiedName &name) const override;
-        MetaStruct::GetMemberT getMember(const QualifiedName &name) const override;
+        using ISceneObject::getMember;
+        using ISceneObject::getMemberOffset;
+        using ISceneObject::getMemberSize;
+
+        MetaStruct::GetMemberT getMember(const MemberPath &path) const override;
         std::vector<RefPtr<MetaMember>> getMembers() const override { return m_members; }
-        size_t getMemberOffset(const QualifiedName &name, int index) const override;
-        size_t getMemberSize(const QualifiedName &name, int index) const override;
+        Result<size_t, MetaScopeError> getMemberOffset(const MemberPath &path,
+                                                       size_t index) const override;
+        Result<size_t, MetaScopeError> getMemberSize(const MemberPath &path,
+                                                     size_t index) const override;
 
         Result<void, ObjectGroupError> addChild(RefPtr<ISceneObject> child) override {
             ObjectGroupError err = {"Cannot add child to a non-group object.",
@@ -597,6 +642,7 @@ namespace Toolbox::Object {
                 }
             }
 
+            notifyChanged(ChangeKind::MEMBERS);
             return {};
         }
 
@@ -639,13 +685,15 @@ namespace Toolbox::Object {
 
         [[nodiscard]] bool getCanPerform() const { return true; }
         [[nodiscard]] bool getIsPerforming() const { return m_is_performing; }
-        void setIsPerforming(bool performing) { m_is_performing = performing; }
+        void setIsPerforming(bool performing);
 
         Result<void, ObjectError> performScene(float delta_time, bool animate,
                                                std::vector<RenderInfo> &renderables,
                                                ResourceCache &resource_cache,
                                                std::vector<J3DLight> &scene_lights) override;
 
+        std::optional<RenderInfo> refreshRenderInfo() override;
+
         u32 getGamePtr() const override { return m_game_ptr; }
         void setGamePtr(u32 ptr) override { m_game_ptr = ptr; }
 
@@ -658,10 +706,28 @@ namespace Toolbox::Object {
 
         void applyWizard(const TemplateWizard &wizard);
 
+        struct RenderDataPaths {
+            std::filesystem::path m_model;
+            std::filesystem::path m_materials;
+        };
+
+        // Empty if the object has no model
+        Result<std::optional<RenderDataPaths>, FSError>
+        getRenderDataPaths(const std::filesystem::path &asset_path,
+                           const TemplateRenderInfo &info) const;
+
+        // Starts reading the model files in the background
+        void prefetchRenderData(const std::filesystem::path &asset_path,
+                                const TemplateRenderInfo &info, ResourceCache &resource_cache) const;
+
         Result<void, FSError> loadRenderData(const std::filesystem::path &asset_path,
                                              const TemplateRenderInfo &info,
                                              ResourceCache &resource_cache);
 
+        // Appends the render data to `requests` instead of loading it
+        Result<void, SerialError> deserializeDeferred(Deserializer &in,
+                                                      std::vector<RenderDataRequest> &requests);
+
     public:
         // Inherited via ISerializable
         Result<void, SerialError> serialize(Serializer &out) const override;
@@ -702,8 +768,6 @@ namespace Toolbox::Object {
         mutable std::vector<u8> m_data;
         ISceneObject *m_parent = nullptr;
 
-        mutable MetaStruct::CacheMemberT m_member_cache;
-
         std::optional<Transform> m_transform;
         RefPtr<J3DModelInstance> m_model_instance = {};
 
@@ -712,16 +776,36 @@ namespace Toolbox::Object {
         u32 m_game_ptr = 0;
     };
 
+    struct RenderDataRequest {
+        PhysicalSceneObject *m_object;
+        std::filesystem::path m_asset_path;
+        TemplateRenderInfo m_info;
+    };
+
     class ObjectFactory {
     public:
         using create_ret_t = ScopePtr<ISceneObject>;
         using create_err_t = SerialError;
         using create_t     = Result<create_ret_t, create_err_t>;
 
+        using RenderDataRequest = Toolbox::Object::RenderDataRequest;
+
+        // Render data for the whole object tree is loaded once the outermost
+        // object finishes, so the model files of nested objects can be read
+        // on the thread pool while the rest of the stream is parsed
         static create_t create(Deserializer &in);
         static create_ret_t create(const Template &template_, std::string_view wizard_name);
 
+        // Leaves the render data to the caller instead, appending what each
+        // physical object in the tree needs to `requests`. Requests point
+        // into the returned tree and must be loaded on the thread owning
+        // the GL context.
+        static create_t create(Deserializer &in, std::vector<RenderDataRequest> &requests);
+        static Result<void, SerialError> loadRenderData(const RenderDataRequest &request);
+
     protected:
+        static create_t createDeferred(Deserializer &in, std::vector<RenderDataRequest> &requests);
+
         static bool isGroupObject(std::string_view type);
         static bool isGroupObject(Deserializer &in);
         static bool isPhysicalObject(std::string_view type);
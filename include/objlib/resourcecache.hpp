@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <J3D/Data/J3DModelData.hpp>
+#include <J3D/Material/J3DMaterialTable.hpp>
+
+#include "core/memory.hpp"
+
+namespace Toolbox::Object {
+
+    // Decoded J3D assets shared between every object that references them.
+    //
+    // Each file is read and decoded at most once per cache lifetime. Only
+    // reading can be started early on the shared thread pool, with
+    // prefetchFile; a later get either picks up the bytes, waits on the
+    // worker reading them, or reads them inline if no worker reached them
+    // yet. The J3D loaders create GL resources, so models and material
+    // tables are decoded on the calling thread, which must own the context.
+    //
+    // Returned data is shared and must be treated as read-only. Objects
+    // that modify their materials need to load a private table instead.
+    class ResourceCache {
+    public:
+        struct Statistics {
+            size_t m_model_loads    = 0;
+            size_t m_model_hits     = 0;
+            size_t m_material_loads = 0;
+            size_t m_material_hits  = 0;
+        };
+
+        ResourceCache()                      = default;
+        ResourceCache(const ResourceCache &) = delete;
+        ~ResourceCache()                     = default;
+
+        ResourceCache &operator=(const ResourceCache &) = delete;
+
+        // Case is kept as is, folding it would break lookups on
+        // case sensitive hosts
+        [[nodiscard]] static std::string NormalizePath(const std::filesystem::path &path);
+
+        // nullptr if the file doesn't exist
+        [[nodiscard]] RefPtr<const std::vector<u8>> getFile(const std::filesystem::path &path);
+        [[nodiscard]] RefPtr<J3DModelData> getModel(const std::filesystem::path &path);
+        [[nodiscard]] RefPtr<J3DMaterialTable>
+        getMaterialTable(const std::filesystem::path &path,
+                         const std::filesystem::path &model_path);
+
+        void prefetchFile(const std::filesystem::path &path);
+
+        // Data already handed out stays alive with its users
+        void clear();
+
+        [[nodiscard]] Statistics getStatistics() const;
+        void logStatistics() const;
+
+    private:
+        template <typename _DataT> struct Entry {
+            std::once_flag m_once;
+            std::atomic<bool> m_requested = false;
+            RefPtr<_DataT> m_data;
+        };
+
+        using file_entry_t     = Entry<std::vector<u8>>;
+        using model_entry_t    = Entry<J3DModelData>;
+        using material_entry_t = Entry<J3DMaterialTable>;
+
+        template <typename _DataT>
+        std::pair<RefPtr<Entry<_DataT>>, bool>
+        acquireEntry(std::unordered_map<std::string, RefPtr<Entry<_DataT>>> &entries,
+                     std::string &&key);
+
+        static RefPtr<std::vector<u8>> ResolveFile(file_entry_t &entry,
+                                                   const std::filesystem::path &path);
+
+        // The bytes are only needed until the data is decoded
+        void releaseFile(const std::filesystem::path &path);
+
+        mutable std::mutex m_mutex;
+        std::unordered_map<std::string, RefPtr<file_entry_t>> m_files;
+        std::unordered_map<std::string, RefPtr<model_entry_t>> m_models;
+        std::unordered_map<std::string, RefPtr<material_entry_t>> m_materials;
+
+        std::atomic<size_t> m_model_loads    = 0;
+        std::atomic<size_t> m_model_hits     = 0;
+        std::atomic<size_t> m_material_loads = 0;
+        std::atomic<size_t> m_material_hits  = 0;
+    };
+
+    ResourceCache &getResourceCache();
+    inline void clearResourceCache() { getResourceCache().clear(); }
+
+}  // namespace Toolbox::Object
\ No newline at end of file
@@ -40,8 +40,11 @@ namespace Toolbox::Object {
         }
     };
 
+    class TemplateStringTable;
+
     class Template : public ISerializable {
     public:
+        friend class TemplateCache;
         friend class TemplateFactory;
 
         using json_t = nlohmann::ordered_json;
@@ -59,21 +62,22 @@ namespace Toolbox::Object {
     public:
         [[nodiscard]] std::string_view type() const { return m_type; }
 
-        [[nodiscard]] std::vector<TemplateWizard> wizards() const { return m_wizards; }
+        [[nodiscard]] const std::vector<TemplateWizard> &wizards() const { return m_wizards; }
 
-        [[nodiscard]] std::optional<TemplateWizard> getWizard() const { return m_wizards[0]; }
-        [[nodiscard]] std::optional<TemplateWizard> getWizard(std::string_view name) const {
-            for (const auto &wizard : m_wizards) {
-                if (wizard.m_name == name) {
-                    return wizard;
-                }
-            }
-            return {};
+        // nullptr when there is no such wizard. The wizard lives as
+        // long as the template does.
+        [[nodiscard]] const TemplateWizard *getWizard() const {
+            return m_wizards.empty() ? nullptr : &m_wizards[0];
+        }
+        [[nodiscard]] const TemplateWizard *getWizard(std::string_view name) const {
+            auto it = m_wizard_indices.find(name);
+            return it == m_wizard_indices.end() ? nullptr : &m_wizards[it->second];
         }
 
         Template &operator=(const Template &other) {
-            m_type    = other.m_type;
-            m_wizards = other.m_wizards;
+            m_type           = other.m_type;
+            m_wizards        = other.m_wizards;
+            m_wizard_indices = other.m_wizard_indices;
 
             m_struct_cache.clear();
             for (auto &s : other.m_struct_cache) {
@@ -106,16 +110,46 @@ namespace Toolbox::Object {
         std::optional<MetaMember> loadMemberPrimitive(std::string_view name, std::string_view type,
                                                       MetaMember::size_type array_size);
 
+        MetaMember loadMemberEnum(std::string_view name, const MetaEnum &enum_,
+                                  MetaMember::size_type array_size);
+        MetaMember loadMemberStruct(std::string_view name, const MetaStruct &struct_,
+                                    MetaMember::size_type array_size);
+        MetaMember loadMemberPrimitive(std::string_view name, MetaType type,
+                                       MetaMember::size_type array_size);
+
         void loadMembers(const json_t &members, std::vector<MetaMember> &out);
         void loadWizards(const json_t &wizards, const json_t &render_infos);
 
-        static void threadLoadTemplate(const std::string &type);
-        static void threadLoadTemplateBlob(const std::string &type, const json_t &the_json);
+        // Has to run whenever the wizard list changes
+        void indexWizards();
+
+        // Precompiled form used by TemplateCache, with every type resolved
+        // to an index into this template's enum and struct tables
+        Result<void, SerialError> serializeCached(Serializer &out,
+                                                  TemplateStringTable &strings) const;
+        Result<void, SerialError> deserializeCached(Deserializer &in,
+                                                    const TemplateStringTable &strings);
+
+        Result<void, SerialError>
+        serializeCachedMembers(Serializer &out, TemplateStringTable &strings,
+                               const std::vector<const MetaMember *> &members) const;
+        Result<void, SerialError> deserializeCachedMembers(Deserializer &in,
+                                                           const TemplateStringTable &strings,
+                                                           std::vector<MetaMember> &out);
 
     private:
+        struct WizardNameHash {
+            using is_transparent = void;
+            size_t operator()(std::string_view name) const {
+                return std::hash<std::string_view>{}(name);
+            }
+        };
+
         std::string m_type;
 
         std::vector<TemplateWizard> m_wizards = {};
+        std::unordered_map<std::string, size_t, WizardNameHash, std::equal_to<>>
+            m_wizard_indices = {};
 
         std::vector<MetaStruct> m_struct_cache = {};
         std::vector<MetaEnum> m_enum_cache     = {};
@@ -123,7 +157,8 @@ namespace Toolbox::Object {
 
     class TemplateFactory {
     public:
-        using create_ret_t = ScopePtr<Template>;
+        // Templates are shared between everything created from them
+        using create_ret_t = RefPtr<const Template>;
         using create_err_t = std::variant<FSError, JSONError>;
         using create_t     = Result<create_ret_t, create_err_t>;
 
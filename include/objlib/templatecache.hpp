@@ -0,0 +1,102 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "core/types.hpp"
+#include "fsystem.hpp"
+#include "objlib/template.hpp"
+#include "platform/filemap.hpp"
+#include "serial.hpp"
+
+namespace Toolbox::Object {
+
+    // Every name and string value in a template cache is stored once
+    // and referenced by its index into this table
+    class TemplateStringTable {
+    public:
+        u32 intern(std::string_view str);
+
+        // Empty for an out of range index
+        [[nodiscard]] std::string_view get(u32 index) const;
+        [[nodiscard]] size_t size() const { return m_offsets.size() - 1; }
+
+        Result<void, SerialError> serialize(Serializer &out) const;
+        Result<void, SerialError> deserialize(Deserializer &in);
+
+    private:
+        std::string m_data;
+        std::vector<u32> m_offsets = {0};
+
+        std::unordered_map<std::string, u32> m_lookup;
+    };
+
+    // Precompiled form of the Templates folder.
+    //
+    // Templates are stored with their struct, enum and member types already
+    // resolved to table indices, so loading one never touches JSON. A table
+    // of offsets lets every template be decoded independently straight out
+    // of the mapped file. The cache is rejected when any template json was
+    // added, removed or changed since it was written; a file whose mtime
+    // moved but whose content hash still matches is accepted, and its new
+    // mtime is written back so later opens skip hashing it.
+    class TemplateCache {
+    public:
+        static constexpr u32 c_magic   = 'TPLC';
+        static constexpr u32 c_version = 1;
+
+        struct SourceInfo {
+            std::string m_type;
+            u64 m_mtime = 0;
+            u64 m_size  = 0;
+            u64 m_hash  = 0;
+        };
+
+        TemplateCache()                      = default;
+        TemplateCache(const TemplateCache &) = delete;
+        TemplateCache(TemplateCache &&)      = default;
+        ~TemplateCache()                     = default;
+
+        TemplateCache &operator=(const TemplateCache &) = delete;
+        TemplateCache &operator=(TemplateCache &&)      = default;
+
+        // Type and stats of each template json in `folder`, hashes are left
+        // empty unless `hash_files` is set
+        static Result<std::vector<SourceInfo>, FSError>
+        ScanSources(const std::filesystem::path &folder, bool hash_files);
+        static Result<u64, FSError> HashFile(const std::filesystem::path &path);
+
+        static Result<void, FSError>
+        Save(const std::filesystem::path &cache_path, const std::filesystem::path &folder,
+             const std::unordered_map<std::string, RefPtr<const Template>> &templates);
+
+        // Maps the cache and checks it against the templates in `folder`
+        Result<void, FSError> open(const std::filesystem::path &cache_path,
+                                   const std::filesystem::path &folder);
+
+        [[nodiscard]] size_t templateCount() const { return m_offsets.size(); }
+
+        // Safe to call from several threads at once
+        Result<Template, SerialError> loadTemplate(size_t index) const;
+
+    private:
+        // Offset of a recorded mtime in the cache and the mtime it should hold
+        using mtime_patch_t = std::pair<size_t, u64>;
+
+        Result<void, FSError> validateSources(Deserializer &in, const std::filesystem::path &folder,
+                                              std::vector<mtime_patch_t> &mtime_patches) const;
+
+        static Result<void, FSError> PatchSourceTimes(const std::filesystem::path &cache_path,
+                                                      std::span<const mtime_patch_t> patches);
+
+        Platform::MappedFile m_mapping;
+        TemplateStringTable m_strings;
+        std::vector<u32> m_offsets;
+    };
+
+}  // namespace Toolbox::Object
\ No newline at end of file
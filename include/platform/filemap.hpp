@@ -0,0 +1,46 @@
+#pragma once
+
+#include <filesystem>
+#include <span>
+#include <utility>
+
+#include "core/core.hpp"
+#include "core/error.hpp"
+
+namespace Toolbox::Platform {
+
+    // Read-only view of a file mapped into the address space.
+    // The view is valid until the file is closed or destroyed.
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        MappedFile(const MappedFile &) = delete;
+        MappedFile(MappedFile &&other) noexcept
+            : m_view(std::exchange(other.m_view, nullptr)), m_size(std::exchange(other.m_size, 0)) {}
+        ~MappedFile() { close(); }
+
+        MappedFile &operator=(const MappedFile &) = delete;
+        MappedFile &operator=(MappedFile &&other) noexcept {
+            if (this != &other) {
+                close();
+                m_view = std::exchange(other.m_view, nullptr);
+                m_size = std::exchange(other.m_size, 0);
+            }
+            return *this;
+        }
+
+        Result<void> open(const std::filesystem::path &path);
+        void close();
+
+        [[nodiscard]] bool isOpen() const { return m_view != nullptr; }
+
+        [[nodiscard]] const char *data() const { return m_view; }
+        [[nodiscard]] size_t size() const { return m_size; }
+        [[nodiscard]] std::span<const char> view() const { return {m_view, m_size}; }
+
+    private:
+        const char *m_view = nullptr;
+        size_t m_size      = 0;
+    };
+
+}  // namespace Toolbox::Platform
\ No newline at end of file
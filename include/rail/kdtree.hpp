@@ -0,0 +1,45 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "core/types.hpp"
+
+namespace Toolbox::Rail {
+
+    // k-d tree over points identified by their index.
+    //
+    // The tree is implicit in the order the points are kept in: the
+    // middle point of every range is a node, splitting the range along
+    // its widest axis into the points before and after it.
+    class KDTree {
+    public:
+        static constexpr size_t c_no_point = std::numeric_limits<size_t>::max();
+
+        using neighbor_t = std::pair<f32, size_t>;
+
+        void build(const std::vector<glm::vec3> &points);
+        void clear();
+
+        [[nodiscard]] bool empty() const { return m_points.empty(); }
+        [[nodiscard]] size_t size() const { return m_points.size(); }
+
+        // The `count` points nearest to `point` as pairs of distance and
+        // index, nearest first. Point `exclude` is skipped so a point of
+        // the tree can ask for its neighbors.
+        void nearest(const glm::vec3 &point, size_t count, size_t exclude,
+                     std::vector<neighbor_t> &out) const;
+
+    private:
+        void buildRange(const std::vector<glm::vec3> &points, size_t begin, size_t end);
+        void searchRange(size_t begin, size_t end, const glm::vec3 &point, size_t count,
+                         size_t exclude, std::vector<neighbor_t> &heap) const;
+
+        std::vector<glm::vec3> m_points;
+        std::vector<size_t> m_indices;
+        std::vector<u8> m_axes;
+    };
+
+}  // namespace Toolbox::Rail
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "objlib/meta/value.hpp"
 #include "serial.hpp"
 #include "unique.hpp"
+#include <array>
 #include <string>
 #include <vector>
 
@@ -14,6 +15,28 @@ namespace Toolbox::Rail {
 
     class Rail;
 
+    // The data of one node as the game lays it out, decoded. Rails keep
+    // each field in its own array, this is what a node holds while it
+    // belongs to none.
+    struct RailNodeRecord {
+        static constexpr size_t c_data_size       = 68;
+        static constexpr size_t c_max_connections = 8;
+
+        glm::vec3 m_position                             = {};
+        u32 m_flags                                      = 0;
+        std::array<s16, 4> m_values                      = {-1, -1, -1, -1};
+        u16 m_connection_count                           = 0;
+        std::array<s16, c_max_connections> m_connections = {};
+        std::array<f32, c_max_connections> m_distances   = {};
+
+        // `data` is one big endian record of c_data_size bytes
+        static RailNodeRecord FromBytes(const char *data);
+        void toBytes(char *data) const;
+    };
+
+    // A node is a view of its slot in the arrays of the rail it belongs
+    // to. The handle keeps its identity as the rail reorders, and takes
+    // its data along when it is removed from the rail.
     class RailNode : public ISerializable, public ISmartResource, public IUnique {
     protected:
         friend class Rail;
@@ -25,13 +48,13 @@ namespace Toolbox::Rail {
         RailNode(s16 x, s16 y, s16 z, u32 flags);
         RailNode(glm::vec3 pos);
         RailNode(glm::vec3 pos, u32 flags);
-        RailNode(const RailNode &other) = default;
-        RailNode(RailNode &&other)      = default;
-        ~RailNode()                     = default;
+        // Copies are detached from any rail, but keep the identity
+        RailNode(const RailNode &other);
+        ~RailNode() = default;
 
         [[nodiscard]] UUID64 getUUID() const override { return m_UUID64; }
 
-        [[nodiscard]] UUID64 getRailUUID() const { return m_rail_uuid; }
+        [[nodiscard]] UUID64 getRailUUID() const;
 
         [[nodiscard]] glm::vec3 getPosition() const;
         [[nodiscard]] void getPosition(s16 &x, s16 &y, s16 &z) const;
@@ -40,19 +63,25 @@ namespace Toolbox::Rail {
 
         [[nodiscard]] Result<s16, MetaError> getValue(size_t index) const;
 
-        [[nodiscard]] size_t getDataSize() const { return 68; }
+        [[nodiscard]] size_t getDataSize() const { return RailNodeRecord::c_data_size; }
 
         [[nodiscard]] u16 getConnectionCount() const;
         [[nodiscard]] Result<s16, MetaError> getConnectionValue(size_t index) const;
         [[nodiscard]] Result<f32, MetaError> getConnectionDistance(size_t index) const;
 
+        [[nodiscard]] RailNodeRecord getRecord() const;
+
+        // Members built from the node's data for the property editor.
+        // They are a snapshot, edits have to go through the rail.
+        [[nodiscard]] std::vector<RefPtr<MetaMember>> getMembers() const;
+
         Result<void, SerialError> serialize(Serializer &out) const override;
         Result<void, SerialError> deserialize(Deserializer &in) override;
 
         ScopePtr<ISmartResource> clone(bool deep) const override;
 
-        RailNode &operator=(const RailNode &other) = default;
-        RailNode &operator=(RailNode &&other)      = default;
+        // Assigns the data only, the node stays in its rail
+        RailNode &operator=(const RailNode &other);
 
         bool operator==(const RailNode &other) const;
 
@@ -68,6 +97,8 @@ namespace Toolbox::Rail {
         void setPosition(const glm::vec3 &position);
         void setPosition(s16 x, s16 y, s16 z) { setPosition({x, y, z}); }
 
+        void setRecord(const RailNodeRecord &record);
+
         void setConnectionCount(u16 count);
         Result<void, MetaError> setConnectionValue(size_t index, s16 value);
 
@@ -76,20 +107,19 @@ namespace Toolbox::Rail {
         Result<void, MetaError> setConnectionDistance(size_t connection, f32 distance);
 
     private:
-        UUID64 m_rail_uuid;
+        // The node's slot in one of the rail's arrays while it belongs to
+        // one, otherwise the field of its own record
+        template <typename T> T &field(std::vector<T> Rail::*array, T RailNodeRecord::*member);
+        template <typename T>
+        const T &field(std::vector<T> Rail::*array, T RailNodeRecord::*member) const;
 
         UUID64 m_UUID64;
 
-        RefPtr<MetaMember> m_pos_x;
-        RefPtr<MetaMember> m_pos_y;
-        RefPtr<MetaMember> m_pos_z;
-
-        RefPtr<MetaMember> m_flags;
-        RefPtr<MetaMember> m_values;
+        // Set while the node belongs to a rail, which then owns its data
+        Rail *m_rail   = nullptr;
+        size_t m_index = 0;
 
-        RefPtr<MetaMember> m_connection_count;
-        RefPtr<MetaMember> m_connections;
-        RefPtr<MetaMember> m_distances;
+        RailNodeRecord m_record;
     };
 
 }  // namespace Toolbox::Rail
\ No newline at end of file
@@ -2,11 +2,13 @@
 
 #include "boundbox.hpp"
 #include "smart_resource.hpp"
+#include "kdtree.hpp"
 #include "node.hpp"
 #include "unique.hpp"
 #include "objlib/meta/member.hpp"
 #include "objlib/meta/value.hpp"
 #include "serial.hpp"
+#include <array>
 #include <string>
 #include <vector>
 
@@ -15,28 +17,38 @@ using namespace Toolbox::Object;
 namespace Toolbox::Rail {
 
     // NOTE: Serialization is for Toolbox UI only. Use RalData for actual game data.
+    //
+    // Node data is stored as one array per field, indexed like the node
+    // handles, so walking the positions or connections of a rail never
+    // has to chase a pointer per node.
     class Rail : public ISerializable, public ISmartResource, public IUnique {
+        friend class RailNode;
+
     public:
         using node_ptr_t = RefPtr<RailNode>;
 
         Rail() = delete;
         explicit Rail(std::string_view name) : m_name(name) {}
-        Rail(std::string_view name, std::vector<node_ptr_t> nodes) : m_name(name), m_nodes(nodes) {
-            for (auto &node : m_nodes) {
-                node->m_rail_uuid = getUUID();
-            }
-        }
-        Rail(const Rail &other) = default;
-        Rail(Rail &&other)      = default;
+        Rail(std::string_view name, std::vector<node_ptr_t> nodes);
+
+        // Copies get their own handles to the copied nodes, with the same
+        // identities as the originals
+        Rail(const Rail &other);
+        Rail(Rail &&other);
 
-        ~Rail() = default;
+        ~Rail();
 
-        Rail &operator=(const Rail &other) = default;
-        Rail &operator=(Rail &&other)      = default;
+        Rail &operator=(const Rail &other);
+        Rail &operator=(Rail &&other);
 
         Result<void, SerialError> serialize(Serializer &out) const override;
         Result<void, SerialError> deserialize(Deserializer &in) override;
 
+        // Node records as the game stores them, back to back. Reading
+        // replaces the nodes of the rail with `count` new ones.
+        Result<void, SerialError> serializeNodes(Serializer &out) const;
+        Result<void, SerialError> deserializeNodes(Deserializer &in, size_t count);
+
         [[nodiscard]] UUID64 getUUID() const override { return m_UUID64; }
 
         [[nodiscard]] u32 getSiblingID() const { return m_sibling_id; }
@@ -48,12 +60,17 @@ namespace Toolbox::Rail {
         void setName(std::string_view name) { m_name = name; }
 
         [[nodiscard]] const std::vector<node_ptr_t> &nodes() const { return m_nodes; }
-        [[nodiscard]] std::vector<node_ptr_t> &nodes() { return m_nodes; }
+
+        [[nodiscard]] const std::vector<glm::vec3> &nodePositions() const {
+            return m_node_positions;
+        }
 
         [[nodiscard]] glm::vec3 getCenteroid() const;
         [[nodiscard]] BoundingBox getBoundingBox() const;
 
-        [[nodiscard]] size_t getDataSize() const { return 68 * m_nodes.size(); }
+        [[nodiscard]] size_t getDataSize() const {
+            return RailNodeRecord::c_data_size * m_nodes.size();
+        }
 
         Rail &translate(s16 x, s16 y, s16 z) { return translate(glm::vec3(x, y, z)); }
         Rail &translate(const glm::vec3 &t);
@@ -73,7 +90,7 @@ namespace Toolbox::Rail {
 
         [[nodiscard]] size_t getNodeCount() const { return m_nodes.size(); }
 
-        void clearNodes() { m_nodes.clear(); }
+        void clearNodes();
 
         void addNode(node_ptr_t node);
 
@@ -136,14 +153,16 @@ namespace Toolbox::Rail {
         Result<void, MetaError> connectNodeToReferrers(size_t node);
         Result<void, MetaError> connectNodeToReferrers(node_ptr_t node);
 
+        // Connects every node to its `count` nearest nodes, spread over the
+        // thread pool for large rails unless already running on a worker
+        Result<void, MetaError> connectNodesToNearest(size_t count);
+        Result<void, MetaError> connectNodesToNearest() { return connectNodesToNearest(1); }
+
         [[nodiscard]] std::vector<node_ptr_t>::const_iterator begin() const {
             return m_nodes.begin();
         }
         [[nodiscard]] std::vector<node_ptr_t>::const_iterator end() const { return m_nodes.end(); }
 
-        [[nodiscard]] std::vector<node_ptr_t>::iterator begin() { return m_nodes.begin(); }
-        [[nodiscard]] std::vector<node_ptr_t>::iterator end() { return m_nodes.end(); }
-
         [[nodiscard]] node_ptr_t operator[](size_t index) const { return m_nodes[index]; }
 
         void dump(std::ostream &out, size_t indention, size_t indention_width) const;
@@ -158,10 +177,48 @@ namespace Toolbox::Rail {
         void chaikinSubdivide();
 
     private:
+        [[nodiscard]] RailNodeRecord getNodeRecord(size_t index) const;
+        void insertNodeRecord(size_t index, const RailNodeRecord &record);
+        void eraseNodeRecord(size_t index);
+
+        // Points the handles from `index` on at their slots again
+        void reindexNodes(size_t index);
+
+        // Hands every node its data and lets go of it
+        void detachNodes();
+
+        void copyNodesFrom(const Rail &other);
+        void moveNodesFrom(Rail &other);
+
+        // The tree over the node positions and the nodes connecting to each
+        // node are rebuilt on demand once node edits invalidate them
+        const KDTree &nodeTree();
+        const std::vector<u32> &nodeReferrers(size_t node);
+
+        void invalidateNodeTree() { m_node_tree_dirty = true; }
+        void invalidateNodeReferrers() { m_node_referrers_dirty = true; }
+
+        // Keeps the referrers current as a single connection changes
+        void addNodeReferrer(size_t node, s16 to);
+        void removeNodeReferrer(size_t node, s16 to);
+
         UUID64 m_UUID64;
         u32 m_sibling_id = 0;
         std::string m_name;
         std::vector<node_ptr_t> m_nodes = {};
+
+        std::vector<glm::vec3> m_node_positions;
+        std::vector<u32> m_node_flags;
+        std::vector<std::array<s16, 4>> m_node_values;
+        std::vector<u16> m_node_connection_counts;
+        std::vector<std::array<s16, RailNodeRecord::c_max_connections>> m_node_connections;
+        std::vector<std::array<f32, RailNodeRecord::c_max_connections>> m_node_distances;
+
+        KDTree m_node_tree;
+        bool m_node_tree_dirty = true;
+
+        std::vector<std::vector<u32>> m_node_referrers;
+        bool m_node_referrers_dirty = true;
     };
 
 }  // namespace Toolbox::Rail
\ No newline at end of file
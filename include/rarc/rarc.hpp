@@ -4,12 +4,15 @@
 #include "smart_resource.hpp"
 #include "core/error.hpp"
 #include "fsystem.hpp"
+#include "platform/filemap.hpp"
 #include "serial.hpp"
+#include <algorithm>
 #include <array>
 #include <expected>
 #include <filesystem>
 #include <span>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace Toolbox::RARC {
@@ -50,6 +53,48 @@ namespace Toolbox::RARC {
 
     class ResourceArchive : public ISerializable, public ISmartResource {
     public:
+        // File payload that either owns its bytes or views the mapping of a
+        // mapped archive. Views are only copied once they are modified, and
+        // stay valid for as long as the archive that produced them.
+        class NodeData {
+        public:
+            NodeData() = default;
+            NodeData(std::vector<char> bytes) : m_bytes(std::move(bytes)) {}
+            NodeData(std::span<const char> view) : m_view(view), m_is_view(true) {}
+
+            [[nodiscard]] bool isMapped() const { return m_is_view; }
+
+            [[nodiscard]] const char *data() const {
+                return m_is_view ? m_view.data() : m_bytes.data();
+            }
+            [[nodiscard]] size_t size() const { return m_is_view ? m_view.size() : m_bytes.size(); }
+            [[nodiscard]] bool empty() const { return size() == 0; }
+
+            [[nodiscard]] const char *begin() const { return data(); }
+            [[nodiscard]] const char *end() const { return data() + size(); }
+
+            [[nodiscard]] std::span<const char> view() const { return {data(), size()}; }
+
+            // Copies mapped bytes into owned storage
+            [[nodiscard]] std::vector<char> &mutableBytes() {
+                if (m_is_view) {
+                    m_bytes.assign(m_view.begin(), m_view.end());
+                    m_view    = {};
+                    m_is_view = false;
+                }
+                return m_bytes;
+            }
+
+            bool operator==(const NodeData &rhs) const {
+                return size() == rhs.size() && std::equal(begin(), end(), rhs.begin());
+            }
+
+        private:
+            std::vector<char> m_bytes;
+            std::span<const char> m_view;
+            bool m_is_view = false;
+        };
+
         struct FolderInfo {
             s32 parent;
             s32 sibling_next;
@@ -63,7 +108,7 @@ namespace Toolbox::RARC {
             std::string name;
 
             FolderInfo folder;
-            std::vector<char> data;
+            NodeData data;
 
             bool is_folder() const { return (flags & DIRECTORY) != 0; }
 
@@ -87,11 +132,28 @@ namespace Toolbox::RARC {
         static Result<ResourceArchive, FSError>
         createFromPath(const std::filesystem::path root);
 
+        // Maps the archive read-only instead of copying it into memory.
+        // File payloads view the mapping until they are modified.
+        static Result<ResourceArchive, SerialError>
+        createFromMappedFile(const std::filesystem::path &path);
+
         [[nodiscard]] bool isMatchingOutput() const { return m_keep_matching; }
         void setMatchingOutput(bool matching) { m_keep_matching = matching; }
 
+        // Archives loaded from Yaz0 data (.szs) are recompressed when saved
+        [[nodiscard]] bool isCompressed() const { return m_compressed; }
+        void setCompressed(bool compressed) { m_compressed = compressed; }
+
+        [[nodiscard]] bool isMapped() const { return m_mapping != nullptr; }
+
+        // Copies every mapped payload into owned storage and drops the mapping
+        void unmap();
+
         [[nodiscard]] std::string_view name() const { return m_name; }
-        [[nodiscard]] std::vector<Node> &getNodes() { return m_nodes; }
+        [[nodiscard]] std::vector<Node> &getNodes() {
+            invalidateIndex();
+            return m_nodes;
+        }
         [[nodiscard]] const std::vector<Node> &getNodes() const { return m_nodes; }
 
         [[nodiscard]] node_it begin() { return m_nodes.begin(); }
@@ -106,6 +168,13 @@ namespace Toolbox::RARC {
         [[nodiscard]] node_it findNode(const std::filesystem::path &path);
         [[nodiscard]] const_node_it findNode(const std::filesystem::path &path) const;
 
+        // Lookups are served from an index that the archive updates in place
+        // as it inserts and removes nodes. Call this after renaming or moving
+        // nodes through iterators. The next non-const lookup rebuilds it, and
+        // until then const lookups scan the nodes, so concurrent const
+        // lookups never write to the archive.
+        void invalidateIndex() { m_index_dirty = true; }
+
         Result<void, FSError> extractToPath(const std::filesystem::path &path) const;
 
         Result<void, FSError> importFiles(const std::vector<std::filesystem::path> &files,
@@ -127,6 +196,10 @@ namespace Toolbox::RARC {
         void dump(std::ostream &out, size_t indention) const { dump(out, indention, 2); }
         void dump(std::ostream &out) const { dump(out, 0, 2); }
 
+        // Saving over the file this archive is mapped from unmaps it first,
+        // and is refused while other copies of the archive still view it
+        Result<void, SerialError> saveToPath(const std::filesystem::path &path);
+
         Result<void, SerialError> serialize(Serializer &out) const override;
         Result<void, SerialError> deserialize(Deserializer &in) override;
 
@@ -135,12 +208,71 @@ namespace Toolbox::RARC {
     protected:
         Result<void> recalculateIDs();
 
+        Result<void, SerialError> loadArchive(Deserializer &in,
+                                              RefPtr<const Platform::MappedFile> mapping);
+
     private:
+        struct StringHash {
+            using is_transparent = void;
+
+            std::size_t operator()(std::string_view str) const {
+                return std::hash<std::string_view>{}(str);
+            }
+        };
+
+        using string_index_type =
+            std::unordered_map<std::string, size_t, StringHash, std::equal_to<>>;
+
+        // Keys whose node was dropped from the index, see repairIndex
+        struct IndexOrphans {
+            std::vector<std::string> names;
+            std::vector<s32> ids;
+            std::vector<std::string> paths;
+        };
+
+        size_t findNodeIndex(std::string_view name) const;
+        size_t findNodeIndex(s32 id) const;
+        size_t findNodeIndex(const std::filesystem::path &path) const;
+
+        // Full path of a node, root name included
+        std::string nodePath(size_t index) const;
+
+        // Moves the folder ends around `inserted` nodes placed at `at` under
+        // the folder at `parent_index`, which replaced nodes worth `delta`
+        void adjustFolderSpans(size_t parent_index, size_t at, size_t inserted, s32 delta);
+
+        void rebuildIndex();
+        void rebuildIdIndex();
+
+        // Moves every indexed node to remap(index), where npos drops it
+        template <typename RemapFn> IndexOrphans remapIndex(RemapFn &&remap);
+
+        // Calls visit(index, path) for the nodes in [begin, end), which must
+        // share a parent whose path is `path`, until it returns false
+        template <typename VisitFn>
+        void forEachNodePath(size_t begin, size_t end, std::string path, VisitFn &&visit) const;
+
+        // Indexes the nodes in [begin, end), which must share a parent
+        void indexNodes(size_t begin, size_t end);
+
+        // Gives dropped keys to the first node from `from` on that still has them
+        void repairIndex(const IndexOrphans &orphans, size_t from);
+
         std::string m_name        = "(null)";
         std::vector<Node> m_nodes = {};
 
         bool m_ids_synced = true;
         bool m_keep_matching = true;
+        bool m_compressed    = false;
+
+        RefPtr<const Platform::MappedFile> m_mapping;
+        std::filesystem::path m_mapped_path;
+
+        // First node by name, id and full path (root name included)
+        string_index_type m_name_index;
+        std::unordered_map<s32, size_t> m_id_index;
+        string_index_type m_path_index;
+        bool m_index_dirty = true;
     };
 
     struct ResourceArchiveNodeHasher {
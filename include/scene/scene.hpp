@@ -93,6 +93,9 @@ namespace Toolbox {
     public:
         ~SceneInstance();
 
+        // Reads the scene files on the shared thread pool, so it must not be
+        // called from one of the pool's tasks. Render data is decoded on the
+        // calling thread, which has to own the GL context.
         static Result<ScopePtr<SceneInstance>, SerialError>
         FromPath(const std::filesystem::path &root);
 
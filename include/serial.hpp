@@ -4,6 +4,7 @@
 #include "core/memory.hpp"
 #include "core/types.hpp"
 #include <bit>
+#include <cstring>
 #include <expected>
 #include <format>
 #include <iostream>
@@ -33,9 +34,20 @@ namespace Toolbox {
         Serializer(std::streambuf *out) : m_out(out) {}
         Serializer(std::streambuf *out, std::string_view file_path)
             : m_out(out), m_file_path(file_path) {}
+
+        // Writes straight into `arena` rather than through a stream. The
+        // arena is cleared and then grown as data is written, tell, seek
+        // and size are all O(1).
+        Serializer(std::vector<char> &arena) : m_out(nullptr), m_arena(&arena) { arena.clear(); }
+        Serializer(std::vector<char> &arena, std::string_view file_path)
+            : m_out(nullptr), m_arena(&arena), m_file_path(file_path) {
+            arena.clear();
+        }
+
         Serializer(const Serializer &) = default;
         Serializer(Serializer &&)      = default;
 
+        // Only usable when writing to a stream
         std::ostream &stream() { return m_out; }
         std::string_view filepath() const { return m_file_path; }
 
@@ -46,9 +58,9 @@ namespace Toolbox {
 
             Result<void, SerialError> result;
 
-            std::stringstream strstream;
-            Serializer sout(strstream.rdbuf());
-            
+            std::vector<char> arena;
+            Serializer sout(arena);
+
             // Write padding bytes
             for (size_t i = 0; i < offset; ++i) {
                 sout.write<u8>(0);
@@ -68,7 +80,7 @@ namespace Toolbox {
             size_t objsize = static_cast<size_t>(endpos - startpos);
 
             buf_out.alloc(objsize);
-            strstream.read(buf_out.buf<char>(), objsize);
+            std::memcpy(buf_out.buf<char>(), arena.data(), objsize);
 
             return result;
         }
@@ -125,6 +137,18 @@ namespace Toolbox {
         }
 
         Serializer &writeBytes(std::span<const char> bytes) {
+            if (m_arena) {
+                if (bytes.empty()) {
+                    return *this;
+                }
+                size_t end = m_pos + bytes.size();
+                if (end > m_arena->size()) {
+                    m_arena->resize(end);
+                }
+                std::memcpy(m_arena->data() + m_pos, bytes.data(), bytes.size());
+                m_pos = end;
+                return *this;
+            }
             m_out.write(bytes.data(), bytes.size());
             return *this;
         }
@@ -154,16 +178,38 @@ namespace Toolbox {
 
         Serializer &padTo(std::size_t alignment) { return padTo(alignment, '\x00'); }
 
+        // Seeking past the end of an arena is allowed, the gap
+        // is zero filled once something is written after it
         Serializer &seek(std::streamoff off, std::ios_base::seekdir way) {
+            if (m_arena) {
+                std::streamoff base = static_cast<std::streamoff>(m_pos);
+                if (way == std::ios::beg) {
+                    base = 0;
+                } else if (way == std::ios::end) {
+                    base = static_cast<std::streamoff>(m_arena->size());
+                }
+                if (base + off >= 0) {
+                    m_pos = static_cast<size_t>(base + off);
+                }
+                return *this;
+            }
             m_out.seekp(off, way);
             return *this;
         }
 
         Serializer &seek(std::streampos pos) { return seek(pos, std::ios::cur); }
 
-        std::streampos tell() { return m_out.tellp(); }
+        std::streampos tell() {
+            if (m_arena) {
+                return static_cast<std::streamoff>(m_pos);
+            }
+            return m_out.tellp();
+        }
 
         size_t size() {
+            if (m_arena) {
+                return m_arena->size();
+            }
             auto pos = tell();
             seek(0, std::ios::end);
             auto size = static_cast<size_t>(tell());
@@ -176,6 +222,8 @@ namespace Toolbox {
 
     private:
         std::ostream m_out;
+        std::vector<char> *m_arena = nullptr;
+        size_t m_pos               = 0;
         std::stack<std::streampos> m_breakpoints;
         std::string m_file_path = "[unknown path]";
     };
@@ -191,17 +239,34 @@ namespace Toolbox {
         Deserializer(std::streambuf *in) : m_in(in) {}
         Deserializer(std::streambuf *in, std::string_view file_path)
             : m_in(in), m_file_path(file_path) {}
+
+        // Reads straight out of `data` rather than through a stream, which
+        // makes tell, seek and size O(1). `data` must outlive the
+        // deserializer.
+        Deserializer(std::span<const char> data)
+            : m_in(nullptr), m_data(data), m_memory_backed(true) {}
+        Deserializer(std::span<const char> data, std::string_view file_path)
+            : m_in(nullptr), m_data(data), m_memory_backed(true), m_file_path(file_path) {}
+
         Deserializer(const Deserializer &) = default;
         Deserializer(Deserializer &&)      = default;
 
+        // Only usable when reading from a stream
         std::istream &stream() { return m_in; }
+
+        // False once a read or seek went out of bounds
+        bool good() {
+            if (m_memory_backed) {
+                return !m_failed;
+            }
+            return m_in.good();
+        }
         std::string_view filepath() const { return m_file_path; }
 
         template <typename _S, std::endian E = std::endian::native>
         static Result<void, SerialError> BytesToObject(Buffer &serial_data, _S &obj, size_t offset = 0) {
-            std::stringstream str_in(std::string(serial_data.buf<char>() + offset, serial_data.size() - offset));
-
-            Deserializer in(str_in.rdbuf());
+            Deserializer in(std::span<const char>(serial_data.buf<char>() + offset,
+                                                  serial_data.size() - offset));
             return obj.deserialize(in);
         }
 
@@ -292,7 +357,21 @@ namespace Toolbox {
             return *this;
         }
 
+        // Like a stream, an out of bounds read reads what is left
+        // and fails every read and seek after it
         Deserializer &readBytes(std::span<char> bytes) {
+            if (m_memory_backed) {
+                if (m_failed) {
+                    return *this;
+                }
+                size_t count = std::min(bytes.size(), m_data.size() - m_pos);
+                if (count > 0) {
+                    std::memcpy(bytes.data(), m_data.data() + m_pos, count);
+                }
+                m_pos += count;
+                m_failed = count < bytes.size();
+                return *this;
+            }
             m_in.read(bytes.data(), bytes.size());
             return *this;
         }
@@ -303,15 +382,41 @@ namespace Toolbox {
         }
 
         Deserializer &seek(std::streamoff off, std::ios_base::seekdir way) {
+            if (m_memory_backed) {
+                if (m_failed) {
+                    return *this;
+                }
+                std::streamoff base = static_cast<std::streamoff>(m_pos);
+                if (way == std::ios::beg) {
+                    base = 0;
+                } else if (way == std::ios::end) {
+                    base = static_cast<std::streamoff>(m_data.size());
+                }
+                std::streamoff target = base + off;
+                if (target < 0 || target > static_cast<std::streamoff>(m_data.size())) {
+                    m_failed = true;
+                } else {
+                    m_pos = static_cast<size_t>(target);
+                }
+                return *this;
+            }
             m_in.seekg(off, way);
             return *this;
         }
 
         Deserializer &seek(std::streampos pos) { return seek(pos, std::ios::cur); }
 
-        std::streampos tell() { return m_in.tellg(); }
+        std::streampos tell() {
+            if (m_memory_backed) {
+                return static_cast<std::streamoff>(m_pos);
+            }
+            return m_in.tellg();
+        }
 
         size_t size() {
+            if (m_memory_backed) {
+                return m_data.size();
+            }
             auto pos = tell();
             seek(0, std::ios::end);
             auto size = static_cast<size_t>(tell());
@@ -324,6 +429,10 @@ namespace Toolbox {
 
     private:
         std::istream m_in;
+        std::span<const char> m_data;
+        size_t m_pos         = 0;
+        bool m_memory_backed = false;
+        bool m_failed        = false;
         std::stack<std::streampos> m_breakpoints;
         std::string m_file_path = "[unknown path]";
     };
@@ -3,7 +3,6 @@
 #include <cmath>
 #include <expected>
 #include <format>
-#include <iconv.h>
 #include <string>
 #include <string_view>
 
@@ -29,38 +28,13 @@ namespace Toolbox::String {
         return std::unexpected<EncodingError>(err);
     }
 
-    inline Result<std::string, EncodingError>
-    asEncoding(std::string_view value, std::string_view from, std::string_view to) {
-        iconv_t conv = iconv_open(to.data(), from.data());
-        if (conv == (iconv_t)(-1)) {
-            return make_encoding_error<std::string>("ICONV", "Failed to open converter", from, to);
-        }
+    // Converters are opened once per thread and reused. Conversions between
+    // the game and UI encodings skip iconv and go through a lookup table,
+    // plain ASCII is copied as is.
+    Result<std::string, EncodingError> asEncoding(std::string_view value, std::string_view from,
+                                                  std::string_view to);
 
-        size_t inbytesleft = value.size();
-        char *inbuf        = const_cast<char *>(value.data());
-
-        size_t outbytesleft = value.size() * 2;
-        std::string sjis(outbytesleft, '\0');
-        char *outbuf = &sjis[0];
-
-        if (iconv(conv, &inbuf, &inbytesleft, &outbuf, &outbytesleft) == (size_t)(-1)) {
-            iconv_close(conv);
-            return make_encoding_error<std::string>(
-                "ICONV", std::format("Failed to convert string encoding from {} to {}", from, to),
-                from, to);
-        }
-
-        sjis.resize(std::max(sjis.size() - outbytesleft, size_t(0)));
-        iconv_close(conv);
-        return sjis;
-    }
-
-    inline Result<std::string, EncodingError> fromGameEncoding(std::string_view value) {
-        return asEncoding(value, GAME_ENCODING, IMGUI_ENCODING);
-    }
-
-    inline Result<std::string, EncodingError> toGameEncoding(std::string_view value) {
-        return asEncoding(value, IMGUI_ENCODING, GAME_ENCODING);
-    }
+    Result<std::string, EncodingError> fromGameEncoding(std::string_view value);
+    Result<std::string, EncodingError> toGameEncoding(std::string_view value);
 
 }  // namespace Toolbox::String
\ No newline at end of file
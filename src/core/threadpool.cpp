@@ -0,0 +1,119 @@
+#include <algorithm>
+
+#include "core/threadpool.hpp"
+
+namespace Toolbox {
+
+    namespace {
+        // Lets a task's submissions land on the queue of the worker running it
+        thread_local const ThreadPool *s_worker_pool = nullptr;
+        thread_local size_t s_worker_index           = 0;
+    }  // namespace
+
+    ThreadPool::ThreadPool(size_t thread_count) {
+        if (thread_count == 0) {
+            thread_count = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+        }
+
+        m_queues.reserve(thread_count);
+        for (size_t i = 0; i < thread_count; ++i) {
+            m_queues.emplace_back(make_scoped<WorkQueue>());
+        }
+
+        m_workers.reserve(thread_count);
+        for (size_t i = 0; i < thread_count; ++i) {
+            m_workers.emplace_back(&ThreadPool::workerLoop, this, i);
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::unique_lock<std::mutex> lk(m_sleep_mutex);
+            m_stopping = true;
+        }
+        m_condition.notify_all();
+
+        for (auto &worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    ThreadPool &ThreadPool::instance() {
+        static ThreadPool s_pool;
+        return s_pool;
+    }
+
+    bool ThreadPool::isWorkerThread() const { return s_worker_pool == this; }
+
+    void ThreadPool::push(std::function<void()> &&task) {
+        size_t index;
+        if (s_worker_pool == this) {
+            index = s_worker_index;
+        } else {
+            index = m_next_queue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+        }
+
+        {
+            std::unique_lock<std::mutex> lk(m_sleep_mutex);
+            m_pending += 1;
+        }
+
+        {
+            WorkQueue &queue = *m_queues[index];
+            std::unique_lock<std::mutex> lk(queue.m_mutex);
+            queue.m_tasks.emplace_back(std::move(task));
+        }
+
+        m_condition.notify_one();
+    }
+
+    bool ThreadPool::pop(size_t index, std::function<void()> &task) {
+        {
+            WorkQueue &own = *m_queues[index];
+            std::unique_lock<std::mutex> lk(own.m_mutex);
+            if (!own.m_tasks.empty()) {
+                task = std::move(own.m_tasks.back());
+                own.m_tasks.pop_back();
+                return true;
+            }
+        }
+
+        for (size_t i = 1; i < m_queues.size(); ++i) {
+            WorkQueue &victim = *m_queues[(index + i) % m_queues.size()];
+            std::unique_lock<std::mutex> lk(victim.m_mutex, std::try_to_lock);
+            if (lk.owns_lock() && !victim.m_tasks.empty()) {
+                task = std::move(victim.m_tasks.front());
+                victim.m_tasks.pop_front();
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void ThreadPool::workerLoop(size_t index) {
+        s_worker_pool  = this;
+        s_worker_index = index;
+
+        while (true) {
+            std::function<void()> task;
+            if (pop(index, task)) {
+                {
+                    std::unique_lock<std::mutex> lk(m_sleep_mutex);
+                    m_pending -= 1;
+                }
+                task();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lk(m_sleep_mutex);
+            m_condition.wait(lk, [this]() { return m_stopping || m_pending > 0; });
+
+            // Drain what is left so pending futures are still fulfilled
+            if (m_stopping && m_pending == 0) {
+                return;
+            }
+        }
+    }
+
+}  // namespace Toolbox
\ No newline at end of file
@@ -1,61 +1,50 @@
+#include <cstring>
+
+#include "dolphin/capture.hpp"
 #include "dolphin/hook.hpp"
-#include <algorithm>
-#include <glad/glad.h>
+#include "image/yuv.hpp"
 
 namespace Toolbox::Dolphin {
 
-    static Buffer YUV422ToRGB888(const u8 *yuv, int width, int height) {
-        Buffer out;
-        out.alloc(width * height * 3);
-
-        // YUV 4:2:2 each 4 bytes is 2 pixels
-        // Y0 U0 Y1 V0
-        for (int y = 0; y < height; ++y) {
-            for (int x = 0; x < width; x += 2) {
-                int base_index = (y * width + x) * 2;
-
-                // Scale colors from studio to full range
-                int y0        = static_cast<int>((yuv[base_index] - 16) * 255 / 219);
-                int y1        = static_cast<int>((yuv[base_index + 2] - 16) * 255 / 219);
-                int u         = static_cast<int>((yuv[base_index + 1] - 128) * 255 / 224);
-                int v         = static_cast<int>((yuv[base_index + 3] - 128) * 255 / 224);
-
-                int r0 = std::clamp(static_cast<int>(y0 + 1.402 * v), 0, 255);
-                int g0 = std::clamp(static_cast<int>(y0 - 0.344136 * u - 0.714136 * v), 0, 255);
-                int b0 = std::clamp(static_cast<int>(y0 + 1.772 * u), 0, 255);
+    const ImageHandle &XFBCapture::capture(DolphinHookManager &manager, u32 xfb_start,
+                                           int xfb_width, int xfb_height) {
+        if (xfb_start == 0 || xfb_width <= 0 || xfb_height <= 0) {
+            return m_no_image;
+        }
 
-                int r1 = std::clamp(static_cast<int>(y1 + 1.402 * v), 0, 255);
-                int g1 = std::clamp(static_cast<int>(y1 - 0.344136 * u - 0.714136 * v), 0, 255);
-                int b1 = std::clamp(static_cast<int>(y1 + 1.772 * u), 0, 255);
+        // YUV 4:2:2 stores 2 pixels in every 4 bytes
+        size_t pixel_count = static_cast<size_t>(xfb_width) * static_cast<size_t>(xfb_height);
+        m_xfb_read.resize(pixel_count * 2);
 
-                size_t rgb_index = static_cast<size_t>((y * width + x) * 3);
+        auto result = manager.readBytes(reinterpret_cast<char *>(m_xfb_read.data()), xfb_start,
+                                        m_xfb_read.size());
+        if (!result) {
+            return m_no_image;
+        }
 
-                out.set(rgb_index, static_cast<u8>(r0));
-                out.set(rgb_index + 1, static_cast<u8>(g0));
-                out.set(rgb_index + 2, static_cast<u8>(b0));
+        ImageHandle &current = m_images[m_image_index];
+        if (current && current.size() == std::pair<int, int>{xfb_width, xfb_height} &&
+            m_xfb_read == m_xfb_data) {
+            return current;
+        }
+        std::swap(m_xfb_read, m_xfb_data);
 
-                out.set(rgb_index + 3, static_cast<u8>(r1));
-                out.set(rgb_index + 4, static_cast<u8>(g1));
-                out.set(rgb_index + 5, static_cast<u8>(b1));
-            }
+        if (m_rgba_data.size() != pixel_count * 4) {
+            m_rgba_data.alloc(pixel_count * 4);
         }
+        YUV422ToRGBA8(m_xfb_data.data(), m_rgba_data.buf<u8>(), pixel_count);
 
-        return out;
+        m_image_index     = (m_image_index + 1) % m_images.size();
+        ImageHandle &next = m_images[m_image_index];
+        next.update(m_rgba_data, 4, xfb_width, xfb_height);
+        return next;
     }
 
-    ImageHandle DolphinHookManager::captureXFBAsTexture(int width, int height, u32 xfb_start, int xfb_width,
-                                                int xfb_height) {
-        if (xfb_start == 0 || xfb_width == 0 || xfb_height == 0)
-            return ImageHandle();
-
-        std::vector<u8> xfb_data(xfb_width * xfb_height * 2);
-        auto result = readBytes(reinterpret_cast<char *>(&xfb_data[0]), xfb_start, xfb_data.size());
-        if (!result) {
-            return ImageHandle();
+    void XFBCapture::reset() {
+        m_xfb_data.clear();
+        for (ImageHandle &image : m_images) {
+            image = ImageHandle();
         }
-
-        Buffer rgb_image = YUV422ToRGB888(xfb_data.data(), xfb_width, xfb_height);
-        return ImageHandle(rgb_image, 3, xfb_width, xfb_height);
     }
 
 }  // namespace Toolbox::Dolphin
\ No newline at end of file
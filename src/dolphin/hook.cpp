@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <chrono>
+#include <cstring>
 #include <mutex>
 #include <string>
 #include <string_view>
@@ -8,102 +10,10 @@
 #include "gui/settings.hpp"
 
 #include "dolphin/hook.hpp"
+#include "dolphin/sharedmem.hpp"
 
 namespace Toolbox::Dolphin {
 
-#ifdef TOOLBOX_PLATFORM_WINDOWS
-#include <tlhelp32.h>
-
-    static Result<Platform::ProcessID, BaseError> FindProcessPID(std::string_view process_name) {
-        std::string process_file = std::string(process_name) + ".exe";
-
-        Platform::LowHandle hSnapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
-        if (hSnapshot == INVALID_HANDLE_VALUE) {
-            return make_error<Platform::ProcessID>(std::format(
-                "(PROCESS) Failed to create snapshot to find process \"{}\".", process_file));
-        }
-
-        PROCESSENTRY32 pe32;
-        pe32.dwSize = sizeof(PROCESSENTRY32);
-
-        if (!Process32First(hSnapshot, &pe32)) {
-            CloseHandle(hSnapshot);
-            return make_error<Platform::ProcessID>(
-                "(PROCESS) Failed to retrieve first process entry!");
-        }
-
-        Platform::ProcessID pid = std::numeric_limits<Platform::ProcessID>::max();
-        do {
-            if (strcmp(pe32.szExeFile, process_file.data()) == 0) {
-                // Sometimes dead processes are still in the list
-                if (pe32.cntThreads == 0) {
-                    continue;
-                }
-                pid = pe32.th32ProcessID;
-                break;
-            }
-        } while (Process32Next(hSnapshot, &pe32));
-
-        CloseHandle(hSnapshot);
-
-        return pid;
-    }
-
-    static Result<Platform::LowHandle, BaseError> OpenProcessMemory(std::string_view memory_name) {
-        Platform::LowHandle memory_handle =
-            OpenFileMapping(FILE_MAP_ALL_ACCESS, FALSE, memory_name.data());
-        if (!memory_handle) {
-            return make_error<Platform::LowHandle>(
-                "SHARED_MEMORY",
-                std::format("Failed to find shared process memory handle \"{}\".", memory_name));
-        }
-
-        return memory_handle;
-    }
-
-    static Result<void *, BaseError> OpenMemoryView(Platform::LowHandle memory_handle) {
-        void *mem_buf = MapViewOfFile(memory_handle, FILE_MAP_ALL_ACCESS, 0, 0, 0);
-        if (!mem_buf) {
-            return make_error<void *>("SHARED_MEMORY",
-                                      "Failed to get view of shared process memory handle.");
-        }
-        return mem_buf;
-    }
-
-    static Result<void> CloseProcessMemory(Platform::LowHandle memory_handle) {
-        CloseHandle(memory_handle);
-        return {};
-    }
-
-    static Result<void> CloseMemoryView(void *memory_view) {
-        UnmapViewOfFile(memory_view);
-        return {};
-    }
-
-    static bool IsHandleOpen(Platform::LowHandle handle) {
-        DCB flags;
-        return GetCommState(handle, &flags);
-    }
-
-#elif TOOLBOX_PLATFORM_LINUX
-    static Result<Platform::ProcessID, BaseError> FindProcessPID(std::string_view process_name) {
-        return make_error<Platform::ProcessID>("Linux support unimplemented!");
-    }
-
-    static Result<Platform::MemoryHandle, BaseError>
-    OpenProcessMemory(std::string_view memory_name) {
-        return nullptr;
-    }
-
-    static Result<void *, BaseError> OpenMemoryView(Platform::MemoryHandle memory_handle) {
-        return nullptr;
-    }
-
-    static Result<void> CloseProcessMemory(Platform::MemoryHandle memory_handle) { return {}; }
-
-    static Result<void> CloseMemoryView(void *memory_view) { return {}; }
-#endif
-
     DolphinHookManager &DolphinHookManager::instance() {
         static DolphinHookManager _instance;
         return _instance;
@@ -146,7 +56,7 @@ namespace Toolbox::Dolphin {
     }
 
     Result<bool> DolphinHookManager::hook() {
-        if (m_mem_view) {
+        if (m_mem_handle) {
             return {};
         }
 
@@ -154,7 +64,12 @@ namespace Toolbox::Dolphin {
 
         if (!IsExProcessRunning(m_proc_info)) {
             Platform::ProcessID pid                   = sentinel;
+#ifdef TOOLBOX_PLATFORM_LINUX
+            std::vector<std::string> target_processes = {"dolphin-emu", "dolphin-emu-qt2",
+                                                         "dolphin-emu-wx"};
+#else
             std::vector<std::string> target_processes = {"Dolphin", "DolphinQt2", "DolphinWx"};
+#endif
 
             size_t i = 0;
             for (auto &proc_name : target_processes) {
@@ -179,15 +94,16 @@ namespace Toolbox::Dolphin {
 
         std::string dolphin_memory_name = std::format("dolphin-emu.{}", m_proc_info.m_process_id);
 
-        auto handle_result = OpenProcessMemory(dolphin_memory_name);
+        auto handle_result = OpenProcessMemory(m_proc_info.m_process_id, dolphin_memory_name);
         if (!handle_result || handle_result.value() == nullptr) {
             return std::unexpected(handle_result.error());
         }
 
         m_mem_handle = handle_result.value();
 
+        // A null view leaves every access to TransferProcessSpans
         auto view_result = OpenMemoryView(m_mem_handle);
-        if (!view_result || view_result.value() == nullptr) {
+        if (!view_result) {
             CloseProcessMemory(m_mem_handle);
             m_mem_handle = nullptr;
             return std::unexpected(view_result.error());
@@ -209,11 +125,11 @@ namespace Toolbox::Dolphin {
     }
 
     Result<bool> DolphinHookManager::unhook() {
-        if (!m_mem_view) {
+        if (!m_mem_handle) {
             return {};
         }
 
-        auto view_result = CloseMemoryView(m_mem_view);
+        auto view_result = CloseMemoryView(m_mem_handle, m_mem_view);
         if (!view_result) {
             return std::unexpected(view_result.error());
         }
@@ -254,7 +170,7 @@ namespace Toolbox::Dolphin {
 
     Result<void> DolphinHookManager::readBytes(char *buf, u32 address, size_t size) {
         std::unique_lock lock(m_memory_mutex);
-        if (!m_mem_view) {
+        if (!m_mem_handle) {
             return make_error<void>("SHARED_MEMORY",
                                     "Tried to read bytes without a memory handle!");
         }
@@ -264,6 +180,11 @@ namespace Toolbox::Dolphin {
                                     "Tried to read bytes to a protected memory region!");
         }
 
+        if (!m_mem_view) {
+            MemorySpan span = {address, static_cast<u32>(size), buf};
+            return TransferProcessSpans(m_mem_handle, {}, {&span, 1});
+        }
+
         const char *true_address = static_cast<const char *>(m_mem_view) + (address & 0x7FFFFFFF);
         memcpy(buf, true_address, size);
         return {};
@@ -271,7 +192,7 @@ namespace Toolbox::Dolphin {
 
     Result<void> DolphinHookManager::writeBytes(const char *buf, u32 address, size_t size) {
         std::unique_lock lock(m_memory_mutex);
-        if (!m_mem_view) {
+        if (!m_mem_handle) {
             return make_error<void>("SHARED_MEMORY",
                                     "Tried to write bytes without a memory handle!");
         }
@@ -281,9 +202,45 @@ namespace Toolbox::Dolphin {
                                     "Tried to write bytes to a protected memory region!");
         }
 
+        if (!m_mem_view) {
+            MemorySpan span = {address, static_cast<u32>(size), const_cast<char *>(buf)};
+            return TransferProcessSpans(m_mem_handle, {&span, 1}, {});
+        }
+
         char *true_address = static_cast<char *>(m_mem_view) + (address & 0x7FFFFFFF);
         memcpy(true_address, buf, size);
         return {};
     }
 
+    Result<void> DolphinHookManager::transferSpans(std::span<const MemorySpan> writes,
+                                                   std::span<const MemorySpan> reads) {
+        std::unique_lock lock(m_memory_mutex);
+        if (!m_mem_handle) {
+            return make_error<void>("SHARED_MEMORY",
+                                    "Tried to transfer bytes without a memory handle!");
+        }
+
+        auto in_bounds = [](const MemorySpan &span) {
+            return static_cast<u64>(span.m_address & 0x7FFFFFFF) + span.m_size <= 0x1800000;
+        };
+        if (!std::all_of(writes.begin(), writes.end(), in_bounds) ||
+            !std::all_of(reads.begin(), reads.end(), in_bounds)) {
+            return make_error<void>("SHARED_MEMORY",
+                                    "Tried to transfer bytes to a protected memory region!");
+        }
+
+        if (!m_mem_view) {
+            return TransferProcessSpans(m_mem_handle, writes, reads);
+        }
+
+        char *memory = static_cast<char *>(m_mem_view);
+        for (const MemorySpan &span : writes) {
+            memcpy(memory + (span.m_address & 0x7FFFFFFF), span.m_data, span.m_size);
+        }
+        for (const MemorySpan &span : reads) {
+            memcpy(span.m_data, memory + (span.m_address & 0x7FFFFFFF), span.m_size);
+        }
+        return {};
+    }
+
 }  // namespace Toolbox::Dolphin
\ No newline at end of file
@@ -29,12 +29,12 @@ inline u32 MakeRotationMask(u32 mb, u32 me) {
 namespace Toolbox::Interpreter {
 
     // Memory
-    void FixedPointProcessor::lbz(u8 rt, s16 d, u8 ra, Buffer &storage) {
+    void FixedPointProcessor::lbz(u8 rt, s16 d, u8 ra, MemoryStorage &storage) {
         if (!IsRegValid(rt) || !IsRegValid(ra)) {
             m_invalid_cb(PROC_INVALID_MSG(FixedPointProcessor, lbz, "Invalid registers detected!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(m_gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
         if (!MemoryContainsPAddress(storage, destination)) {
             m_exception_cb(ExceptionCause::EXCEPTION_DSI);
             return;
@@ -42,13 +42,13 @@ namespace Toolbox::Interpreter {
         m_gpr[rt] = storage.get<u8>(destination);
     }
 
-    void FixedPointProcessor::lbzu(u8 rt, s16 d, u8 ra, Buffer &storage) {
+    void FixedPointProcessor::lbzu(u8 rt, s16 d, u8 ra, MemoryStorage &storage) {
         if (!IsRegValid(rt) || !IsRegValid(ra)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, lbzu, "Invalid registers detected!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(m_gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
         if (!MemoryContainsPAddress(storage, destination)) {
             m_exception_cb(ExceptionCause::EXCEPTION_DSI);
             return;
@@ -57,7 +57,7 @@ namespace Toolbox::Interpreter {
         m_gpr[ra] += d;
     }
 
-    void FixedPointProcessor::lbzx(u8 rt, u8 ra, u8 rb, Buffer &storage) {
+    void FixedPointProcessor::lbzx(u8 rt, u8 ra, u8 rb, MemoryStorage &storage) {
         if (!IsRegValid(rt) || !IsRegValid(ra) || !IsRegValid(rb)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, lbzx, "Invalid registers detected!"));
@@ -73,7 +73,7 @@ namespace Toolbox::Interpreter {
                                           "Indexed load using source register 0 is invalid!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
         if (!MemoryContainsPAddress(storage, destination)) {
             m_exception_cb(ExceptionCause::EXCEPTION_DSI);
             return;
@@ -81,7 +81,7 @@ namespace Toolbox::Interpreter {
         m_gpr[rt] = storage.get<u8>(destination);
     }
 
-    void FixedPointProcessor::lbzux(u8 rt, u8 ra, u8 rb, Buffer &storage) {
+    void FixedPointProcessor::lbzux(u8 rt, u8 ra, u8 rb, MemoryStorage &storage) {
         if (!IsRegValid(rt) || !IsRegValid(ra) || !IsRegValid(rb)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, lbzux, "Invalid registers detected!"));
@@ -97,7 +97,7 @@ namespace Toolbox::Interpreter {
                                           "Indexed load using source register 0 is invalid!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
         if (!MemoryContainsPAddress(storage, destination)) {
             m_exception_cb(ExceptionCause::EXCEPTION_DSI);
             return;
@@ -106,12 +106,12 @@ namespace Toolbox::Interpreter {
         m_gpr[ra] += m_gpr[rb];
     }
 
-    void FixedPointProcessor::lhz(u8 rt, s16 d, u8 ra, Buffer &storage) {
+    void FixedPointProcessor::lhz(u8 rt, s16 d, u8 ra, MemoryStorage &storage) {
         if (!IsRegValid(rt) || !IsRegValid(ra)) {
             m_invalid_cb(PROC_INVALID_MSG(FixedPointProcessor, lhz, "Invalid registers detected!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(m_gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
         if (!MemoryContainsPAddress(storage, destination)) {
             m_exception_cb(ExceptionCause::EXCEPTION_DSI);
             return;
@@ -119,13 +119,13 @@ namespace Toolbox::Interpreter {
         m_gpr[rt] = std::byteswap<u16>(storage.get<u16>(destination));
     }
 
-    void FixedPointProcessor::lhzu(u8 rt, s16 d, u8 ra, Buffer &storage) {
+    void FixedPointProcessor::lhzu(u8 rt, s16 d, u8 ra, MemoryStorage &storage) {
         if (!IsRegValid(rt) || !IsRegValid(ra)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, lhzu, "Invalid registers detected!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(m_gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
         if (!MemoryContainsPAddress(storage, destination)) {
             m_exception_cb(ExceptionCause::EXCEPTION_DSI);
             return;
@@ -134,7 +134,7 @@ namespace Toolbox::Interpreter {
         m_gpr[ra] += d;
     }
 
-    void FixedPointProcessor::lhzx(u8 rt, u8 ra, u8 rb, Buffer &storage) {
+    void FixedPointProcessor::lhzx(u8 rt, u8 ra, u8 rb, MemoryStorage &storage) {
         if (!IsRegValid(rt) || !IsRegValid(ra) || !IsRegValid(rb)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, lhzx, "Invalid registers detected!"));
@@ -150,7 +150,7 @@ namespace Toolbox::Interpreter {
                                           "Indexed load using source register 0 is invalid!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
         if (!MemoryContainsPAddress(storage, destination)) {
             m_exception_cb(ExceptionCause::EXCEPTION_DSI);
             return;
@@ -158,7 +158,7 @@ namespace Toolbox::Interpreter {
         m_gpr[rt] = std::byteswap<u16>(storage.get<u16>(destination));
     }
 
-    void FixedPointProcessor::lhzux(u8 rt, u8 ra, u8 rb, Buffer &storage) {
+    void FixedPointProcessor::lhzux(u8 rt, u8 ra, u8 rb, MemoryStorage &storage) {
         if (!IsRegValid(rt) || !IsRegValid(ra) || !IsRegValid(rb)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, lhzux, "Invalid registers detected!"));
@@ -174,7 +174,7 @@ namespace Toolbox::Interpreter {
                                           "Indexed load using source register 0 is invalid!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
         if (!MemoryContainsPAddress(storage, destination)) {
             m_exception_cb(ExceptionCause::EXCEPTION_DSI);
             return;
@@ -183,12 +183,12 @@ namespace Toolbox::Interpreter {
         m_gpr[ra] += m_gpr[rb];
     }
 
-    void FixedPointProcessor::lha(u8 rt, s16 d, u8 ra, Buffer &storage) {
+    void FixedPointProcessor::lha(u8 rt, s16 d, u8 ra, MemoryStorage &storage) {
         if (!IsRegValid(rt) || !IsRegValid(ra)) {
             m_invalid_cb(PROC_INVALID_MSG(FixedPointProcessor, lha, "Invalid registers detected!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(m_gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
         if (!MemoryContainsPAddress(storage, destination)) {
             m_exception_cb(ExceptionCause::EXCEPTION_DSI);
             return;
@@ -196,13 +196,13 @@ namespace Toolbox::Interpreter {
         m_gpr[rt] = storage.get<bs16>(destination);
     }
 
-    void FixedPointProcessor::lhau(u8 rt, s16 d, u8 ra, Buffer &storage) {
+    void FixedPointProcessor::lhau(u8 rt, s16 d, u8 ra, MemoryStorage &storage) {
         if (!IsRegValid(rt) || !IsRegValid(ra)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, lhau, "Invalid registers detected!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(m_gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
         if (!MemoryContainsPAddress(storage, destination)) {
             m_exception_cb(ExceptionCause::EXCEPTION_DSI);
             return;
@@ -211,13 +211,13 @@ namespace Toolbox::Interpreter {
         m_gpr[ra] += d;
     }
 
-    void FixedPointProcessor::lhax(u8 rt, u8 ra, u8 rb, Buffer &storage) {
+    void FixedPointProcessor::lhax(u8 rt, u8 ra, u8 rb, MemoryStorage &storage) {
         if (!IsRegValid(rt) || !IsRegValid(ra) || !IsRegValid(rb)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, lhax, "Invalid registers detected!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
         if (!MemoryContainsPAddress(storage, destination)) {
             m_exception_cb(ExceptionCause::EXCEPTION_DSI);
             return;
@@ -225,13 +225,13 @@ namespace Toolbox::Interpreter {
         m_gpr[rt] = storage.get<bs16>(destination);
     }
 
-    void FixedPointProcessor::lhaux(u8 rt, u8 ra, u8 rb, Buffer &storage) {
+    void FixedPointProcessor::lhaux(u8 rt, u8 ra, u8 rb, MemoryStorage &storage) {
         if (!IsRegValid(rt) || !IsRegValid(ra) || !IsRegValid(rb)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, lhaux, "Invalid registers detected!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
         if (!MemoryContainsPAddress(storage, destination)) {
             m_exception_cb(ExceptionCause::EXCEPTION_DSI);
             return;
@@ -240,12 +240,12 @@ namespace Toolbox::Interpreter {
         m_gpr[ra] += m_gpr[rb];
     }
 
-    void FixedPointProcessor::lwz(u8 rt, s16 d, u8 ra, Buffer &storage) {
+    void FixedPointProcessor::lwz(u8 rt, s16 d, u8 ra, MemoryStorage &storage) {
         if (!IsRegValid(rt) || !IsRegValid(ra)) {
             m_invalid_cb(PROC_INVALID_MSG(FixedPointProcessor, lwz, "Invalid registers detected!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(m_gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
         if (!MemoryContainsPAddress(storage, destination)) {
             m_exception_cb(ExceptionCause::EXCEPTION_DSI);
             return;
@@ -253,13 +253,13 @@ namespace Toolbox::Interpreter {
         m_gpr[rt] = std::byteswap<u32>(storage.get<u32>(destination));
     }
 
-    void FixedPointProcessor::lwzu(u8 rt, s16 d, u8 ra, Buffer &storage) {
+    void FixedPointProcessor::lwzu(u8 rt, s16 d, u8 ra, MemoryStorage &storage) {
         if (!IsRegValid(rt) || !IsRegValid(ra)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, lwzu, "Invalid registers detected!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(m_gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
         if (!MemoryContainsPAddress(storage, destination)) {
             m_exception_cb(ExceptionCause::EXCEPTION_DSI);
             return;
@@ -268,7 +268,7 @@ namespace Toolbox::Interpreter {
         m_gpr[ra] += d;
     }
 
-    void FixedPointProcessor::lwzx(u8 rt, u8 ra, u8 rb, Buffer &storage) {
+    void FixedPointProcessor::lwzx(u8 rt, u8 ra, u8 rb, MemoryStorage &storage) {
         if (!IsRegValid(rt) || !IsRegValid(ra) || !IsRegValid(rb)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, lwzx, "Invalid registers detected!"));
@@ -284,7 +284,7 @@ namespace Toolbox::Interpreter {
                                           "Indexed load using source register 0 is invalid!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
         if (!MemoryContainsPAddress(storage, destination)) {
             m_exception_cb(ExceptionCause::EXCEPTION_DSI);
             return;
@@ -292,7 +292,7 @@ namespace Toolbox::Interpreter {
         m_gpr[rt] = std::byteswap<u32>(storage.get<u32>(destination));
     }
 
-    void FixedPointProcessor::lwzux(u8 rt, u8 ra, u8 rb, Buffer &storage) {
+    void FixedPointProcessor::lwzux(u8 rt, u8 ra, u8 rb, MemoryStorage &storage) {
         if (!IsRegValid(rt) || !IsRegValid(ra) || !IsRegValid(rb)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, lwzux, "Invalid registers detected!"));
@@ -308,7 +308,7 @@ namespace Toolbox::Interpreter {
                                           "Indexed load using source register 0 is invalid!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
         if (!MemoryContainsPAddress(storage, destination)) {
             m_exception_cb(ExceptionCause::EXCEPTION_DSI);
             return;
@@ -317,12 +317,12 @@ namespace Toolbox::Interpreter {
         m_gpr[ra] += m_gpr[rb];
     }
 
-    void FixedPointProcessor::stb(u8 rs, s16 d, u8 ra, Buffer &storage) {
+    void FixedPointProcessor::stb(u8 rs, s16 d, u8 ra, MemoryStorage &storage) {
         if (!IsRegValid(rs) || !IsRegValid(ra)) {
             m_invalid_cb(PROC_INVALID_MSG(FixedPointProcessor, stb, "Invalid registers detected!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(m_gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
         if (!MemoryContainsPAddress(storage, destination)) {
             m_exception_cb(ExceptionCause::EXCEPTION_DSI);
             return;
@@ -330,13 +330,13 @@ namespace Toolbox::Interpreter {
         storage.set<u8>(destination, static_cast<u8>(m_gpr[rs]));
     }
 
-    void FixedPointProcessor::stbu(u8 rs, s16 d, u8 ra, Buffer &storage) {
+    void FixedPointProcessor::stbu(u8 rs, s16 d, u8 ra, MemoryStorage &storage) {
         if (!IsRegValid(rs) || !IsRegValid(ra)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, stbu, "Invalid registers detected!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(m_gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
         if (!MemoryContainsPAddress(storage, destination)) {
             m_exception_cb(ExceptionCause::EXCEPTION_DSI);
             return;
@@ -345,7 +345,7 @@ namespace Toolbox::Interpreter {
         m_gpr[ra] += d;
     }
 
-    void FixedPointProcessor::stbx(u8 rs, u8 ra, u8 rb, Buffer &storage) {
+    void FixedPointProcessor::stbx(u8 rs, u8 ra, u8 rb, MemoryStorage &storage) {
         if (!IsRegValid(rs) || !IsRegValid(ra) || !IsRegValid(rb)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, stbx, "Invalid registers detected!"));
@@ -361,7 +361,7 @@ namespace Toolbox::Interpreter {
                                           "Indexed store using source register 0 is invalid!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
         if (!MemoryContainsPAddress(storage, destination)) {
             m_exception_cb(ExceptionCause::EXCEPTION_DSI);
             return;
@@ -369,7 +369,7 @@ namespace Toolbox::Interpreter {
         storage.set<u8>(destination, static_cast<u8>(m_gpr[rs]));
     }
 
-    void FixedPointProcessor::stbux(u8 rs, u8 ra, u8 rb, Buffer &storage) {
+    void FixedPointProcessor::stbux(u8 rs, u8 ra, u8 rb, MemoryStorage &storage) {
         if (!IsRegValid(rs) || !IsRegValid(ra) || !IsRegValid(rb)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, stbux, "Invalid registers detected!"));
@@ -385,7 +385,7 @@ namespace Toolbox::Interpreter {
                                           "Indexed store using source register 0 is invalid!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
         if (!MemoryContainsPAddress(storage, destination)) {
             m_exception_cb(ExceptionCause::EXCEPTION_DSI);
             return;
@@ -394,12 +394,12 @@ namespace Toolbox::Interpreter {
         m_gpr[ra] += m_gpr[rb];
     }
 
-    void FixedPointProcessor::sth(u8 rs, s16 d, u8 ra, Buffer &storage) {
+    void FixedPointProcessor::sth(u8 rs, s16 d, u8 ra, MemoryStorage &storage) {
         if (!IsRegValid(rs) || !IsRegValid(ra)) {
             m_invalid_cb(PROC_INVALID_MSG(FixedPointProcessor, sth, "Invalid registers detected!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(m_gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
         if (!MemoryContainsPAddress(storage, destination)) {
             m_exception_cb(ExceptionCause::EXCEPTION_DSI);
             return;
@@ -407,13 +407,13 @@ namespace Toolbox::Interpreter {
         storage.set<bu16>(destination, static_cast<u16>(m_gpr[rs]));
     }
 
-    void FixedPointProcessor::sthu(u8 rs, s16 d, u8 ra, Buffer &storage) {
+    void FixedPointProcessor::sthu(u8 rs, s16 d, u8 ra, MemoryStorage &storage) {
         if (!IsRegValid(rs) || !IsRegValid(ra)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, sthu, "Invalid registers detected!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(m_gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
         if (!MemoryContainsPAddress(storage, destination)) {
             m_exception_cb(ExceptionCause::EXCEPTION_DSI);
             return;
@@ -422,7 +422,7 @@ namespace Toolbox::Interpreter {
         m_gpr[ra] += d;
     }
 
-    void FixedPointProcessor::sthx(u8 rs, u8 ra, u8 rb, Buffer &storage) {
+    void FixedPointProcessor::sthx(u8 rs, u8 ra, u8 rb, MemoryStorage &storage) {
         if (!IsRegValid(rs) || !IsRegValid(ra) || !IsRegValid(rb)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, sthx, "Invalid registers detected!"));
@@ -438,7 +438,7 @@ namespace Toolbox::Interpreter {
                                           "Indexed store using source register 0 is invalid!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
         if (!MemoryContainsPAddress(storage, destination)) {
             m_exception_cb(ExceptionCause::EXCEPTION_DSI);
             return;
@@ -446,7 +446,7 @@ namespace Toolbox::Interpreter {
         storage.set<bu16>(destination, static_cast<u16>(m_gpr[rs]));
     }
 
-    void FixedPointProcessor::sthux(u8 rs, u8 ra, u8 rb, Buffer &storage) {
+    void FixedPointProcessor::sthux(u8 rs, u8 ra, u8 rb, MemoryStorage &storage) {
         if (!IsRegValid(rs) || !IsRegValid(ra) || !IsRegValid(rb)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, sthux, "Invalid registers detected!"));
@@ -462,7 +462,7 @@ namespace Toolbox::Interpreter {
                                           "Indexed store using source register 0 is invalid!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
         if (!MemoryContainsPAddress(storage, destination)) {
             m_exception_cb(ExceptionCause::EXCEPTION_DSI);
             return;
@@ -471,12 +471,12 @@ namespace Toolbox::Interpreter {
         m_gpr[ra] += m_gpr[rb];
     }
 
-    void FixedPointProcessor::stw(u8 rs, s16 d, u8 ra, Buffer &storage) {
+    void FixedPointProcessor::stw(u8 rs, s16 d, u8 ra, MemoryStorage &storage) {
         if (!IsRegValid(rs) || !IsRegValid(ra)) {
             m_invalid_cb(PROC_INVALID_MSG(FixedPointProcessor, stw, "Invalid registers detected!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(m_gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
         if (!MemoryContainsPAddress(storage, destination)) {
             m_exception_cb(ExceptionCause::EXCEPTION_DSI);
             return;
@@ -484,13 +484,13 @@ namespace Toolbox::Interpreter {
         storage.set<bu32>(destination, static_cast<u32>(m_gpr[rs]));
     }
 
-    void FixedPointProcessor::stwu(u8 rs, s16 d, u8 ra, Buffer &storage) {
+    void FixedPointProcessor::stwu(u8 rs, s16 d, u8 ra, MemoryStorage &storage) {
         if (!IsRegValid(rs) || !IsRegValid(ra)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, stwu, "Invalid registers detected!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(m_gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
         if (!MemoryContainsPAddress(storage, destination)) {
             m_exception_cb(ExceptionCause::EXCEPTION_DSI);
             return;
@@ -499,7 +499,7 @@ namespace Toolbox::Interpreter {
         m_gpr[ra] += d;
     }
 
-    void FixedPointProcessor::stwx(u8 rs, u8 ra, u8 rb, Buffer &storage) {
+    void FixedPointProcessor::stwx(u8 rs, u8 ra, u8 rb, MemoryStorage &storage) {
         if (!IsRegValid(rs) || !IsRegValid(ra) || !IsRegValid(rb)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, stwx, "Invalid registers detected!"));
@@ -515,7 +515,7 @@ namespace Toolbox::Interpreter {
                                           "Indexed store using source register 0 is invalid!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
         if (!MemoryContainsPAddress(storage, destination)) {
             m_exception_cb(ExceptionCause::EXCEPTION_DSI);
             return;
@@ -523,7 +523,7 @@ namespace Toolbox::Interpreter {
         storage.set<bu32>(destination, static_cast<u32>(m_gpr[rs]));
     }
 
-    void FixedPointProcessor::stwux(u8 rs, u8 ra, u8 rb, Buffer &storage) {
+    void FixedPointProcessor::stwux(u8 rs, u8 ra, u8 rb, MemoryStorage &storage) {
         if (!IsRegValid(rs) || !IsRegValid(ra) || !IsRegValid(rb)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, stwux, "Invalid registers detected!"));
@@ -539,7 +539,7 @@ namespace Toolbox::Interpreter {
                                           "Indexed store using source register 0 is invalid!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
         if (!MemoryContainsPAddress(storage, destination)) {
             m_exception_cb(ExceptionCause::EXCEPTION_DSI);
             return;
@@ -548,7 +548,7 @@ namespace Toolbox::Interpreter {
         m_gpr[ra] += m_gpr[rb];
     }
 
-    void FixedPointProcessor::lhbrx(u8 rt, u8 ra, u8 rb, Buffer &storage) {
+    void FixedPointProcessor::lhbrx(u8 rt, u8 ra, u8 rb, MemoryStorage &storage) {
         if (!IsRegValid(rt) || !IsRegValid(ra) || !IsRegValid(rb)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, lhbrx, "Invalid registers detected!"));
@@ -564,14 +564,14 @@ namespace Toolbox::Interpreter {
                                           "Indexed load using source register 0 is invalid!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
         if (!MemoryContainsPAddress(storage, destination)) {
             m_exception_cb(ExceptionCause::EXCEPTION_DSI);
             return;
         }
         m_gpr[rt] = storage.get<u16>(destination);
     }
-    void FixedPointProcessor::lwbrx(u8 rt, u8 ra, u8 rb, Buffer &storage) {
+    void FixedPointProcessor::lwbrx(u8 rt, u8 ra, u8 rb, MemoryStorage &storage) {
         if (!IsRegValid(rt) || !IsRegValid(ra) || !IsRegValid(rb)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, lwbrx, "Invalid registers detected!"));
@@ -587,7 +587,7 @@ namespace Toolbox::Interpreter {
                                           "Indexed load using source register 0 is invalid!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
         if (!MemoryContainsPAddress(storage, destination)) {
             m_exception_cb(ExceptionCause::EXCEPTION_DSI);
             return;
@@ -595,26 +595,26 @@ namespace Toolbox::Interpreter {
         m_gpr[rt] = storage.get<u32>(destination);
     }
 
-    void FixedPointProcessor::sthbrx(u8 rs, u8 ra, u8 rb, Buffer &storage) {
+    void FixedPointProcessor::sthbrx(u8 rs, u8 ra, u8 rb, MemoryStorage &storage) {
         if (!IsRegValid(rs) || !IsRegValid(ra) || !IsRegValid(rb)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, sthbrx, "Invalid registers detected!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
         if (!MemoryContainsPAddress(storage, destination)) {
             m_exception_cb(ExceptionCause::EXCEPTION_DSI);
             return;
         }
         storage.set<u16>(destination, static_cast<u16>(m_gpr[rs]));
     }
-    void FixedPointProcessor::stwbrx(u8 rs, u8 ra, u8 rb, Buffer &storage) {
+    void FixedPointProcessor::stwbrx(u8 rs, u8 ra, u8 rb, MemoryStorage &storage) {
         if (!IsRegValid(rs) || !IsRegValid(ra) || !IsRegValid(rb)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, stwbrx, "Invalid registers detected!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
         if (!MemoryContainsPAddress(storage, destination)) {
             m_exception_cb(ExceptionCause::EXCEPTION_DSI);
             return;
@@ -622,7 +622,7 @@ namespace Toolbox::Interpreter {
         storage.set<u32>(destination, static_cast<u32>(m_gpr[rs]));
     }
 
-    void FixedPointProcessor::lmw(u8 rt, s16 d, u8 ra, Buffer &storage) {
+    void FixedPointProcessor::lmw(u8 rt, s16 d, u8 ra, MemoryStorage &storage) {
         if (!IsRegValid(rt) || !IsRegValid(ra)) {
             m_invalid_cb(PROC_INVALID_MSG(FixedPointProcessor, lmw, "Invalid registers detected!"));
             return;
@@ -637,7 +637,7 @@ namespace Toolbox::Interpreter {
                                           "Load using source register 0 is invalid!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(m_gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
         if ((destination & 0b11) != 0) {
             m_exception_cb(ExceptionCause::EXCEPTION_ALIGNMENT);
         }
@@ -650,7 +650,7 @@ namespace Toolbox::Interpreter {
             destination += 4;
         }
     }
-    void FixedPointProcessor::stmw(u8 rs, s16 d, u8 ra, Buffer &storage) {
+    void FixedPointProcessor::stmw(u8 rs, s16 d, u8 ra, MemoryStorage &storage) {
         if (!IsRegValid(rs) || !IsRegValid(ra)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, stmw, "Invalid registers detected!"));
@@ -666,7 +666,7 @@ namespace Toolbox::Interpreter {
                                           "Store using source register 0 is invalid!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(m_gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
         if ((destination & 0b11) != 0) {
             m_exception_cb(ExceptionCause::EXCEPTION_ALIGNMENT);
         }
@@ -680,7 +680,7 @@ namespace Toolbox::Interpreter {
         }
     }
 
-    void FixedPointProcessor::lswi(u8 rt, u8 ra, u8 nb, Buffer &storage) {
+    void FixedPointProcessor::lswi(u8 rt, u8 ra, u8 nb, MemoryStorage &storage) {
         if (!IsRegValid(rt) || !IsRegValid(ra)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, lswi, "Invalid registers detected!"));
@@ -696,7 +696,7 @@ namespace Toolbox::Interpreter {
                                           "Source register in range of string load is invalid!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] - 0x80000000);
+        u32 destination = static_cast<u32>(m_gpr[ra] - 0x80000000);
         while (nb > 0) {
             if (!MemoryContainsPAddress(storage, destination)) {
                 m_exception_cb(ExceptionCause::EXCEPTION_DSI);
@@ -717,7 +717,7 @@ namespace Toolbox::Interpreter {
         }
     }
 
-    void FixedPointProcessor::lswx(u8 rt, u8 ra, u8 rb, Buffer &storage) {
+    void FixedPointProcessor::lswx(u8 rt, u8 ra, u8 rb, MemoryStorage &storage) {
         if (!IsRegValid(rt) || !IsRegValid(ra) || !IsRegValid(rb)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, lswx, "Invalid registers detected!"));
@@ -733,7 +733,7 @@ namespace Toolbox::Interpreter {
                                           "Source register in range of string load is invalid!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(m_gpr[ra] + m_gpr[rb] - 0x80000000) & 0x7FFFFFFF;
         u8 nb           = XER_STR(m_xer);
         while (nb > 0) {
             if (!MemoryContainsPAddress(storage, destination)) {
@@ -755,7 +755,7 @@ namespace Toolbox::Interpreter {
         }
     }
 
-    void FixedPointProcessor::stswi(u8 rs, u8 ra, u8 nb, Buffer &storage) {
+    void FixedPointProcessor::stswi(u8 rs, u8 ra, u8 nb, MemoryStorage &storage) {
         if (!IsRegValid(rs) || !IsRegValid(ra)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, stswi, "Invalid registers detected!"));
@@ -771,14 +771,15 @@ namespace Toolbox::Interpreter {
                                           "Source register in range of string load is invalid!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] - 0x80000000);
+        u32 destination = static_cast<u32>(m_gpr[ra] - 0x80000000);
         while (nb > 0) {
             if (!MemoryContainsPAddress(storage, destination)) {
                 m_exception_cb(ExceptionCause::EXCEPTION_DSI);
                 return;
             }
             if (nb < 4) {
-                memcpy(storage.buf<u8>() + destination, &m_gpr[rs++ % 32], nb);
+                storage.writeBytes(reinterpret_cast<const char *>(&m_gpr[rs++ % 32]), destination,
+                                   nb);
                 destination += 4;
                 nb = 0;
             } else {
@@ -790,7 +791,7 @@ namespace Toolbox::Interpreter {
         }
     }
 
-    void FixedPointProcessor::stswx(u8 rs, u8 ra, u8 rb, Buffer &storage) {
+    void FixedPointProcessor::stswx(u8 rs, u8 ra, u8 rb, MemoryStorage &storage) {
         if (!IsRegValid(rs) || !IsRegValid(ra) || !IsRegValid(rb)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, stswx, "Invalid registers detected!"));
@@ -806,7 +807,7 @@ namespace Toolbox::Interpreter {
                                           "Source register in range of string load is invalid!"));
             return;
         }
-        s32 destination = static_cast<s32>(m_gpr[ra] - 0x80000000);
+        u32 destination = static_cast<u32>(m_gpr[ra] - 0x80000000);
         u8 nb           = XER_STR(m_xer);
         while (nb > 0) {
             if (!MemoryContainsPAddress(storage, destination)) {
@@ -814,7 +815,8 @@ namespace Toolbox::Interpreter {
                 return;
             }
             if (nb < 4) {
-                memcpy(storage.buf<u8>() + destination, &m_gpr[rs++ % 32], nb);
+                storage.writeBytes(reinterpret_cast<const char *>(&m_gpr[rs++ % 32]), destination,
+                                   nb);
                 destination += 4;
                 nb = 0;
             } else {
@@ -1653,7 +1655,7 @@ namespace Toolbox::Interpreter {
 
     // External control
 
-    void FixedPointProcessor::eciwx(u8 rt, u8 ra, u8 rb, Buffer &storage) { m_gpr[rt] = 0; }
-    void FixedPointProcessor::ecowx(u8 rs, u8 ra, u8 rb, Buffer &storage) {}
+    void FixedPointProcessor::eciwx(u8 rt, u8 ra, u8 rb, MemoryStorage &storage) { m_gpr[rt] = 0; }
+    void FixedPointProcessor::ecowx(u8 rs, u8 ra, u8 rb, MemoryStorage &storage) {}
 
 }  // namespace Toolbox::Interpreter
\ No newline at end of file
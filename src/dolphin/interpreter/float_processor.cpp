@@ -722,12 +722,13 @@ namespace Toolbox::Interpreter {
         }
     }  // Anonymous namespace
 
-    void FloatingPointProcessor::lfs(u8 frt, s16 d, u8 ra, Register::GPR gpr[32], Buffer &storage) {
+    void FloatingPointProcessor::lfs(u8 frt, s16 d, u8 ra, Register::GPR gpr[32],
+                                     MemoryStorage &storage) {
         if (!IsRegValid(frt) || !IsRegValid(ra)) {
             m_invalid_cb(PROC_INVALID_MSG(FixedPointProcessor, lfs, "Invalid registers detected!"));
             return;
         }
-        s32 destination = static_cast<s32>(gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
         if ((destination & 0b11)) {
             m_exception_cb(ExceptionCause::EXCEPTION_ALIGNMENT);
             return;
@@ -740,13 +741,13 @@ namespace Toolbox::Interpreter {
     }
 
     void FloatingPointProcessor::lfsu(u8 frt, s16 d, u8 ra, Register::GPR gpr[32],
-                                      Buffer &storage) {
+                                      MemoryStorage &storage) {
         if (!IsRegValid(frt) || !IsRegValid(ra)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, lfsu, "Invalid registers detected!"));
             return;
         }
-        s32 destination = static_cast<s32>(gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
         if ((destination & 0b11)) {
             m_exception_cb(ExceptionCause::EXCEPTION_ALIGNMENT);
             return;
@@ -760,13 +761,13 @@ namespace Toolbox::Interpreter {
     }
 
     void FloatingPointProcessor::lfsx(u8 frt, u8 ra, u8 rb, Register::GPR gpr[32],
-                                      Buffer &storage) {
+                                      MemoryStorage &storage) {
         if (!IsRegValid(frt) || !IsRegValid(ra) || !IsRegValid(rb)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, lfsx, "Invalid registers detected!"));
             return;
         }
-        s32 destination = static_cast<s32>(gpr[ra] + gpr[rb] - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(gpr[ra] + gpr[rb] - 0x80000000) & 0x7FFFFFFF;
         if ((destination & 0b11)) {
             m_exception_cb(ExceptionCause::EXCEPTION_ALIGNMENT);
             return;
@@ -779,13 +780,13 @@ namespace Toolbox::Interpreter {
     }
 
     void FloatingPointProcessor::lfsux(u8 frt, u8 ra, u8 rb, Register::GPR gpr[32],
-                                       Buffer &storage) {
+                                       MemoryStorage &storage) {
         if (!IsRegValid(frt) || !IsRegValid(ra) || !IsRegValid(rb)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, lfsux, "Invalid registers detected!"));
             return;
         }
-        s32 destination = static_cast<s32>(gpr[ra] + gpr[rb] - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(gpr[ra] + gpr[rb] - 0x80000000) & 0x7FFFFFFF;
         if ((destination & 0b11)) {
             m_exception_cb(ExceptionCause::EXCEPTION_ALIGNMENT);
             return;
@@ -798,12 +799,13 @@ namespace Toolbox::Interpreter {
         gpr[ra] += gpr[rb];
     }
 
-    void FloatingPointProcessor::lfd(u8 frt, s16 d, u8 ra, Register::GPR gpr[32], Buffer &storage) {
+    void FloatingPointProcessor::lfd(u8 frt, s16 d, u8 ra, Register::GPR gpr[32],
+                                     MemoryStorage &storage) {
         if (!IsRegValid(frt) || !IsRegValid(ra)) {
             m_invalid_cb(PROC_INVALID_MSG(FixedPointProcessor, lfd, "Invalid registers detected!"));
             return;
         }
-        s32 destination = static_cast<s32>(gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
         if ((destination & 0b11)) {
             m_exception_cb(ExceptionCause::EXCEPTION_ALIGNMENT);
             return;
@@ -816,13 +818,13 @@ namespace Toolbox::Interpreter {
     }
 
     void FloatingPointProcessor::lfdu(u8 frt, s16 d, u8 ra, Register::GPR gpr[32],
-                                      Buffer &storage) {
+                                      MemoryStorage &storage) {
         if (!IsRegValid(frt) || !IsRegValid(ra)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, lfdu, "Invalid registers detected!"));
             return;
         }
-        s32 destination = static_cast<s32>(gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
         if ((destination & 0b11)) {
             m_exception_cb(ExceptionCause::EXCEPTION_ALIGNMENT);
             return;
@@ -836,13 +838,13 @@ namespace Toolbox::Interpreter {
     }
 
     void FloatingPointProcessor::lfdx(u8 frt, u8 ra, u8 rb, Register::GPR gpr[32],
-                                      Buffer &storage) {
+                                      MemoryStorage &storage) {
         if (!IsRegValid(frt) || !IsRegValid(ra) || !IsRegValid(rb)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, lfdx, "Invalid registers detected!"));
             return;
         }
-        s32 destination = static_cast<s32>(gpr[ra] + gpr[rb] - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(gpr[ra] + gpr[rb] - 0x80000000) & 0x7FFFFFFF;
         if ((destination & 0b11)) {
             m_exception_cb(ExceptionCause::EXCEPTION_ALIGNMENT);
             return;
@@ -855,13 +857,13 @@ namespace Toolbox::Interpreter {
     }
 
     void FloatingPointProcessor::lfdux(u8 frt, u8 ra, u8 rb, Register::GPR gpr[32],
-                                       Buffer &storage) {
+                                       MemoryStorage &storage) {
         if (!IsRegValid(frt) || !IsRegValid(ra) || !IsRegValid(rb)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, lfdux, "Invalid registers detected!"));
             return;
         }
-        s32 destination = static_cast<s32>(gpr[ra] + gpr[rb] - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(gpr[ra] + gpr[rb] - 0x80000000) & 0x7FFFFFFF;
         if ((destination & 0b11)) {
             m_exception_cb(ExceptionCause::EXCEPTION_ALIGNMENT);
             return;
@@ -875,13 +877,13 @@ namespace Toolbox::Interpreter {
     }
 
     void FloatingPointProcessor::stfs(u8 frs, s16 d, u8 ra, Register::GPR gpr[32],
-                                      Buffer &storage) {
+                                      MemoryStorage &storage) {
         if (!IsRegValid(frs) || !IsRegValid(ra)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, stfs, "Invalid registers detected!"));
             return;
         }
-        s32 destination = static_cast<s32>(gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
         if ((destination & 0b11)) {
             m_exception_cb(ExceptionCause::EXCEPTION_ALIGNMENT);
             return;
@@ -894,13 +896,13 @@ namespace Toolbox::Interpreter {
     }
 
     void FloatingPointProcessor::stfsu(u8 frs, s16 d, u8 ra, Register::GPR gpr[32],
-                                       Buffer &storage) {
+                                       MemoryStorage &storage) {
         if (!IsRegValid(frs) || !IsRegValid(ra)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, stfsu, "Invalid registers detected!"));
             return;
         }
-        s32 destination = static_cast<s32>(gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
         if ((destination & 0b11)) {
             m_exception_cb(ExceptionCause::EXCEPTION_ALIGNMENT);
             return;
@@ -914,13 +916,13 @@ namespace Toolbox::Interpreter {
     }
 
     void FloatingPointProcessor::stfsx(u8 frs, u8 ra, u8 rb, Register::GPR gpr[32],
-                                       Buffer &storage) {
+                                       MemoryStorage &storage) {
         if (!IsRegValid(frs) || !IsRegValid(ra) || !IsRegValid(rb)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, stfsx, "Invalid registers detected!"));
             return;
         }
-        s32 destination = static_cast<s32>(gpr[ra] + gpr[rb] - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(gpr[ra] + gpr[rb] - 0x80000000) & 0x7FFFFFFF;
         if ((destination & 0b11)) {
             m_exception_cb(ExceptionCause::EXCEPTION_ALIGNMENT);
             return;
@@ -933,13 +935,13 @@ namespace Toolbox::Interpreter {
     }
 
     void FloatingPointProcessor::stfsux(u8 frs, u8 ra, u8 rb, Register::GPR gpr[32],
-                                        Buffer &storage) {
+                                        MemoryStorage &storage) {
         if (!IsRegValid(frs) || !IsRegValid(ra) || !IsRegValid(rb)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, stfsux, "Invalid registers detected!"));
             return;
         }
-        s32 destination = static_cast<s32>(gpr[ra] + gpr[rb] - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(gpr[ra] + gpr[rb] - 0x80000000) & 0x7FFFFFFF;
         if ((destination & 0b11)) {
             m_exception_cb(ExceptionCause::EXCEPTION_ALIGNMENT);
             return;
@@ -953,13 +955,13 @@ namespace Toolbox::Interpreter {
     }
 
     void FloatingPointProcessor::stfd(u8 frs, s16 d, u8 ra, Register::GPR gpr[32],
-                                      Buffer &storage) {
+                                      MemoryStorage &storage) {
         if (!IsRegValid(frs) || !IsRegValid(ra)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, stfsux, "Invalid registers detected!"));
             return;
         }
-        s32 destination = static_cast<s32>(gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
         if ((destination & 0b11)) {
             m_exception_cb(ExceptionCause::EXCEPTION_ALIGNMENT);
             return;
@@ -972,13 +974,13 @@ namespace Toolbox::Interpreter {
     }
 
     void FloatingPointProcessor::stfdu(u8 frs, s16 d, u8 ra, Register::GPR gpr[32],
-                                       Buffer &storage) {
+                                       MemoryStorage &storage) {
         if (!IsRegValid(frs) || !IsRegValid(ra)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, stfsux, "Invalid registers detected!"));
             return;
         }
-        s32 destination = static_cast<s32>(gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(gpr[ra] + d - 0x80000000) & 0x7FFFFFFF;
         if ((destination & 0b11)) {
             m_exception_cb(ExceptionCause::EXCEPTION_ALIGNMENT);
             return;
@@ -992,13 +994,13 @@ namespace Toolbox::Interpreter {
     }
 
     void FloatingPointProcessor::stfdx(u8 frs, u8 ra, u8 rb, Register::GPR gpr[32],
-                                       Buffer &storage) {
+                                       MemoryStorage &storage) {
         if (!IsRegValid(frs) || !IsRegValid(ra) || !IsRegValid(rb)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, stfsux, "Invalid registers detected!"));
             return;
         }
-        s32 destination = static_cast<s32>(gpr[ra] + gpr[rb] - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(gpr[ra] + gpr[rb] - 0x80000000) & 0x7FFFFFFF;
         if ((destination & 0b11)) {
             m_exception_cb(ExceptionCause::EXCEPTION_ALIGNMENT);
             return;
@@ -1011,13 +1013,13 @@ namespace Toolbox::Interpreter {
     }
 
     void FloatingPointProcessor::stfdux(u8 frs, u8 ra, u8 rb, Register::GPR gpr[32],
-                                        Buffer &storage) {
+                                        MemoryStorage &storage) {
         if (!IsRegValid(frs) || !IsRegValid(ra) || !IsRegValid(rb)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, stfsux, "Invalid registers detected!"));
             return;
         }
-        s32 destination = static_cast<s32>(gpr[ra] + gpr[rb] - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(gpr[ra] + gpr[rb] - 0x80000000) & 0x7FFFFFFF;
         if ((destination & 0b11)) {
             m_exception_cb(ExceptionCause::EXCEPTION_ALIGNMENT);
             return;
@@ -1031,13 +1033,13 @@ namespace Toolbox::Interpreter {
     }
 
     void FloatingPointProcessor::stfiwx(u8 frs, u8 ra, u8 rb, Register::GPR gpr[32],
-                                        Buffer &storage) {
+                                        MemoryStorage &storage) {
         if (!IsRegValid(frs) || !IsRegValid(ra) || !IsRegValid(rb)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, stfsux, "Invalid registers detected!"));
             return;
         }
-        s32 destination = static_cast<s32>(gpr[ra] + gpr[rb] - 0x80000000) & 0x7FFFFFFF;
+        u32 destination = static_cast<u32>(gpr[ra] + gpr[rb] - 0x80000000) & 0x7FFFFFFF;
         if ((destination & 0b11)) {
             m_exception_cb(ExceptionCause::EXCEPTION_ALIGNMENT);
             return;
@@ -1744,67 +1746,67 @@ namespace Toolbox::Interpreter {
         return SType(std::clamp(conv_ps, min, max));
     }
 
-    template <typename T> static T ReadUnpaired(Buffer &storage, u32 addr);
+    template <typename T> static T ReadUnpaired(MemoryStorage &storage, u32 addr);
 
-    template <> u8 ReadUnpaired<u8>(Buffer &storage, u32 addr) {
+    template <> u8 ReadUnpaired<u8>(MemoryStorage &storage, u32 addr) {
         return storage.get<u8>(addr - 0x80000000);
     }
 
-    template <> u16 ReadUnpaired<u16>(Buffer &storage, u32 addr) {
+    template <> u16 ReadUnpaired<u16>(MemoryStorage &storage, u32 addr) {
         return storage.get<u16>(addr - 0x80000000);
     }
 
-    template <> u32 ReadUnpaired<u32>(Buffer &storage, u32 addr) {
+    template <> u32 ReadUnpaired<u32>(MemoryStorage &storage, u32 addr) {
         return storage.get<u32>(addr - 0x80000000);
     }
 
-    template <typename T> static std::pair<T, T> ReadPair(Buffer &storage, u32 addr);
+    template <typename T> static std::pair<T, T> ReadPair(MemoryStorage &storage, u32 addr);
 
-    template <> std::pair<u8, u8> ReadPair<u8>(Buffer &storage, u32 addr) {
+    template <> std::pair<u8, u8> ReadPair<u8>(MemoryStorage &storage, u32 addr) {
         const u16 val = std::byteswap(storage.get<u16>(addr - 0x80000000));
         return {u8(val >> 8), u8(val)};
     }
 
-    template <> std::pair<u16, u16> ReadPair<u16>(Buffer &storage, u32 addr) {
+    template <> std::pair<u16, u16> ReadPair<u16>(MemoryStorage &storage, u32 addr) {
         const u32 val = std::byteswap(storage.get<u32>(addr - 0x80000000));
         return {u16(val >> 16), u16(val)};
     }
 
-    template <> std::pair<u32, u32> ReadPair<u32>(Buffer &storage, u32 addr) {
+    template <> std::pair<u32, u32> ReadPair<u32>(MemoryStorage &storage, u32 addr) {
         const u64 val = std::byteswap(storage.get<u64>(addr - 0x80000000));
         return {u32(val >> 32), u32(val)};
     }
 
-    template <typename T> static void WriteUnpaired(Buffer &storage, T val, u32 addr);
+    template <typename T> static void WriteUnpaired(MemoryStorage &storage, T val, u32 addr);
 
-    template <> void WriteUnpaired<u8>(Buffer &storage, u8 val, u32 addr) {
+    template <> void WriteUnpaired<u8>(MemoryStorage &storage, u8 val, u32 addr) {
         storage.set<u8>(addr - 0x80000000, val);
     }
 
-    template <> void WriteUnpaired<u16>(Buffer &storage, u16 val, u32 addr) {
+    template <> void WriteUnpaired<u16>(MemoryStorage &storage, u16 val, u32 addr) {
         storage.set<u16>(addr - 0x80000000, std::byteswap(val));
     }
 
-    template <> void WriteUnpaired<u32>(Buffer &storage, u32 val, u32 addr) {
+    template <> void WriteUnpaired<u32>(MemoryStorage &storage, u32 val, u32 addr) {
         storage.set<u32>(addr - 0x80000000, std::byteswap(val));
     }
 
-    template <typename T> static void WritePair(Buffer &storage, T val1, T val2, u32 addr);
+    template <typename T> static void WritePair(MemoryStorage &storage, T val1, T val2, u32 addr);
 
-    template <> void WritePair<u8>(Buffer &storage, u8 val1, u8 val2, u32 addr) {
+    template <> void WritePair<u8>(MemoryStorage &storage, u8 val1, u8 val2, u32 addr) {
         storage.set<u16>(addr - 0x80000000, std::byteswap((u16{val1} << 8) | u16{val2}));
     }
 
-    template <> void WritePair<u16>(Buffer &storage, u16 val1, u16 val2, u32 addr) {
+    template <> void WritePair<u16>(MemoryStorage &storage, u16 val1, u16 val2, u32 addr) {
         storage.set<u32>(addr - 0x80000000, std::byteswap((u32{val1} << 16) | u32{val2}));
     }
 
-    template <> void WritePair<u32>(Buffer &storage, u32 val1, u32 val2, u32 addr) {
+    template <> void WritePair<u32>(MemoryStorage &storage, u32 val1, u32 val2, u32 addr) {
         storage.set<u64>(addr - 0x80000000, std::byteswap((u64{val1} << 32) | u64{val2}));
     }
 
     template <typename T>
-    void QuantizeAndStore(Buffer &storage, double ps0, double ps1, u32 addr, u32 instW,
+    void QuantizeAndStore(MemoryStorage &storage, double ps0, double ps1, u32 addr, u32 instW,
                           u32 st_scale) {
         using U = std::make_unsigned_t<T>;
 
@@ -1817,8 +1819,8 @@ namespace Toolbox::Interpreter {
         }
     }
 
-    void FloatingPointProcessor::helperQuantize(Buffer &storage, u32 addr, u32 instI, u32 instRS,
-                                                u32 instW) {
+    void FloatingPointProcessor::helperQuantize(MemoryStorage &storage, u32 addr, u32 instI,
+                                                u32 instRS, u32 instW) {
         if (!MemoryContainsVAddress(storage, addr)) {
             m_exception_cb(ExceptionCause::EXCEPTION_DSI);
             return;
@@ -1872,7 +1874,7 @@ namespace Toolbox::Interpreter {
     }
 
     template <typename T>
-    std::pair<double, double> LoadAndDequantize(Buffer &storage, u32 addr, u32 instW,
+    std::pair<double, double> LoadAndDequantize(MemoryStorage &storage, u32 addr, u32 instW,
                                                 u32 ld_scale) {
         using U = std::make_unsigned_t<T>;
 
@@ -1890,8 +1892,8 @@ namespace Toolbox::Interpreter {
         return {static_cast<double>(ps0), static_cast<double>(ps1)};
     }
 
-    void FloatingPointProcessor::helperDequantize(Buffer &storage, u32 addr, u32 instI, u32 instRD,
-                                                  u32 instW) {
+    void FloatingPointProcessor::helperDequantize(MemoryStorage &storage, u32 addr, u32 instI,
+                                                  u32 instRD, u32 instW) {
         if (!MemoryContainsVAddress(storage, addr)) {
             m_exception_cb(ExceptionCause::EXCEPTION_DSI);
             return;
@@ -1945,7 +1947,7 @@ namespace Toolbox::Interpreter {
     }
 
     void FloatingPointProcessor::ps_l(u8 frt, s16 d, u8 i, u8 ra, u8 w, Register::GPR gpr[32],
-                                      Buffer &storage) {
+                                      MemoryStorage &storage) {
         if (!IsRegValid(frt) || !IsRegValid(ra)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, ps_l, "Invalid registers detected!"));
@@ -1956,7 +1958,7 @@ namespace Toolbox::Interpreter {
     }
 
     void FloatingPointProcessor::ps_lu(u8 frt, s16 d, u8 i, u8 ra, u8 w, Register::GPR gpr[32],
-                                       Buffer &storage) {
+                                       MemoryStorage &storage) {
         if (!IsRegValid(frt) || !IsRegValid(ra)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, ps_lu, "Invalid registers detected!"));
@@ -1968,7 +1970,7 @@ namespace Toolbox::Interpreter {
     }
 
     void FloatingPointProcessor::ps_lx(u8 frt, u8 ix, u8 ra, u8 rb, u8 wx, Register::GPR gpr[32],
-                                       Buffer &storage) {
+                                       MemoryStorage &storage) {
         if (!IsRegValid(frt) || !IsRegValid(ra) || !IsRegValid(rb)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, ps_lx, "Invalid registers detected!"));
@@ -1979,7 +1981,7 @@ namespace Toolbox::Interpreter {
     }
 
     void FloatingPointProcessor::ps_lux(u8 frt, u8 ix, u8 ra, u8 rb, u8 wx, Register::GPR gpr[32],
-                                        Buffer &storage) {
+                                        MemoryStorage &storage) {
         if (!IsRegValid(frt) || !IsRegValid(ra) || !IsRegValid(rb)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, ps_lux, "Invalid registers detected!"));
@@ -1991,7 +1993,7 @@ namespace Toolbox::Interpreter {
     }
 
     void FloatingPointProcessor::ps_st(u8 frt, s16 d, u8 i, u8 ra, u8 w, Register::GPR gpr[32],
-                                       Buffer &storage) {
+                                       MemoryStorage &storage) {
         if (!IsRegValid(frt) || !IsRegValid(ra)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, ps_st, "Invalid registers detected!"));
@@ -2002,7 +2004,7 @@ namespace Toolbox::Interpreter {
     }
 
     void FloatingPointProcessor::ps_stu(u8 frt, s16 d, u8 i, u8 ra, u8 w, Register::GPR gpr[32],
-                                        Buffer &storage) {
+                                        MemoryStorage &storage) {
         if (!IsRegValid(frt) || !IsRegValid(ra)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, ps_stu, "Invalid registers detected!"));
@@ -2014,7 +2016,7 @@ namespace Toolbox::Interpreter {
     }
 
     void FloatingPointProcessor::ps_stx(u8 frt, u8 ix, u8 ra, u8 rb, u8 wx, Register::GPR gpr[32],
-                                        Buffer &storage) {
+                                        MemoryStorage &storage) {
         if (!IsRegValid(frt) || !IsRegValid(ra) || !IsRegValid(rb)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, ps_stx, "Invalid registers detected!"));
@@ -2025,7 +2027,7 @@ namespace Toolbox::Interpreter {
     }
 
     void FloatingPointProcessor::ps_stux(u8 frt, u8 ix, u8 ra, u8 rb, u8 wx, Register::GPR gpr[32],
-                                         Buffer &storage) {
+                                         MemoryStorage &storage) {
         if (!IsRegValid(frt) || !IsRegValid(ra) || !IsRegValid(rb)) {
             m_invalid_cb(
                 PROC_INVALID_MSG(FixedPointProcessor, ps_stux, "Invalid registers detected!"));
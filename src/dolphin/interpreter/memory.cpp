@@ -0,0 +1,171 @@
+#include <algorithm>
+
+#include "dolphin/interpreter/memory.hpp"
+
+namespace Toolbox::Interpreter {
+
+    namespace {
+        // Backing for pages of detached storage that have never been written
+        const u8 s_zero_page[MemoryStorage::c_page_size] = {};
+    }  // namespace
+
+    void MemoryStorage::initialize(size_t size) {
+        reset();
+        m_size     = size;
+        m_attached = false;
+
+        const size_t page_count = (size + c_page_mask) >> c_page_shift;
+        m_read_pages.assign(page_count, s_zero_page);
+        m_write_pages.assign(page_count, nullptr);
+        m_code_pages.assign(page_count, false);
+        m_code_write_pages.assign(page_count, nullptr);
+    }
+
+    void MemoryStorage::attach(void *view, size_t size) {
+        reset();
+        m_view     = static_cast<u8 *>(view);
+        m_size     = size;
+        m_attached = true;
+        buildPageTables(m_view, true);
+    }
+
+    void MemoryStorage::overlay(const void *view, size_t size) {
+        reset();
+        // The view is never written through in overlay mode
+        m_view     = const_cast<u8 *>(static_cast<const u8 *>(view));
+        m_size     = size;
+        m_attached = false;
+        buildPageTables(m_view, false);
+    }
+
+    void MemoryStorage::reset() {
+        m_view     = nullptr;
+        m_size     = 0;
+        m_attached = false;
+        m_read_pages.clear();
+        m_write_pages.clear();
+        m_private_pages.clear();
+        m_code_pages.clear();
+        m_code_write_pages.clear();
+        m_code_writes.clear();
+    }
+
+    void MemoryStorage::readBytes(char *buf, size_t ofs, size_t size) const {
+        TOOLBOX_CORE_ASSERT(ofs + size <= m_size);
+        while (size > 0) {
+            const size_t page_ofs = ofs & c_page_mask;
+            const size_t chunk    = std::min(size, c_page_size - page_ofs);
+            std::memcpy(buf, m_read_pages[ofs >> c_page_shift] + page_ofs, chunk);
+            buf += chunk;
+            ofs += chunk;
+            size -= chunk;
+        }
+    }
+
+    void MemoryStorage::writeBytes(const char *buf, size_t ofs, size_t size) {
+        TOOLBOX_CORE_ASSERT(ofs + size <= m_size);
+        while (size > 0) {
+            const size_t page_ofs = ofs & c_page_mask;
+            const size_t chunk    = std::min(size, c_page_size - page_ofs);
+            std::memcpy(writablePage(ofs >> c_page_shift) + page_ofs, buf, chunk);
+            buf += chunk;
+            ofs += chunk;
+            size -= chunk;
+        }
+    }
+
+    void MemoryStorage::fill(size_t ofs, u8 value, size_t size) {
+        TOOLBOX_CORE_ASSERT(ofs + size <= m_size);
+        while (size > 0) {
+            const size_t page_ofs = ofs & c_page_mask;
+            const size_t chunk    = std::min(size, c_page_size - page_ofs);
+            std::memset(writablePage(ofs >> c_page_shift) + page_ofs, value, chunk);
+            ofs += chunk;
+            size -= chunk;
+        }
+    }
+
+    void MemoryStorage::protectCodePage(size_t page) {
+        if (m_code_pages[page]) {
+            return;
+        }
+        m_code_pages[page]       = true;
+        m_code_write_pages[page] = std::exchange(m_write_pages[page], nullptr);
+    }
+
+    void MemoryStorage::copyTo(MemoryStorage &other) const {
+        other.reset();
+        other.m_view = m_view;
+        other.m_size = m_size;
+
+        // A copy must never write through to the original's view,
+        // so attached storage becomes an overlay of the same view.
+        other.m_attached    = false;
+        other.m_read_pages  = m_read_pages;
+        other.m_write_pages.assign(m_write_pages.size(), nullptr);
+        other.m_code_pages.assign(m_code_pages.size(), false);
+        other.m_code_write_pages.assign(m_code_write_pages.size(), nullptr);
+        other.m_code_writes = m_code_writes;
+
+        // Privatizing reads from the shared read table, which still
+        // points at our private pages, so this deep copies them.
+        if (!m_attached) {
+            for (size_t page = 0; page < m_write_pages.size(); ++page) {
+                if (m_write_pages[page] || m_code_write_pages[page]) {
+                    other.privatizePage(page);
+                }
+            }
+        }
+
+        // The copy shares our decoded code, so it has to report writes to it too
+        for (size_t page = 0; page < m_code_pages.size(); ++page) {
+            if (m_code_pages[page]) {
+                other.protectCodePage(page);
+            }
+        }
+    }
+
+    void MemoryStorage::buildPageTables(const u8 *view, bool writable) {
+        const size_t page_count = (m_size + c_page_mask) >> c_page_shift;
+        m_read_pages.resize(page_count);
+        m_write_pages.assign(page_count, nullptr);
+        m_code_pages.assign(page_count, false);
+        m_code_write_pages.assign(page_count, nullptr);
+        for (size_t page = 0; page < page_count; ++page) {
+            m_read_pages[page] = view + (page << c_page_shift);
+            if (writable) {
+                m_write_pages[page] = const_cast<u8 *>(m_read_pages[page]);
+            }
+        }
+    }
+
+    u8 *MemoryStorage::acquireWritablePage(size_t page) {
+        if (m_code_pages[page]) {
+            m_code_pages[page] = false;
+            m_code_writes.push_back(page);
+
+            u8 *page_ptr = std::exchange(m_code_write_pages[page], nullptr);
+            if (page_ptr) {
+                m_write_pages[page] = page_ptr;
+                return page_ptr;
+            }
+        }
+        return privatizePage(page);
+    }
+
+    u8 *MemoryStorage::privatizePage(size_t page) {
+        ScopePtr<u8[]> page_buf = make_scoped<u8[]>(c_page_size);
+
+        // The tail page of an unaligned view is shorter than a full page
+        const size_t page_start = page << c_page_shift;
+        const size_t copy_size  = std::min(c_page_size, m_size - page_start);
+        std::memcpy(page_buf.get(), m_read_pages[page], copy_size);
+
+        u8 *page_ptr        = page_buf.get();
+        m_read_pages[page]  = page_ptr;
+        m_write_pages[page] = page_ptr;
+        m_private_pages.emplace_back(std::move(page_buf));
+        return page_ptr;
+    }
+
+}  // namespace Toolbox::Interpreter
@@ -1,21 +1,20 @@
+#include <array>
+#include <utility>
+
 #include "dolphin/interpreter/system.hpp"
 #include "dolphin/interpreter/instructions/forms.hpp"
-#include "dolphin/process.hpp"
-
-#include "gui/application.hpp"
-#include "core/log.hpp"
-
-using namespace Toolbox::Dolphin;
 
 namespace Toolbox::Interpreter {
     SystemDolphin SystemDolphin::CreateDetached() {
         SystemDolphin &&interpreter = SystemDolphin();
-        interpreter.m_storage.alloc(0x1800000);
+        interpreter.m_storage.initialize(0x1800000);
         return interpreter;
     }
 
     SystemDolphin &SystemDolphin::operator=(SystemDolphin &&other) noexcept {
         m_storage             = std::move(other.m_storage);
+        m_block_cache         = std::move(other.m_block_cache);
+        m_block_cache_enabled = other.m_block_cache_enabled;
         m_branch_proc         = std::move(other.m_branch_proc);
         m_fixed_proc          = std::move(other.m_fixed_proc);
         m_float_proc          = std::move(other.m_float_proc);
@@ -34,16 +33,11 @@ namespace Toolbox::Interpreter {
 
     SystemDolphin::SystemDolphin() : m_evaluating(false) { bindCallbacks(); }
 
-    SystemDolphin::SystemDolphin(const Dolphin::DolphinCommunicator &communicator)
-        : m_evaluating(false) {
-        bindCallbacks();
-        m_storage.setBuf(communicator.manager().getMemoryView(),
-                         communicator.manager().getMemorySize());
-    }
-
     SystemDolphin::SystemDolphin(const SystemDolphin &other)
-        : m_storage(other.m_storage), m_branch_proc(other.m_branch_proc),
-          m_fixed_proc(other.m_fixed_proc), m_float_proc(other.m_float_proc),
+        : m_storage(other.m_storage), m_block_cache(other.m_block_cache),
+          m_block_cache_enabled(other.m_block_cache_enabled),
+          m_branch_proc(other.m_branch_proc), m_fixed_proc(other.m_fixed_proc),
+          m_float_proc(other.m_float_proc),
           m_system_proc(other.m_system_proc), m_evaluating(false),
           m_system_return_cb(other.m_system_return_cb),
           m_system_exception_cb(other.m_system_exception_cb),
@@ -52,8 +46,10 @@ namespace Toolbox::Interpreter {
     }
 
     SystemDolphin::SystemDolphin(SystemDolphin &&other) noexcept
-        : m_storage(other.m_storage), m_branch_proc(other.m_branch_proc),
-          m_fixed_proc(other.m_fixed_proc), m_float_proc(other.m_float_proc),
+        : m_storage(std::move(other.m_storage)), m_block_cache(std::move(other.m_block_cache)),
+          m_block_cache_enabled(other.m_block_cache_enabled),
+          m_branch_proc(other.m_branch_proc), m_fixed_proc(other.m_fixed_proc),
+          m_float_proc(other.m_float_proc),
           m_system_proc(other.m_system_proc), m_evaluating(false),
           m_system_return_cb(other.m_system_return_cb),
           m_system_exception_cb(other.m_system_exception_cb),
@@ -89,205 +85,432 @@ namespace Toolbox::Interpreter {
                 m_evaluating = false;
                 break;
             }
-            evaluateInstruction();
+
+            // Code may have been written through the storage since the last run
+            if (m_storage.hasCodeWrites()) [[unlikely]] {
+                invalidateWrittenBlocks();
+            }
+            m_block_cache_invalidated = false;
+
+            const DecodedBlock *block = lookupBlock(static_cast<u32>(m_system_proc.m_pc));
+            if (!block) {
+                internalExceptionCB(ExceptionCause::EXCEPTION_ISI);
+                break;
+            }
+
+            // Run the block until control flow leaves the straight line
+            Register::PC expected_pc = block->m_address;
+            for (size_t i = 0; i < block->m_instructions.size(); ++i) {
+                evaluateInstruction(block->m_instructions[i]);
+                expected_pc += 4;
+
+                if (m_storage.hasCodeWrites()) [[unlikely]] {
+                    invalidateWrittenBlocks();
+                }
+
+                // A store or icbi may have destroyed the block we are running
+                if (m_block_cache_invalidated) {
+                    break;
+                }
+
+                if (!m_evaluating || m_system_proc.m_pc != expected_pc) {
+                    break;
+                }
+            }
         }
     }
 
-    void SystemDolphin::evaluateInstruction() {
-        DolphinCommunicator &communicator = GUIApplication::instance().getDolphinCommunicator();
+    const SystemDolphin::DecodedBlock *SystemDolphin::lookupBlock(u32 address) {
+        const u32 paddress = address & 0x7FFFFFFF;
+        if ((address & 0b11) || !MemoryContainsPAddress(m_storage, paddress)) {
+            return nullptr;
+        }
 
-        u32 inst      = read<u32>((u32)m_system_proc.m_pc);
-        Opcode opcode = FORM_OPCD(inst);
+        if (!m_block_cache_enabled) [[unlikely]] {
+            m_uncached_block = decodeBlock(address, 1);
+            return &m_uncached_block;
+        }
 
-        Register::PC next_instruction = m_system_proc.m_pc + 4;
+        auto block_it = m_block_cache.find(address);
+        if (block_it != m_block_cache.end()) {
+            // Code patched from outside the storage is caught where it is
+            // usually patched, at the entry of the block
+            const u32 inst = std::byteswap<u32>(m_storage.get<u32>(paddress));
+            if (inst == block_it->second.m_instructions.front().m_inst) [[likely]] {
+                m_block_cache_hits += 1;
+                return &block_it->second;
+            }
+            m_block_cache.erase(block_it);
+        }
 
-        switch (opcode) {
-        case Opcode::OP_TWI:
-            m_fixed_proc.twi(FORM_TO(inst), FORM_RA(inst), FORM_SI(inst));
-            break;
-        case Opcode::OP_PAIRED_SINGLE:
-            evaluatePairedSingleSubOp(inst);
-            break;
-        case Opcode::OP_MULLI:
-            m_fixed_proc.mulli(FORM_TO(inst), FORM_RA(inst), FORM_SI(inst));
-            break;
-        case Opcode::OP_SUBFIC:
-            m_fixed_proc.subfic(FORM_TO(inst), FORM_RA(inst), FORM_SI(inst));
-            break;
-        case Opcode::OP_CMPLI:
-            m_fixed_proc.cmpli(FORM_CRFD(inst), FORM_L(inst), FORM_RA(inst), FORM_UI(inst),
-                               m_branch_proc.m_cr);
-            break;
-        case Opcode::OP_CMPI:
-            m_fixed_proc.cmpi(FORM_CRFD(inst), FORM_L(inst), FORM_RA(inst), FORM_SI(inst),
-                              m_branch_proc.m_cr);
-            break;
-        case Opcode::OP_ADDIC:
-        case Opcode::OP_ADDIC_RC:
-            m_fixed_proc.addic(FORM_RS(inst), FORM_RA(inst), FORM_SI(inst), FORM_Rc(inst),
-                               m_branch_proc.m_cr);
-            break;
-        case Opcode::OP_ADDI:
-            m_fixed_proc.addi(FORM_RS(inst), FORM_RA(inst), FORM_SI(inst));
-            break;
-        case Opcode::OP_ADDIS:
-            m_fixed_proc.addis(FORM_RS(inst), FORM_RA(inst), FORM_SI(inst));
-            break;
-        case Opcode::OP_BC:
-            next_instruction -= 4;
-            m_branch_proc.bc(FORM_BD(inst), FORM_BO(inst), FORM_BI(inst), FORM_AA(inst),
-                             FORM_LK(inst), next_instruction);
-            break;
-        case Opcode::OP_SC:
-            m_system_proc.sc(FORM_LEV(inst));
-            break;
-        case Opcode::OP_B:
-            next_instruction -= 4;
-            m_branch_proc.b(FORM_LI(inst), FORM_AA(inst), FORM_LK(inst), next_instruction);
-            break;
-        case Opcode::OP_CONTROL_FLOW:
-            next_instruction = evaluateControlFlowSubOp(inst);
-            break;
-        case Opcode::OP_RLWIMI:
-            m_fixed_proc.rlwimi(FORM_RA(inst), FORM_RS(inst), FORM_SH(inst), FORM_MB(inst),
-                                FORM_ME(inst), FORM_Rc(inst), m_branch_proc.m_cr);
-            break;
-        case Opcode::OP_RLWINM:
-            m_fixed_proc.rlwinm(FORM_RA(inst), FORM_RS(inst), FORM_SH(inst), FORM_MB(inst),
-                                FORM_ME(inst), FORM_Rc(inst), m_branch_proc.m_cr);
-            break;
-        case Opcode::OP_RLWNM:
-            m_fixed_proc.rlwnm(FORM_RA(inst), FORM_RS(inst), FORM_RB(inst), FORM_MB(inst),
-                               FORM_ME(inst), FORM_Rc(inst), m_branch_proc.m_cr);
-            break;
-        case Opcode::OP_ORI:
-            m_fixed_proc.ori(FORM_RA(inst), FORM_RS(inst), FORM_UI(inst));
-            break;
-        case Opcode::OP_ORIS:
-            m_fixed_proc.oris(FORM_RA(inst), FORM_RS(inst), FORM_UI(inst));
-            break;
-        case Opcode::OP_XORI:
-            m_fixed_proc.xori(FORM_RA(inst), FORM_RS(inst), FORM_UI(inst));
-            break;
-        case Opcode::OP_XORIS:
-            m_fixed_proc.xoris(FORM_RA(inst), FORM_RS(inst), FORM_UI(inst));
-            break;
-        case Opcode::OP_ANDI:
-            m_fixed_proc.andi(FORM_RA(inst), FORM_RS(inst), FORM_UI(inst), m_branch_proc.m_cr);
-            break;
-        case Opcode::OP_ANDIS:
-            m_fixed_proc.andis(FORM_RA(inst), FORM_RS(inst), FORM_UI(inst), m_branch_proc.m_cr);
-            break;
-        case Opcode::OP_FIXED:
-            next_instruction = evaluateFixedSubOp(inst);
-            break;
-        case Opcode::OP_LWZ:
-            m_fixed_proc.lwz(FORM_RS(inst), FORM_D(inst), FORM_RA(inst), m_storage);
-            break;
-        case Opcode::OP_LWZU:
-            m_fixed_proc.lwzu(FORM_RS(inst), FORM_D(inst), FORM_RA(inst), m_storage);
-            break;
-        case Opcode::OP_LBZ:
-            m_fixed_proc.lbz(FORM_RS(inst), FORM_D(inst), FORM_RA(inst), m_storage);
-            break;
-        case Opcode::OP_LBZU:
-            m_fixed_proc.lbzu(FORM_RS(inst), FORM_D(inst), FORM_RA(inst), m_storage);
-            break;
-        case Opcode::OP_STW:
-            m_fixed_proc.stw(FORM_RS(inst), FORM_D(inst), FORM_RA(inst), m_storage);
-            break;
-        case Opcode::OP_STWU:
-            m_fixed_proc.stwu(FORM_RS(inst), FORM_D(inst), FORM_RA(inst), m_storage);
-            break;
-        case Opcode::OP_STB:
-            m_fixed_proc.stb(FORM_RS(inst), FORM_D(inst), FORM_RA(inst), m_storage);
-            break;
-        case Opcode::OP_STBU:
-            m_fixed_proc.stbu(FORM_RS(inst), FORM_D(inst), FORM_RA(inst), m_storage);
-            break;
-        case Opcode::OP_LHZ:
-            m_fixed_proc.lhz(FORM_RS(inst), FORM_D(inst), FORM_RA(inst), m_storage);
-            break;
-        case Opcode::OP_LHZU:
-            m_fixed_proc.lhzu(FORM_RS(inst), FORM_D(inst), FORM_RA(inst), m_storage);
-            break;
-        case Opcode::OP_LHA:
-            m_fixed_proc.lha(FORM_RS(inst), FORM_D(inst), FORM_RA(inst), m_storage);
-            break;
-        case Opcode::OP_LHAU:
-            m_fixed_proc.lhau(FORM_RS(inst), FORM_D(inst), FORM_RA(inst), m_storage);
-            break;
-        case Opcode::OP_STH:
-            m_fixed_proc.sth(FORM_RS(inst), FORM_D(inst), FORM_RA(inst), m_storage);
-            break;
-        case Opcode::OP_STHU:
-            m_fixed_proc.sthu(FORM_RS(inst), FORM_D(inst), FORM_RA(inst), m_storage);
-            break;
-        case Opcode::OP_LMW:
-            m_fixed_proc.lmw(FORM_RS(inst), FORM_D(inst), FORM_RA(inst), m_storage);
-            break;
-        case Opcode::OP_STMW:
-            m_fixed_proc.stmw(FORM_RS(inst), FORM_D(inst), FORM_RA(inst), m_storage);
-            break;
-        case Opcode::OP_LFS:
-            m_float_proc.lfs(FORM_FS(inst), FORM_D(inst), FORM_RA(inst), m_fixed_proc.m_gpr,
-                             m_storage);
-            break;
-        case Opcode::OP_LFSU:
-            m_float_proc.lfsu(FORM_FS(inst), FORM_D(inst), FORM_RA(inst), m_fixed_proc.m_gpr,
-                              m_storage);
-            break;
-        case Opcode::OP_LFD:
-            m_float_proc.lfd(FORM_FS(inst), FORM_D(inst), FORM_RA(inst), m_fixed_proc.m_gpr,
-                             m_storage);
-            break;
-        case Opcode::OP_LFDU:
-            m_float_proc.lfdu(FORM_FS(inst), FORM_D(inst), FORM_RA(inst), m_fixed_proc.m_gpr,
-                              m_storage);
-            break;
-        case Opcode::OP_STFS:
-            m_float_proc.stfs(FORM_FS(inst), FORM_D(inst), FORM_RA(inst), m_fixed_proc.m_gpr,
-                              m_storage);
-            break;
-        case Opcode::OP_STFSU:
-            m_float_proc.stfsu(FORM_FS(inst), FORM_D(inst), FORM_RA(inst), m_fixed_proc.m_gpr,
-                               m_storage);
-            break;
-        case Opcode::OP_STFD:
-            m_float_proc.stfd(FORM_FS(inst), FORM_D(inst), FORM_RA(inst), m_fixed_proc.m_gpr,
-                              m_storage);
-            break;
-        case Opcode::OP_STFDU:
-            m_float_proc.stfdu(FORM_FS(inst), FORM_D(inst), FORM_RA(inst), m_fixed_proc.m_gpr,
-                               m_storage);
-            break;
-        case Opcode::OP_PSQ_L:
-            m_float_proc.ps_l(FORM_FS(inst), FORM_D(inst), FORM_I(inst), FORM_RA(inst),
-                              FORM_W(inst), m_fixed_proc.m_gpr, m_storage);
-            break;
-        case Opcode::OP_PSQ_LU:
-            m_float_proc.ps_lu(FORM_FS(inst), FORM_D(inst), FORM_I(inst), FORM_RA(inst),
-                               FORM_W(inst), m_fixed_proc.m_gpr, m_storage);
-            break;
-        case Opcode::OP_FS_MATH:
-            next_instruction = evaluateFloatSingleSubOp(inst);
-            break;
-        case Opcode::OP_PSQ_ST:
-            m_float_proc.ps_st(FORM_FS(inst), FORM_D(inst), FORM_I(inst), FORM_RA(inst),
-                               FORM_W(inst), m_fixed_proc.m_gpr, m_storage);
-            break;
-        case Opcode::OP_PSQ_STU:
-            m_float_proc.ps_stu(FORM_FS(inst), FORM_D(inst), FORM_I(inst), FORM_RA(inst),
-                                FORM_W(inst), m_fixed_proc.m_gpr, m_storage);
-            break;
-        case Opcode::OP_FLOAT:
-            next_instruction = evaluateFloatSubOp(inst);
-            break;
-        default:
-            internalInvalidCB(PROC_INVALID_MSG(SystemDolphin, unknown,
-                                               "Attempted to evaluate unknown instruction!"));
-            break;
+        m_block_cache_misses += 1;
+
+        // Dropping everything is cheaper than tracking use, and
+        // the code a function runs is redecoded within a few calls
+        if (m_block_cache.size() >= c_max_cached_blocks) {
+            m_block_cache.clear();
+        }
+
+        // Stores to the page now take the storage's slow path, which
+        // reports them so the blocks on it can be dropped
+        m_storage.protectCodePage(paddress >> MemoryStorage::c_page_shift);
+
+        auto [new_it, _] = m_block_cache.emplace(address, decodeBlock(address));
+        return &new_it->second;
+    }
+
+    SystemDolphin::DecodedBlock SystemDolphin::decodeBlock(u32 address,
+                                                           size_t max_length) const {
+        DecodedBlock block;
+        block.m_address = address;
+
+        // Blocks never straddle a page so a store to one page can't invalidate two
+        const u32 page_end = (address | MemoryStorage::c_page_mask) + 1;
+        const u32 phys_end =
+            std::min<u32>(0x80000000 + static_cast<u32>(m_storage.size()), page_end);
+
+        for (u32 pc = address;
+             pc < phys_end && block.m_instructions.size() < max_length; pc += 4) {
+            u32 inst      = std::byteswap<u32>(m_storage.get<u32>(pc & 0x7FFFFFFF));
+            Opcode opcode = FORM_OPCD(inst);
+
+            block.m_instructions.push_back({inst, GetHandler(opcode)});
+
+            if (opcode == Opcode::OP_B || opcode == Opcode::OP_BC || opcode == Opcode::OP_SC ||
+                opcode == Opcode::OP_CONTROL_FLOW) {
+                break;
+            }
+        }
+
+        return block;
+    }
+
+    void SystemDolphin::invalidateBlocks(u32 address) {
+        const size_t page = (address & 0x7FFFFFFF) >> MemoryStorage::c_page_shift;
+        std::erase_if(m_block_cache, [page](const auto &item) {
+            return ((item.first & 0x7FFFFFFF) >> MemoryStorage::c_page_shift) == page;
+        });
+        m_block_cache_invalidated = true;
+    }
+
+    void SystemDolphin::invalidateWrittenBlocks() {
+        for (size_t page : m_storage.takeCodeWrites()) {
+            invalidateBlocks(static_cast<u32>(page << MemoryStorage::c_page_shift));
         }
+    }
+
+    // Unknown primary opcodes end up here
+    template <Opcode _Op>
+    void SystemDolphin::evaluateOp(u32 inst, Register::PC &next_instruction) {
+        internalInvalidCB(PROC_INVALID_MSG(SystemDolphin, unknown,
+                                           "Attempted to evaluate unknown instruction!"));
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_TWI>(u32 inst, Register::PC &next_instruction) {
+        m_fixed_proc.twi(FORM_TO(inst), FORM_RA(inst), FORM_SI(inst));
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_PAIRED_SINGLE>(u32 inst,
+                                                             Register::PC &next_instruction) {
+        evaluatePairedSingleSubOp(inst);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_MULLI>(u32 inst, Register::PC &next_instruction) {
+        m_fixed_proc.mulli(FORM_TO(inst), FORM_RA(inst), FORM_SI(inst));
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_SUBFIC>(u32 inst, Register::PC &next_instruction) {
+        m_fixed_proc.subfic(FORM_TO(inst), FORM_RA(inst), FORM_SI(inst));
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_CMPLI>(u32 inst, Register::PC &next_instruction) {
+        m_fixed_proc.cmpli(FORM_CRFD(inst), FORM_L(inst), FORM_RA(inst), FORM_UI(inst),
+                           m_branch_proc.m_cr);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_CMPI>(u32 inst, Register::PC &next_instruction) {
+        m_fixed_proc.cmpi(FORM_CRFD(inst), FORM_L(inst), FORM_RA(inst), FORM_SI(inst),
+                          m_branch_proc.m_cr);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_ADDIC>(u32 inst, Register::PC &next_instruction) {
+        m_fixed_proc.addic(FORM_RS(inst), FORM_RA(inst), FORM_SI(inst), FORM_Rc(inst),
+                           m_branch_proc.m_cr);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_ADDIC_RC>(u32 inst, Register::PC &next_instruction) {
+        evaluateOp<Opcode::OP_ADDIC>(inst, next_instruction);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_ADDI>(u32 inst, Register::PC &next_instruction) {
+        m_fixed_proc.addi(FORM_RS(inst), FORM_RA(inst), FORM_SI(inst));
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_ADDIS>(u32 inst, Register::PC &next_instruction) {
+        m_fixed_proc.addis(FORM_RS(inst), FORM_RA(inst), FORM_SI(inst));
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_BC>(u32 inst, Register::PC &next_instruction) {
+        next_instruction -= 4;
+        m_branch_proc.bc(FORM_BD(inst), FORM_BO(inst), FORM_BI(inst), FORM_AA(inst),
+                         FORM_LK(inst), next_instruction);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_SC>(u32 inst, Register::PC &next_instruction) {
+        m_system_proc.sc(FORM_LEV(inst));
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_B>(u32 inst, Register::PC &next_instruction) {
+        next_instruction -= 4;
+        m_branch_proc.b(FORM_LI(inst), FORM_AA(inst), FORM_LK(inst), next_instruction);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_CONTROL_FLOW>(u32 inst,
+                                                            Register::PC &next_instruction) {
+        next_instruction = evaluateControlFlowSubOp(inst);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_RLWIMI>(u32 inst, Register::PC &next_instruction) {
+        m_fixed_proc.rlwimi(FORM_RA(inst), FORM_RS(inst), FORM_SH(inst), FORM_MB(inst),
+                            FORM_ME(inst), FORM_Rc(inst), m_branch_proc.m_cr);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_RLWINM>(u32 inst, Register::PC &next_instruction) {
+        m_fixed_proc.rlwinm(FORM_RA(inst), FORM_RS(inst), FORM_SH(inst), FORM_MB(inst),
+                            FORM_ME(inst), FORM_Rc(inst), m_branch_proc.m_cr);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_RLWNM>(u32 inst, Register::PC &next_instruction) {
+        m_fixed_proc.rlwnm(FORM_RA(inst), FORM_RS(inst), FORM_RB(inst), FORM_MB(inst),
+                           FORM_ME(inst), FORM_Rc(inst), m_branch_proc.m_cr);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_ORI>(u32 inst, Register::PC &next_instruction) {
+        m_fixed_proc.ori(FORM_RA(inst), FORM_RS(inst), FORM_UI(inst));
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_ORIS>(u32 inst, Register::PC &next_instruction) {
+        m_fixed_proc.oris(FORM_RA(inst), FORM_RS(inst), FORM_UI(inst));
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_XORI>(u32 inst, Register::PC &next_instruction) {
+        m_fixed_proc.xori(FORM_RA(inst), FORM_RS(inst), FORM_UI(inst));
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_XORIS>(u32 inst, Register::PC &next_instruction) {
+        m_fixed_proc.xoris(FORM_RA(inst), FORM_RS(inst), FORM_UI(inst));
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_ANDI>(u32 inst, Register::PC &next_instruction) {
+        m_fixed_proc.andi(FORM_RA(inst), FORM_RS(inst), FORM_UI(inst), m_branch_proc.m_cr);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_ANDIS>(u32 inst, Register::PC &next_instruction) {
+        m_fixed_proc.andis(FORM_RA(inst), FORM_RS(inst), FORM_UI(inst), m_branch_proc.m_cr);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_FIXED>(u32 inst, Register::PC &next_instruction) {
+        next_instruction = evaluateFixedSubOp(inst);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_LWZ>(u32 inst, Register::PC &next_instruction) {
+        m_fixed_proc.lwz(FORM_RS(inst), FORM_D(inst), FORM_RA(inst), m_storage);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_LWZU>(u32 inst, Register::PC &next_instruction) {
+        m_fixed_proc.lwzu(FORM_RS(inst), FORM_D(inst), FORM_RA(inst), m_storage);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_LBZ>(u32 inst, Register::PC &next_instruction) {
+        m_fixed_proc.lbz(FORM_RS(inst), FORM_D(inst), FORM_RA(inst), m_storage);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_LBZU>(u32 inst, Register::PC &next_instruction) {
+        m_fixed_proc.lbzu(FORM_RS(inst), FORM_D(inst), FORM_RA(inst), m_storage);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_STW>(u32 inst, Register::PC &next_instruction) {
+        m_fixed_proc.stw(FORM_RS(inst), FORM_D(inst), FORM_RA(inst), m_storage);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_STWU>(u32 inst, Register::PC &next_instruction) {
+        m_fixed_proc.stwu(FORM_RS(inst), FORM_D(inst), FORM_RA(inst), m_storage);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_STB>(u32 inst, Register::PC &next_instruction) {
+        m_fixed_proc.stb(FORM_RS(inst), FORM_D(inst), FORM_RA(inst), m_storage);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_STBU>(u32 inst, Register::PC &next_instruction) {
+        m_fixed_proc.stbu(FORM_RS(inst), FORM_D(inst), FORM_RA(inst), m_storage);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_LHZ>(u32 inst, Register::PC &next_instruction) {
+        m_fixed_proc.lhz(FORM_RS(inst), FORM_D(inst), FORM_RA(inst), m_storage);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_LHZU>(u32 inst, Register::PC &next_instruction) {
+        m_fixed_proc.lhzu(FORM_RS(inst), FORM_D(inst), FORM_RA(inst), m_storage);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_LHA>(u32 inst, Register::PC &next_instruction) {
+        m_fixed_proc.lha(FORM_RS(inst), FORM_D(inst), FORM_RA(inst), m_storage);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_LHAU>(u32 inst, Register::PC &next_instruction) {
+        m_fixed_proc.lhau(FORM_RS(inst), FORM_D(inst), FORM_RA(inst), m_storage);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_STH>(u32 inst, Register::PC &next_instruction) {
+        m_fixed_proc.sth(FORM_RS(inst), FORM_D(inst), FORM_RA(inst), m_storage);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_STHU>(u32 inst, Register::PC &next_instruction) {
+        m_fixed_proc.sthu(FORM_RS(inst), FORM_D(inst), FORM_RA(inst), m_storage);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_LMW>(u32 inst, Register::PC &next_instruction) {
+        m_fixed_proc.lmw(FORM_RS(inst), FORM_D(inst), FORM_RA(inst), m_storage);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_STMW>(u32 inst, Register::PC &next_instruction) {
+        m_fixed_proc.stmw(FORM_RS(inst), FORM_D(inst), FORM_RA(inst), m_storage);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_LFS>(u32 inst, Register::PC &next_instruction) {
+        m_float_proc.lfs(FORM_FS(inst), FORM_D(inst), FORM_RA(inst), m_fixed_proc.m_gpr,
+                         m_storage);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_LFSU>(u32 inst, Register::PC &next_instruction) {
+        m_float_proc.lfsu(FORM_FS(inst), FORM_D(inst), FORM_RA(inst), m_fixed_proc.m_gpr,
+                          m_storage);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_LFD>(u32 inst, Register::PC &next_instruction) {
+        m_float_proc.lfd(FORM_FS(inst), FORM_D(inst), FORM_RA(inst), m_fixed_proc.m_gpr,
+                         m_storage);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_LFDU>(u32 inst, Register::PC &next_instruction) {
+        m_float_proc.lfdu(FORM_FS(inst), FORM_D(inst), FORM_RA(inst), m_fixed_proc.m_gpr,
+                          m_storage);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_STFS>(u32 inst, Register::PC &next_instruction) {
+        m_float_proc.stfs(FORM_FS(inst), FORM_D(inst), FORM_RA(inst), m_fixed_proc.m_gpr,
+                          m_storage);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_STFSU>(u32 inst, Register::PC &next_instruction) {
+        m_float_proc.stfsu(FORM_FS(inst), FORM_D(inst), FORM_RA(inst), m_fixed_proc.m_gpr,
+                           m_storage);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_STFD>(u32 inst, Register::PC &next_instruction) {
+        m_float_proc.stfd(FORM_FS(inst), FORM_D(inst), FORM_RA(inst), m_fixed_proc.m_gpr,
+                          m_storage);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_STFDU>(u32 inst, Register::PC &next_instruction) {
+        m_float_proc.stfdu(FORM_FS(inst), FORM_D(inst), FORM_RA(inst), m_fixed_proc.m_gpr,
+                           m_storage);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_PSQ_L>(u32 inst, Register::PC &next_instruction) {
+        m_float_proc.ps_l(FORM_FS(inst), FORM_D(inst), FORM_I(inst), FORM_RA(inst),
+                          FORM_W(inst), m_fixed_proc.m_gpr, m_storage);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_PSQ_LU>(u32 inst, Register::PC &next_instruction) {
+        m_float_proc.ps_lu(FORM_FS(inst), FORM_D(inst), FORM_I(inst), FORM_RA(inst),
+                           FORM_W(inst), m_fixed_proc.m_gpr, m_storage);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_FS_MATH>(u32 inst, Register::PC &next_instruction) {
+        next_instruction = evaluateFloatSingleSubOp(inst);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_PSQ_ST>(u32 inst, Register::PC &next_instruction) {
+        m_float_proc.ps_st(FORM_FS(inst), FORM_D(inst), FORM_I(inst), FORM_RA(inst),
+                           FORM_W(inst), m_fixed_proc.m_gpr, m_storage);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_PSQ_STU>(u32 inst, Register::PC &next_instruction) {
+        m_float_proc.ps_stu(FORM_FS(inst), FORM_D(inst), FORM_I(inst), FORM_RA(inst),
+                            FORM_W(inst), m_fixed_proc.m_gpr, m_storage);
+    }
+
+    template <>
+    void SystemDolphin::evaluateOp<Opcode::OP_FLOAT>(u32 inst, Register::PC &next_instruction) {
+        next_instruction = evaluateFloatSubOp(inst);
+    }
+
+    SystemDolphin::instruction_handler_t SystemDolphin::GetHandler(Opcode opcode) {
+        static constexpr auto s_handlers = []<size_t... _Is>(std::index_sequence<_Is...>) {
+            return std::array<instruction_handler_t, 64>{
+                &SystemDolphin::evaluateOp<static_cast<Opcode>(_Is)>...};
+        }(std::make_index_sequence<64>());
+        return s_handlers[static_cast<u8>(opcode)];
+    }
+
+    void SystemDolphin::evaluateInstruction(const DecodedInstruction &instr) {
+        Register::PC next_instruction = m_system_proc.m_pc + 4;
+
+        (this->*instr.m_handler)(instr.m_inst, next_instruction);
 
         m_system_proc.m_last_pc = m_system_proc.m_pc;
         m_system_proc.m_pc      = next_instruction;
@@ -839,9 +1062,13 @@ namespace Toolbox::Interpreter {
         case TableSubOpcode31::SYNC:
             m_system_proc.sync((SyncType)FORM_I(inst));
             break;
-        case TableSubOpcode31::ICBI:
+        case TableSubOpcode31::ICBI: {
             m_system_proc.icbi(FORM_RA(inst), FORM_RB(inst), m_storage);
+            u32 ra_value =
+                FORM_RA(inst) == 0 ? 0 : static_cast<u32>(m_fixed_proc.m_gpr[FORM_RA(inst)]);
+            invalidateBlocks(ra_value + static_cast<u32>(m_fixed_proc.m_gpr[FORM_RB(inst)]));
             break;
+        }
         case TableSubOpcode31::ECIWX:
             m_fixed_proc.eciwx(FORM_RD(inst), FORM_RA(inst), FORM_RB(inst), m_storage);
             break;
@@ -0,0 +1,341 @@
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#include "dolphin/sharedmem.hpp"
+
+#ifdef TOOLBOX_PLATFORM_WINDOWS
+#include <tlhelp32.h>
+#elif defined(TOOLBOX_PLATFORM_LINUX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace Toolbox::Dolphin {
+
+#ifdef TOOLBOX_PLATFORM_WINDOWS
+
+    Result<Platform::ProcessID, BaseError> FindProcessPID(std::string_view process_name) {
+        std::string process_file = std::string(process_name) + ".exe";
+
+        Platform::LowHandle hSnapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+        if (hSnapshot == INVALID_HANDLE_VALUE) {
+            return make_error<Platform::ProcessID>(std::format(
+                "(PROCESS) Failed to create snapshot to find process \"{}\".", process_file));
+        }
+
+        PROCESSENTRY32 pe32;
+        pe32.dwSize = sizeof(PROCESSENTRY32);
+
+        if (!Process32First(hSnapshot, &pe32)) {
+            CloseHandle(hSnapshot);
+            return make_error<Platform::ProcessID>(
+                "(PROCESS) Failed to retrieve first process entry!");
+        }
+
+        Platform::ProcessID pid = std::numeric_limits<Platform::ProcessID>::max();
+        do {
+            if (strcmp(pe32.szExeFile, process_file.data()) == 0) {
+                // Sometimes dead processes are still in the list
+                if (pe32.cntThreads == 0) {
+                    continue;
+                }
+                pid = pe32.th32ProcessID;
+                break;
+            }
+        } while (Process32Next(hSnapshot, &pe32));
+
+        CloseHandle(hSnapshot);
+
+        return pid;
+    }
+
+    Result<Platform::LowHandle, BaseError> OpenProcessMemory(Platform::ProcessID pid,
+                                                             std::string_view memory_name) {
+        Platform::LowHandle memory_handle =
+            OpenFileMapping(FILE_MAP_ALL_ACCESS, FALSE, memory_name.data());
+        if (!memory_handle) {
+            return make_error<Platform::LowHandle>(
+                "SHARED_MEMORY",
+                std::format("Failed to find shared process memory handle \"{}\".", memory_name));
+        }
+
+        return memory_handle;
+    }
+
+    Result<void *, BaseError> OpenMemoryView(Platform::LowHandle memory_handle) {
+        void *mem_buf = MapViewOfFile(memory_handle, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+        if (!mem_buf) {
+            return make_error<void *>("SHARED_MEMORY",
+                                      "Failed to get view of shared process memory handle.");
+        }
+        return mem_buf;
+    }
+
+    Result<void> CloseProcessMemory(Platform::LowHandle memory_handle) {
+        CloseHandle(memory_handle);
+        return {};
+    }
+
+    Result<void> CloseMemoryView(Platform::LowHandle memory_handle, void *memory_view) {
+        UnmapViewOfFile(memory_view);
+        return {};
+    }
+
+    // Views always map on Windows, so nothing is transferred out of process
+    Result<void> TransferProcessSpans(Platform::LowHandle memory_handle,
+                                      std::span<const MemorySpan> writes,
+                                      std::span<const MemorySpan> reads) {
+        return make_error<void>("SHARED_MEMORY",
+                                "Tried to transfer bytes without a view of process memory!");
+    }
+
+    static bool IsHandleOpen(Platform::LowHandle handle) {
+        DCB flags;
+        return GetCommState(handle, &flags);
+    }
+
+#elif defined(TOOLBOX_PLATFORM_LINUX)
+    // Dolphin creates its emulated memory with shm_open as dolphin-emu.<pid>
+    // but unlinks the name right away, so the segment only survives as a
+    // deleted /dev/shm file held open by Dolphin. It is reopened through the
+    // process' file descriptors or mappings, and when neither is accessible
+    // the memory is accessed with process_vm_readv/process_vm_writev instead.
+    struct SharedMemoryHandle {
+        int m_fd      = -1;
+        size_t m_size = 0;
+
+        // Only used when the segment could not be opened
+        pid_t m_pid            = 0;
+        uintptr_t m_remote_mem = 0;
+    };
+
+    Result<Platform::ProcessID, BaseError> FindProcessPID(std::string_view process_name) {
+        Platform::ProcessID pid = std::numeric_limits<Platform::ProcessID>::max();
+
+        std::error_code err;
+        for (auto &entry : std::filesystem::directory_iterator("/proc", err)) {
+            const std::string dir_name = entry.path().filename().string();
+            if (dir_name.empty() || !std::all_of(dir_name.begin(), dir_name.end(), ::isdigit)) {
+                continue;
+            }
+
+            std::ifstream comm_file(entry.path() / "comm");
+            std::string comm;
+            if (!std::getline(comm_file, comm)) {
+                continue;
+            }
+
+            // The kernel truncates comm to 15 characters, compare the prefix
+            if (comm == process_name.substr(0, 15)) {
+                pid = static_cast<Platform::ProcessID>(std::stoi(dir_name));
+                break;
+            }
+        }
+
+        if (err) {
+            return make_error<Platform::ProcessID>(
+                std::format("(PROCESS) Failed to enumerate /proc to find process \"{}\": {}",
+                            process_name, err.message()));
+        }
+
+        return pid;
+    }
+
+    // Opens the first link in the directory that resolves to the segment,
+    // the kernel appends " (deleted)" to the target once it is unlinked
+    static int OpenLinkedMemory(const std::filesystem::path &link_dir,
+                                std::string_view memory_path) {
+        std::error_code err;
+        for (auto &entry : std::filesystem::directory_iterator(link_dir, err)) {
+            std::filesystem::path target = std::filesystem::read_symlink(entry.path(), err);
+            if (err || !target.string().starts_with(memory_path)) {
+                continue;
+            }
+
+            int fd = open(entry.path().c_str(), O_RDWR);
+            if (fd != -1) {
+                return fd;
+            }
+        }
+        return -1;
+    }
+
+    // Finds where Dolphin mapped the start of the segment, which is MEM1
+    static uintptr_t FindMappedMemory(Platform::ProcessID pid, std::string_view memory_path) {
+        std::ifstream maps_file(std::format("/proc/{}/maps", pid));
+
+        std::string line;
+        while (std::getline(maps_file, line)) {
+            uintptr_t start, end;
+            u64 offset;
+            char perms[5];
+            int path_pos = 0;
+            if (std::sscanf(line.c_str(), "%lx-%lx %4s %lx %*s %*s %n", &start, &end, perms,
+                            &offset, &path_pos) < 4 ||
+                path_pos == 0) {
+                continue;
+            }
+
+            std::string_view path = std::string_view(line).substr(path_pos);
+            if (offset == 0 && end - start >= 0x1800000 && perms[0] == 'r' && perms[1] == 'w' &&
+                path.starts_with(memory_path)) {
+                return start;
+            }
+        }
+        return 0;
+    }
+
+    Result<Platform::LowHandle, BaseError> OpenProcessMemory(Platform::ProcessID pid,
+                                                             std::string_view memory_name) {
+        const std::string memory_path = std::format("/dev/shm/{}", memory_name);
+
+        int fd = OpenLinkedMemory(std::format("/proc/{}/fd", pid), memory_path);
+        if (fd == -1) {
+            fd = OpenLinkedMemory(std::format("/proc/{}/map_files", pid), memory_path);
+        }
+        if (fd == -1) {
+            // Builds that keep the name linked can still be opened by name
+            fd = shm_open(std::format("/{}", memory_name).c_str(), O_RDWR, 0600);
+        }
+
+        if (fd != -1) {
+            struct stat shm_stat;
+            if (fstat(fd, &shm_stat) == -1 || shm_stat.st_size < 0x1800000) {
+                close(fd);
+                return make_error<Platform::LowHandle>(
+                    "SHARED_MEMORY",
+                    std::format("Shared process memory \"{}\" is too small to be MEM1.",
+                                memory_name));
+            }
+
+            SharedMemoryHandle *handle = new SharedMemoryHandle;
+            handle->m_fd               = fd;
+            handle->m_size             = static_cast<size_t>(shm_stat.st_size);
+            return static_cast<Platform::LowHandle>(handle);
+        }
+
+        return OpenRemoteProcessMemory(pid, memory_name);
+    }
+
+    Result<Platform::LowHandle, BaseError> OpenRemoteProcessMemory(Platform::ProcessID pid,
+                                                                   std::string_view memory_name) {
+        const std::string memory_path = std::format("/dev/shm/{}", memory_name);
+
+        uintptr_t remote_mem = FindMappedMemory(pid, memory_path);
+        if (remote_mem == 0) {
+            return make_error<Platform::LowHandle>(
+                "SHARED_MEMORY",
+                std::format("Failed to find shared process memory \"{}\".", memory_name));
+        }
+
+        // Probe once so a missing ptrace permission fails the hook, not every access
+        char probe;
+        iovec local_iov  = {&probe, sizeof(probe)};
+        iovec remote_iov = {reinterpret_cast<void *>(remote_mem), sizeof(probe)};
+        if (process_vm_readv(pid, &local_iov, 1, &remote_iov, 1, 0) != sizeof(probe)) {
+            return make_error<Platform::LowHandle>(
+                "SHARED_MEMORY",
+                std::format("Failed to access process memory \"{}\" ({}).", memory_name,
+                            std::strerror(errno)));
+        }
+
+        SharedMemoryHandle *handle = new SharedMemoryHandle;
+        handle->m_size             = 0x1800000;
+        handle->m_pid              = pid;
+        handle->m_remote_mem       = remote_mem;
+        return static_cast<Platform::LowHandle>(handle);
+    }
+
+    // Returns a null view when the memory is only reachable through TransferProcessSpans
+    Result<void *, BaseError> OpenMemoryView(Platform::LowHandle memory_handle) {
+        SharedMemoryHandle *handle = static_cast<SharedMemoryHandle *>(memory_handle);
+        if (handle->m_fd == -1) {
+            return nullptr;
+        }
+
+        void *mem_buf =
+            mmap(nullptr, handle->m_size, PROT_READ | PROT_WRITE, MAP_SHARED, handle->m_fd, 0);
+        if (mem_buf == MAP_FAILED) {
+            return make_error<void *>(
+                "SHARED_MEMORY",
+                std::format("Failed to map shared process memory ({}).", std::strerror(errno)));
+        }
+        return mem_buf;
+    }
+
+    Result<void> CloseProcessMemory(Platform::LowHandle memory_handle) {
+        SharedMemoryHandle *handle = static_cast<SharedMemoryHandle *>(memory_handle);
+        if (handle) {
+            if (handle->m_fd != -1) {
+                close(handle->m_fd);
+            }
+            delete handle;
+        }
+        return {};
+    }
+
+    Result<void> CloseMemoryView(Platform::LowHandle memory_handle, void *memory_view) {
+        SharedMemoryHandle *handle = static_cast<SharedMemoryHandle *>(memory_handle);
+        if (handle && memory_view) {
+            munmap(memory_view, handle->m_size);
+        }
+        return {};
+    }
+
+    // Copies the spans (already bounds checked) in as few syscalls as IOV_MAX allows
+    Result<void> TransferProcessSpans(Platform::LowHandle memory_handle,
+                                      std::span<const MemorySpan> writes,
+                                      std::span<const MemorySpan> reads) {
+        SharedMemoryHandle *handle = static_cast<SharedMemoryHandle *>(memory_handle);
+
+        auto transfer = [&](std::span<const MemorySpan> spans, bool write) -> Result<void> {
+            constexpr size_t max_iov = IOV_MAX;
+
+            iovec local_iov[max_iov];
+            iovec remote_iov[max_iov];
+
+            for (size_t i = 0; i < spans.size(); i += max_iov) {
+                const size_t count = std::min(max_iov, spans.size() - i);
+
+                ssize_t expected = 0;
+                for (size_t j = 0; j < count; ++j) {
+                    const MemorySpan &span = spans[i + j];
+                    local_iov[j]           = {span.m_data, span.m_size};
+                    remote_iov[j]          = {
+                        reinterpret_cast<void *>(handle->m_remote_mem +
+                                                          (span.m_address & 0x7FFFFFFF)),
+                        span.m_size};
+                    expected += static_cast<ssize_t>(span.m_size);
+                }
+
+                ssize_t transferred =
+                    write ? process_vm_writev(handle->m_pid, local_iov, count, remote_iov, count, 0)
+                          : process_vm_readv(handle->m_pid, local_iov, count, remote_iov, count, 0);
+                if (transferred != expected) {
+                    return make_error<void>(
+                        "SHARED_MEMORY",
+                        std::format("Failed to {} process memory ({}).", write ? "write" : "read",
+                                    std::strerror(errno)));
+                }
+            }
+            return {};
+        };
+
+        auto write_result = transfer(writes, true);
+        if (!write_result) {
+            return write_result;
+        }
+        return transfer(reads, false);
+    }
+#endif
+
+}  // namespace Toolbox::Dolphin
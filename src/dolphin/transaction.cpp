@@ -0,0 +1,165 @@
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#include "dolphin/hook.hpp"
+#include "dolphin/transaction.hpp"
+
+namespace Toolbox::Dolphin {
+
+    template <typename T> static void SwapElementsAs(char *data, u32 size) {
+        for (u32 i = 0; i + sizeof(T) <= size; i += sizeof(T)) {
+            T element;
+            std::memcpy(&element, data + i, sizeof(T));
+            element = std::byteswap(element);
+            std::memcpy(data + i, &element, sizeof(T));
+        }
+    }
+
+    static void SwapElements(char *data, u32 size, u32 element_size) {
+        switch (element_size) {
+        case 2:
+            SwapElementsAs<u16>(data, size);
+            break;
+        case 4:
+            SwapElementsAs<u32>(data, size);
+            break;
+        case 8:
+            SwapElementsAs<u64>(data, size);
+            break;
+        default:
+            break;
+        }
+    }
+
+    void MemoryTransaction::readBytes(char *buf, u32 address, u32 size, u32 element_size) {
+        if (size == 0) {
+            return;
+        }
+        m_reads.push_back({address, size, element_size, buf, 0, 0});
+    }
+
+    void MemoryTransaction::writeBytes(const char *buf, u32 address, u32 size, u32 element_size) {
+        if (size == 0) {
+            return;
+        }
+
+        // Swapped now so the caller's value can go away before the commit
+        size_t offset = m_write_data.size();
+        m_write_data.insert(m_write_data.end(), buf, buf + size);
+        SwapElements(m_write_data.data() + offset, size, element_size);
+
+        m_writes.push_back({address, size, element_size, nullptr, offset, 0});
+    }
+
+    void MemoryTransaction::clear() {
+        m_reads.clear();
+        m_writes.clear();
+        m_write_data.clear();
+    }
+
+    Result<void> MemoryTransaction::commit(DolphinHookManager &manager) {
+        if (empty()) {
+            return {};
+        }
+
+        buildSpans(m_reads, c_read_merge_gap, m_read_spans, m_read_span_data);
+
+        // Writes only merge where they touch so the gaps are left alone.
+        // They are laid out in the order they were made, the last one to
+        // a byte wins.
+        buildSpans(m_writes, 0, m_write_spans, m_write_span_data);
+        for (const Request &request : m_writes) {
+            std::memcpy(m_write_span_data.data() + request.m_span_offset,
+                        m_write_data.data() + request.m_data_offset, request.m_size);
+        }
+
+        auto result = manager.transferSpans(m_write_spans, m_read_spans);
+        if (!result) {
+            clear();
+            return result;
+        }
+
+        for (const Request &request : m_reads) {
+            std::memcpy(request.m_dest, m_read_span_data.data() + request.m_span_offset,
+                        request.m_size);
+            SwapElements(request.m_dest, request.m_size, request.m_element_size);
+        }
+
+        clear();
+        return {};
+    }
+
+    void MemoryTransaction::buildSpans(std::vector<Request> &requests, u32 merge_gap,
+                                       std::vector<MemorySpan> &spans, std::vector<char> &data) {
+        spans.clear();
+        if (requests.empty()) {
+            data.clear();
+            return;
+        }
+
+        auto key = [&](size_t index) {
+            return (static_cast<u64>(requests[index].m_address) << 32) | index;
+        };
+
+        // Requests mostly come in runs of rising addresses, one for each
+        // value mapped, so the runs are sorted by where they start. A run
+        // also ends where the addresses jump, as the next value is rarely
+        // above all of the later ones. Only when runs interleave are all
+        // of the requests sorted.
+        auto continues_run = [&](size_t i) {
+            return requests[i].m_address >= requests[i - 1].m_address &&
+                   requests[i].m_address <= requests[i - 1].m_address + c_run_gap;
+        };
+
+        std::vector<u64> &runs = m_sorted_runs;
+        runs.clear();
+        for (size_t i = 0; i < requests.size(); ++i) {
+            if (i == 0 || !continues_run(i)) {
+                runs.push_back(key(i));
+            }
+        }
+        std::sort(runs.begin(), runs.end());
+
+        std::vector<u64> &order = m_sorted_requests;
+        order.clear();
+        for (u64 run : runs) {
+            size_t i = static_cast<u32>(run);
+            do {
+                order.push_back(key(i++));
+            } while (i < requests.size() && continues_run(i));
+        }
+        if (!std::is_sorted(order.begin(), order.end())) {
+            std::sort(order.begin(), order.end());
+        }
+
+        // The bytes of every span follow the last one's in `data`
+        std::vector<size_t> &span_offsets = m_span_offsets;
+        span_offsets.clear();
+        size_t data_size = 0;
+        u64 span_end     = 0;
+        for (u64 key : order) {
+            Request &request = requests[static_cast<u32>(key)];
+            u64 request_end  = static_cast<u64>(request.m_address) + request.m_size;
+
+            if (spans.empty() || request.m_address > span_end + merge_gap) {
+                data_size += spans.empty() ? 0 : spans.back().m_size;
+                spans.push_back({request.m_address, 0, nullptr});
+                span_offsets.push_back(data_size);
+                span_end = request.m_address;
+            }
+
+            MemorySpan &span      = spans.back();
+            span_end              = std::max(span_end, request_end);
+            span.m_size           = static_cast<u32>(span_end - span.m_address);
+            request.m_span_offset = data_size + (request.m_address - span.m_address);
+        }
+        data_size += spans.back().m_size;
+
+        data.resize(data_size);
+        for (size_t i = 0; i < spans.size(); ++i) {
+            spans[i].m_data = data.data() + span_offsets[i];
+        }
+    }
+
+}  // namespace Toolbox::Dolphin
\ No newline at end of file
@@ -93,6 +93,17 @@ namespace Toolbox::Game {
 
             m_game_interpreter.setMemoryBuffer(communicator.manager().getMemoryView(),
                                                communicator.manager().getMemorySize());
+
+            // Resets and stage changes load code behind the interpreter's
+            // back, so decoded blocks can't outlive the scene they came from
+            u8 stage = 0xFF, scenario = 0xFF;
+            getLoadedScene(stage, scenario);
+            if (stage != m_interpreter_stage || scenario != m_interpreter_scenario) {
+                m_game_interpreter.clearBlockCache();
+                m_interpreter_stage    = stage;
+                m_interpreter_scenario = scenario;
+            }
+
             checkForAcquiredStackFrameAndBuffer();
 
             // Dismiss tasks if disconnected to avoid errors
@@ -135,6 +146,10 @@ namespace Toolbox::Game {
         // We must respect the mutex
         // lockMutex(spoof_thread_id, heap_ptr + 0x18);
 
+        if (!hasGameMemory()) {
+            return 0;
+        }
+
         waitMutex(heap_ptr + 0x18);
 
         u32 args[3]   = {heap_ptr, size, alignment};
@@ -147,6 +162,10 @@ namespace Toolbox::Game {
 
     bool TaskCommunicator::constructThread(u32 thread_ptr, u32 func, u32 parameter, u32 stack,
                                            u32 stackSize, u32 priority, u16 attributes) {
+        if (!hasGameMemory()) {
+            return false;
+        }
+
         u32 args[7] = {thread_ptr, func, parameter, stack, stackSize, priority, attributes};
         Interpreter::Register::RegisterSnapshot snapshot =
             m_game_interpreter.evaluateFunction(0x80348948, 7, args, 0, nullptr);
@@ -304,9 +323,13 @@ namespace Toolbox::Game {
         }
     }
 
+    bool TaskCommunicator::hasGameMemory() {
+        return m_game_interpreter.getMemoryStorage().size() > 0;
+    }
+
     bool TaskCommunicator::checkForAcquiredStackFrameAndBuffer() {
         DolphinCommunicator &communicator = GUIApplication::instance().getDolphinCommunicator();
-        if (!communicator.manager().isHooked()) {
+        if (!communicator.manager().isHooked() || !hasGameMemory()) {
             m_game_interpreter.setStackPointer(0);
             return false;
         }
@@ -379,13 +402,13 @@ namespace Toolbox::Game {
 
         constexpr u32 request_buffer_address = 0x80000FA0;
 
-        Buffer &interpreter_buf = dolphin_interpreter->getMemoryBuffer();
-
-        std::memset(interpreter_buf.buf<u8>() + (request_buffer_address - 0x80000000), '\0', 0x200);
+        // Only the request page is privatized, the rest reads through to Dolphin
+        Interpreter::MemoryStorage &interpreter_mem = dolphin_interpreter->getMemoryStorage();
 
         std::string actor_name = result.value();
-        std::strncpy(interpreter_buf.buf<char>() + (request_buffer_address - 0x80000000),
-                     actor_name.c_str(), actor_name.size());
+        interpreter_mem.fill(request_buffer_address - 0x80000000, '\0', 0x200);
+        interpreter_mem.writeBytes(actor_name.c_str(), request_buffer_address - 0x80000000,
+                                   std::min<size_t>(actor_name.size(), 0x1FF));
 
         u32 namerefgen_addr = dolphin_interpreter->read<u32>(0x8040E408);
         u32 rootref_addr    = dolphin_interpreter->read<u32>(namerefgen_addr + 0x4);
@@ -408,12 +431,11 @@ namespace Toolbox::Game {
 
         constexpr u32 request_buffer_address = 0x80000FA0;
 
-        Buffer &interpreter_buf = dolphin_interpreter->getMemoryBuffer();
+        Interpreter::MemoryStorage &interpreter_mem = dolphin_interpreter->getMemoryStorage();
 
-        std::memset(interpreter_buf.buf<u8>() + (request_buffer_address - 0x80000000), '\0', 0x200);
-
-        std::strncpy(interpreter_buf.buf<char>() + (request_buffer_address - 0x80000000),
-                     name.c_str(), name.size());
+        interpreter_mem.fill(request_buffer_address - 0x80000000, '\0', 0x200);
+        interpreter_mem.writeBytes(name.c_str(), request_buffer_address - 0x80000000,
+                                   std::min<size_t>(name.size(), 0x1FF));
 
         u32 namerefgen_addr = dolphin_interpreter->read<u32>(0x8040E408);
         u32 rootref_addr    = dolphin_interpreter->read<u32>(namerefgen_addr + 0x4);
@@ -621,6 +643,11 @@ namespace Toolbox::Game {
     Result<void> TaskCommunicator::taskAddSceneObject(RefPtr<ISceneObject> object,
                                                       RefPtr<GroupSceneObject> parent,
                                                       transact_complete_cb complete_cb) {
+        if (!hasGameMemory()) {
+            return make_error<void>(
+                "GAME TASK", "Failed to add object to game scene (Dolphin's memory isn't mapped)!");
+        }
+
         u32 parent_ptr = getActorPtr(parent);
         if (parent_ptr == 0) {
             return make_error<void>(
@@ -760,10 +787,13 @@ namespace Toolbox::Game {
                             return;
                         }
 
-                        const char *item_key =
-                            static_cast<const char *>(communicator.manager().getMemoryView()) +
-                            item_key_ptr - 0x80000000;
-                        if (obj_game_key == item_key) {
+                        // One extra byte to check the key terminates where ours does
+                        std::string item_key(obj_game_key.size() + 1, '\0');
+                        if (!communicator.readBytes(item_key.data(), item_key_ptr,
+                                                    item_key.size())) {
+                            return;
+                        }
+                        if (item_key.starts_with(obj_game_key) && item_key.back() == '\0') {
                             u32 next_ptr = communicator.read<u32>(iter_ptr).value();
                             u32 prev_ptr = communicator.read<u32>(iter_ptr + 0x4).value();
 
@@ -789,9 +819,9 @@ namespace Toolbox::Game {
                 u32 elem_ptr      = communicator.read<u32>(elem_array_at).value();
                 if (elem_ptr == obj_ptr) {
                     // This moves the future elements on top of the deleted one
-                    char *buf = static_cast<char *>(communicator.manager().getMemoryView());
-                    std::memmove(buf + elem_array_at - 0x80000000,
-                                 buf + elem_array_at + 4 - 0x80000000, (obj_count - i) * 4);
+                    std::vector<char> elems((obj_count - i) * 4);
+                    communicator.readBytes(elems.data(), elem_array_at + 4, elems.size());
+                    communicator.writeBytes(elems.data(), elem_array_at, elems.size());
                     communicator.write<u32>(item_ptr + 0x14, --obj_count);
                     break;
                 }
@@ -831,11 +861,9 @@ namespace Toolbox::Game {
             constexpr u32 request_buffer_address = 0x80000FA0;
             constexpr u32 name_address           = request_buffer_address - 0x80000000;
 
-            std::memset(static_cast<char *>(communicator.manager().getMemoryView()) + name_address,
-                        '\0', 0x200);
-
-            std::strncpy(static_cast<char *>(communicator.manager().getMemoryView()) + name_address,
-                         demo_name.data(), demo_name.size());
+            char name_buf[0x200] = {};
+            std::strncpy(name_buf, demo_name.data(), std::min(demo_name.size(), sizeof(name_buf)));
+            communicator.writeBytes(name_buf, request_buffer_address, sizeof(name_buf));
 
             s32 offset = static_cast<s32>(cam_index * 0x24);
             communicator.write<u32>(mar_director_address + offset + 0x12C, name_address);
@@ -876,17 +904,17 @@ namespace Toolbox::Game {
 
         u32 mario_ptr = communicator.read<u32>(0x8040E108).value();
 
-        glm::vec3 translation = {
-            communicator.read<f32>(mario_ptr + 0x10).value(),
-            communicator.read<f32>(mario_ptr + 0x14).value(),
-            communicator.read<f32>(mario_ptr + 0x18).value(),
-        };
-
-        glm::vec3 rotation = {
-            communicator.read<f32>(mario_ptr + 0x30).value(),
-            communicator.read<f32>(mario_ptr + 0x34).value(),
-            communicator.read<f32>(mario_ptr + 0x38).value(),
-        };
+        glm::vec3 translation;
+        glm::vec3 rotation;
+        {
+            Dolphin::MemoryTransaction transaction;
+            transaction.read(mario_ptr + 0x10, translation);
+            transaction.read(mario_ptr + 0x30, rotation);
+            auto result = transaction.commit(communicator.manager());
+            if (!result) {
+                return result;
+            }
+        }
 
         RefPtr<MetaMember> transform_member = transform_result.value();
         Transform transform                 = getMetaValue<Transform>(transform_member, 0).value();
@@ -916,11 +944,7 @@ namespace Toolbox::Game {
 
         u32 mario_ptr = communicator.read<u32>(0x8040E108).value();
 
-        glm::vec3 translation = {
-            communicator.read<f32>(mario_ptr + 0x10).value(),
-            communicator.read<f32>(mario_ptr + 0x14).value(),
-            communicator.read<f32>(mario_ptr + 0x18).value(),
-        };
+        glm::vec3 translation = communicator.read<glm::vec3>(mario_ptr + 0x10).value();
 
         RefPtr<MetaMember> transform_member = transform_result.value();
         Transform transform                 = getMetaValue<Transform>(transform_member, 0).value();
@@ -944,26 +968,22 @@ namespace Toolbox::Game {
 
         u32 camera_ptr = communicator.read<u32>(0x8040D0A8).value();
 
-        glm::vec3 translation = {
-            communicator.read<f32>(camera_ptr + 0x10).value(),
-            communicator.read<f32>(camera_ptr + 0x14).value(),
-            communicator.read<f32>(camera_ptr + 0x18).value(),
-        };
-
-        glm::vec3 up_vec = {
-            communicator.read<f32>(camera_ptr + 0x30).value(),
-            communicator.read<f32>(camera_ptr + 0x34).value(),
-            communicator.read<f32>(camera_ptr + 0x38).value(),
-        };
-
-        glm::vec3 target_pos = {
-            communicator.read<f32>(camera_ptr + 0x3C).value(),
-            communicator.read<f32>(camera_ptr + 0x40).value(),
-            communicator.read<f32>(camera_ptr + 0x44).value(),
-        };
-
-        f32 fovy   = communicator.read<f32>(camera_ptr + 0x48).value();
-        f32 aspect = communicator.read<f32>(camera_ptr + 0x4C).value();
+        glm::vec3 translation;
+        glm::vec3 up_vec;
+        glm::vec3 target_pos;
+        f32 fovy;
+        f32 aspect;
+
+        Dolphin::MemoryTransaction transaction;
+        transaction.read(camera_ptr + 0x10, translation);
+        transaction.read(camera_ptr + 0x30, up_vec);
+        transaction.read(camera_ptr + 0x3C, target_pos);
+        transaction.read(camera_ptr + 0x48, fovy);
+        transaction.read(camera_ptr + 0x4C, aspect);
+        auto result = transaction.commit(communicator.manager());
+        if (!result) {
+            return result;
+        }
 
         camera.setOrientAndPosition(up_vec, target_pos, translation);
         return {};
@@ -978,9 +998,11 @@ namespace Toolbox::Game {
 
         u32 mario_ptr = communicator.read<u32>(0x8040E108).value();
 
-        translation.x = communicator.read<f32>(mario_ptr + 0x10).value();
-        translation.y = communicator.read<f32>(mario_ptr + 0x14).value();
-        translation.z = communicator.read<f32>(mario_ptr + 0x18).value();
+        auto result = communicator.read<glm::vec3>(mario_ptr + 0x10);
+        if (!result) {
+            return std::unexpected(result.error());
+        }
+        translation = result.value();
         return {};
     }
 
@@ -994,10 +1016,7 @@ namespace Toolbox::Game {
         }
 
         u32 mario_ptr = communicator.read<u32>(0x8040E108).value();
-        communicator.write<f32>(mario_ptr + 0x10, translation.x);
-        communicator.write<f32>(mario_ptr + 0x14, translation.y);
-        communicator.write<f32>(mario_ptr + 0x18, translation.z);
-        return {};
+        return communicator.write<glm::vec3>(mario_ptr + 0x10, translation);
     }
 
     Result<void> TaskCommunicator::getMarioTransform(Transform &transform) {
@@ -1010,10 +1029,15 @@ namespace Toolbox::Game {
 
         u32 mario_ptr = communicator.read<u32>(0x8040E108).value();
 
-        transform.m_translation.x = communicator.read<f32>(mario_ptr + 0x10).value();
-        transform.m_translation.y = communicator.read<f32>(mario_ptr + 0x14).value();
-        transform.m_translation.z = communicator.read<f32>(mario_ptr + 0x18).value();
-        s16 raw_angle             = communicator.read<s16>(mario_ptr + 0x96).value();
+        s16 raw_angle;
+
+        Dolphin::MemoryTransaction transaction;
+        transaction.read(mario_ptr + 0x10, transform.m_translation);
+        transaction.read(mario_ptr + 0x96, raw_angle);
+        auto result = transaction.commit(communicator.manager());
+        if (!result) {
+            return result;
+        }
 
         transform.m_rotation = {0.0f, convertAngleS16ToFloat(raw_angle), 0.0f};
         transform.m_scale    = {1.0f, 1.0f, 1.0f};
@@ -1035,28 +1059,23 @@ namespace Toolbox::Game {
                                     "Failed to set mario transform in scene (nullptr)!");
         }
 
-        communicator.write<f32>(mario_ptr + 0x10, transform.m_translation.x);
-        communicator.write<f32>(mario_ptr + 0x14, transform.m_translation.y);
-        communicator.write<f32>(mario_ptr + 0x18, transform.m_translation.z);
+        communicator.write<glm::vec3>(mario_ptr + 0x10, transform.m_translation);
 
         u32 gpr_args[2] = {mario_ptr, mario_ptr + 0x10};
         f64 fpr_args[1] = {transform.m_rotation.y};
 
-        // Call function TMario::warpRequest(TVec3f<float> *, float)
-        if (warp_camera) {
+        // Call function TMario::warpRequest(TVec3f<float> *, float), without
+        // mapped memory only the transform itself can be written
+        if (warp_camera && hasGameMemory()) {
             m_game_interpreter.evaluateFunction(0x8025599C, 2, gpr_args, 1, fpr_args);
             return {};
         }
 
-        communicator.write<f32>(mario_ptr + 0x10, transform.m_translation.x);
-        communicator.write<f32>(mario_ptr + 0x14, transform.m_translation.y);
-        communicator.write<f32>(mario_ptr + 0x18, transform.m_translation.z);
-        communicator.write<f32>(mario_ptr + 0x34, transform.m_rotation.y);
-
-        s16 signed_angle = convertAngleFloatToS16(transform.m_rotation.y);
-        communicator.write<s16>(mario_ptr + 0x96, signed_angle);
-
-        return {};
+        Dolphin::MemoryTransaction transaction;
+        transaction.write(mario_ptr + 0x10, transform.m_translation);
+        transaction.write(mario_ptr + 0x34, transform.m_rotation.y);
+        transaction.write(mario_ptr + 0x96, convertAngleFloatToS16(transform.m_rotation.y));
+        return transaction.commit(communicator.manager());
     }
 
     Result<void> TaskCommunicator::setObjectTransform(RefPtr<PhysicalSceneObject> object,
@@ -1068,13 +1087,24 @@ namespace Toolbox::Game {
             return make_error<void>("GAME TASK", "Failed to set object transform in scene!");
         }
 
+        Dolphin::MemoryTransaction transaction;
+        auto result = setObjectTransform(object, transform, transaction);
+        if (!result) {
+            return result;
+        }
+        return transaction.commit(communicator.manager());
+    }
+
+    Result<void> TaskCommunicator::setObjectTransform(RefPtr<PhysicalSceneObject> object,
+                                                      const Transform &transform,
+                                                      Dolphin::MemoryTransaction &transaction) {
         std::string_view obj_name = object->getNameRef().name();
 
         u32 ptr = object->getGamePtr();
         if (ptr == 0) {
-            u32 new_ptr = getActorPtr(object);
-            object->setGamePtr(new_ptr);
-            if (new_ptr == 0) {
+            ptr = getActorPtr(object);
+            object->setGamePtr(ptr);
+            if (ptr == 0) {
                 return make_error<void>(
                     "GAME TASK", std::format("Failed to ptr to object \"{}\" in scene!", obj_name));
             }
@@ -1082,36 +1112,30 @@ namespace Toolbox::Game {
                            obj_name);
         }
 
-        communicator.write<f32>(ptr + 0x10, transform.m_translation.x);
-        communicator.write<f32>(ptr + 0x14, transform.m_translation.y);
-        communicator.write<f32>(ptr + 0x18, transform.m_translation.z);
-        communicator.write<f32>(ptr + 0x24, transform.m_scale.x);
-        communicator.write<f32>(ptr + 0x28, transform.m_scale.y);
-        communicator.write<f32>(ptr + 0x2C, transform.m_scale.z);
-        communicator.write<f32>(ptr + 0x30, transform.m_rotation.x);
-        communicator.write<f32>(ptr + 0x34, transform.m_rotation.y);
-        communicator.write<f32>(ptr + 0x38, transform.m_rotation.z);
+        std::string type    = object->type();
+        bool clear_velocity = type.starts_with("NPC") || type.ends_with("Fruit");
 
-        std::string type = object->type();
-        if (type.starts_with("NPC")) {
-            communicator.write<f32>(ptr + 0xAC, 0.0f);
-            communicator.write<f32>(ptr + 0xB0, 0.0f);
-            communicator.write<f32>(ptr + 0xB4, 0.0f);
+        // Checked before queueing anything, as one bad range would fail
+        // the commit for every other object in the transaction
+        u32 end_offset = clear_velocity ? 0xAC + sizeof(glm::vec3) : 0x10 + 0x2C;
+        if (!Dolphin::MemoryTransaction::IsInMemory(ptr, end_offset)) {
+            return make_error<void>(
+                "GAME TASK", std::format("Pointer 0x{:08X} to object \"{}\" is out of bounds!",
+                                         ptr, obj_name));
         }
 
-        if (type.ends_with("Fruit")) {
-            communicator.write<f32>(ptr + 0xAC, 0.0f);
-            communicator.write<f32>(ptr + 0xB0, 0.0f);
-            communicator.write<f32>(ptr + 0xB4, 0.0f);
+        transaction.write(ptr + 0x10, transform);
+        if (clear_velocity) {
+            transaction.write(ptr + 0xAC, glm::vec3(0.0f));
         }
 
         return {};
     }
 
-    ImageHandle TaskCommunicator::captureXFBAsTexture(int width, int height) {
+    const ImageHandle &TaskCommunicator::captureXFBAsTexture(int width, int height) {
         DolphinCommunicator &communicator = GUIApplication::instance().getDolphinCommunicator();
         if (!communicator.manager().isHooked()) {
-            return ImageHandle();
+            return m_xfb_capture.noImage();
         }
 
         u32 application_address = 0x803E9700;
@@ -1120,8 +1144,7 @@ namespace Toolbox::Game {
         u16 xfb_width           = communicator.read<u16>(display_address + 0x14).value();
         u16 xfb_height          = communicator.read<u16>(display_address + 0x18).value();
 
-        return communicator.manager().captureXFBAsTexture(width, height, xfb_address, xfb_width,
-                                                          xfb_height);
+        return m_xfb_capture.capture(communicator.manager(), xfb_address, xfb_width, xfb_height);
     }
 
     ScopePtr<Interpreter::SystemDolphin> TaskCommunicator::createInterpreter() {
@@ -1132,12 +1155,23 @@ namespace Toolbox::Game {
             return nullptr;
         }
 
+        // Hooks through process_vm have no view to evaluate upon
+        if (!communicator.manager().getMemoryView()) {
+            TOOLBOX_ERROR("[INTERPRETER] Dolphin's memory could not be mapped!");
+            return nullptr;
+        }
+
         return createInterpreterUnchecked();
     }
 
     ScopePtr<Interpreter::SystemDolphin> TaskCommunicator::createInterpreterUnchecked() {
         DolphinCommunicator &communicator = GUIApplication::instance().getDolphinCommunicator();
 
+        // There is nothing to overlay without a view
+        if (!communicator.manager().getMemoryView()) {
+            return nullptr;
+        }
+
         auto dolphin_interpreter = Toolbox::make_scoped<Interpreter::SystemDolphin>();
 
         dolphin_interpreter->onException(
@@ -1166,8 +1200,7 @@ namespace Toolbox::Game {
         dolphin_interpreter->setGlobalsPointerR(0x80416BA0);
         dolphin_interpreter->setGlobalsPointerRW(0x804141C0);
 
-        // Copy bytes so we only have to check hook status once
-        // m_storage.resize(communicator.manager().getMemorySize());
+        // Overlay the live memory so writes made by the evaluation stay private
         dolphin_interpreter->applyMemory(communicator.manager().getMemoryView(),
                                          communicator.manager().getMemorySize());
 
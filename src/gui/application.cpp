@@ -152,6 +152,7 @@ namespace Toolbox {
         if (!SettingsManager::instance().initialize()) {
             TOOLBOX_ERROR("[INIT] Failed to initialize settings manager!");
         }
+        Log::AppLogger::instance().refreshSettings();
 
         auto &font_manager = FontManager::instance();
         if (!font_manager.initialize()) {
@@ -173,6 +174,9 @@ namespace Toolbox {
 
         m_dolphin_communicator.tStart(false, nullptr);
         m_task_communicator.tStart(false, nullptr);
+
+        // Template loading logs a lot before the first frame
+        Log::AppLogger::instance().flush();
     }
 
     void GUIApplication::onUpdate(TimeStep delta_time) {
@@ -200,6 +204,8 @@ namespace Toolbox {
             glfwPollEvents();
             Input::UpdateInputState();
 
+            Log::AppLogger::instance().flush();
+
             render(delta_time);
 
             Input::PostUpdateInputState();
@@ -220,6 +226,9 @@ namespace Toolbox {
 
         m_dolphin_communicator.tKill(true);
         m_task_communicator.tKill(true);
+
+        // Messages the workers logged while stopping still reach the file
+        Log::AppLogger::instance().flush();
     }
 
     RefPtr<ImWindow> GUIApplication::findWindow(UUID64 uuid) {
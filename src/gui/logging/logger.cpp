@@ -1,7 +1,30 @@
 #include "core/log.hpp"
 #include "gui/settings.hpp"
 
+static const char *getReportLevelTag(Toolbox::Log::ReportLevel level) {
+    switch (level) {
+    case Toolbox::Log::ReportLevel::REPORT_LOG:
+        return "[LOG]    ";
+    case Toolbox::Log::ReportLevel::REPORT_WARNING:
+        return "[WARNING]";
+    case Toolbox::Log::ReportLevel::REPORT_ERROR:
+        return "[ERROR]  ";
+    case Toolbox::Log::ReportLevel::REPORT_DEBUG:
+        return "[DEBUG]  ";
+    default:
+        return "[UNKNOWN]";
+    }
+}
+
 namespace Toolbox::Log {
+    AppLogger::AppLogger() : m_queue(std::make_unique<QueueSlot[]>(c_queue_capacity)) {
+        static_assert((c_queue_capacity & (c_queue_capacity - 1)) == 0,
+                      "Log queue capacity must be a power of two");
+        for (size_t i = 0; i < c_queue_capacity; ++i) {
+            m_queue[i].m_sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
     AppLogger &AppLogger::instance() {
         static AppLogger s_logger;
         return s_logger;
@@ -15,10 +38,145 @@ namespace Toolbox::Log {
             else
                 std::cout << message << std::endl;
         }
-        m_write_mutex.lock();
-        m_messages.emplace_back(level, message, m_indentation);
-        m_log_callback(m_messages.back());
-        m_write_mutex.unlock();
+        LogMessage log_message = {level, message, m_indentation.load(std::memory_order_relaxed)};
+        if (m_overflowing.load(std::memory_order_acquire) || !pushMessage(std::move(log_message))) {
+            pushOverflow(std::move(log_message));
+        }
+    }
+
+    void AppLogger::flush() {
+        LogMessage message;
+        while (popMessage(message)) {
+            appendHistory(std::move(message));
+        }
+
+        if (m_overflowing.load(std::memory_order_acquire)) {
+            std::vector<LogMessage> overflow;
+            {
+                std::scoped_lock lock(m_overflow_mutex);
+                overflow.swap(m_overflow);
+                m_overflowing.store(false, std::memory_order_release);
+            }
+            for (LogMessage &overflowed : overflow) {
+                appendHistory(std::move(overflowed));
+            }
+        }
+
+        size_t dropped = m_dropped.exchange(0, std::memory_order_relaxed);
+        if (dropped > 0) {
+            appendHistory({ReportLevel::REPORT_WARNING,
+                           std::format("[LOG] {} messages were dropped, too many were logged "
+                                       "at once",
+                                       dropped),
+                           0});
+        }
+
+        if (m_log_file.is_open()) {
+            m_log_file.flush();
+        }
+    }
+
+    void AppLogger::refreshSettings() {
+        AppSettings &settings = SettingsManager::instance().getCurrentProfile();
+        setCapacity(static_cast<size_t>(std::max<s64>(settings.m_log_capacity, 1)));
+        setLogFile(settings.m_log_to_file ? "toolbox.log" : "");
+    }
+
+    void AppLogger::setCapacity(size_t capacity) {
+        if (capacity == m_history_capacity) {
+            return;
+        }
+
+        // Unroll the ring so the oldest message is first again
+        std::rotate(m_history.begin(), m_history.begin() + m_history_start, m_history.end());
+        m_history_start = 0;
+
+        if (m_history.size() > capacity) {
+            m_history.erase(m_history.begin(), m_history.end() - capacity);
+        }
+        m_history_capacity = capacity;
+    }
+
+    bool AppLogger::setLogFile(const std::filesystem::path &path) {
+        if (path == m_log_file_path) {
+            return path.empty() || m_log_file.is_open();
+        }
+
+        m_log_file.close();
+        m_log_file_path = path;
+
+        if (path.empty()) {
+            return true;
+        }
+
+        m_log_file.open(path, std::ios::out | std::ios::app);
+        return m_log_file.is_open();
+    }
+
+    bool AppLogger::pushMessage(LogMessage &&message) {
+        size_t position = m_queue_write.load(std::memory_order_relaxed);
+        QueueSlot *slot;
+        for (;;) {
+            slot            = &m_queue[position & (c_queue_capacity - 1)];
+            size_t sequence = slot->m_sequence.load(std::memory_order_acquire);
+
+            // The slot is free for this position, behind it when it's still
+            // waiting to be flushed, or ahead when another thread claimed it
+            if (sequence == position) {
+                if (m_queue_write.compare_exchange_weak(position, position + 1,
+                                                        std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (sequence < position) {
+                return false;
+            } else {
+                position = m_queue_write.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->m_message = std::move(message);
+        slot->m_sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    void AppLogger::pushOverflow(LogMessage &&message) {
+        std::scoped_lock lock(m_overflow_mutex);
+        m_overflowing.store(true, std::memory_order_release);
+        if (m_overflow.size() >= c_overflow_capacity) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        m_overflow.emplace_back(std::move(message));
+    }
+
+    bool AppLogger::popMessage(LogMessage &message) {
+        QueueSlot &slot = m_queue[m_queue_read & (c_queue_capacity - 1)];
+        if (slot.m_sequence.load(std::memory_order_acquire) != m_queue_read + 1) {
+            return false;
+        }
+
+        message = std::move(slot.m_message);
+        slot.m_sequence.store(m_queue_read + c_queue_capacity, std::memory_order_release);
+        m_queue_read += 1;
+        return true;
+    }
+
+    void AppLogger::appendHistory(LogMessage &&message) {
+        if (m_log_file.is_open()) {
+            m_log_file << std::format("{} - {:>{}}\n", getReportLevelTag(message.m_level),
+                                      message.m_message,
+                                      message.m_indentation * 4 + message.m_message.size());
+        }
+
+        m_log_callback(message);
+
+        if (m_history.size() < m_history_capacity) {
+            m_history.emplace_back(std::move(message));
+            return;
+        }
+
+        m_history[m_history_start] = std::move(message);
+        m_history_start            = (m_history_start + 1) % m_history.size();
     }
 
 }  // namespace Toolbox
\ No newline at end of file
@@ -3,29 +3,24 @@
 #include "gui/font.hpp"
 #include "gui/logging/window.hpp"
 
-static std::string s_message_pool;
-
 namespace Toolbox::UI {
-    void LoggingWindow::appendMessageToPool(const Log::AppLogger::LogMessage &message) {
+    void LoggingWindow::onMessageLogged(const Log::AppLogger::LogMessage &message) {
+        m_scroll_requested = (int)m_logging_level <= (int)message.m_level;
+    }
+
+    bool LoggingWindow::isMessageVisible(const Log::AppLogger::LogMessage &message) const {
         switch (message.m_level) {
         case Log::ReportLevel::REPORT_LOG:
-            s_message_pool += std::format("[LOG]     - {:>{}}", message.m_message,
-                                          message.m_indentation * 4 + message.m_message.size());
-            break;
+            return m_logging_level == Log::ReportLevel::REPORT_LOG;
         case Log::ReportLevel::REPORT_WARNING:
-            s_message_pool += std::format("[WARNING] - {:>{}}", message.m_message,
-                                          message.m_indentation * 4 + message.m_message.size());
-            break;
+            return m_logging_level != Log::ReportLevel::REPORT_DEBUG &&
+                   m_logging_level != Log::ReportLevel::REPORT_ERROR;
         case Log::ReportLevel::REPORT_ERROR:
-            s_message_pool += std::format("[ERROR]   - {:>{}}", message.m_message,
-                                          message.m_indentation * 4 + message.m_message.size());
-            break;
+            return m_logging_level != Log::ReportLevel::REPORT_DEBUG;
         case Log::ReportLevel::REPORT_DEBUG:
-            s_message_pool += std::format("[DEBUG]   - {:>{}}", message.m_message,
-                                          message.m_indentation * 4 + message.m_message.size());
-            break;
+            return true;
         }
-        m_scroll_requested = (int)m_logging_level <= (int)message.m_level;
+        return false;
     }
 
     void LoggingWindow::onRenderMenuBar() {
@@ -49,31 +44,28 @@ namespace Toolbox::UI {
 
             if (ImGui::MenuItem("Copy")) {
                 std::string clipboard_text;
-                for (size_t i = 0; i < logger.messages().size(); ++i) {
-                    const auto &message = logger.messages()[i];
+                for (size_t i = 0; i < logger.messageCount(); ++i) {
+                    const auto &message = logger.message(i);
+                    if (!isMessageVisible(message)) {
+                        continue;
+                    }
+                    if (!clipboard_text.empty()) {
+                        clipboard_text += "\n";
+                    }
                     switch (message.m_level) {
                     case Log::ReportLevel::REPORT_LOG:
-                        if (m_logging_level != Log::ReportLevel::REPORT_LOG)
-                            break;
-                        clipboard_text += std::format("[INFO]    - {}", message.m_message.c_str());
+                        clipboard_text += std::format("[INFO]    - {}", message.m_message);
                         break;
                     case Log::ReportLevel::REPORT_WARNING:
-                        if (m_logging_level == Log::ReportLevel::REPORT_DEBUG ||
-                            m_logging_level == Log::ReportLevel::REPORT_ERROR)
-                            break;
-                        clipboard_text += std::format("[WARNING] - {}", message.m_message.c_str());
+                        clipboard_text += std::format("[WARNING] - {}", message.m_message);
                         break;
                     case Log::ReportLevel::REPORT_ERROR:
-                        if (m_logging_level == Log::ReportLevel::REPORT_DEBUG)
-                            break;
-                        clipboard_text += std::format("[ERROR]   - {}", message.m_message.c_str());
+                        clipboard_text += std::format("[ERROR]   - {}", message.m_message);
                         break;
                     case Log::ReportLevel::REPORT_DEBUG:
-                        clipboard_text += std::format("[DEBUG]   - {}", message.m_message.c_str());
+                        clipboard_text += std::format("[DEBUG]   - {}", message.m_message);
                         break;
                     }
-                    if (i < logger.messages().size() - 1)
-                        clipboard_text += "\n";
                 }
                 SystemClipboard::instance().setText(clipboard_text);
             }
@@ -96,37 +88,42 @@ namespace Toolbox::UI {
                               ImGuiWindowFlags_AlwaysUseWindowPadding)) {
             bool is_auto_scroll_mode = ImGui::GetScrollMaxY() - ImGui::GetScrollY() < 12.0f;
 
-            auto &messages           = Log::AppLogger::instance().messages();
-            size_t begin             = (size_t)std::max<s64>(
-                0, messages.size() - 5000);  // Have up to 5000 messages at once displayed
-            for (size_t i = begin; i < messages.size(); ++i) {
-                auto &message = messages[i];
-                switch (message.m_level) {
-                case Log::ReportLevel::REPORT_LOG:
-                    if (m_logging_level != Log::ReportLevel::REPORT_LOG)
+            auto &logger = Log::AppLogger::instance();
+
+            m_visible_messages.clear();
+            for (size_t i = 0; i < logger.messageCount(); ++i) {
+                if (isMessageVisible(logger.message(i))) {
+                    m_visible_messages.push_back(i);
+                }
+            }
+
+            // Only the rows in view are formatted
+            ImGuiListClipper clipper;
+            clipper.Begin(static_cast<int>(m_visible_messages.size()));
+            while (clipper.Step()) {
+                for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                    auto &message = logger.message(m_visible_messages[row]);
+                    switch (message.m_level) {
+                    case Log::ReportLevel::REPORT_LOG:
+                        ImGui::TextColored({0.2f, 0.9f, 0.3f, 1.0f}, "[LOG]     - %s",
+                                           message.m_message.c_str());
                         break;
-                    ImGui::TextColored({0.2f, 0.9f, 0.3f, 1.0f}, "[LOG]     - %s",
-                                       message.m_message.c_str());
-                    break;
-                case Log::ReportLevel::REPORT_WARNING:
-                    if (m_logging_level == Log::ReportLevel::REPORT_DEBUG ||
-                        m_logging_level == Log::ReportLevel::REPORT_ERROR)
+                    case Log::ReportLevel::REPORT_WARNING:
+                        ImGui::TextColored({0.7f, 0.5f, 0.1f, 1.0f}, "[WARNING] - %s",
+                                           message.m_message.c_str());
                         break;
-                    ImGui::TextColored({0.7f, 0.5f, 0.1f, 1.0f}, "[WARNING] - %s",
-                                       message.m_message.c_str());
-                    break;
-                case Log::ReportLevel::REPORT_ERROR:
-                    if (m_logging_level == Log::ReportLevel::REPORT_DEBUG)
+                    case Log::ReportLevel::REPORT_ERROR:
+                        ImGui::TextColored({0.9f, 0.2f, 0.1f, 1.0f}, "[ERROR]   - %s",
+                                           message.m_message.c_str());
                         break;
-                    ImGui::TextColored({0.9f, 0.2f, 0.1f, 1.0f}, "[ERROR]   - %s",
-                                       message.m_message.c_str());
-                    break;
-                case Log::ReportLevel::REPORT_DEBUG:
-                    ImGui::TextColored({0.3f, 0.4f, 0.9f, 1.0f}, "[DEBUG]   - %s",
-                                       message.m_message.c_str());
-                    break;
+                    case Log::ReportLevel::REPORT_DEBUG:
+                        ImGui::TextColored({0.3f, 0.4f, 0.9f, 1.0f}, "[DEBUG]   - %s",
+                                           message.m_message.c_str());
+                        break;
+                    }
                 }
             }
+            clipper.End();
 
             if (m_scroll_requested) {
                 if (is_auto_scroll_mode)
@@ -933,9 +933,53 @@ namespace Toolbox {
         DolphinCommunicator &communicator = GUIApplication::instance().getDolphinCommunicator();
 
         u32 application_ptr = 0x803E9700;
-        u32 gamepad_ptr = communicator.read<u32>(application_ptr + 0x20 + (m_port << 2)).value();
+        u32 gamepad_ptr     = 0;
+        u32 rumble_ptr      = 0;
+        {
+            Dolphin::MemoryTransaction transaction;
+            transaction.read(application_ptr + 0x20 + (m_port << 2), gamepad_ptr);
+            transaction.read(0x804141C0 - 0x60F0, rumble_ptr);
+            auto result = transaction.commit(communicator.manager());
+            if (!result) {
+                return std::unexpected(result.error());
+            }
+        }
+
+        PadFrameData frame_data{};
+        u8 connection_status = 0xFF;
+        u32 rumble_data_ptr  = 0;
+        {
+            u32 held_buttons    = 0;
+            u32 pressed_buttons = 0;
+
+            // The pad's fields sit close enough to merge into one read
+            Dolphin::MemoryTransaction transaction;
+            transaction.read(gamepad_ptr + 0x18, held_buttons);
+            transaction.read(gamepad_ptr + 0x1C, pressed_buttons);
+            transaction.read(gamepad_ptr + 0x26, frame_data.m_trigger_l);
+            transaction.read(gamepad_ptr + 0x27, frame_data.m_trigger_r);
+            transaction.read(gamepad_ptr + 0x48, frame_data.m_stick_x);
+            transaction.read(gamepad_ptr + 0x4C, frame_data.m_stick_y);
+            transaction.read(gamepad_ptr + 0x50, frame_data.m_stick_mag);
+            transaction.read(gamepad_ptr + 0x54, frame_data.m_stick_angle);
+            transaction.read(gamepad_ptr + 0x58, frame_data.m_c_stick_x);
+            transaction.read(gamepad_ptr + 0x5C, frame_data.m_c_stick_y);
+            transaction.read(gamepad_ptr + 0x60, frame_data.m_c_stick_mag);
+            transaction.read(gamepad_ptr + 0x64, frame_data.m_c_stick_angle);
+            transaction.read(gamepad_ptr + 0x7A, connection_status);
+            if (rumble_ptr) {
+                transaction.read(rumble_ptr + 0xC + (m_port << 2), rumble_data_ptr);
+            }
+            auto result = transaction.commit(communicator.manager());
+            if (!result) {
+                return std::unexpected(result.error());
+            }
+
+            frame_data.m_held_buttons    = static_cast<PadButtons>(held_buttons);
+            frame_data.m_pressed_buttons = static_cast<PadButtons>(pressed_buttons);
+        }
 
-        bool is_connected = communicator.read<u8>(gamepad_ptr + 0x7A).value() != 0xFF;
+        bool is_connected = connection_status != 0xFF;
         if (!is_connected) {
             TOOLBOX_ERROR("[PAD RECORD] Controller is not connected. Please ensure that "
                           "the controller is "
@@ -946,35 +990,15 @@ namespace Toolbox {
                                             "connected and the input is being read by Dolphin.");
         }
 
-        PadFrameData frame_data{};
-        {
-            frame_data.m_held_buttons =
-                static_cast<PadButtons>(communicator.read<u32>(gamepad_ptr + 0x18).value());
-            frame_data.m_pressed_buttons =
-                static_cast<PadButtons>(communicator.read<u32>(gamepad_ptr + 0x1C).value());
-
-            frame_data.m_trigger_l = communicator.read<u8>(gamepad_ptr + 0x26).value();
-            frame_data.m_trigger_r = communicator.read<u8>(gamepad_ptr + 0x27).value();
-
-            frame_data.m_stick_x = communicator.read<f32>(gamepad_ptr + 0x48).value();
-            frame_data.m_stick_y = communicator.read<f32>(gamepad_ptr + 0x4C).value();
-
-            frame_data.m_stick_mag   = communicator.read<f32>(gamepad_ptr + 0x50).value();
-            frame_data.m_stick_angle = communicator.read<s16>(gamepad_ptr + 0x54).value();
-
-            frame_data.m_c_stick_x = communicator.read<f32>(gamepad_ptr + 0x58).value();
-            frame_data.m_c_stick_y = communicator.read<f32>(gamepad_ptr + 0x5C).value();
-
-            frame_data.m_c_stick_mag   = communicator.read<f32>(gamepad_ptr + 0x60).value();
-            frame_data.m_c_stick_angle = communicator.read<s16>(gamepad_ptr + 0x64).value();
-
-            frame_data.m_rumble_x = 0.0f;
-            frame_data.m_rumble_y = 0.0f;
-            u32 rumble_ptr        = communicator.read<u32>(0x804141C0 - 0x60F0).value();
-            if (rumble_ptr) {
-                u32 data_ptr = communicator.read<u32>(rumble_ptr + 0xC + (m_port << 2)).value();
-                frame_data.m_rumble_x = communicator.read<f32>(data_ptr + 0x0).value();
-                frame_data.m_rumble_y = communicator.read<f32>(data_ptr + 0x4).value();
+        frame_data.m_rumble_x = 0.0f;
+        frame_data.m_rumble_y = 0.0f;
+        if (rumble_ptr) {
+            Dolphin::MemoryTransaction transaction;
+            transaction.read(rumble_data_ptr + 0x0, frame_data.m_rumble_x);
+            transaction.read(rumble_data_ptr + 0x4, frame_data.m_rumble_y);
+            auto result = transaction.commit(communicator.manager());
+            if (!result) {
+                return std::unexpected(result.error());
             }
         }
         return frame_data;
@@ -0,0 +1,133 @@
+#include <algorithm>
+
+#include "gui/scene/bvh.hpp"
+
+namespace Toolbox::UI {
+
+    BVHBounds BVHBounds::FromBox(const glm::vec3 &min, const glm::vec3 &max,
+                                 const glm::mat4x4 &transform) {
+        BVHBounds bounds;
+        for (int i = 0; i < 8; ++i) {
+            glm::vec4 corner = {(i & 1) ? max.x : min.x, (i & 2) ? max.y : min.y,
+                                (i & 4) ? max.z : min.z, 1.0f};
+            glm::vec3 world  = glm::vec3(transform * corner);
+            bounds.m_min     = glm::min(bounds.m_min, world);
+            bounds.m_max     = glm::max(bounds.m_max, world);
+        }
+        return bounds;
+    }
+
+    BVHBounds BVHBounds::FromSphere(const glm::vec3 &center, float radius) {
+        BVHBounds bounds;
+        bounds.m_min = center - glm::vec3(radius);
+        bounds.m_max = center + glm::vec3(radius);
+        return bounds;
+    }
+
+    bool BVHBounds::intersectRay(const glm::vec3 &origin, const glm::vec3 &inv_direction,
+                                 float max_distance, float &distance) const {
+        float t_min = 0.0f;
+        float t_max = max_distance;
+
+        for (int i = 0; i < 3; ++i) {
+            float t1 = (m_min[i] - origin[i]) * inv_direction[i];
+            float t2 = (m_max[i] - origin[i]) * inv_direction[i];
+
+            t_min = std::max(t_min, std::min(t1, t2));
+            t_max = std::min(t_max, std::max(t1, t2));
+        }
+
+        if (t_min > t_max) {
+            return false;
+        }
+
+        distance = t_min;
+        return true;
+    }
+
+    void BoundingVolumeHierarchy::build(const std::vector<BVHBounds> &bounds) {
+        clear();
+        if (bounds.empty()) {
+            return;
+        }
+
+        m_nodes.reserve(bounds.size() * 2 - 1);
+        m_leaves.resize(bounds.size(), c_no_node);
+
+        std::vector<u32> items(bounds.size());
+        for (size_t i = 0; i < items.size(); ++i) {
+            items[i] = static_cast<u32>(i);
+        }
+
+        buildNode(bounds, items, 0, items.size(), c_no_node);
+    }
+
+    void BoundingVolumeHierarchy::refit(size_t item, const BVHBounds &bounds) {
+        if (item >= m_leaves.size()) {
+            return;
+        }
+
+        u32 index               = m_leaves[item];
+        m_nodes[index].m_bounds = bounds;
+
+        for (index = m_nodes[index].m_parent; index != c_no_node;
+             index = m_nodes[index].m_parent) {
+            Node &node    = m_nodes[index];
+            node.m_bounds = m_nodes[node.m_left].m_bounds;
+            node.m_bounds.expand(m_nodes[node.m_right].m_bounds);
+        }
+    }
+
+    void BoundingVolumeHierarchy::clear() {
+        m_nodes.clear();
+        m_leaves.clear();
+    }
+
+    u32 BoundingVolumeHierarchy::buildNode(const std::vector<BVHBounds> &bounds,
+                                           std::vector<u32> &items, size_t begin, size_t end,
+                                           u32 parent) {
+        u32 index = static_cast<u32>(m_nodes.size());
+        m_nodes.emplace_back().m_parent = parent;
+
+        if (end - begin == 1) {
+            m_nodes[index].m_bounds = bounds[items[begin]];
+            m_nodes[index].m_item   = items[begin];
+            m_leaves[items[begin]]  = index;
+            return index;
+        }
+
+        // Split at the median of the centers along their widest axis
+        BVHBounds centers;
+        for (size_t i = begin; i < end; ++i) {
+            glm::vec3 center = bounds[items[i]].center();
+            centers.m_min    = glm::min(centers.m_min, center);
+            centers.m_max    = glm::max(centers.m_max, center);
+        }
+
+        glm::vec3 extent = centers.m_max - centers.m_min;
+        int axis         = 0;
+        if (extent.y > extent[axis]) {
+            axis = 1;
+        }
+        if (extent.z > extent[axis]) {
+            axis = 2;
+        }
+
+        size_t middle = begin + (end - begin) / 2;
+        std::nth_element(items.begin() + begin, items.begin() + middle, items.begin() + end,
+                         [&](u32 a, u32 b) {
+                             return bounds[a].center()[axis] < bounds[b].center()[axis];
+                         });
+
+        u32 left  = buildNode(bounds, items, begin, middle, index);
+        u32 right = buildNode(bounds, items, middle, end, index);
+
+        Node &node    = m_nodes[index];
+        node.m_left   = left;
+        node.m_right  = right;
+        node.m_bounds = m_nodes[left].m_bounds;
+        node.m_bounds.expand(m_nodes[right].m_bounds);
+        return index;
+    }
+
+}  // namespace Toolbox::UI
@@ -122,7 +122,7 @@ namespace Toolbox::UI {
                                                           .m_name.c_str(),
                                   ImGuiComboFlags_PopupAlignLeft)) {
                 if (m_template_index != -1) {
-                    auto wizards                = m_templates.at(m_template_index)->wizards();
+                    const auto &wizards         = m_templates.at(m_template_index)->wizards();
                     bool needs_internal_default = wizards.size() <= 1;
 
                     // True default should be skipped if a custom default is configured
@@ -40,6 +40,62 @@ namespace Toolbox::UI {
             }\n\
         }";
 
+    // Draws a line per instance from gl_VertexID, it stops where the
+    // arrowhead starts so neither overlaps the target node. Zero-length
+    // connections have no direction and collapse onto `from`
+    const char *line_vtx_shader_source = "#version 330\n\
+        layout (location = 0) in vec3 from;\n\
+        layout (location = 1) in vec3 to;\n\
+        layout (location = 2) in vec4 color;\n\
+        out vec4 line_color;\n\
+        uniform mat4 gpu_ModelViewProjectionMatrix;\n\
+        uniform float headSize;\n\
+        void main()\n\
+        {\n\
+            vec3 position = from;\n\
+            float len = length(to - from);\n\
+            if (gl_VertexID == 1 && len > 0.0001) {\n\
+                position = to - (to - from) / len * min(headSize, len);\n\
+            }\n\
+            gl_Position = gpu_ModelViewProjectionMatrix * vec4(position, 1.0);\n\
+            line_color = color;\n\
+        }";
+
+    // Draws an arrowhead per instance from gl_VertexID, the tip sits
+    // short of the target node and the barbs face the camera. Degenerate
+    // directions are guarded so they never produce NaN vertices
+    const char *arrow_vtx_shader_source = "#version 330\n\
+        layout (location = 0) in vec3 from;\n\
+        layout (location = 1) in vec3 to;\n\
+        layout (location = 2) in vec4 color;\n\
+        out vec4 line_color;\n\
+        uniform mat4 gpu_ModelViewProjectionMatrix;\n\
+        uniform vec3 eyePosition;\n\
+        uniform float headSize;\n\
+        void main()\n\
+        {\n\
+            vec3 position = to;\n\
+            float len = length(to - from);\n\
+            if (len > 0.0001) {\n\
+                vec3 dir = (to - from) / len;\n\
+                float size = min(headSize, len);\n\
+                vec3 side = cross(dir, eyePosition - to);\n\
+                if (dot(side, side) < 0.0001) {\n\
+                    side = cross(dir, abs(dir.y) < 0.99 ? vec3(0.0, 1.0, 0.0)\n\
+                                                        : vec3(1.0, 0.0, 0.0));\n\
+                }\n\
+                side = normalize(side);\n\
+                position = to - dir * size;\n\
+                if (gl_VertexID == 1) {\n\
+                    position += (side * 0.5 - dir * 0.866) * size;\n\
+                } else if (gl_VertexID == 2) {\n\
+                    position += (-side * 0.5 - dir * 0.866) * size;\n\
+                }\n\
+            }\n\
+            gl_Position = gpu_ModelViewProjectionMatrix * vec4(position, 1.0);\n\
+            line_color = color;\n\
+        }";
+
     bool PathRenderer::initPathRenderer() {
 
         if (!Toolbox::UI::Render::CompileShader(path_vtx_shader_source, nullptr,
@@ -48,9 +104,27 @@ namespace Toolbox::UI {
             return false;
         }
 
+        if (!Toolbox::UI::Render::CompileShader(line_vtx_shader_source, nullptr,
+                                                path_frg_shader_source, m_line_program)) {
+            return false;
+        }
+
+        if (!Toolbox::UI::Render::CompileShader(arrow_vtx_shader_source, nullptr,
+                                                path_frg_shader_source, m_arrow_program)) {
+            return false;
+        }
+
         m_mvp_uniform  = glGetUniformLocation(m_program, "gpu_ModelViewProjectionMatrix");
         m_mode_uniform = glGetUniformLocation(m_program, "pointMode");
 
+        m_line_mvp_uniform  = glGetUniformLocation(m_line_program, "gpu_ModelViewProjectionMatrix");
+        m_line_size_uniform = glGetUniformLocation(m_line_program, "headSize");
+
+        m_arrow_mvp_uniform =
+            glGetUniformLocation(m_arrow_program, "gpu_ModelViewProjectionMatrix");
+        m_arrow_eye_uniform  = glGetUniformLocation(m_arrow_program, "eyePosition");
+        m_arrow_size_uniform = glGetUniformLocation(m_arrow_program, "headSize");
+
         glGenVertexArrays(1, &m_vao);
         glBindVertexArray(m_vao);
 
@@ -67,8 +141,27 @@ namespace Toolbox::UI {
         glVertexAttribIPointer(2, 1, GL_UNSIGNED_INT, sizeof(PathPoint),
                                (void *)offsetof(PathPoint, m_point_size));
 
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glGenVertexArrays(1, &m_arrow_vao);
+        glBindVertexArray(m_arrow_vao);
+
+        glGenBuffers(1, &m_arrow_vbo);
+        glBindBuffer(GL_ARRAY_BUFFER, m_arrow_vbo);
+
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(PathArrow),
+                              (void *)offsetof(PathArrow, m_from));
+        glVertexAttribDivisor(0, 1);
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(PathArrow),
+                              (void *)offsetof(PathArrow, m_to));
+        glVertexAttribDivisor(1, 1);
+        glEnableVertexAttribArray(2);
+        glVertexAttribPointer(2, 4, GL_FLOAT, GL_TRUE, sizeof(PathArrow),
+                              (void *)offsetof(PathArrow, m_color));
+        glVertexAttribDivisor(2, 1);
+
         glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
 
         return true;
     }
@@ -77,22 +170,21 @@ namespace Toolbox::UI {
 
     PathRenderer::~PathRenderer() {
         // This should check
-        m_path_connections.clear();
+        m_node_ranges.clear();
         glDeleteBuffers(1, &m_vbo);
+        glDeleteBuffers(1, &m_arrow_vbo);
         glDeleteVertexArrays(1, &m_vao);
+        glDeleteVertexArrays(1, &m_arrow_vao);
     }
 
     void PathRenderer::updateGeometry(const RailData &data,
                                       std::unordered_map<UUID64, bool> visible_map) {
         size_t rail_count = data.getRailCount();
 
-        if (rail_count == 0)
-            return;
-
-        glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-
-        // TODO: Render shortened lines with arrow tips for connections, fix color relations
-        m_path_connections.clear();
+        // TODO: fix color relations
+        m_points.clear();
+        m_arrows.clear();
+        m_node_ranges.clear();
 
         for (size_t i = 0; i < rail_count; ++i) {
             auto rail = data.getRail(i);
@@ -102,6 +194,8 @@ namespace Toolbox::UI {
 
             float node_hue = (static_cast<float>(i) / (rail_count - 1)) * 360.0f;
 
+            const std::vector<glm::vec3> &positions = rail->nodePositions();
+
             size_t node_count = rail->getNodeCount();
             for (size_t j = 0; j < node_count; ++j) {
                 Rail::Rail::node_ptr_t node = rail->nodes()[j];
@@ -112,39 +206,81 @@ namespace Toolbox::UI {
                 auto node_color =
                     Color::HSVToColor<Color::RGBShader>(node_hue, node_saturation, node_brightness);
 
-                PathConnection p_connection{};
-                p_connection.m_point = {
-                    node->getPosition(),
+                m_node_ranges[node->getUUID()].m_point = static_cast<uint32_t>(m_points.size());
+                m_points.push_back({
+                    positions[j],
                     {node_color.m_r, node_color.m_g, node_color.m_b, 1.0f},
                     128
-                };
+                });
+            }
+
+            // Each connection is one instance of both the line and the arrowhead
+            for (size_t j = 0; j < node_count; ++j) {
+                Rail::Rail::node_ptr_t node = rail->nodes()[j];
+                NodeRange &from_range       = m_node_ranges[node->getUUID()];
 
                 for (Rail::Rail::node_ptr_t connection : rail->getNodeConnections(node)) {
-                    PathPoint connectionPoint(
-                        connection->getPosition(),
-                        {node_color.m_r, node_color.m_g, node_color.m_b, 1.0f}, 128);
-                    p_connection.m_connections.push_back(connectionPoint);
-                };
-                m_path_connections.push_back(p_connection);
+                    auto to_it = m_node_ranges.find(connection->getUUID());
+                    if (to_it == m_node_ranges.end()) {
+                        continue;
+                    }
+                    NodeRange &to_range = to_it->second;
+
+                    from_range.m_arrows_from.push_back(static_cast<uint32_t>(m_arrows.size()));
+                    to_range.m_arrows_to.push_back(static_cast<uint32_t>(m_arrows.size()));
+                    m_arrows.push_back({m_points[from_range.m_point].m_position,
+                                        m_points[to_range.m_point].m_position,
+                                        m_points[from_range.m_point].m_color});
+                }
             }
         }
 
-        std::vector<PathPoint> buffer;
-        for (auto &connection : m_path_connections) {
-            // For the connecting points, we adjust back the end and add an arrowhead
-            for (auto &point : connection.m_connections) {
-                buffer.push_back(connection.m_point);
-                buffer.push_back(point);
-            }
-        }
+        glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(PathPoint) * m_points.size(), m_points.data(),
+                     GL_DYNAMIC_DRAW);
 
-        glBufferData(GL_ARRAY_BUFFER, sizeof(PathPoint) * buffer.size(), &buffer[0],
+        glBindBuffer(GL_ARRAY_BUFFER, m_arrow_vbo);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(PathArrow) * m_arrows.size(), m_arrows.data(),
                      GL_DYNAMIC_DRAW);
         glBindBuffer(GL_ARRAY_BUFFER, 0);
     }
 
+    void PathRenderer::updateNode(const Rail::RailNode &node) {
+        auto range_it = m_node_ranges.find(node.getUUID());
+        if (range_it == m_node_ranges.end()) {
+            return;
+        }
+        const NodeRange &range = range_it->second;
+
+        glm::vec3 position = node.getPosition();
+
+        m_points[range.m_point].m_position = position;
+
+        glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+        glBufferSubData(GL_ARRAY_BUFFER,
+                        range.m_point * sizeof(PathPoint) + offsetof(PathPoint, m_position),
+                        sizeof(glm::vec3), &position);
+
+        glBindBuffer(GL_ARRAY_BUFFER, m_arrow_vbo);
+        for (uint32_t arrow : range.m_arrows_from) {
+            m_arrows[arrow].m_from = position;
+            glBufferSubData(GL_ARRAY_BUFFER,
+                            arrow * sizeof(PathArrow) + offsetof(PathArrow, m_from),
+                            sizeof(glm::vec3), &position);
+        }
+        for (uint32_t arrow : range.m_arrows_to) {
+            m_arrows[arrow].m_to = position;
+            glBufferSubData(GL_ARRAY_BUFFER,
+                            arrow * sizeof(PathArrow) + offsetof(PathArrow, m_to),
+                            sizeof(glm::vec3), &position);
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
     void PathRenderer::drawPaths(Camera *camera) {
-        if (m_path_connections.size() == 0)
+        m_draw_calls = 0;
+
+        if (m_points.size() == 0)
             return;
 
         glEnable(GL_DEPTH_TEST);
@@ -165,65 +301,31 @@ namespace Toolbox::UI {
 
         glUniformMatrix4fv(m_mvp_uniform, 1, 0, &mvp[0][0]);
 
-        {
-            GLint start = 0;
+        glUniform1i(m_mode_uniform, GL_TRUE);
+        glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(m_points.size()));
+        m_draw_calls += 1;
 
-            glUniform1i(m_mode_uniform, GL_TRUE);
-            for (auto &connection : m_path_connections) {
-                // +1 for self
-                glDrawArrays(GL_POINTS, start, 1);
-                start += static_cast<GLint>(connection.m_connections.size() * 2);
-            }
-        }
+        if (m_arrows.size() > 0) {
+            glm::vec3 eye;
+            camera->getPos(eye);
 
-        {
-            GLint start = 0;
-
-            glUniform1i(m_mode_uniform, GL_FALSE);
-            for (auto &connection : m_path_connections) {
-                for (size_t i = 0; i < connection.m_connections.size(); ++i) {
-                    const PathPoint &self_point = connection.m_point;
-                    const PathPoint &to_point   = connection.m_connections[i];
-
-                    // Calculate the direction vector of the line segment
-                    glm::vec3 dir     = glm::normalize(to_point.m_position - self_point.m_position);
-
-                    // Shorten the line by some factor (e.g., arrowhead size)
-                    glm::vec3 adjusted_end_pos = to_point.m_position - dir * s_arrow_head_size;
-
-                    // Update the buffer with the new end point
-                    PathPoint adjusted_end_point = {adjusted_end_pos, to_point.m_color,
-                                                    to_point.m_point_size};
-                    /*glBufferSubData(GL_ARRAY_BUFFER, start * sizeof(PathPoint) + (i + 1) * sizeof(PathPoint),
-                                    sizeof(PathPoint), &adjusted_end_point);*/
-
-                    // Draw the shortened line segment
-                    glDrawArrays(GL_LINES, start, 2);
-                    start += 2;
-
-                    //// Draw arrowhead here (this could be a separate VAO/VBO setup for drawing a
-                    //// cone or a simple triangle) For a simple triangle arrowhead:
-                    //glm::quat leftRot =
-                    //    glm::rotate(rotQuat, glm::radians(150.0f), glm::vec3(0, 0, 1));
-                    //glm::quat rightRot =
-                    //    glm::rotate(rotQuat, glm::radians(210.0f), glm::vec3(0, 0, 1));
-
-                    //glm::vec3 left  = glm::rotate(leftRot, dir) * s_arrow_head_size;
-                    //glm::vec3 right = glm::rotate(rightRot, dir) * s_arrow_head_size;
-
-                    //PathPoint arrowhead[3] = {
-                    //    PathPoint(newEndPoint, line[i + 1].m_color, line[i + 1].m_point_size),
-                    //    PathPoint(newEndPoint + left, line[i + 1].m_color,
-                    //              line[i + 1].m_point_size),
-                    //    PathPoint(newEndPoint + right, line[i + 1].m_color,
-                    //              line[i + 1].m_point_size)};
-
-                    //glBufferSubData(GL_ARRAY_BUFFER, start * sizeof(PathPoint),
-                    //                3 * sizeof(PathPoint), arrowhead);
-                    //glDrawArrays(GL_TRIANGLES, start, 3);
-                    //start += 3;
-                }
-            }
+            glBindVertexArray(m_arrow_vao);
+
+            glUseProgram(m_line_program);
+
+            glUniformMatrix4fv(m_line_mvp_uniform, 1, 0, &mvp[0][0]);
+            glUniform1f(m_line_size_uniform, s_arrow_head_size);
+
+            glDrawArraysInstanced(GL_LINES, 0, 2, static_cast<GLsizei>(m_arrows.size()));
+
+            glUseProgram(m_arrow_program);
+
+            glUniformMatrix4fv(m_arrow_mvp_uniform, 1, 0, &mvp[0][0]);
+            glUniform3fv(m_arrow_eye_uniform, 1, &eye[0]);
+            glUniform1f(m_arrow_size_uniform, s_arrow_head_size);
+
+            glDrawArraysInstanced(GL_TRIANGLES, 0, 3, static_cast<GLsizei>(m_arrows.size()));
+            m_draw_calls += 2;
         }
 
         glBindVertexArray(0);
@@ -2,6 +2,7 @@
 
 #include <J3D/Material/J3DUniformBufferObject.hpp>
 #include <J3D/Rendering/J3DRendering.hpp>
+#include <chrono>
 #include <iostream>
 #include <unordered_set>
 
@@ -14,11 +15,54 @@
 #include "gui/settings.hpp"
 #include "gui/util.hpp"
 
+#include <glm/gtc/matrix_access.hpp>
 #include <glm/gtx/euler_angles.hpp>
 
 static std::set<std::string> s_skybox_materials = {"_00_spline", "_01_nyudougumo", "_02_usugumo",
                                                    "_03_sky"};
 
+static const std::unordered_set<std::string_view> s_selection_blacklist = {
+    "Map",
+    "MapObjWave",
+    "Shimmer",
+    "Sky",
+};
+
+static constexpr float s_rail_node_radius = 64.0f;
+
+// Planes of the view frustum with their normals pointing inwards
+static void getFrustumPlanes(const glm::mat4 &viewProjection, glm::vec4 (&planes)[6]) {
+    glm::vec4 row0 = glm::row(viewProjection, 0);
+    glm::vec4 row1 = glm::row(viewProjection, 1);
+    glm::vec4 row2 = glm::row(viewProjection, 2);
+    glm::vec4 row3 = glm::row(viewProjection, 3);
+
+    planes[0] = row3 + row0;  // Left
+    planes[1] = row3 - row0;  // Right
+    planes[2] = row3 + row1;  // Bottom
+    planes[3] = row3 - row1;  // Top
+    planes[4] = row3 + row2;  // Near
+    planes[5] = row3 - row2;  // Far
+}
+
+static bool isBoundsInFrustum(const glm::vec4 (&planes)[6], const Toolbox::UI::BVHBounds &bounds) {
+    for (const glm::vec4 &plane : planes) {
+        // The corner furthest along the plane's normal
+        glm::vec3 corner = {plane.x >= 0.0f ? bounds.m_max.x : bounds.m_min.x,
+                            plane.y >= 0.0f ? bounds.m_max.y : bounds.m_min.y,
+                            plane.z >= 0.0f ? bounds.m_max.z : bounds.m_min.z};
+        if (glm::dot(glm::vec3(plane), corner) + plane.w < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static float getBoundsDistanceSq(const Toolbox::UI::BVHBounds &bounds, const glm::vec3 &point) {
+    glm::vec3 delta = glm::max(glm::max(bounds.m_min - point, point - bounds.m_max), 0.0f);
+    return glm::dot(delta, delta);
+}
+
 // Utility function to convert 2D screen space coordinates to a 3D ray in world space
 static std::pair<glm::vec3, glm::vec3>
 getRayFromMouse(const glm::vec2 &mousePos, Toolbox::Camera &camera, const glm::vec4 &viewport) {
@@ -83,19 +127,17 @@ static bool intersectRayAABB(const glm::vec3 &rayOrigin, const glm::vec3 &rayDir
     return true;
 }
 
+// Distances are along the world space ray, so they compare with other shapes
 static bool intersectRayOBB(const glm::vec3 &rayOrigin, const glm::vec3 &rayDirection,
                             const glm::vec3 &obbMin, const glm::vec3 &obbMax,
-                            const glm::mat4 &obbTransform, float &intersectionDistance) {
-    // Inverse OBB transformation matrix to transform the ray into OBB's local space
-    glm::mat4 invTransform = glm::inverse(obbTransform);
-
+                            const glm::mat4 &obbInvTransform, float &intersectionDistance) {
     // Transform the ray origin and direction into the OBB's local space
-    glm::vec4 localRayOrigin    = invTransform * glm::vec4(rayOrigin, 1.0f);
-    glm::vec4 localRayDirection = invTransform * glm::vec4(rayDirection, 0.0f);
+    glm::vec4 localRayOrigin    = obbInvTransform * glm::vec4(rayOrigin, 1.0f);
+    glm::vec4 localRayDirection = obbInvTransform * glm::vec4(rayDirection, 0.0f);
 
     // Perform AABB intersection test in local space
-    return intersectRayAABB(glm::vec3(localRayOrigin), glm::normalize(glm::vec3(localRayDirection)),
-                            obbMin, obbMax, intersectionDistance);
+    return intersectRayAABB(glm::vec3(localRayOrigin), glm::vec3(localRayDirection), obbMin,
+                            obbMax, intersectionDistance);
 }
 
 static bool intersectRaySphere(const glm::vec3 &rayOrigin, const glm::vec3 &rayDirection,
@@ -135,31 +177,88 @@ static bool intersectRaySphere(const glm::vec3 &rayOrigin, const glm::vec3 &rayD
 
 namespace Toolbox::UI {
     namespace Render {
-        void PacketSort(J3D::Rendering::RenderPacketVector packets) {
-            std::sort(packets.begin(), packets.end(),
-                      [](const J3DRenderPacket &a, const J3DRenderPacket &b) -> bool {
-                          // Sort bias
-                          {
-                              u8 sort_bias_a = static_cast<u8>((a.SortKey & 0xFF000000) >> 24);
-                              u8 sort_bias_b = static_cast<u8>((b.SortKey & 0xFF000000) >> 24);
-                              if (sort_bias_a != sort_bias_b) {
-                                  return sort_bias_a > sort_bias_b;
-                              }
-                          }
-
-                          // Opaque or alpha test
-                          {
-                              u8 sort_alpha_a = static_cast<u8>((a.SortKey & 0x800000) >> 23);
-                              u8 sort_alpha_b = static_cast<u8>((b.SortKey & 0x800000) >> 23);
-                              if (sort_alpha_a != sort_alpha_b) {
-                                  return sort_alpha_a > sort_alpha_b;
-                              }
-                          }
-
-                          return a.Material->Name < b.Material->Name;
-                      });
+        namespace {
+            bool PacketLess(const J3DRenderPacket &a, const J3DRenderPacket &b) {
+                // Sort bias
+                {
+                    u8 sort_bias_a = static_cast<u8>((a.SortKey & 0xFF000000) >> 24);
+                    u8 sort_bias_b = static_cast<u8>((b.SortKey & 0xFF000000) >> 24);
+                    if (sort_bias_a != sort_bias_b) {
+                        return sort_bias_a > sort_bias_b;
+                    }
+                }
+
+                // Opaque or alpha test
+                {
+                    u8 sort_alpha_a = static_cast<u8>((a.SortKey & 0x800000) >> 23);
+                    u8 sort_alpha_b = static_cast<u8>((b.SortKey & 0x800000) >> 23);
+                    if (sort_alpha_a != sort_alpha_b) {
+                        return sort_alpha_a > sort_alpha_b;
+                    }
+                }
+
+                return a.Material->Name < b.Material->Name;
+            }
+
+            // Where each material landed in the last sort. The order only
+            // depends on the material, so from one frame to the next it
+            // only changes for materials that weren't drawn before.
+            std::unordered_map<const J3DMaterial *, u32> s_material_ranks;
+            f64 s_packet_sort_time = 0.0;
+        }  // namespace
+
+        void PacketSort(J3D::Rendering::RenderPacketVector &packets) {
+            auto sort_start = std::chrono::steady_clock::now();
+
+            // Counting sort by last frame's rank, unranked packets go last
+            const u32 unranked = static_cast<u32>(s_material_ranks.size());
+
+            std::vector<u32> ranks(packets.size());
+            std::vector<size_t> rank_starts(static_cast<size_t>(unranked) + 2, 0);
+            for (size_t i = 0; i < packets.size(); ++i) {
+                auto rank_it = s_material_ranks.find(packets[i].Material.get());
+                ranks[i]     = rank_it != s_material_ranks.end() ? rank_it->second : unranked;
+                rank_starts[ranks[i] + 1] += 1;
+            }
+            for (size_t i = 1; i < rank_starts.size(); ++i) {
+                rank_starts[i] += rank_starts[i - 1];
+            }
+
+            std::vector<size_t> order(packets.size());
+            for (size_t i = 0; i < packets.size(); ++i) {
+                order[rank_starts[ranks[i]]++] = i;
+            }
+
+            J3D::Rendering::RenderPacketVector placed;
+            placed.reserve(packets.size());
+            for (size_t i : order) {
+                placed.emplace_back(std::move(packets[i]));
+            }
+            packets = std::move(placed);
+
+            // The ranked run is sorted unless a material changed, only the
+            // new packets need a full sort before merging them in
+            auto unranked_begin =
+                packets.begin() + (unranked > 0 ? rank_starts[unranked - 1] : 0);
+            if (!std::is_sorted(packets.begin(), unranked_begin, PacketLess)) {
+                std::sort(packets.begin(), unranked_begin, PacketLess);
+            }
+            std::sort(unranked_begin, packets.end(), PacketLess);
+            std::inplace_merge(packets.begin(), unranked_begin, packets.end(), PacketLess);
+
+            s_material_ranks.clear();
+            for (const J3DRenderPacket &packet : packets) {
+                s_material_ranks.try_emplace(packet.Material.get(),
+                                             static_cast<u32>(s_material_ranks.size()));
+            }
+
+            s_packet_sort_time = std::chrono::duration<f64, std::milli>(
+                                     std::chrono::steady_clock::now() - sort_start)
+                                     .count();
         }
 
+        f64 GetPacketSortTime() { return s_packet_sort_time; }
+
         bool CompileShader(const char *vertex_shader_src, const char *geometry_shader_src,
                            const char *fragment_shader_src, uint32_t &program_id_out) {
 
@@ -311,7 +410,8 @@ namespace Toolbox::UI {
         glDeleteTextures(1, &m_tex_id);
     }
 
-    void Renderer::render(std::vector<ISceneObject::RenderInfo> renderables, TimeStep delta_time) {
+    void Renderer::render(const std::vector<ISceneObject::RenderInfo> &renderables,
+                          TimeStep delta_time) {
         ImGuiStyle &style = ImGui::GetStyle();
 
         ImVec2 window_pos = ImGui::GetWindowPos();
@@ -321,6 +421,11 @@ namespace Toolbox::UI {
         };
         m_window_size_prev = m_window_size;
         m_window_size      = ImGui::GetWindowSize();
+
+        // The view is otherwise only redrawn when something changed
+        if (m_window_size.x != m_window_size_prev.x || m_window_size.y != m_window_size_prev.y) {
+            m_is_view_dirty = true;
+        }
         m_render_rect      = {m_window_rect.Min + style.WindowPadding,
                               m_window_rect.Max};
 
@@ -398,9 +503,7 @@ namespace Toolbox::UI {
             }
 
             std::vector<RefPtr<J3DModelInstance>> models = {};
-            for (auto &renderable : renderables) {
-                models.push_back(renderable.m_model);
-            }
+            cullRenderables(renderables, models);
 
             J3D::Rendering::RenderPacketVector packets =
                 J3D::Rendering::SortPackets(models, position);
@@ -408,6 +511,9 @@ namespace Toolbox::UI {
 
             m_path_renderer.drawPaths(&m_camera);
             m_billboard_renderer.drawBillboards(&m_camera);
+
+            m_draw_calls = packets.size() + m_path_renderer.getDrawCallCount() +
+                           m_billboard_renderer.getDrawCallCount();
             m_is_view_dirty = false;
         }
         viewportEnd();
@@ -421,6 +527,139 @@ namespace Toolbox::UI {
     void Renderer::initializePaths(const RailData &rail_data,
                                    std::unordered_map<UUID64, bool> visible_map) {
         m_path_renderer.updateGeometry(rail_data, visible_map);
+
+        m_selection_nodes.clear();
+        m_selection_node_indices.clear();
+
+        std::vector<BVHBounds> bounds;
+        for (auto &rail : rail_data) {
+            if (visible_map.contains(rail->getUUID()) && visible_map[rail->getUUID()] == false) {
+                continue;
+            }
+            const std::vector<glm::vec3> &positions = rail->nodePositions();
+            for (size_t i = 0; i < rail->getNodeCount(); ++i) {
+                const Rail::Rail::node_ptr_t &node = rail->nodes()[i];
+                m_selection_node_indices[node->getUUID()] = m_selection_nodes.size();
+                m_selection_nodes.push_back(node);
+                bounds.push_back(BVHBounds::FromSphere(positions[i], s_rail_node_radius));
+            }
+        }
+        m_selection_node_bvh.build(bounds);
+    }
+
+    void Renderer::updatePathNode(const Rail::RailNode &node) {
+        m_path_renderer.updateNode(node);
+        m_is_view_dirty = true;
+
+        auto index_it = m_selection_node_indices.find(node.getUUID());
+        if (index_it != m_selection_node_indices.end()) {
+            m_selection_node_bvh.refit(index_it->second,
+                                       BVHBounds::FromSphere(node.getPosition(),
+                                                             s_rail_node_radius));
+        }
+    }
+
+    bool Renderer::MakeRenderBounds(const ISceneObject::RenderInfo &renderable,
+                                    RenderBounds &bounds, SelectionBox &box) {
+        const std::string type = renderable.m_object->type();
+
+        glm::mat4x4 obb_transform = glm::identity<glm::mat4x4>();
+        obb_transform = glm::translate(obb_transform, renderable.m_transform.m_translation);
+
+        glm::mat4x4 obb_rot_mtx = glm::eulerAngleXYZ(renderable.m_transform.m_rotation.x,
+                                                     renderable.m_transform.m_rotation.y,
+                                                     renderable.m_transform.m_rotation.z);
+
+        obb_transform = obb_transform * obb_rot_mtx;
+
+        if (type != "SunModel") {
+            obb_transform = glm::scale(obb_transform, renderable.m_transform.m_scale);
+        }
+
+        // Bounding box is local
+        renderable.m_model->GetBoundingBox(box.m_min, box.m_max);
+
+        // The sky follows the camera
+        bounds.m_bounds      = BVHBounds::FromBox(box.m_min, box.m_max, obb_transform);
+        bounds.m_is_cullable = type != "Sky";
+
+        if (s_selection_blacklist.contains(type)) {
+            return false;
+        }
+
+        box.m_object        = renderable.m_object;
+        box.m_inv_transform = glm::inverse(obb_transform);
+        box.m_bounds        = bounds.m_bounds;
+        return true;
+    }
+
+    void Renderer::updateRenderables(const std::vector<ISceneObject::RenderInfo> &renderables) {
+        m_render_bounds.resize(renderables.size());
+
+        m_selection_boxes.clear();
+        m_selection_box_indices.assign(renderables.size(), c_not_selectable);
+
+        std::vector<BVHBounds> bounds;
+        for (size_t i = 0; i < renderables.size(); ++i) {
+            SelectionBox box;
+            if (!MakeRenderBounds(renderables[i], m_render_bounds[i], box)) {
+                continue;
+            }
+            m_selection_box_indices[i] = m_selection_boxes.size();
+            bounds.push_back(box.m_bounds);
+            m_selection_boxes.emplace_back(std::move(box));
+        }
+        m_selection_box_bvh.build(bounds);
+    }
+
+    void Renderer::updateRenderable(size_t index, const ISceneObject::RenderInfo &renderable) {
+        if (index >= m_render_bounds.size()) {
+            return;
+        }
+
+        SelectionBox box;
+        if (!MakeRenderBounds(renderable, m_render_bounds[index], box)) {
+            return;
+        }
+
+        size_t box_index = m_selection_box_indices[index];
+        if (box_index != c_not_selectable) {
+            m_selection_box_bvh.refit(box_index, box.m_bounds);
+            m_selection_boxes[box_index] = std::move(box);
+        }
+    }
+
+    void Renderer::cullRenderables(const std::vector<ISceneObject::RenderInfo> &renderables,
+                                   std::vector<RefPtr<J3DModelInstance>> &models) {
+        const AppSettings &settings = SettingsManager::instance().getCurrentProfile();
+
+        glm::vec3 position;
+        m_camera.getPos(position);
+
+        glm::vec4 planes[6];
+        getFrustumPlanes(m_camera.getProjMatrix() * m_camera.getViewMatrix(), planes);
+
+        const float max_distance_sq = settings.m_render_distance * settings.m_render_distance;
+
+        models.reserve(renderables.size());
+        m_visible_count = 0;
+        m_culled_count  = 0;
+
+        for (size_t i = 0; i < renderables.size(); ++i) {
+            // Renderables not yet given to updateRenderables are never culled
+            if (i < m_render_bounds.size() && m_render_bounds[i].m_is_cullable) {
+                const BVHBounds &bounds = m_render_bounds[i].m_bounds;
+                if (!isBoundsInFrustum(planes, bounds) ||
+                    (max_distance_sq > 0.0f &&
+                     getBoundsDistanceSq(bounds, position) > max_distance_sq)) {
+                    m_culled_count += 1;
+                    continue;
+                }
+            }
+
+            models.push_back(renderables[i].m_model);
+            m_visible_count += 1;
+        }
     }
 
     void Renderer::initializeBillboards() {
@@ -545,13 +784,14 @@ namespace Toolbox::UI {
             ImGui::Text(camera_dir_str.c_str());
         }
 
-        {
-            std::string fps_str = std::format("{:.2f} FPS", ImGui::GetIO().Framerate);
-
-            ImVec2 text_size = ImGui::CalcTextSize(fps_str.c_str());
+        // Stats are stacked up from the bottom right corner
+        auto render_stat = [&](const std::string &stat_str, size_t row) {
+            ImVec2 text_size = ImGui::CalcTextSize(stat_str.c_str());
 
-            ImGui::SetCursorPos({m_window_size.x - text_size.x - window_padding.x,
-                                 m_window_size.y - text_box_height - window_padding.y});
+            ImGui::SetCursorPos(
+                {m_window_size.x - text_size.x - window_padding.x,
+                 m_window_size.y - text_box_height * static_cast<float>(row + 1) -
+                     window_padding.y});
 
             ImVec2 text_pos = ImGui::GetCursorScreenPos();
 
@@ -560,8 +800,13 @@ namespace Toolbox::UI {
             draw_list->AddRectFilled(text_pos, text_pos + text_size,
                                      ImGui::GetColorU32(text_bg_color));
 
-            ImGui::Text(fps_str.c_str());
-        }
+            ImGui::Text(stat_str.c_str());
+        };
+
+        render_stat(std::format("{:.2f} FPS", ImGui::GetIO().Framerate), 0);
+        render_stat(std::format("{} Draw Calls", m_draw_calls), 1);
+        render_stat(std::format("{} Visible / {} Culled", m_visible_count, m_culled_count), 2);
+        render_stat(std::format("Sort {:.3f} ms", Render::GetPacketSortTime()), 3);
 
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
     }
@@ -645,10 +890,7 @@ namespace Toolbox::UI {
         return true;
     }
 
-    Renderer::selection_variant_t
-    Renderer::findSelection(std::vector<ISceneObject::RenderInfo> renderables,
-                            std::vector<RefPtr<Rail::RailNode>> rail_nodes,
-                            bool &should_reset) {
+    Renderer::selection_variant_t Renderer::findSelection(bool &should_reset) {
         should_reset = false;
         if (!m_is_window_hovered || !m_is_window_focused) {
             return std::nullopt;
@@ -679,66 +921,33 @@ namespace Toolbox::UI {
                                       m_window_rect.Max.x - m_window_rect.Min.x,
                                       m_window_rect.Max.y - m_window_rect.Min.y));
 
-        const std::unordered_set<std::string> selection_blacklist = {
-            "Map",
-            "MapObjWave",
-            "Shimmer",
-            "Sky",
-        };
-
         float nearest_intersection = std::numeric_limits<float>::max();
 
         selection_variant_t selected_item = std::nullopt;
 
-        for (auto &renderable : renderables) {
-            if (selection_blacklist.contains(renderable.m_object->type())) {
-                continue;
-            }
-
-            glm::vec3 min, max;
-
-            // Bounding box is local
-            renderable.m_model->GetBoundingBox(min, max);
-
-            glm::mat4x4 obb_transform = glm::identity<glm::mat4x4>();
-            obb_transform = glm::translate(obb_transform, renderable.m_transform.m_translation);
-
-            glm::mat4x4 obb_rot_mtx = glm::eulerAngleXYZ(renderable.m_transform.m_rotation.x,
-                                                         renderable.m_transform.m_rotation.y,
-                                                         renderable.m_transform.m_rotation.z);
-
-            obb_transform = obb_transform * obb_rot_mtx;
-
-            if (renderable.m_object->type() != "SunModel") {
-                obb_transform = glm::scale(obb_transform, renderable.m_transform.m_scale);
-            }
-
-            float this_intersection;
-
-            // Perform ray-box intersection test
-            if (intersectRayOBB(rayOrigin, rayDirection, min, max, obb_transform,
-                                this_intersection)) {
-                // Intersection detected, check if nearest and use
-                if (this_intersection >= nearest_intersection) {
-                    continue;
-                }
-                nearest_intersection = this_intersection;
-                selected_item        = renderable.m_object;
-            }
+        std::optional<size_t> box_hit = m_selection_box_bvh.raycast(
+            rayOrigin, rayDirection,
+            [&](size_t index, float &intersection) {
+                const SelectionBox &box = m_selection_boxes[index];
+                return intersectRayOBB(rayOrigin, rayDirection, box.m_min, box.m_max,
+                                       box.m_inv_transform, intersection);
+            },
+            nearest_intersection);
+        if (box_hit) {
+            selected_item = m_selection_boxes[box_hit.value()].m_object;
         }
 
-        for (auto &node : rail_nodes) {
-            float this_intersection;
-
-            if (intersectRaySphere(rayOrigin, rayDirection, node->getPosition(), 64.0f,
-                                   this_intersection)) {
-                // Intersection detected, check if nearest and use
-                if (this_intersection >= nearest_intersection) {
-                    continue;
-                }
-                nearest_intersection = this_intersection;
-                selected_item        = node;
-            }
+        // Only nodes nearer than the object hit are searched
+        std::optional<size_t> node_hit = m_selection_node_bvh.raycast(
+            rayOrigin, rayDirection,
+            [&](size_t index, float &intersection) {
+                return intersectRaySphere(rayOrigin, rayDirection,
+                                          m_selection_nodes[index]->getPosition(),
+                                          s_rail_node_radius, intersection);
+            },
+            nearest_intersection);
+        if (node_hit) {
+            selected_item = m_selection_nodes[node_hit.value()];
         }
 
         return selected_item;
@@ -127,13 +127,26 @@ namespace Toolbox::UI {
 
             bool result = true;
 
+            // Assets still used by other scenes stay alive with their objects
+            Object::clearResourceCache();
+
             SceneInstance::FromPath(path)
                 .and_then([&](ScopePtr<SceneInstance> &&scene) {
                     m_current_scene = std::move(scene);
                     m_renderer.initializeData(*m_current_scene);
 
-                    m_resource_cache.m_model.clear();
-                    m_resource_cache.m_material.clear();
+                    m_current_scene->getObjHierarchy().getRoot()->setChangeCallback(
+                        [this](ISceneObject &object, ISceneObject::ChangeKind kind) {
+                            onObjectChanged(object, kind);
+                        });
+                    m_current_scene->getTableHierarchy().getRoot()->setChangeCallback(
+                        [this](ISceneObject &object, ISceneObject::ChangeKind kind) {
+                            onObjectChanged(object, kind);
+                        });
+                    m_update_render_objs = true;
+                    m_hierarchy_dirty    = true;
+
+                    Object::getResourceCache().logStatistics();
 
                     // Initialize the rail visibility map
                     for (RefPtr<Rail::Rail> rail : m_current_scene->getRailData().rails()) {
@@ -209,11 +222,16 @@ namespace Toolbox::UI {
 
         m_hierarchy_filter.Clear();
         m_hierarchy_selected_nodes.clear();
+        m_hierarchy_rows.clear();
+        m_table_rows.clear();
+        m_toggled_groups.clear();
+        m_hierarchy_dirty = true;
         m_selected_properties.clear();
         m_properties_render_handler = renderEmptyProperties;
 
         m_renderables.clear();
-        m_resource_cache = {};
+        m_renderable_indices.clear();
+        m_dirty_renderables.clear();
 
         m_rail_visible_map.clear();
         m_rail_list_selected_nodes.clear();
@@ -239,20 +257,12 @@ namespace Toolbox::UI {
             m_is_game_edit_mode = false;
         }
 
-        std::vector<RefPtr<Rail::RailNode>> rendered_nodes;
-        for (auto &rail : m_current_scene->getRailData().rails()) {
-            if (!m_rail_visible_map[rail->getUUID()])
-                continue;
-            rendered_nodes.insert(rendered_nodes.end(), rail->nodes().begin(), rail->nodes().end());
-        }
-
         if (ImGuizmo::IsOver()) {
             return;
         }
 
-        bool should_reset = false;
-        Renderer::selection_variant_t selection =
-            m_renderer.findSelection(m_renderables, rendered_nodes, should_reset);
+        bool should_reset                       = false;
+        Renderer::selection_variant_t selection = m_renderer.findSelection(should_reset);
 
         bool multi_select = Input::GetKey(KeyCode::KEY_LEFTCONTROL);
 
@@ -321,13 +331,31 @@ namespace Toolbox::UI {
             m_hierarchy_selected_nodes[0].m_selected->setTransform(obj_transform);
         }
 
-        if (m_is_game_edit_mode) {
+        if (m_is_game_edit_mode && task_communicator.isSceneLoaded()) {
             for (auto &renderable : m_renderables) {
                 if (s_game_blacklist.contains(renderable.m_object->type())) {
                     continue;
                 }
-                task_communicator.setObjectTransform(
-                    ref_cast<PhysicalSceneObject>(renderable.m_object), renderable.m_transform);
+
+                // This runs every frame, so each failure is only logged
+                // until the object succeeds again
+                UUID64 object_id = renderable.m_object->getUUID();
+                auto result      = task_communicator.setObjectTransform(
+                    ref_cast<PhysicalSceneObject>(renderable.m_object), renderable.m_transform,
+                    m_game_edit_transaction);
+                if (!result) {
+                    if (m_game_edit_failures.insert(object_id).second) {
+                        LogError(result.error());
+                    }
+                } else if (!m_game_edit_failures.empty()) {
+                    m_game_edit_failures.erase(object_id);
+                }
+            }
+
+            auto result = m_game_edit_transaction.commit(
+                GUIApplication::instance().getDolphinCommunicator().manager());
+            if (!result) {
+                LogError(result.error());
             }
         }
 
@@ -347,8 +375,6 @@ namespace Toolbox::UI {
             m_rail_node_drop_target = -1;
             m_rail_node_rail_uuid   = 0;
         }
-
-        m_update_render_objs = true;
     }
 
     void SceneWindow::onContextMenuEvent(RefPtr<ContextMenuEvent> ev) {}
@@ -372,6 +398,7 @@ namespace Toolbox::UI {
                 const Rail::Rail &rail = event->getRail();
                 m_current_scene->getRailData().addRail(rail);
                 m_rail_visible_map[rail.getUUID()] = true;
+                m_update_render_objs               = true;
                 ev->accept();
             }
             break;
@@ -420,7 +447,9 @@ void SceneWindow::renderHierarchy() {
         ImGui::SameLine();
 
         ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x);
-        m_hierarchy_filter.Draw("##obj_filter");
+        if (m_hierarchy_filter.Draw("##obj_filter")) {
+            m_hierarchy_dirty = true;
+        }
 
         ImGui::Text("Map Objects");
         if (ImGui::IsItemClicked(ImGuiMouseButton_Left) /* Check if scene is loaded here*/) {
@@ -429,11 +458,25 @@ void SceneWindow::renderHierarchy() {
 
         ImGui::Separator();
 
+        if (m_current_scene != nullptr && m_hierarchy_dirty) {
+            m_hierarchy_rows.clear();
+            m_table_rows.clear();
+            buildHierarchyRows(m_hierarchy_rows, 0, m_current_scene->getObjHierarchy().getRoot(),
+                               0);
+            buildHierarchyRows(m_table_rows, 0, m_current_scene->getTableHierarchy().getRoot(),
+                               0);
+            m_hierarchy_dirty = false;
+        }
+
+        m_hierarchy_selected_ids.clear();
+        for (const SelectionNodeInfo<Object::ISceneObject> &info : m_hierarchy_selected_nodes) {
+            m_hierarchy_selected_ids.insert(info.m_node_id);
+        }
+
         // Render Objects
 
         if (m_current_scene != nullptr) {
-            auto root = m_current_scene->getObjHierarchy().getRoot();
-            renderTree(0, root);
+            renderTree(m_hierarchy_rows);
         }
 
         ImGui::Spacing();
@@ -441,8 +484,7 @@ void SceneWindow::renderHierarchy() {
         ImGui::Separator();
 
         if (m_current_scene != nullptr) {
-            auto root = m_current_scene->getTableHierarchy().getRoot();
-            renderTree(0, root);
+            renderTree(m_table_rows);
         }
     }
     ImGui::End();
@@ -453,30 +495,76 @@ void SceneWindow::renderHierarchy() {
     }
 }
 
-void SceneWindow::renderTree(size_t node_index, RefPtr<Toolbox::Object::ISceneObject> node) {
+void SceneWindow::buildHierarchyRows(std::vector<HierarchyRow> &rows, size_t node_index,
+                                     RefPtr<Toolbox::Object::ISceneObject> node, size_t depth) {
+    std::string display_name = std::format("{} ({})", node->type(), node->getNameRef().name());
+    bool is_filtered_out     = !m_hierarchy_filter.PassFilter(display_name.c_str());
+
+    if (!node->isGroupObject()) {
+        if (!is_filtered_out) {
+            rows.push_back({node, node_index, depth, false});
+        }
+        return;
+    }
+
+    // Children of a filtered out group take its place
+    size_t child_depth = depth;
+    if (!is_filtered_out) {
+        bool is_open =
+            (node->getParent() == nullptr) != m_toggled_groups.contains(node->getUUID());
+        rows.push_back({node, node_index, depth, is_open});
+        if (!is_open) {
+            return;
+        }
+        child_depth += 1;
+    }
+
+    std::vector<RefPtr<ISceneObject>> children = node->getChildren();
+    for (size_t i = 0; i < children.size(); ++i) {
+        buildHierarchyRows(rows, i, children[i], child_depth);
+    }
+}
+
+void SceneWindow::renderTree(const std::vector<HierarchyRow> &rows) {
+    // Only the rows in view are submitted
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(rows.size()));
+    while (clipper.Step()) {
+        for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+            const HierarchyRow &row = rows[i];
+
+            float indent = ImGui::GetStyle().IndentSpacing * static_cast<float>(row.m_depth);
+            if (indent > 0.0f) {
+                ImGui::Indent(indent);
+            }
+            renderTreeNode(row);
+            if (indent > 0.0f) {
+                ImGui::Unindent(indent);
+            }
+        }
+    }
+    clipper.End();
+}
+
+void SceneWindow::renderTreeNode(const HierarchyRow &row) {
     constexpr auto dir_flags = ImGuiTreeNodeFlags_OpenOnArrow |
                                ImGuiTreeNodeFlags_OpenOnDoubleClick |
-                               ImGuiTreeNodeFlags_SpanFullWidth;
+                               ImGuiTreeNodeFlags_SpanFullWidth |
+                               ImGuiTreeNodeFlags_NoTreePushOnOpen;
 
-    constexpr auto file_flags = ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_SpanFullWidth;
+    constexpr auto file_flags = ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_SpanFullWidth |
+                                ImGuiTreeNodeFlags_NoTreePushOnOpen;
 
-    constexpr auto node_flags = dir_flags | ImGuiTreeNodeFlags_DefaultOpen;
+    const RefPtr<Toolbox::Object::ISceneObject> &node = row.m_node;
+    size_t node_index                                 = row.m_node_index;
 
     bool multi_select     = Input::GetKey(KeyCode::KEY_LEFTCONTROL);
     bool needs_scene_sync = node->getTransform() ? false : true;
 
-    std::string display_name = std::format("{} ({})", node->type(), node->getNameRef().name());
-    bool is_filtered_out     = !m_hierarchy_filter.PassFilter(display_name.c_str());
-
     std::string node_uid_str = getNodeUID(node);
     ImGuiID tree_node_id     = static_cast<ImGuiID>(node->getUUID());
 
-    auto node_it =
-        std::find_if(m_hierarchy_selected_nodes.begin(), m_hierarchy_selected_nodes.end(),
-                     [&](const SelectionNodeInfo<Object::ISceneObject> &other) {
-                         return other.m_node_id == tree_node_id;
-                     });
-    bool node_already_clicked = node_it != m_hierarchy_selected_nodes.end();
+    bool node_already_clicked = m_hierarchy_selected_ids.contains(tree_node_id);
 
     bool node_visible    = node->getIsPerforming();
     bool node_visibility = node->getCanPerform();
@@ -490,217 +578,202 @@ void SceneWindow::renderTree(size_t node_index, RefPtr<Toolbox::Object::ISceneOb
         .m_scene_synced  = needs_scene_sync};  // Only spacial objects get scene selection
 
     if (node->isGroupObject()) {
-        if (is_filtered_out) {
-            for (size_t i = 0; i < node->getChildren().size(); ++i) {
-                renderTree(i, node->getChildren()[i]);
+        ImGui::SetNextItemOpen(row.m_is_open);
+        if (node_visibility) {
+            node_open = ImGui::TreeNodeEx(node_uid_str.c_str(), dir_flags, node_already_clicked,
+                                          &node_visible);
+            if (node->getIsPerforming() != node_visible) {
+                node->setIsPerforming(node_visible);
+                m_update_render_objs = true;
             }
         } else {
-            if (node_visibility) {
-                node_open = ImGui::TreeNodeEx(node_uid_str.c_str(),
-                                              node->getParent() ? dir_flags : node_flags,
-                                              node_already_clicked, &node_visible);
-                if (node->getIsPerforming() != node_visible) {
-                    node->setIsPerforming(node_visible);
-                    m_update_render_objs = true;
-                }
-            } else {
-                node_open = ImGui::TreeNodeEx(node_uid_str.c_str(),
-                                              node->getParent() ? dir_flags : node_flags,
-                                              node_already_clicked);
-            }
+            node_open = ImGui::TreeNodeEx(node_uid_str.c_str(), dir_flags, node_already_clicked);
+        }
 
-            // Drag and drop for OBJECT
-            {
-                ImVec2 mouse_pos = ImGui::GetMousePos();
-                ImVec2 item_size = ImGui::GetItemRectSize();
-                ImVec2 item_pos  = ImGui::GetItemRectMin();
+        if (node_open != row.m_is_open) {
+            if (!m_toggled_groups.erase(node->getUUID())) {
+                m_toggled_groups.insert(node->getUUID());
+            }
+            m_hierarchy_dirty = true;
+        }
 
-                if (ImGui::BeginDragDropSource()) {
-                    Toolbox::Buffer buffer;
-                    saveMimeObject(buffer, node_index, get_shared_ptr(*node->getParent()));
-                    ImGui::SetDragDropPayload("toolbox/scene/object", buffer.buf(), buffer.size(),
-                                              ImGuiCond_Once);
-                    ImGui::Text("Object: %s", node->getNameRef().name().data());
-                    ImGui::EndDragDropSource();
-                }
+        // Drag and drop for OBJECT
+        {
+            ImVec2 mouse_pos = ImGui::GetMousePos();
+            ImVec2 item_size = ImGui::GetItemRectSize();
+            ImVec2 item_pos  = ImGui::GetItemRectMin();
+
+            if (ImGui::BeginDragDropSource()) {
+                Toolbox::Buffer buffer;
+                saveMimeObject(buffer, node_index, get_shared_ptr(*node->getParent()));
+                ImGui::SetDragDropPayload("toolbox/scene/object", buffer.buf(), buffer.size(),
+                                          ImGuiCond_Once);
+                ImGui::Text("Object: %s", node->getNameRef().name().data());
+                ImGui::EndDragDropSource();
+            }
+
+            ImGuiDropFlags drop_flags = ImGuiDropFlags_None;
+            if (mouse_pos.y < item_pos.y + (item_size.y / 4)) {
+                drop_flags = ImGuiDropFlags_InsertBefore;
+            } else if (mouse_pos.y > item_pos.y + 3 * (item_size.y / 4)) {
+                drop_flags = ImGuiDropFlags_InsertAfter;
+            } else {
+                drop_flags = ImGuiDropFlags_InsertChild;
+            }
 
-                ImGuiDropFlags drop_flags = ImGuiDropFlags_None;
-                if (mouse_pos.y < item_pos.y + (item_size.y / 4)) {
-                    drop_flags = ImGuiDropFlags_InsertBefore;
-                } else if (mouse_pos.y > item_pos.y + 3 * (item_size.y / 4)) {
-                    drop_flags = ImGuiDropFlags_InsertAfter;
-                } else {
-                    drop_flags = ImGuiDropFlags_InsertChild;
-                }
+            if (node->getParent() == nullptr) {
+                drop_flags = ImGuiDropFlags_InsertChild;
+            }
 
-                if (node->getParent() == nullptr) {
-                    drop_flags = ImGuiDropFlags_InsertChild;
-                }
+            if (ImGui::BeginDragDropTarget()) {
+                if (const ImGuiPayload *payload = ImGui::AcceptDragDropPayload(
+                        "toolbox/scene/object",
+                        ImGuiDragDropFlags_AcceptBeforeDelivery |
+                            ImGuiDragDropFlags_AcceptNoDrawDefaultRect |
+                            ImGuiDragDropFlags_SourceNoHoldToOpenOthers)) {
 
-                if (ImGui::BeginDragDropTarget()) {
-                    if (const ImGuiPayload *payload = ImGui::AcceptDragDropPayload(
-                            "toolbox/scene/object",
-                            ImGuiDragDropFlags_AcceptBeforeDelivery |
-                                ImGuiDragDropFlags_AcceptNoDrawDefaultRect |
-                                ImGuiDragDropFlags_SourceNoHoldToOpenOthers)) {
+                    ImGui::RenderDragDropTargetRect(
+                        ImGui::GetCurrentContext()->DragDropTargetRect,
+                        ImGui::GetCurrentContext()->DragDropTargetClipRect, drop_flags);
 
-                        ImGui::RenderDragDropTargetRect(
-                            ImGui::GetCurrentContext()->DragDropTargetRect,
-                            ImGui::GetCurrentContext()->DragDropTargetClipRect, drop_flags);
+                    if (payload->IsDelivery()) {
+                        Toolbox::Buffer buffer;
+                        buffer.setBuf(payload->Data, payload->DataSize);
+                        buffer.copyTo(m_drop_target_buffer);
 
-                        if (payload->IsDelivery()) {
-                            Toolbox::Buffer buffer;
-                            buffer.setBuf(payload->Data, payload->DataSize);
-                            buffer.copyTo(m_drop_target_buffer);
-
-                            // Calculate index based on position relative to center
-                            switch (drop_flags) {
-                            case ImGuiDropFlags_InsertBefore:
-                                m_object_drop_target = node_index;
-                                m_object_parent_uuid = node->getParent()->getUUID();
-                                break;
-                            case ImGuiDropFlags_InsertAfter:
-                                m_object_drop_target = node_index + 1;
-                                m_object_parent_uuid = node->getParent()->getUUID();
-                                break;
-                            case ImGuiDropFlags_InsertChild:
-                                m_object_drop_target = node->getChildren().size();
-                                m_object_parent_uuid = node->getUUID();
-                                break;
-                            }
+                        // Calculate index based on position relative to center
+                        switch (drop_flags) {
+                        case ImGuiDropFlags_InsertBefore:
+                            m_object_drop_target = node_index;
+                            m_object_parent_uuid = node->getParent()->getUUID();
+                            break;
+                        case ImGuiDropFlags_InsertAfter:
+                            m_object_drop_target = node_index + 1;
+                            m_object_parent_uuid = node->getParent()->getUUID();
+                            break;
+                        case ImGuiDropFlags_InsertChild:
+                            m_object_drop_target = node->getChildren().size();
+                            m_object_parent_uuid = node->getUUID();
+                            break;
                         }
-                        ImGui::EndDragDropTarget();
                     }
+                    ImGui::EndDragDropTarget();
                 }
             }
+        }
 
-            if (ImGui::IsItemClicked(ImGuiMouseButton_Left) ||
-                ImGui::IsItemClicked(ImGuiMouseButton_Right)) {
-                ImGui::FocusWindow(ImGui::GetCurrentWindow());
+        if (ImGui::IsItemClicked(ImGuiMouseButton_Left) ||
+            ImGui::IsItemClicked(ImGuiMouseButton_Right)) {
+            ImGui::FocusWindow(ImGui::GetCurrentWindow());
 
-                m_selected_properties.clear();
+            m_selected_properties.clear();
 
-                if (multi_select) {
-                    if (node_it == m_hierarchy_selected_nodes.end())
-                        m_hierarchy_selected_nodes.push_back(node_info);
-                } else {
-                    m_hierarchy_selected_nodes.clear();
+            if (multi_select) {
+                if (!node_already_clicked)
                     m_hierarchy_selected_nodes.push_back(node_info);
-                    for (auto &member : node->getMembers()) {
-                        member->syncArray();
-                        auto prop = createProperty(member);
-                        if (prop) {
-                            m_selected_properties.push_back(std::move(prop));
-                        }
+            } else {
+                m_hierarchy_selected_nodes.clear();
+                m_hierarchy_selected_nodes.push_back(node_info);
+                for (auto &member : node->getMembers()) {
+                    member->syncArray();
+                    auto prop = createProperty(member);
+                    if (prop) {
+                        m_selected_properties.push_back(std::move(prop));
                     }
                 }
-
-                m_properties_render_handler = renderObjectProperties;
             }
 
-            renderHierarchyContextMenu(node_uid_str, node_info);
+            m_properties_render_handler = renderObjectProperties;
+        }
 
-            if (node_open) {
-                for (size_t i = 0; i < node->getChildren().size(); ++i) {
-                    renderTree(i, node->getChildren()[i]);
-                }
-                ImGui::TreePop();
+        renderHierarchyContextMenu(node_uid_str, node_info);
+    } else {
+        if (node_visibility) {
+            node_open = ImGui::TreeNodeEx(node_uid_str.c_str(), file_flags, node_already_clicked,
+                                          &node_visible);
+            if (node->getIsPerforming() != node_visible) {
+                node->setIsPerforming(node_visible);
+                m_update_render_objs = true;
             }
+        } else {
+            node_open = ImGui::TreeNodeEx(node_uid_str.c_str(), file_flags, node_already_clicked);
         }
-    } else {
-        if (!is_filtered_out) {
-            if (node_visibility) {
-                node_open = ImGui::TreeNodeEx(node_uid_str.c_str(), file_flags,
-                                              node_already_clicked, &node_visible);
-                if (node->getIsPerforming() != node_visible) {
-                    node->setIsPerforming(node_visible);
-                    m_update_render_objs = true;
-                }
+
+        // Drag and drop for OBJECT
+        {
+            ImVec2 mouse_pos = ImGui::GetMousePos();
+            ImVec2 item_size = ImGui::GetItemRectSize();
+            ImVec2 item_pos  = ImGui::GetItemRectMin();
+
+            if (ImGui::BeginDragDropSource()) {
+                Toolbox::Buffer buffer;
+                saveMimeObject(buffer, node_index, get_shared_ptr(*node->getParent()));
+                ImGui::SetDragDropPayload("toolbox/scene/object", buffer.buf(), buffer.size(),
+                                          ImGuiCond_Once);
+                ImGui::Text("Object: %s", node->getNameRef().name().data());
+                ImGui::EndDragDropSource();
+            }
+
+            ImGuiDropFlags drop_flags = ImGuiDropFlags_None;
+            if (mouse_pos.y < item_pos.y + (item_size.y / 2)) {
+                drop_flags = ImGuiDropFlags_InsertBefore;
             } else {
-                node_open =
-                    ImGui::TreeNodeEx(node_uid_str.c_str(), file_flags, node_already_clicked);
+                drop_flags = ImGuiDropFlags_InsertAfter;
             }
 
-            // Drag and drop for OBJECT
-            {
-                ImVec2 mouse_pos = ImGui::GetMousePos();
-                ImVec2 item_size = ImGui::GetItemRectSize();
-                ImVec2 item_pos  = ImGui::GetItemRectMin();
+            if (ImGui::BeginDragDropTarget()) {
+                if (const ImGuiPayload *payload = ImGui::AcceptDragDropPayload(
+                        "toolbox/scene/object",
+                        ImGuiDragDropFlags_AcceptBeforeDelivery |
+                            ImGuiDragDropFlags_AcceptNoDrawDefaultRect |
+                            ImGuiDragDropFlags_SourceNoHoldToOpenOthers)) {
 
-                if (ImGui::BeginDragDropSource()) {
-                    Toolbox::Buffer buffer;
-                    saveMimeObject(buffer, node_index, get_shared_ptr(*node->getParent()));
-                    ImGui::SetDragDropPayload("toolbox/scene/object", buffer.buf(), buffer.size(),
-                                              ImGuiCond_Once);
-                    ImGui::Text("Object: %s", node->getNameRef().name().data());
-                    ImGui::EndDragDropSource();
-                }
-
-                ImGuiDropFlags drop_flags = ImGuiDropFlags_None;
-                if (mouse_pos.y < item_pos.y + (item_size.y / 2)) {
-                    drop_flags = ImGuiDropFlags_InsertBefore;
-                } else {
-                    drop_flags = ImGuiDropFlags_InsertAfter;
-                }
-
-                if (ImGui::BeginDragDropTarget()) {
-                    if (const ImGuiPayload *payload = ImGui::AcceptDragDropPayload(
-                            "toolbox/scene/object",
-                            ImGuiDragDropFlags_AcceptBeforeDelivery |
-                                ImGuiDragDropFlags_AcceptNoDrawDefaultRect |
-                                ImGuiDragDropFlags_SourceNoHoldToOpenOthers)) {
-
-                        ImGui::RenderDragDropTargetRect(
-                            ImGui::GetCurrentContext()->DragDropTargetRect,
-                            ImGui::GetCurrentContext()->DragDropTargetClipRect, drop_flags);
+                    ImGui::RenderDragDropTargetRect(
+                        ImGui::GetCurrentContext()->DragDropTargetRect,
+                        ImGui::GetCurrentContext()->DragDropTargetClipRect, drop_flags);
 
-                        if (payload->IsDelivery()) {
-                            Toolbox::Buffer buffer;
-                            buffer.setBuf(payload->Data, payload->DataSize);
-                            buffer.copyTo(m_drop_target_buffer);
+                    if (payload->IsDelivery()) {
+                        Toolbox::Buffer buffer;
+                        buffer.setBuf(payload->Data, payload->DataSize);
+                        buffer.copyTo(m_drop_target_buffer);
 
-                            // Calculate index based on position relative to center
-                            m_object_drop_target = node_index;
-                            if (drop_flags == ImGuiDropFlags_InsertAfter) {
-                                m_object_drop_target++;
-                            }
-                            m_object_parent_uuid = node->getParent()->getUUID();
+                        // Calculate index based on position relative to center
+                        m_object_drop_target = node_index;
+                        if (drop_flags == ImGuiDropFlags_InsertAfter) {
+                            m_object_drop_target++;
                         }
+                        m_object_parent_uuid = node->getParent()->getUUID();
                     }
-                    ImGui::EndDragDropTarget();
                 }
+                ImGui::EndDragDropTarget();
             }
+        }
 
-            if (ImGui::IsItemClicked(ImGuiMouseButton_Left) ||
-                ImGui::IsItemClicked(ImGuiMouseButton_Right)) {
-                ImGui::FocusWindow(ImGui::GetCurrentWindow());
+        if (ImGui::IsItemClicked(ImGuiMouseButton_Left) ||
+            ImGui::IsItemClicked(ImGuiMouseButton_Right)) {
+            ImGui::FocusWindow(ImGui::GetCurrentWindow());
 
-                m_selected_properties.clear();
+            m_selected_properties.clear();
 
-                if (multi_select) {
-                    if (node_it == m_hierarchy_selected_nodes.end())
-                        m_hierarchy_selected_nodes.push_back(node_info);
-                } else {
-                    m_hierarchy_selected_nodes.clear();
+            if (multi_select) {
+                if (!node_already_clicked)
                     m_hierarchy_selected_nodes.push_back(node_info);
-                    for (auto &member : node->getMembers()) {
-                        member->syncArray();
-                        auto prop = createProperty(member);
-                        if (prop) {
-                            m_selected_properties.push_back(std::move(prop));
-                        }
+            } else {
+                m_hierarchy_selected_nodes.clear();
+                m_hierarchy_selected_nodes.push_back(node_info);
+                for (auto &member : node->getMembers()) {
+                    member->syncArray();
+                    auto prop = createProperty(member);
+                    if (prop) {
+                        m_selected_properties.push_back(std::move(prop));
                     }
                 }
-
-                m_properties_render_handler = renderObjectProperties;
             }
 
-            renderHierarchyContextMenu(node_uid_str, node_info);
-
-            if (node_open) {
-                ImGui::TreePop();
-            }
+            m_properties_render_handler = renderObjectProperties;
         }
+
+        renderHierarchyContextMenu(node_uid_str, node_info);
     }
 }
 
@@ -721,7 +794,7 @@ void SceneWindow::renderProperties() {
             m_focused_window = EditorWindow::PROPERTY_EDITOR;
         }
         if (m_properties_render_handler(*this)) {
-            m_update_render_objs = true;
+            m_renderer.markDirty();
         }
     }
     ImGui::End();
@@ -741,6 +814,12 @@ bool SceneWindow::renderObjectProperties(SceneWindow &window) {
         ImGui::ItemSize({0, 2});
     }
 
+    // Properties are only listed while a single object is selected
+    if (is_updated && !window.m_hierarchy_selected_nodes.empty()) {
+        window.m_hierarchy_selected_nodes[0].m_selected->notifyChanged(
+            ISceneObject::ChangeKind::MEMBERS);
+    }
+
     return is_updated;
 }
 
@@ -755,7 +834,8 @@ bool SceneWindow::renderRailNodeProperties(SceneWindow &window) {
     RefPtr<Rail::RailNode> node = window.m_rail_node_list_selected_nodes[0].m_selected;
     RefPtr<Rail::Rail> rail = window.m_current_scene->getRailData().getRail(node->getRailUUID());
 
-    bool is_updated = false;
+    bool is_updated            = false;
+    bool is_connection_updated = false;
 
     /* Position */
     {
@@ -781,6 +861,7 @@ bool SceneWindow::renderRailNodeProperties(SceneWindow &window) {
             if (!result) {
                 LogError(result.error());
             }
+            window.m_renderer.updatePathNode(*node);
             is_updated = true;
         }
     }
@@ -845,7 +926,8 @@ bool SceneWindow::renderRailNodeProperties(SceneWindow &window) {
                     }
                 }
             }
-            is_updated = true;
+            is_connection_updated = true;
+            is_updated            = true;
         }
     }
 
@@ -882,14 +964,15 @@ bool SceneWindow::renderRailNodeProperties(SceneWindow &window) {
                     if (!result) {
                         LogError(result.error());
                     }
-                    is_updated = true;
+                    is_connection_updated = true;
+                    is_updated            = true;
                 }
             }
         }
     }
     ImGui::EndGroupPanel();
 
-    if (is_updated) {
+    if (is_connection_updated) {
         window.m_renderer.updatePaths(window.m_current_scene->getRailData(),
                                       window.m_rail_visible_map);
     }
@@ -1212,20 +1295,17 @@ void SceneWindow::renderRailEditor() {
 void SceneWindow::renderScene(TimeStep delta_time) {
     const AppSettings &settings = SettingsManager::instance().getCurrentProfile();
 
-    std::vector<J3DLight> lights;
-
-    // perhaps find a way to limit this so it only happens when we need to re-render?
     if (m_current_scene != nullptr) {
-        if (m_update_render_objs || !settings.m_is_rendering_simple) {
-            m_renderables.clear();
-            auto perform_result = m_current_scene->getObjHierarchy().getRoot()->performScene(
-                delta_time, !settings.m_is_rendering_simple, m_renderables, m_resource_cache,
-                lights);
-            if (!perform_result) {
-                const ObjectError &error = perform_result.error();
-                LogError(error);
-            }
-            m_update_render_objs = false;
+        if (m_update_render_objs) {
+            rebuildRenderables();
+        } else if (!m_dirty_renderables.empty()) {
+            updateDirtyRenderables();
+        }
+
+        if (!settings.m_is_rendering_simple) {
+            for (auto &renderable : m_renderables) {
+                renderable.m_model->UpdateAnimations(delta_time);
+            }
             m_renderer.markDirty();
         }
     }
@@ -1253,6 +1333,72 @@ void SceneWindow::renderScene(TimeStep delta_time) {
     ImGui::End();
 }
 
+void SceneWindow::onObjectChanged(ISceneObject &object, ISceneObject::ChangeKind kind) {
+    if (kind == ISceneObject::ChangeKind::CHILDREN) {
+        m_hierarchy_dirty = true;
+    }
+
+    // Lights are applied to every model after them in the hierarchy
+    if (kind != ISceneObject::ChangeKind::MEMBERS || object.type() == "Light") {
+        m_update_render_objs = true;
+        return;
+    }
+
+    if (m_renderable_indices.contains(object.getUUID())) {
+        m_dirty_renderables[object.getUUID()] = get_shared_ptr<ISceneObject>(object);
+    }
+}
+
+void SceneWindow::rebuildRenderables() {
+    std::vector<J3DLight> lights;
+
+    m_renderables.clear();
+    m_renderable_indices.clear();
+    m_dirty_renderables.clear();
+
+    // Animations are ticked separately each frame
+    auto perform_result = m_current_scene->getObjHierarchy().getRoot()->performScene(
+        0.0f, false, m_renderables, Object::getResourceCache(), lights);
+    if (!perform_result) {
+        const ObjectError &error = perform_result.error();
+        LogError(error);
+    }
+
+    m_renderable_indices.reserve(m_renderables.size());
+    for (size_t i = 0; i < m_renderables.size(); ++i) {
+        m_renderable_indices[m_renderables[i].m_object->getUUID()] = i;
+    }
+    m_renderer.updateRenderables(m_renderables);
+
+    // Rails are edited in many places that only flag a rebuild
+    m_renderer.updatePaths(m_current_scene->getRailData(), m_rail_visible_map);
+
+    m_update_render_objs = false;
+    m_renderer.markDirty();
+}
+
+void SceneWindow::updateDirtyRenderables() {
+    for (auto &[uuid, object] : m_dirty_renderables) {
+        auto index_it = m_renderable_indices.find(uuid);
+        if (index_it == m_renderable_indices.end()) {
+            continue;
+        }
+
+        std::optional<ISceneObject::RenderInfo> render_info = object->refreshRenderInfo();
+        if (!render_info) {
+            // It stopped rendering without a hierarchy change, nothing
+            // short of a rebuild keeps the indices right
+            rebuildRenderables();
+            return;
+        }
+        m_renderables[index_it->second] = std::move(render_info.value());
+        m_renderer.updateRenderable(index_it->second, m_renderables[index_it->second]);
+    }
+
+    m_dirty_renderables.clear();
+    m_renderer.markDirty();
+}
+
 void SceneWindow::renderPlaybackButtons(TimeStep delta_time) {
     Game::TaskCommunicator &task_communicator = GUIApplication::instance().getTaskCommunicator();
 
@@ -1370,13 +1516,13 @@ void SceneWindow::renderDolphin(TimeStep delta_time) {
             Game::TaskCommunicator &task_communicator =
                 GUIApplication::instance().getTaskCommunicator();
 
-            m_dolphin_image = std::move(
+            const ImageHandle &dolphin_image =
                 task_communicator.captureXFBAsTexture(static_cast<int>(ImGui::GetWindowWidth()),
-                                                      static_cast<int>(ImGui::GetWindowHeight())));
-            if (!m_dolphin_image) {
+                                                      static_cast<int>(ImGui::GetWindowHeight()));
+            if (!dolphin_image) {
                 ImGui::Text("Start a Dolphin process running\nSuper Mario Sunshine to get started");
             } else {
-                m_dolphin_painter.render(m_dolphin_image, render_size);
+                m_dolphin_painter.render(dolphin_image, render_size);
 
                 ImGui::SetCursorPos(cursor_pos);
                 for (const auto &[layer_name, render_layer] : m_render_layers) {
@@ -1712,7 +1858,7 @@ void SceneWindow::buildContextMenuPhysicalObj() {
                 return;
             }
 
-            m_update_render_objs = true;
+            info.m_selected->notifyChanged(ISceneObject::ChangeKind::MEMBERS);
             return;
         });
 
@@ -1908,9 +2054,19 @@ void SceneWindow::buildContextMenuRail() {
                                                return;
                                            });
 
-    // m_rail_list_single_node_menu.addDivider();
-    //
-    // TODO: Add rail manipulators here.
+    m_rail_list_single_node_menu.addDivider();
+
+    m_rail_list_single_node_menu.addOption(
+        "Connect Nodes To Nearest", {KeyCode::KEY_LEFTALT, KeyCode::KEY_N},
+        [this](SelectionNodeInfo<Rail::Rail> info) {
+            auto result = info.m_selected->connectNodesToNearest();
+            if (!result) {
+                LogError(result.error());
+                return;
+            }
+            m_update_render_objs = true;
+            return;
+        });
 
     m_rail_list_single_node_menu.addDivider();
 
@@ -2045,8 +2201,7 @@ void SceneWindow::buildContextMenuRailNode() {
                 return;
             }
 
-            m_renderer.updatePaths(m_current_scene->getRailData(), m_rail_visible_map);
-            m_update_render_objs = true;
+            m_renderer.updatePathNode(*info.m_selected);
             return;
         });
 
@@ -2197,6 +2352,7 @@ void SceneWindow::buildRenameObjDialog() {
                 return;
             }
             info.m_selected->setNameRef(new_name);
+            m_hierarchy_dirty = true;
         });
     m_rename_obj_dialog.setActionOnReject([](SelectionNodeInfo<Object::ISceneObject>) {});
 }
@@ -91,12 +91,16 @@ namespace Toolbox {
                 settings.m_camera_sensitivity   = j["Camera Sensitivity"];
                 settings.m_near_plane           = j["Camera Near Plane"];
                 settings.m_far_plane            = j["Camera Far Plane"];
+                settings.m_render_distance =
+                    j.value("Render Distance", settings.m_render_distance);
 
                 // Advanced
                 settings.m_dolphin_path = std::filesystem::path(std::string(j["Dolphin Path"]));
                 settings.m_dolphin_refresh_rate      = j["Dolphin Refresh Rate"];
                 settings.m_is_template_cache_allowed = j["Cache Object Templates"];
                 settings.m_log_to_cout_cerr          = j["Log To Terminal"];
+                settings.m_log_to_file  = j.value("Log To File", settings.m_log_to_file);
+                settings.m_log_capacity = j.value("Log Capacity", settings.m_log_capacity);
             });
 
             if (!result) {
@@ -215,12 +219,15 @@ namespace Toolbox {
             j["Camera Sensitivity"] = profile.m_camera_sensitivity;
             j["Camera Near Plane"]  = profile.m_near_plane;
             j["Camera Far Plane"]   = profile.m_far_plane;
+            j["Render Distance"]    = profile.m_render_distance;
 
             // Advanced
             j["Dolphin Path"]           = profile.m_dolphin_path.string();
             j["Dolphin Refresh Rate"]   = profile.m_dolphin_refresh_rate;
             j["Cache Object Templates"] = profile.m_is_template_cache_allowed;
             j["Log To Terminal"]        = profile.m_log_to_cout_cerr;
+            j["Log To File"]            = profile.m_log_to_file;
+            j["Log Capacity"]           = profile.m_log_capacity;
         });
 
         if (!result) {
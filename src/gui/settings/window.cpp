@@ -85,6 +85,9 @@ namespace Toolbox::UI {
 
             ImGui::EndTabBar();
         }
+
+        // Settings only change while this window is open
+        Log::AppLogger::instance().refreshSettings();
     }
 
     void SettingsWindow::renderProfileBar(TimeStep delta_time) {
@@ -317,6 +320,10 @@ namespace Toolbox::UI {
             ImGui::SliderFloat("Far Plane", &settings.m_far_plane, 100000.0f, 10000000.0f, "%.0f",
                                ImGuiSliderFlags_AlwaysClamp | ImGuiSliderFlags_Logarithmic);
 
+            ImGui::SliderFloat("Render Distance", &settings.m_render_distance, 0.0f, 1000000.0f,
+                               settings.m_render_distance > 0.0f ? "%.0f" : "Unlimited",
+                               ImGuiSliderFlags_AlwaysClamp | ImGuiSliderFlags_Logarithmic);
+
             ImGui::SliderFloat("Speed", &settings.m_camera_speed, 0.5f, 5.0f, "%.1f",
                                ImGuiSliderFlags_AlwaysClamp);
 
@@ -357,6 +364,14 @@ namespace Toolbox::UI {
 
         ImGui::Checkbox("Cache Object Templates", &settings.m_is_template_cache_allowed);
         ImGui::Checkbox("Pipe Logs To Terminal", &settings.m_log_to_cout_cerr);
+        ImGui::Checkbox("Save Logs To File", &settings.m_log_to_file);
+        {
+            s64 min = 100;
+            s64 max = 100000;
+            ImGui::SliderScalar("Log Capacity", ImGuiDataType_S64, &settings.m_log_capacity, &min,
+                                &max, nullptr,
+                                ImGuiSliderFlags_AlwaysClamp | ImGuiSliderFlags_Logarithmic);
+        }
 
         if (ImGui::Button("Clear Cache")) {
             auto cwd_result = Toolbox::Filesystem::current_path();
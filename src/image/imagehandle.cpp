@@ -16,6 +16,18 @@
 
 namespace Toolbox {
 
+    static GLint GetFormatForChannels(int channels) {
+        switch (channels) {
+        case 1:
+            return GL_RED;
+        case 3:
+        default:
+            return GL_RGB;
+        case 4:
+            return GL_RGBA;
+        }
+    }
+
     ImageHandle::ImageHandle(const ImageHandle &other) { copyGL(other); }
 
     ImageHandle::ImageHandle(ImageHandle &&other) noexcept { moveGL(std::move(other)); }
@@ -38,6 +50,21 @@ namespace Toolbox {
         loadGL(data, channels, dx, dy);
     }
 
+    void ImageHandle::update(const Buffer &data, int channels, int dx, int dy) {
+        GLint format = GetFormatForChannels(channels);
+        if (!isValid() || m_image_width != dx || m_image_height != dy ||
+            m_image_format != static_cast<u32>(format)) {
+            unloadGL();
+            loadGL(data, channels, dx, dy);
+            return;
+        }
+
+        glBindTexture(GL_TEXTURE_2D, (GLuint)m_image_handle);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, dx, dy, format, GL_UNSIGNED_BYTE, data.buf());
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+
     bool ImageHandle::isValid() const noexcept {
         return m_image_handle != std::numeric_limits<u64>::max();
     }
@@ -70,19 +97,7 @@ namespace Toolbox {
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
-        GLint format;
-        switch (channels) {
-        case 1:
-            format = GL_RED;
-            break;
-        case 3:
-        default:
-            format = GL_RGB;
-            break;
-        case 4:
-            format = GL_RGBA;
-            break;
-        }
+        GLint format = GetFormatForChannels(channels);
 
         // Upload the texture data
         glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
@@ -0,0 +1,177 @@
+#include <algorithm>
+
+#include "image/yuv.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define TOOLBOX_YUV_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TOOLBOX_YUV_SSE2
+#endif
+
+namespace Toolbox {
+
+    // BT.601 studio range to full range, scaled by 64. The luma term
+    // carries the rounding so the shift at the end rounds to nearest.
+    static constexpr int c_luma_offset   = 16;
+    static constexpr int c_luma_scale    = 75;  // 255 / 219
+    static constexpr int c_luma_round    = 32;
+    static constexpr int c_chroma_offset = 128;
+    static constexpr int c_r_from_v      = 102;  // 1.402 * 255 / 224
+    static constexpr int c_g_from_u      = 25;   // 0.344136 * 255 / 224
+    static constexpr int c_g_from_v      = 52;   // 0.714136 * 255 / 224
+    static constexpr int c_b_from_u      = 129;  // 1.772 * 255 / 224
+    static constexpr int c_shift         = 6;
+
+    static u8 ClampChannel(int value) {
+        return static_cast<u8>(std::clamp(value >> c_shift, 0, 255));
+    }
+
+    static void ConvertPairScalar(const u8 *yuv, u8 *rgba) {
+        int y0 = (yuv[0] - c_luma_offset) * c_luma_scale + c_luma_round;
+        int y1 = (yuv[2] - c_luma_offset) * c_luma_scale + c_luma_round;
+        int u  = yuv[1] - c_chroma_offset;
+        int v  = yuv[3] - c_chroma_offset;
+
+        int r = v * c_r_from_v;
+        int g = -u * c_g_from_u - v * c_g_from_v;
+        int b = u * c_b_from_u;
+
+        rgba[0] = ClampChannel(y0 + r);
+        rgba[1] = ClampChannel(y0 + g);
+        rgba[2] = ClampChannel(y0 + b);
+        rgba[3] = 255;
+        rgba[4] = ClampChannel(y1 + r);
+        rgba[5] = ClampChannel(y1 + g);
+        rgba[6] = ClampChannel(y1 + b);
+        rgba[7] = 255;
+    }
+
+#if defined(TOOLBOX_YUV_AVX2)
+
+    // 16 pixels per step. The unpacks work within each 128 bit lane, so
+    // the two halves of the output are put back in order at the end.
+    static size_t ConvertVector(const u8 *yuv, u8 *rgba, size_t pixel_count) {
+        const __m256i byte_mask     = _mm256_set1_epi16(0x00FF);
+        const __m256i word_mask     = _mm256_set1_epi32(0x0000FFFF);
+        const __m256i luma_offset   = _mm256_set1_epi16(c_luma_offset);
+        const __m256i luma_scale    = _mm256_set1_epi16(c_luma_scale);
+        const __m256i luma_round    = _mm256_set1_epi16(c_luma_round);
+        const __m256i chroma_offset = _mm256_set1_epi16(c_chroma_offset);
+        const __m256i r_from_v      = _mm256_set1_epi16(c_r_from_v);
+        const __m256i g_from_u      = _mm256_set1_epi16(c_g_from_u);
+        const __m256i g_from_v      = _mm256_set1_epi16(c_g_from_v);
+        const __m256i b_from_u      = _mm256_set1_epi16(c_b_from_u);
+        const __m256i alpha         = _mm256_set1_epi16(255);
+
+        size_t i = 0;
+        for (; i + 16 <= pixel_count; i += 16) {
+            __m256i yuyv = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(yuv + i * 2));
+
+            __m256i y  = _mm256_and_si256(yuyv, byte_mask);
+            __m256i uv = _mm256_srli_epi16(yuyv, 8);
+
+            // Each pair of pixels shares the U and V in its 32 bits
+            __m256i u = _mm256_and_si256(uv, word_mask);
+            u         = _mm256_or_si256(u, _mm256_slli_epi32(u, 16));
+            __m256i v = _mm256_srli_epi32(uv, 16);
+            v         = _mm256_or_si256(v, _mm256_slli_epi32(v, 16));
+
+            y = _mm256_mullo_epi16(_mm256_sub_epi16(y, luma_offset), luma_scale);
+            y = _mm256_add_epi16(y, luma_round);
+            u = _mm256_sub_epi16(u, chroma_offset);
+            v = _mm256_sub_epi16(v, chroma_offset);
+
+            __m256i r = _mm256_adds_epi16(y, _mm256_mullo_epi16(v, r_from_v));
+            __m256i g = _mm256_subs_epi16(y, _mm256_mullo_epi16(u, g_from_u));
+            g         = _mm256_subs_epi16(g, _mm256_mullo_epi16(v, g_from_v));
+            __m256i b = _mm256_adds_epi16(y, _mm256_mullo_epi16(u, b_from_u));
+
+            r = _mm256_srai_epi16(r, c_shift);
+            g = _mm256_srai_epi16(g, c_shift);
+            b = _mm256_srai_epi16(b, c_shift);
+
+            __m256i rb = _mm256_packus_epi16(r, b);
+            __m256i ga = _mm256_packus_epi16(g, alpha);
+            __m256i rg = _mm256_unpacklo_epi8(rb, ga);
+            __m256i ba = _mm256_unpackhi_epi8(rb, ga);
+            __m256i lo = _mm256_unpacklo_epi16(rg, ba);
+            __m256i hi = _mm256_unpackhi_epi16(rg, ba);
+
+            __m256i *out = reinterpret_cast<__m256i *>(rgba + i * 4);
+            _mm256_storeu_si256(out, _mm256_permute2x128_si256(lo, hi, 0x20));
+            _mm256_storeu_si256(out + 1, _mm256_permute2x128_si256(lo, hi, 0x31));
+        }
+        return i;
+    }
+
+#elif defined(TOOLBOX_YUV_SSE2)
+
+    // 8 pixels per step
+    static size_t ConvertVector(const u8 *yuv, u8 *rgba, size_t pixel_count) {
+        const __m128i byte_mask     = _mm_set1_epi16(0x00FF);
+        const __m128i word_mask     = _mm_set1_epi32(0x0000FFFF);
+        const __m128i luma_offset   = _mm_set1_epi16(c_luma_offset);
+        const __m128i luma_scale    = _mm_set1_epi16(c_luma_scale);
+        const __m128i luma_round    = _mm_set1_epi16(c_luma_round);
+        const __m128i chroma_offset = _mm_set1_epi16(c_chroma_offset);
+        const __m128i r_from_v      = _mm_set1_epi16(c_r_from_v);
+        const __m128i g_from_u      = _mm_set1_epi16(c_g_from_u);
+        const __m128i g_from_v      = _mm_set1_epi16(c_g_from_v);
+        const __m128i b_from_u      = _mm_set1_epi16(c_b_from_u);
+        const __m128i alpha         = _mm_set1_epi16(255);
+
+        size_t i = 0;
+        for (; i + 8 <= pixel_count; i += 8) {
+            __m128i yuyv = _mm_loadu_si128(reinterpret_cast<const __m128i *>(yuv + i * 2));
+
+            __m128i y  = _mm_and_si128(yuyv, byte_mask);
+            __m128i uv = _mm_srli_epi16(yuyv, 8);
+
+            // Each pair of pixels shares the U and V in its 32 bits
+            __m128i u = _mm_and_si128(uv, word_mask);
+            u         = _mm_or_si128(u, _mm_slli_epi32(u, 16));
+            __m128i v = _mm_srli_epi32(uv, 16);
+            v         = _mm_or_si128(v, _mm_slli_epi32(v, 16));
+
+            y = _mm_mullo_epi16(_mm_sub_epi16(y, luma_offset), luma_scale);
+            y = _mm_add_epi16(y, luma_round);
+            u = _mm_sub_epi16(u, chroma_offset);
+            v = _mm_sub_epi16(v, chroma_offset);
+
+            __m128i r = _mm_adds_epi16(y, _mm_mullo_epi16(v, r_from_v));
+            __m128i g = _mm_subs_epi16(y, _mm_mullo_epi16(u, g_from_u));
+            g         = _mm_subs_epi16(g, _mm_mullo_epi16(v, g_from_v));
+            __m128i b = _mm_adds_epi16(y, _mm_mullo_epi16(u, b_from_u));
+
+            r = _mm_srai_epi16(r, c_shift);
+            g = _mm_srai_epi16(g, c_shift);
+            b = _mm_srai_epi16(b, c_shift);
+
+            __m128i rb = _mm_packus_epi16(r, b);
+            __m128i ga = _mm_packus_epi16(g, alpha);
+            __m128i rg = _mm_unpacklo_epi8(rb, ga);
+            __m128i ba = _mm_unpackhi_epi8(rb, ga);
+
+            __m128i *out = reinterpret_cast<__m128i *>(rgba + i * 4);
+            _mm_storeu_si128(out, _mm_unpacklo_epi16(rg, ba));
+            _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(rg, ba));
+        }
+        return i;
+    }
+
+#else
+
+    static size_t ConvertVector(const u8 *yuv, u8 *rgba, size_t pixel_count) { return 0; }
+
+#endif
+
+    void YUV422ToRGBA8(const u8 *yuv, u8 *rgba, size_t pixel_count) {
+        size_t i = ConvertVector(yuv, rgba, pixel_count);
+        for (; i + 2 <= pixel_count; i += 2) {
+            ConvertPairScalar(yuv + i * 2, rgba + i * 4);
+        }
+    }
+
+}  // namespace Toolbox
\ No newline at end of file
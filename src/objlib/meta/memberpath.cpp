@@ -0,0 +1,422 @@
+#include "objlib/meta/memberpath.hpp"
+#include "objlib/meta/enum.hpp"
+#include "objlib/meta/struct.hpp"
+#include "objlib/meta/value.hpp"
+#include "strutil.hpp"
+#include <algorithm>
+#include <deque>
+#include <mutex>
+
+namespace Toolbox::Object {
+
+    namespace {
+        struct ScopeNameHash {
+            using is_transparent = void;
+            size_t operator()(std::string_view name) const {
+                return std::hash<std::string_view>{}(name);
+            }
+        };
+
+        // Every scope name ever parsed, kept for the life of the program
+        // so paths can hold views of them
+        class ScopeNameTable {
+        public:
+            static ScopeNameTable &instance() {
+                static ScopeNameTable s_table;
+                return s_table;
+            }
+
+            std::pair<u32, std::string_view> intern(std::string_view name) {
+                {
+                    std::shared_lock lk(m_mutex);
+                    auto it = m_ids.find(name);
+                    if (it != m_ids.end()) {
+                        return {it->second, m_names[it->second]};
+                    }
+                }
+
+                std::unique_lock lk(m_mutex);
+                auto [it, inserted] =
+                    m_ids.try_emplace(std::string(name), static_cast<u32>(m_names.size()));
+                if (inserted) {
+                    m_names.emplace_back(name);
+                }
+                return {it->second, m_names[it->second]};
+            }
+
+        private:
+            std::shared_mutex m_mutex;
+            std::deque<std::string> m_names;
+            std::unordered_map<std::string, u32, ScopeNameHash, std::equal_to<>> m_ids;
+        };
+
+        bool IsFixedSize(const MetaMember &member);
+
+        bool IsFixedSizeStruct(const MetaStruct &struct_) {
+            const std::vector<RefPtr<MetaMember>> &members = struct_.members();
+            return std::all_of(members.begin(), members.end(),
+                               [](const RefPtr<MetaMember> &m) { return IsFixedSize(*m); });
+        }
+
+        // Whether the member's serialized size is the same in every
+        // owner, which rules out strings and arrays sized by a member
+        bool IsFixedSize(const MetaMember &member) {
+            if (std::holds_alternative<MetaMember::ReferenceInfo>(member.arraysize_())) {
+                return false;
+            }
+
+            MetaMember::value_type default_value = member.defaultValue();
+            if (std::holds_alternative<RefPtr<MetaStruct>>(default_value)) {
+                return IsFixedSizeStruct(*std::get<RefPtr<MetaStruct>>(default_value));
+            }
+            if (std::holds_alternative<RefPtr<MetaValue>>(default_value)) {
+                return std::get<RefPtr<MetaValue>>(default_value)->type() != MetaType::STRING;
+            }
+            return true;
+        }
+
+        size_t MemberDataSize(const MetaMember &member);
+
+        // Mirrors what MetaMember::serialize writes for one element
+        size_t ElementSize(const MetaMember &member, size_t index) {
+            if (member.isTypeStruct()) {
+                auto struct_result = member.value<MetaStruct>(index);
+                if (!struct_result) {
+                    return 0;
+                }
+
+                size_t size = 0;
+                for (const RefPtr<MetaMember> &child : struct_result.value()->members()) {
+                    size += MemberDataSize(*child);
+                }
+                return size;
+            }
+
+            if (member.isTypeEnum()) {
+                auto enum_result = member.value<MetaEnum>(index);
+                return enum_result ? meta_type_size(enum_result.value()->type()) : 0;
+            }
+
+            auto value_result = member.value<MetaValue>(index);
+            if (!value_result) {
+                return 0;
+            }
+
+            RefPtr<MetaValue> value = value_result.value();
+            if (value->type() != MetaType::STRING) {
+                return meta_type_size(value->type());
+            }
+
+            // Empty strings are written without their length
+            auto str_result = value->get<std::string>();
+            if (!str_result) {
+                return 0;
+            }
+            auto encoded_result = String::toGameEncoding(str_result.value());
+            if (!encoded_result || encoded_result.value().empty()) {
+                return 0;
+            }
+            return meta_type_size(MetaType::STRING) + encoded_result.value().size();
+        }
+
+        size_t MemberDataSize(const MetaMember &member) {
+            size_t size = 0;
+            for (u32 i = 0; i < member.arraysize(); ++i) {
+                size += ElementSize(member, i);
+            }
+            return size;
+        }
+
+        size_t ElementOf(const MemberPath::Scope &scope) {
+            return scope.m_array_index == MemberPath::c_no_index ? 0 : scope.m_array_index;
+        }
+
+        // Walks the indices a layout recorded, nullptr when the owner's
+        // members don't line up with them
+        RefPtr<MetaMember> FollowEntry(const std::vector<RefPtr<MetaMember>> &members,
+                                       const MemberPath &path, const MemberLayout::Entry &entry) {
+            const std::vector<RefPtr<MetaMember>> *scope_members = &members;
+            for (size_t i = 0; i < path.depth(); ++i) {
+                if (scope_members->size() != entry.m_counts[i]) {
+                    return nullptr;
+                }
+
+                const RefPtr<MetaMember> &member = (*scope_members)[entry.m_indices[i]];
+                if (member->name() != path[i].m_name) {
+                    return nullptr;
+                }
+
+                if (i + 1 == path.depth()) {
+                    return member;
+                }
+
+                auto struct_result = member->value<MetaStruct>(ElementOf(path[i]));
+                if (!struct_result) {
+                    return nullptr;
+                }
+                scope_members = &struct_result.value()->members();
+            }
+            return nullptr;
+        }
+
+        // Finds the member by name, recording where it was found in
+        // `entry` for the layout
+        MetaStruct::GetMemberT SearchPath(const std::vector<RefPtr<MetaMember>> &members,
+                                          const MemberPath &path, MemberLayout::Entry &entry) {
+            entry = {};
+
+            size_t offset = 0;
+            bool is_fixed = true;
+
+            const std::vector<RefPtr<MetaMember>> *scope_members = &members;
+            for (size_t i = 0; i < path.depth(); ++i) {
+                const MemberPath::Scope &scope = path[i];
+
+                auto member_it = std::find_if(
+                    scope_members->begin(), scope_members->end(),
+                    [&](const RefPtr<MetaMember> &m) { return m->name() == scope.m_name; });
+                if (member_it == scope_members->end()) {
+                    return nullptr;
+                }
+
+                for (auto it = scope_members->begin(); it != member_it; ++it) {
+                    is_fixed = is_fixed && IsFixedSize(**it);
+                    offset += MemberDataSize(**it);
+                }
+
+                entry.m_indices.push_back(static_cast<u32>(member_it - scope_members->begin()));
+                entry.m_counts.push_back(static_cast<u32>(scope_members->size()));
+
+                const RefPtr<MetaMember> &member = *member_it;
+                if (i + 1 == path.depth()) {
+                    if (is_fixed) {
+                        entry.m_offset = offset;
+                    }
+                    return member;
+                }
+
+                if (!member->isTypeStruct()) {
+                    return nullptr;
+                }
+
+                size_t element = ElementOf(scope);
+
+                auto struct_result = member->value<MetaStruct>(element);
+                if (!struct_result) {
+                    QualifiedName name = path.toQualifiedName();
+                    return make_meta_error<MetaStruct::MemberT>(
+                        name, name.getAbsIndexOf(i, static_cast<int>(scope.m_name.size())),
+                        std::format("Array index {} is out of bounds (size: {})", element,
+                                    member->arraysize()));
+                }
+
+                is_fixed = is_fixed && IsFixedSize(*member);
+                for (size_t e = 0; e < element; ++e) {
+                    offset += ElementSize(*member, e);
+                }
+
+                scope_members = &struct_result.value()->members();
+            }
+            return nullptr;
+        }
+
+        // Resolves through the layout when it knows the path. `entry` is
+        // pointed at the layout's record, or at `scratch` when the path
+        // had to be searched for.
+        MetaStruct::GetMemberT ResolveEntry(const std::vector<RefPtr<MetaMember>> &members,
+                                            const MemberPath &path, MemberLayout *layout,
+                                            MemberLayout::Entry &scratch,
+                                            const MemberLayout::Entry *&entry) {
+            if (path.empty()) {
+                return nullptr;
+            }
+
+            if (layout) {
+                const MemberLayout::Entry *cached = layout->find(path);
+                if (cached) {
+                    RefPtr<MetaMember> member = FollowEntry(members, path, *cached);
+                    if (member) {
+                        entry = cached;
+                        return member;
+                    }
+                }
+            }
+
+            auto result = SearchPath(members, path, scratch);
+            if (layout && result && result.value()) {
+                layout->insert(path, scratch);
+            }
+            entry = &scratch;
+            return result;
+        }
+
+        Result<RefPtr<MetaMember>, MetaScopeError>
+        ResolveExisting(const std::vector<RefPtr<MetaMember>> &members, const MemberPath &path,
+                        size_t index, MemberLayout *layout, MemberLayout::Entry &scratch,
+                        const MemberLayout::Entry *&entry) {
+            auto result = ResolveEntry(members, path, layout, scratch, entry);
+            if (!result) {
+                return std::unexpected(result.error());
+            }
+
+            if (!result.value()) {
+                return make_meta_error<RefPtr<MetaMember>>(path.toQualifiedName(), 0,
+                                                           "No member by this name");
+            }
+
+            if (index >= result.value()->arraysize()) {
+                return make_meta_error<RefPtr<MetaMember>>(
+                    path.toQualifiedName(), 0,
+                    std::format("Array index {} is out of bounds (size: {})", index,
+                                result.value()->arraysize()));
+            }
+
+            return result.value();
+        }
+    }  // namespace
+
+    Result<MemberPath, MetaScopeError> MemberPath::FromName(const QualifiedName &name) {
+        MemberPath path;
+        path.m_scopes.reserve(name.depth());
+
+        size_t hash = 0;
+        for (size_t i = 0; i < name.depth(); ++i) {
+            std::string_view scope_str = name[i];
+
+            Scope scope;
+
+            size_t begin = scope_str.find('[');
+            if (begin != std::string_view::npos) {
+                size_t end = scope_str.find(']', begin);
+                if (end == std::string_view::npos) {
+                    return make_meta_error<MemberPath>(
+                        name, name.getAbsIndexOf(i, static_cast<int>(begin)),
+                        "Array specifier missing end token `]'");
+                }
+
+                std::string index_str(scope_str.substr(begin + 1, end - begin - 1));
+                try {
+                    scope.m_array_index = static_cast<u32>(std::stoul(index_str, nullptr, 0));
+                } catch (const std::exception &) {
+                    return make_meta_error<MemberPath>(
+                        name, name.getAbsIndexOf(i, static_cast<int>(begin + 1)),
+                        "Array specifier is not a number");
+                }
+
+                scope_str = scope_str.substr(0, begin);
+            }
+
+            auto [id, interned] = ScopeNameTable::instance().intern(scope_str);
+            scope.m_name_id     = id;
+            scope.m_name        = interned;
+
+            hash ^= std::hash<u64>{}((static_cast<u64>(id) << 32) | scope.m_array_index) +
+                    0x9E3779B97F4A7C15 + (hash << 6) + (hash >> 2);
+
+            path.m_scopes.push_back(scope);
+        }
+
+        path.m_hash = hash;
+        return path;
+    }
+
+    QualifiedName MemberPath::toQualifiedName() const {
+        std::vector<std::string> scopes;
+        scopes.reserve(m_scopes.size());
+        for (const Scope &scope : m_scopes) {
+            if (scope.m_array_index == c_no_index) {
+                scopes.emplace_back(scope.m_name);
+            } else {
+                scopes.emplace_back(makeNameArrayIndex(scope.m_name, scope.m_array_index));
+            }
+        }
+        return QualifiedName(scopes);
+    }
+
+    MemberLayout &MemberLayout::ForType(std::string_view type) {
+        static std::mutex s_mutex;
+        static std::unordered_map<std::string, ScopePtr<MemberLayout>, ScopeNameHash,
+                                  std::equal_to<>>
+            s_layouts;
+
+        std::unique_lock lk(s_mutex);
+        auto it = s_layouts.find(type);
+        if (it == s_layouts.end()) {
+            it = s_layouts.emplace(std::string(type), make_scoped<MemberLayout>()).first;
+        }
+        return *it->second;
+    }
+
+    const MemberLayout::Entry *MemberLayout::find(const MemberPath &path) const {
+        std::shared_lock lk(m_mutex);
+        auto it = m_entries.find(path);
+        return it != m_entries.end() ? &it->second : nullptr;
+    }
+
+    void MemberLayout::insert(const MemberPath &path, const Entry &entry) {
+        std::unique_lock lk(m_mutex);
+        m_entries.try_emplace(path, entry);
+    }
+
+    MetaStruct::GetMemberT ResolveMember(const std::vector<RefPtr<MetaMember>> &members,
+                                         const MemberPath &path, MemberLayout *layout) {
+        MemberLayout::Entry scratch;
+        const MemberLayout::Entry *entry = nullptr;
+        return ResolveEntry(members, path, layout, scratch, entry);
+    }
+
+    Result<size_t, MetaScopeError>
+    ResolveMemberOffset(const std::vector<RefPtr<MetaMember>> &members, const MemberPath &path,
+                        size_t index, MemberLayout *layout) {
+        MemberLayout::Entry scratch;
+        const MemberLayout::Entry *entry = nullptr;
+        auto member_result = ResolveExisting(members, path, index, layout, scratch, entry);
+        if (!member_result) {
+            return std::unexpected(member_result.error());
+        }
+        const MetaMember &member = *member_result.value();
+
+        size_t offset = 0;
+        if (entry->m_offset) {
+            offset = entry->m_offset.value();
+        } else {
+            // Something in front can change size, so walk it again
+            const std::vector<RefPtr<MetaMember>> *scope_members = &members;
+            for (size_t i = 0; i < path.depth(); ++i) {
+                u32 member_index = entry->m_indices[i];
+                for (u32 j = 0; j < member_index; ++j) {
+                    offset += MemberDataSize(*(*scope_members)[j]);
+                }
+
+                if (i + 1 == path.depth()) {
+                    break;
+                }
+
+                const MetaMember &scope_member = *(*scope_members)[member_index];
+                size_t element                 = ElementOf(path[i]);
+                for (size_t e = 0; e < element; ++e) {
+                    offset += ElementSize(scope_member, e);
+                }
+                scope_members = &scope_member.value<MetaStruct>(element).value()->members();
+            }
+        }
+
+        for (size_t e = 0; e < index; ++e) {
+            offset += ElementSize(member, e);
+        }
+        return offset;
+    }
+
+    Result<size_t, MetaScopeError>
+    ResolveMemberSize(const std::vector<RefPtr<MetaMember>> &members, const MemberPath &path,
+                      size_t index, MemberLayout *layout) {
+        MemberLayout::Entry scratch;
+        const MemberLayout::Entry *entry = nullptr;
+        auto member_result = ResolveExisting(members, path, index, layout, scratch, entry);
+        if (!member_result) {
+            return std::unexpected(member_result.error());
+        }
+        return ElementSize(*member_result.value(), index);
+    }
+
+}  // namespace Toolbox::Object
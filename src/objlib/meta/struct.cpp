@@ -2,6 +2,7 @@
 #include "smart_resource.hpp"
 #include "objlib/meta/enum.hpp"
 #include "objlib/meta/errors.hpp"
+#include "objlib/meta/memberpath.hpp"
 #include "objlib/template.hpp"
 #include "objlib/transform.hpp"
 #include <expected>
@@ -20,47 +21,17 @@ namespace Toolbox::Object {
     }
 
     MetaStruct::GetMemberT MetaStruct::getMember(const QualifiedName &name) const {
-        if (name.empty())
-            return {};
-
-        const auto name_str = name.toString();
-
-        if (m_member_cache.contains(name_str))
-            return m_member_cache.at(name_str);
-
-        auto current_scope = name[0];
-        auto array_result  = getArrayIndex(name, 0);
-        if (!array_result) {
-            return std::unexpected(array_result.error());
-        }
-
-        size_t array_index = array_result.value();
-        if (array_index != std::string_view::npos) {
-            current_scope = current_scope.substr(0, current_scope.find_first_of('['));
-        } else {
-            array_index = 0;
-        }
-
-        for (auto m : m_members) {
-            if (m->name() != current_scope)
-                continue;
-
-            if (name.depth() == 1) {
-                m_member_cache[name_str] = m;
-                return m;
-            }
-
-            if (m->isTypeStruct()) {
-                auto s      = m->value<MetaStruct>(array_index).value();
-                auto member = s->getMember(QualifiedName(name.begin() + 1, name.end()));
-                if (member.has_value()) {
-                    m_member_cache[name_str] = member.value();
-                }
-                return member;
-            }
+        auto path_result = MemberPath::FromName(name);
+        if (!path_result) {
+            return std::unexpected(path_result.error());
         }
+        return getMember(path_result.value());
+    }
 
-        return {};
+    // Struct names aren't unique between templates, so only the objects
+    // that own them keep a layout
+    MetaStruct::GetMemberT MetaStruct::getMember(const MemberPath &path) const {
+        return ResolveMember(m_members, path, nullptr);
     }
 
     constexpr QualifiedName MetaStruct::getQualifiedName() const {
@@ -117,7 +117,7 @@ namespace Toolbox::Object {
     }
 
     bool MetaValue::operator==(const MetaValue &other) const {
-        return m_type == other.m_type && m_value_buf == other.m_value_buf;
+        return m_type == other.m_type && m_inline == other.m_inline && m_string == other.m_string;
     }
 
     Result<void, SerialError> MetaValue::serialize(Serializer &out) const {
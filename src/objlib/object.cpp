@@ -11,6 +11,13 @@
 
 namespace Toolbox::Object {
 
+    namespace {
+        const MemberPath s_transform_path = MemberPath::FromName("Transform").value();
+        const MemberPath s_position_path  = MemberPath::FromName("Position").value();
+        const MemberPath s_color_path     = MemberPath::FromName("Color").value();
+        const MemberPath s_intensity_path = MemberPath::FromName("Intensity").value();
+    }  // namespace
+
     /* INTERFACE */
 
     QualifiedName ISceneObject::getQualifiedName() const {
@@ -20,6 +27,52 @@ namespace Toolbox::Object {
         return QualifiedName(getNameRef().name());
     }
 
+    bool ISceneObject::hasMember(const QualifiedName &name) const {
+        auto member = getMember(name);
+        return member.has_value() && member.value() != nullptr;
+    }
+
+    MetaStruct::GetMemberT ISceneObject::getMember(const QualifiedName &name) const {
+        auto path = MemberPath::FromName(name);
+        if (!path) {
+            return std::unexpected(path.error());
+        }
+        return getMember(path.value());
+    }
+
+    Result<size_t, MetaScopeError> ISceneObject::getMemberOffset(const QualifiedName &name,
+                                                                 size_t index) const {
+        auto path = MemberPath::FromName(name);
+        if (!path) {
+            return std::unexpected(path.error());
+        }
+        return getMemberOffset(path.value(), index);
+    }
+
+    Result<size_t, MetaScopeError> ISceneObject::getMemberSize(const QualifiedName &name,
+                                                               size_t index) const {
+        auto path = MemberPath::FromName(name);
+        if (!path) {
+            return std::unexpected(path.error());
+        }
+        return getMemberSize(path.value(), index);
+    }
+
+    MemberLayout &ISceneObject::getMemberLayout() const {
+        if (!m_member_layout) {
+            m_member_layout = &MemberLayout::ForType(type());
+        }
+        return *m_member_layout;
+    }
+
+    void ISceneObject::notifyChanged(ChangeKind kind) {
+        for (ISceneObject *object = this; object; object = object->getParent()) {
+            if (object->m_change_cb) {
+                object->m_change_cb(*this, kind);
+            }
+        }
+    }
+
     size_t ISceneObject::getAnimationFrames(AnimationType type) const {
         auto ctrl = getAnimationControl(type);
         if (ctrl.expired())
@@ -60,73 +113,30 @@ namespace Toolbox::Object {
     /* VIRTUAL SCENE OBJECT */
 
     std::span<u8> VirtualSceneObject::getData() const {
-        std::stringstream ostr;
-
-        // Lol
-        Serializer out(ostr.rdbuf());
-        Deserializer in(ostr.rdbuf());
+        std::vector<char> arena;
+        Serializer out(arena);
 
         serialize(out);
 
-        m_data.resize(in.size());
-        in.seek(0);
-
-        in.readBytes({reinterpret_cast<char *>(&m_data[0]), m_data.size()});
+        m_data.assign(arena.begin(), arena.end());
 
         return {m_data.data(), m_data.size()};
     }
 
     size_t VirtualSceneObject::getDataSize() const { return getData().size(); }
 
-    bool VirtualSceneObject::hasMember(const QualifiedName &name) const {
-        return getMember(name).has_value();
-    }
-
-    MetaStruct::GetMemberT VirtualSceneObject::getMember(const QualifiedName &name) const {
-        if (name.empty())
-            return {};
-
-        const auto name_str = name.toString();
-
-        if (m_member_cache.contains(name_str))
-            return m_member_cache.at(name_str);
-
-        auto current_scope = name[0];
-        auto array_index   = getArrayIndex(name, 0);
-        if (!array_index) {
-            return std::unexpected(array_index.error());
-        }
-
-        for (auto m : m_members) {
-            if (m->name() != current_scope)
-                continue;
-
-            if (name.depth() == 1) {
-                m_member_cache[name_str] = m;
-                return m;
-            }
-
-            if (m->isTypeStruct()) {
-                auto s      = m->value<MetaStruct>(*array_index).value();
-                auto member = s->getMember(QualifiedName(name.begin() + 1, name.end()));
-                if (member.has_value()) {
-                    m_member_cache[name_str] = member.value();
-                }
-                return member;
-            }
-        }
-
-        return {};
+    MetaStruct::GetMemberT VirtualSceneObject::getMember(const MemberPath &path) const {
+        return ResolveMember(m_members, path, &getMemberLayout());
     }
 
-    size_t VirtualSceneObject::getMemberOffset(const QualifiedName &name, int index) const {
-        size_t offset = 0;
-        return offset;
+    Result<size_t, MetaScopeError> VirtualSceneObject::getMemberOffset(const MemberPath &path,
+                                                                       size_t index) const {
+        return ResolveMemberOffset(m_members, path, index, &getMemberLayout());
     }
 
-    size_t VirtualSceneObject::getMemberSize(const QualifiedName &name, int index) const {
-        size_t size = 0;
-        return size;
+    Result<size_t, MetaScopeError> VirtualSceneObject::getMemberSize(const MemberPath &path,
+                                                                     size_t index) const {
+        return ResolveMemberSize(m_members, path, index, &getMemberLayout());
     }
 
     Result<void, ObjectError> VirtualSceneObject::performScene(float, bool,
@@ -237,6 +247,9 @@ namespace Toolbox::Object {
                 wizard = template_->getWizard();
             }
         }
+        if (!wizard) {
+            return make_serial_error<void>(in, std::format("Template {} has no wizards", m_type));
+        }
 
         // Members
         for (size_t i = 0; i < wizard->m_init_members.size(); ++i) {
@@ -265,18 +278,12 @@ namespace Toolbox::Object {
     /* GROUP SCENE OBJECT */
 
     std::span<u8> GroupSceneObject::getData() const {
-        std::stringstream ostr;
-
-        // Lol
-        Serializer out(ostr.rdbuf());
-        Deserializer in(ostr.rdbuf());
+        std::vector<char> arena;
+        Serializer out(arena);
 
         serialize(out);
 
-        m_data.resize(in.size());
-        in.seek(0);
-
-        in.readBytes({reinterpret_cast<char *>(&m_data[0]), m_data.size()});
+        m_data.assign(arena.begin(), arena.end());
 
         return {m_data.data(), m_data.size()};
     }
@@ -312,6 +319,7 @@ namespace Toolbox::Object {
 
         m_children.insert(m_children.begin() + index, std::move(child));
         updateGroupSize();
+        notifyChanged(ChangeKind::CHILDREN);
         return {};
     }
 
@@ -325,6 +333,7 @@ namespace Toolbox::Object {
         }
         m_children.erase(it);
         updateGroupSize();
+        notifyChanged(ChangeKind::CHILDREN);
         return {};
     }
 
@@ -348,6 +357,7 @@ namespace Toolbox::Object {
         if (name.depth() == 1) {
             m_children.erase(it);
             updateGroupSize();
+            notifyChanged(ChangeKind::CHILDREN);
             return {};
         }
 
@@ -364,6 +374,7 @@ namespace Toolbox::Object {
 
         m_children.erase(m_children.begin() + index);
         updateGroupSize();
+        notifyChanged(ChangeKind::CHILDREN);
         return {};
     }
 
@@ -397,6 +408,14 @@ namespace Toolbox::Object {
         return nullptr;
     }
 
+    void GroupSceneObject::setIsPerforming(bool performing) {
+        if (m_is_performing == performing) {
+            return;
+        }
+        m_is_performing = performing;
+        notifyChanged(ChangeKind::PERFORMING);
+    }
+
     Result<void, ObjectError> GroupSceneObject::performScene(float delta_time, bool animate,
                                                              std::vector<RenderInfo> &renderables,
                                                              ResourceCache &resource_cache,
@@ -505,6 +524,25 @@ namespace Toolbox::Object {
     }
 
     Result<void, SerialError> GroupSceneObject::deserialize(Deserializer &in) {
+        std::vector<RenderDataRequest> requests;
+        auto result = deserializeDeferred(in, requests);
+        if (!result) {
+            return result;
+        }
+
+        for (const RenderDataRequest &request : requests) {
+            auto load_result = ObjectFactory::loadRenderData(request);
+            if (!load_result) {
+                return std::unexpected(load_result.error());
+            }
+        }
+
+        return {};
+    }
+
+    Result<void, SerialError>
+    GroupSceneObject::deserializeDeferred(Deserializer &in,
+                                          std::vector<RenderDataRequest> &requests) {
         // Metadata
         auto length           = in.read<u32, std::endian::big>();
         std::streampos endpos = static_cast<std::size_t>(in.tell()) + length - 4;
@@ -550,6 +588,9 @@ namespace Toolbox::Object {
                 wizard = template_->getWizard();
             }
         }
+        if (!wizard) {
+            return make_serial_error<void>(in, std::format("Template {} has no wizards", m_type));
+        }
 
         // Members
         bool late_group_size = (obj_type.code() == 15406 || obj_type.code() == 9858);
@@ -591,7 +632,7 @@ namespace Toolbox::Object {
                         "Unexpected end of file. {} ({}) expected {} children but only found {}",
                         m_type, m_nameref.name(), num_children, i + 1));
             }
-            ObjectFactory::create_t result = ObjectFactory::create(in);
+            ObjectFactory::create_t result = ObjectFactory::create(in, requests);
             if (!result) {
                 return std::unexpected(result.error());
             }
@@ -623,74 +664,30 @@ namespace Toolbox::Object {
     /* PHYSICAL SCENE OBJECT */
 
     std::span<u8> PhysicalSceneObject::getData() const {
-        std::stringstream ostr;
-
-        // Lol
-        Serializer out(ostr.rdbuf());
-        Deserializer in(ostr.rdbuf());
+        std::vector<char> arena;
+        Serializer out(arena);
 
         serialize(out);
 
-        m_data.resize(in.size());
-        in.seek(0, std::ios::beg);
-
-        in.readBytes({reinterpret_cast<char *>(&m_data[0]), m_data.size()});
+        m_data.assign(arena.begin(), arena.end());
 
         return {m_data.data(), m_data.size()};
     }
 
     size_t PhysicalSceneObject::getDataSize() const { return getData().size(); }
 
-    bool PhysicalSceneObject::hasMember(const QualifiedName &name) const {
-        auto member = getMember(name);
-        return member.has_value() && member.value() != nullptr;
-    }
-
-    MetaStruct::GetMemberT PhysicalSceneObject::getMember(const QualifiedName &name) const {
-        if (name.empty())
-            return make_meta_error<MetaStruct::MemberT>(name, 0, "Empty name for getMember");
-
-        const auto name_str = name.toString();
-
-        if (m_member_cache.contains(name_str))
-            return m_member_cache.at(name_str);
-
-        auto current_scope = name[0];
-        auto array_index   = getArrayIndex(name, 0);
-        if (!array_index) {
-            return std::unexpected(array_index.error());
-        }
-
-        for (auto m : m_members) {
-            if (m->name() != current_scope)
-                continue;
-
-            if (name.depth() == 1) {
-                m_member_cache[name_str] = m;
-                return m;
-            }
-
-            if (m->isTypeStruct()) {
-                auto s      = m->value<MetaStruct>(*array_index).value();
-                auto member = s->getMember(QualifiedName(name.begin() + 1, name.end()));
-                if (member.has_value()) {
-                    m_member_cache[name_str] = member.value();
-                }
-                return member;
-            }
-        }
-
-        return nullptr;
+    MetaStruct::GetMemberT PhysicalSceneObject::getMember(const MemberPath &path) const {
+        return ResolveMember(m_members, path, &getMemberLayout());
     }
 
-    size_t PhysicalSceneObject::getMemberOffset(const QualifiedName &name, int index) const {
-        size_t offset = 0;
-        return offset;
+    Result<size_t, MetaScopeError> PhysicalSceneObject::getMemberOffset(const MemberPath &path,
+                                                                        size_t index) const {
+        return ResolveMemberOffset(m_members, path, index, &getMemberLayout());
     }
 
-    size_t PhysicalSceneObject::getMemberSize(const QualifiedName &name, int index) const {
-        size_t size = 0;
-        return size;
+    Result<size_t, MetaScopeError> PhysicalSceneObject::getMemberSize(const MemberPath &path,
+                                                                      size_t index) const {
+        return ResolveMemberSize(m_members, path, index, &getMemberLayout());
     }
 
     Result<void, ObjectError> PhysicalSceneObject::performScene(
@@ -701,16 +698,16 @@ namespace Toolbox::Object {
         }
 
         if (m_type == "Light") {
-            auto position_value_ptr  = getMember("Position").value();
+            auto position_value_ptr  = getMember(s_position_path).value();
             glm::vec3 position_value = getMetaValue<glm::vec3>(position_value_ptr).value();
 
-            auto color_value_ptr      = getMember("Color").value();
+            auto color_value_ptr      = getMember(s_color_path).value();
             Color::RGBA32 color_value = getMetaValue<Color::RGBA32>(color_value_ptr).value();
 
             f32 r, g, b, a;
             color_value.getColor(r, g, b, a);
 
-            auto intensity_value_ptr = getMember("Intensity").value();
+            auto intensity_value_ptr = getMember(s_intensity_path).value();
             f32 intensity_value      = getMetaValue<f32>(intensity_value_ptr).value();
 
             J3DLight light  = DEFAULT_LIGHT;
@@ -721,7 +718,34 @@ namespace Toolbox::Object {
             scene_lights.push_back(light);
         }
 
-        if (!m_model_instance) {
+        std::optional<RenderInfo> render_info = refreshRenderInfo();
+        if (!render_info) {
+            return {};
+        }
+
+        if (scene_lights.size() > 0) {
+            m_model_instance->SetLight(scene_lights[0], 0);
+            if (scene_lights.size() > 1) {
+                m_model_instance->SetLight(scene_lights[1], 1);
+            } else {
+                m_model_instance->SetLight(DEFAULT_LIGHT, 1);
+            }
+            // m_model_instance->SetLight(scene_lights[4], 2);  // Specular light
+        } else {
+            m_model_instance->SetLight(DEFAULT_LIGHT, 0);
+            m_model_instance->SetLight(DEFAULT_LIGHT, 1);
+        }
+
+        if (animate)
+            m_model_instance->UpdateAnimations(delta_time);
+
+        renderables.emplace_back(std::move(render_info.value()));
+
+        return {};
+    }
+
+    std::optional<ISceneObject::RenderInfo> PhysicalSceneObject::refreshRenderInfo() {
+        if (!getIsPerforming() || !m_model_instance) {
             return {};
         }
 
@@ -731,7 +755,7 @@ namespace Toolbox::Object {
             {1, 1, 1}
         };
 
-        auto transform_value_ptr = getMember("Transform").value();
+        auto transform_value_ptr = getMember(s_transform_path).value();
         if (transform_value_ptr) {
             Transform transform = getMetaValue<Transform>(transform_value_ptr).value();
             m_model_instance->SetTranslation(transform.m_translation);
@@ -745,26 +769,16 @@ namespace Toolbox::Object {
             m_model_instance->SetScale({1, 1, 1});
         }
 
-        if (scene_lights.size() > 0) {
-            m_model_instance->SetLight(scene_lights[0], 0);
-            if (scene_lights.size() > 1) {
-                m_model_instance->SetLight(scene_lights[1], 1);
-            } else {
-                m_model_instance->SetLight(DEFAULT_LIGHT, 1);
-            }
-            // m_model_instance->SetLight(scene_lights[4], 2);  // Specular light
-        } else {
-            m_model_instance->SetLight(DEFAULT_LIGHT, 0);
-            m_model_instance->SetLight(DEFAULT_LIGHT, 1);
-        }
-
-        if (animate)
-            m_model_instance->UpdateAnimations(delta_time);
-
-        renderables.emplace_back(get_shared_ptr<PhysicalSceneObject>(*this), m_model_instance,
-                                 render_transform);
+        return RenderInfo{get_shared_ptr<PhysicalSceneObject>(*this), m_model_instance,
+                          render_transform};
+    }
 
-        return {};
+    void PhysicalSceneObject::setIsPerforming(bool performing) {
+        if (m_is_performing == performing) {
+            return;
+        }
+        m_is_performing = performing;
+        notifyChanged(ChangeKind::PERFORMING);
     }
 
     void PhysicalSceneObject::dump(std::ostream &out, size_t indention,
@@ -789,17 +803,9 @@ namespace Toolbox::Object {
         }
     }
 
-    Result<void, FSError>
-    PhysicalSceneObject::loadRenderData(const std::filesystem::path &asset_path,
-                                        const TemplateRenderInfo &info,
-                                        ResourceCache &resource_cache) {
-        J3DModelLoader bmdLoader;
-        J3DMaterialTableLoader bmtLoader;
-
-        RefPtr<J3DModelData> model_data;
-        RefPtr<J3DMaterialTable> mat_table;
-        RefPtr<J3DAnimationInstance> anim_data;
-
+    Result<std::optional<PhysicalSceneObject::RenderDataPaths>, FSError>
+    PhysicalSceneObject::getRenderDataPaths(const std::filesystem::path &asset_path,
+                                            const TemplateRenderInfo &info) const {
         std::optional<std::string> model_file;
         std::optional<std::string> mat_file = info.m_file_materials;
 
@@ -812,56 +818,89 @@ namespace Toolbox::Object {
                 model_file = std::format("mapobj/{}.bmd", model_member_value);
             }
         } else {
-            return make_fs_error<void>(std::error_code(), model_member_result.error().m_message);
+            return make_fs_error<std::optional<RenderDataPaths>>(
+                std::error_code(), model_member_result.error().m_message);
         }
 
         if (info.m_file_model) {
             model_file = info.m_file_model;
         }
 
-        // Early return since no model to animate etc.
         if (!model_file) {
-            return {};
+            return std::optional<RenderDataPaths>();
         }
 
-        // Load model data
+        RenderDataPaths paths;
+        paths.m_model = asset_path / model_file.value();
+
+        if (!mat_file) {
+            mat_file = model_file->replace(model_file->size() - 3, 3, "bmt");
+        }
+        paths.m_materials = asset_path / mat_file.value();
 
-        std::filesystem::path model_path = asset_path / model_file.value();
-        std::string model_name           = model_path.stem().string();
-        std::transform(model_name.begin(), model_name.end(), model_name.begin(), ::tolower);
+        return paths;
+    }
 
-        if (resource_cache.m_model.count(model_name) == 0) {
-            auto model_path_exists_res = Toolbox::Filesystem::is_regular_file(model_path);
-            if (!model_path_exists_res || !model_path_exists_res.value()) {
-                return {};
-            }
+    void PhysicalSceneObject::prefetchRenderData(const std::filesystem::path &asset_path,
+                                                 const TemplateRenderInfo &info,
+                                                 ResourceCache &resource_cache) const {
+        auto paths_result = getRenderDataPaths(asset_path, info);
+        if (!paths_result || !paths_result.value()) {
+            return;
+        }
 
-            bStream::CFileStream model_stream(model_path.string(), bStream::Endianess::Big,
-                                              bStream::OpenMode::In);
+        const RenderDataPaths &paths = paths_result.value().value();
+        resource_cache.prefetchFile(paths.m_model);
+        resource_cache.prefetchFile(paths.m_materials);
 
-            model_data = bmdLoader.Load(&model_stream, 0);
-            // resource_cache.m_model.insert({model_name, *model_data});
-        } else {
-            model_data = make_referable<J3DModelData>(resource_cache.m_model[model_name]);
+        for (auto &anim_file : info.m_file_animations) {
+            resource_cache.prefetchFile(asset_path / anim_file);
         }
+    }
 
-        if (!mat_file) {
-            mat_file = model_file->replace(model_file->size() - 3, 3, "bmt");
+    Result<void, FSError>
+    PhysicalSceneObject::loadRenderData(const std::filesystem::path &asset_path,
+                                        const TemplateRenderInfo &info,
+                                        ResourceCache &resource_cache) {
+        RefPtr<J3DModelData> model_data;
+        RefPtr<J3DMaterialTable> mat_table;
+        RefPtr<J3DAnimationInstance> anim_data;
+
+        auto paths_result = getRenderDataPaths(asset_path, info);
+        if (!paths_result) {
+            return std::unexpected(paths_result.error());
+        }
+
+        // Early return since no model to animate etc.
+        if (!paths_result.value()) {
+            return {};
+        }
+
+        const RenderDataPaths &paths = paths_result.value().value();
+
+        // Load model data
+
+        model_data = resource_cache.getModel(paths.m_model);
+        if (!model_data) {
+            return {};
         }
 
         // Load material data
 
-        std::filesystem::path mat_path = asset_path / mat_file.value();
-        std::string mat_name           = mat_path.stem().string();
+        std::string mat_name = paths.m_materials.stem().string();
         std::transform(mat_name.begin(), mat_name.end(), mat_name.begin(), ::tolower);
 
-        auto mat_path_exists_res = Toolbox::Filesystem::is_regular_file(mat_path);
-        if (mat_path_exists_res && mat_path_exists_res.value()) {
-            bStream::CFileStream mat_stream(mat_path.string(), bStream::Endianess::Big,
-                                            bStream::OpenMode::In);
+        if (mat_name == "nozzlebox") {
+            // The nozzle color is set per object, so this table can't be shared
+            RefPtr<const std::vector<u8>> mat_data = resource_cache.getFile(paths.m_materials);
+            if (mat_data) {
+                J3DMaterialTableLoader bmtLoader;
+                bStream::CMemoryStream mat_stream(const_cast<u8 *>(mat_data->data()),
+                                                  mat_data->size(), bStream::Endianess::Big,
+                                                  bStream::OpenMode::In);
+
+                mat_table = bmtLoader.Load(&mat_stream, model_data);
 
-            mat_table = bmtLoader.Load(&mat_stream, model_data);
-            if (mat_name == "nozzlebox") {
                 RefPtr<J3DMaterial> nozzle_mat = mat_table->GetMaterial("_mat1");
                 auto nozzle_type_member        = getMember("Spawn").value();
                 std::string nozzle_type = getMetaValue<std::string>(nozzle_type_member).value();
@@ -873,6 +912,8 @@ namespace Toolbox::Object {
                     nozzle_mat->TevBlock->mTevColors[1] = {90, 90, 120, 255};
                 }
             }
+        } else {
+            mat_table = resource_cache.getMaterialTable(paths.m_materials, paths.m_model);
         }
 
         // TODO: Load texture data
@@ -892,11 +933,12 @@ namespace Toolbox::Object {
             std::filesystem::path anim_path = asset_path / anim_file;
             std::string anim_name           = anim_path.stem().string();
 
-            auto anim_path_exists_res = Toolbox::Filesystem::is_regular_file(anim_path);
-            if (anim_path_exists_res && anim_path_exists_res.value()) {
+            RefPtr<const std::vector<u8>> anim_data = resource_cache.getFile(anim_path);
+            if (anim_data) {
                 J3DAnimationLoader anmLoader;
-                bStream::CFileStream anim_stream(anim_path.string(), bStream::Endianess::Big,
-                                                 bStream::OpenMode::In);
+                bStream::CMemoryStream anim_stream(const_cast<u8 *>(anim_data->data()),
+                                                   anim_data->size(), bStream::Endianess::Big,
+                                                   bStream::OpenMode::In);
 
                 if (anim_file.ends_with(".brk")) {
                     m_model_instance->SetRegisterColorAnimation(
@@ -960,6 +1002,28 @@ namespace Toolbox::Object {
     }
 
     Result<void, SerialError> PhysicalSceneObject::deserialize(Deserializer &in) {
+        std::vector<RenderDataRequest> requests;
+        auto result = deserializeDeferred(in, requests);
+        if (!result) {
+            return result;
+        }
+
+        for (const RenderDataRequest &request : requests) {
+            auto load_result = loadRenderData(request.m_asset_path, request.m_info,
+                                              getResourceCache());
+            if (!load_result) {
+                return make_serial_error<void>(
+                    in, std::format("Failed to load render data for object {} ({})!", m_type,
+                                    m_nameref.name()));
+            }
+        }
+
+        return {};
+    }
+
+    Result<void, SerialError>
+    PhysicalSceneObject::deserializeDeferred(Deserializer &in,
+                                             std::vector<RenderDataRequest> &requests) {
         auto scene_path = std::filesystem::path(in.filepath()).parent_path();
 
         // Metadata
@@ -1011,6 +1075,9 @@ namespace Toolbox::Object {
                 wizard = template_->getWizard();
             }
         }
+        if (!wizard) {
+            return make_serial_error<void>(in, std::format("Template {} has no wizards", m_type));
+        }
 
         const char *debug_str = template_->type().data();
 
@@ -1032,27 +1099,73 @@ namespace Toolbox::Object {
         in.seek(endpos, std::ios::beg);
 
         std::filesystem::path asset_path = scene_path.parent_path();
-        auto load_result = loadRenderData(asset_path, wizard->m_render_info, getResourceCache());
+
+        // Loaded by whoever asked for the request, the files
+        // are read in the background until then
+        prefetchRenderData(asset_path, wizard->m_render_info, getResourceCache());
+        requests.push_back({this, asset_path, wizard->m_render_info});
+        return {};
+    }
+
+    ObjectFactory::create_t ObjectFactory::create(Deserializer &in) {
+        std::vector<RenderDataRequest> requests;
+        create_t result = create(in, requests);
+        if (!result) {
+            return result;
+        }
+
+        for (const RenderDataRequest &request : requests) {
+            auto load_result = loadRenderData(request);
+            if (!load_result) {
+                return std::unexpected(load_result.error());
+            }
+        }
+
+        return result;
+    }
+
+    ObjectFactory::create_t ObjectFactory::create(Deserializer &in,
+                                                  std::vector<RenderDataRequest> &requests) {
+        size_t first_request = requests.size();
+
+        create_t result = createDeferred(in, requests);
+
+        // On failure the requesting objects have already been destroyed
+        if (!result) {
+            requests.resize(first_request);
+        }
+
+        return result;
+    }
+
+    Result<void, SerialError> ObjectFactory::loadRenderData(const RenderDataRequest &request) {
+        PhysicalSceneObject *object = request.m_object;
+
+        auto load_result =
+            object->loadRenderData(request.m_asset_path, request.m_info, getResourceCache());
         if (!load_result) {
             return make_serial_error<void>(
-                in, std::format("Failed to load render data for object {} ({})!", m_type,
-                                m_nameref.name()));
+                "OBJECT",
+                std::format("Failed to load render data for object {} ({})!", object->m_type,
+                            object->m_nameref.name()),
+                0, request.m_asset_path.string());
         }
 
         return {};
     }
 
-    ObjectFactory::create_t ObjectFactory::create(Deserializer &in) {
+    ObjectFactory::create_t ObjectFactory::createDeferred(Deserializer &in,
+                                                          std::vector<RenderDataRequest> &requests) {
         if (isGroupObject(in)) {
             auto obj    = make_scoped<GroupSceneObject>();
-            auto result = obj->deserialize(in);
+            auto result = obj->deserializeDeferred(in, requests);
             if (!result) {
                 return std::unexpected(result.error());
             }
             return obj;
         } else {
             auto obj    = make_scoped<PhysicalSceneObject>();
-            auto result = obj->deserialize(in);
+            auto result = obj->deserializeDeferred(in, requests);
             if (!result) {
                 return std::unexpected(result.error());
             }
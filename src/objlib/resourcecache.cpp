@@ -0,0 +1,175 @@
+#include <J3D/J3DModelLoader.hpp>
+#include <J3D/Material/J3DMaterialTableLoader.hpp>
+#include <bstream.h>
+
+#include "core/log.hpp"
+#include "core/threadpool.hpp"
+#include "fsystem.hpp"
+#include "objlib/resourcecache.hpp"
+
+#include <fstream>
+
+namespace Toolbox::Object {
+
+    namespace {
+        ResourceCache s_resource_cache;
+
+        bool IsExistingFile(const std::filesystem::path &path) {
+            auto exists_res = Toolbox::Filesystem::is_regular_file(path);
+            return exists_res && exists_res.value();
+        }
+
+        RefPtr<std::vector<u8>> ReadFile(const std::filesystem::path &path) {
+            if (!IsExistingFile(path)) {
+                return nullptr;
+            }
+
+            std::ifstream file(path, std::ios::in | std::ios::binary | std::ios::ate);
+            if (!file.is_open()) {
+                return nullptr;
+            }
+
+            auto data = make_referable<std::vector<u8>>(static_cast<size_t>(file.tellg()));
+            file.seekg(0, std::ios::beg);
+            file.read(reinterpret_cast<char *>(data->data()), data->size());
+            return data;
+        }
+
+        // The stream only reads from the buffer, it doesn't take it over
+        RefPtr<J3DModelData> LoadModel(const std::vector<u8> &data) {
+            bStream::CMemoryStream stream(const_cast<u8 *>(data.data()), data.size(),
+                                          bStream::Endianess::Big, bStream::OpenMode::In);
+
+            J3DModelLoader loader;
+            return loader.Load(&stream, 0);
+        }
+
+        RefPtr<J3DMaterialTable> LoadMaterialTable(const std::vector<u8> &data,
+                                                   RefPtr<J3DModelData> model_data) {
+            bStream::CMemoryStream stream(const_cast<u8 *>(data.data()), data.size(),
+                                          bStream::Endianess::Big, bStream::OpenMode::In);
+
+            J3DMaterialTableLoader loader;
+            return loader.Load(&stream, model_data);
+        }
+    }  // namespace
+
+    ResourceCache &getResourceCache() { return s_resource_cache; }
+
+    std::string ResourceCache::NormalizePath(const std::filesystem::path &path) {
+        return path.lexically_normal().generic_string();
+    }
+
+    RefPtr<const std::vector<u8>> ResourceCache::getFile(const std::filesystem::path &path) {
+        auto [entry, created] = acquireEntry(m_files, NormalizePath(path));
+        return ResolveFile(*entry, path);
+    }
+
+    RefPtr<J3DModelData> ResourceCache::getModel(const std::filesystem::path &path) {
+        auto [entry, created] = acquireEntry(m_models, NormalizePath(path));
+        if (entry->m_requested.exchange(true)) {
+            m_model_hits += 1;
+        } else {
+            m_model_loads += 1;
+        }
+
+        std::call_once(entry->m_once, [&]() {
+            if (RefPtr<const std::vector<u8>> data = getFile(path)) {
+                entry->m_data = LoadModel(*data);
+            }
+            releaseFile(path);
+        });
+        return entry->m_data;
+    }
+
+    RefPtr<J3DMaterialTable>
+    ResourceCache::getMaterialTable(const std::filesystem::path &path,
+                                    const std::filesystem::path &model_path) {
+        std::string model_key = NormalizePath(model_path);
+
+        // Tables are decoded against their model, so the same
+        // file used with two models is two entries
+        auto [entry, created] = acquireEntry(m_materials, NormalizePath(path) + '|' + model_key);
+        if (entry->m_requested.exchange(true)) {
+            m_material_hits += 1;
+        } else {
+            m_material_loads += 1;
+        }
+
+        std::call_once(entry->m_once, [&]() {
+            RefPtr<J3DModelData> model_data = getModel(model_path);
+            if (!model_data) {
+                return;
+            }
+            if (RefPtr<const std::vector<u8>> data = getFile(path)) {
+                entry->m_data = LoadMaterialTable(*data, model_data);
+            }
+            releaseFile(path);
+        });
+        return entry->m_data;
+    }
+
+    void ResourceCache::prefetchFile(const std::filesystem::path &path) {
+        auto [entry, created] = acquireEntry(m_files, NormalizePath(path));
+        if (!created) {
+            return;
+        }
+
+        ThreadPool::instance().submit([entry, path]() { ResolveFile(*entry, path); });
+    }
+
+    void ResourceCache::releaseFile(const std::filesystem::path &path) {
+        std::unique_lock<std::mutex> lk(m_mutex);
+        m_files.erase(NormalizePath(path));
+    }
+
+    void ResourceCache::clear() {
+        std::unique_lock<std::mutex> lk(m_mutex);
+        m_files.clear();
+        m_models.clear();
+        m_materials.clear();
+        m_model_loads    = 0;
+        m_model_hits     = 0;
+        m_material_loads = 0;
+        m_material_hits  = 0;
+    }
+
+    ResourceCache::Statistics ResourceCache::getStatistics() const {
+        Statistics stats;
+        stats.m_model_loads    = m_model_loads;
+        stats.m_model_hits     = m_model_hits;
+        stats.m_material_loads = m_material_loads;
+        stats.m_material_hits  = m_material_hits;
+        return stats;
+    }
+
+    void ResourceCache::logStatistics() const {
+        Statistics stats = getStatistics();
+        TOOLBOX_INFO_V("[RESOURCE_CACHE] Models: {} loaded, {} shared | Materials: {} loaded, {} "
+                       "shared",
+                       stats.m_model_loads, stats.m_model_hits, stats.m_material_loads,
+                       stats.m_material_hits);
+    }
+
+    template <typename _DataT>
+    std::pair<RefPtr<ResourceCache::Entry<_DataT>>, bool>
+    ResourceCache::acquireEntry(std::unordered_map<std::string, RefPtr<Entry<_DataT>>> &entries,
+                                std::string &&key) {
+        std::unique_lock<std::mutex> lk(m_mutex);
+        auto [it, inserted] = entries.try_emplace(std::move(key));
+        if (inserted) {
+            it->second = make_referable<Entry<_DataT>>();
+        }
+        return {it->second, inserted};
+    }
+
+    // Whoever reaches an entry first reads it, everyone else waits on
+    // the result. A get never waits on a task that hasn't started, so a
+    // full pool can't deadlock the loading thread.
+    RefPtr<std::vector<u8>> ResourceCache::ResolveFile(file_entry_t &entry,
+                                                       const std::filesystem::path &path) {
+        std::call_once(entry.m_once, [&]() { entry.m_data = ReadFile(path); });
+        return entry.m_data;
+    }
+
+}  // namespace Toolbox::Object
\ No newline at end of file
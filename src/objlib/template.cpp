@@ -8,12 +8,15 @@
 
 #include "objlib/template.hpp"
 #include "color.hpp"
+#include "core/threadpool.hpp"
+#include "core/timing.hpp"
 #include "gui/settings.hpp"
 #include "jsonlib.hpp"
 #include "magic_enum.hpp"
 #include "objlib/meta/enum.hpp"
 #include "objlib/meta/member.hpp"
 #include "objlib/meta/struct.hpp"
+#include "objlib/templatecache.hpp"
 #include "objlib/transform.hpp"
 
 namespace Toolbox::Object {
@@ -33,7 +36,8 @@ namespace Toolbox::Object {
     };
 
     Template::Template(std::string_view type) : m_type(type) {
-        std::ifstream file("./Templates/" + std::string(type) + ".json", std::ios::in);
+        std::ifstream file("./Templates/" + std::string(type) + ".json",
+                           std::ios::in | std::ios::binary);
         if (!file.is_open()) {
             throw std::runtime_error("Failed to open template file: " + std::string(type));
         }
@@ -48,10 +52,20 @@ namespace Toolbox::Object {
     Result<void, SerialError> Template::serialize(Serializer &out) const { return {}; }
 
     Result<void, SerialError> Template::deserialize(Deserializer &in) {
+        // Read through the deserializer so memory backed ones, which have
+        // no stream, work too
+        size_t start = static_cast<size_t>(in.tell());
+        std::string text(in.size() - start, '\0');
+        in.readBytes(text);
+        if (!in.good()) {
+            return make_serial_error<void>("TEMPLATE", "Failed to read template JSON", start,
+                                           in.filepath());
+        }
+
         json_t template_json;
 
         auto result = tryJSON(template_json, [&](json_t &j) {
-            in.stream() >> j;
+            j = json_t::parse(text);
 
             for (auto &item : j.items()) {
                 const json_t &metadata    = item.value();
@@ -174,6 +188,11 @@ namespace Toolbox::Object {
         if (enum_ == m_enum_cache.end()) {
             return {};
         }
+        return loadMemberEnum(name, *enum_, array_size);
+    }
+
+    MetaMember Template::loadMemberEnum(std::string_view name, const MetaEnum &enum_,
+                                        MetaMember::size_type array_size) {
         std::vector<MetaEnum> enums;
 
         size_t asize = 1;
@@ -186,13 +205,13 @@ namespace Toolbox::Object {
 
         enums.reserve(asize);
         for (size_t i = 0; i < asize; ++i) {
-            enums.emplace_back(*enum_);
+            enums.emplace_back(enum_);
         }
         if (std::holds_alternative<MetaMember::ReferenceInfo>(array_size)) {
             return MetaMember(name, enums, std::get<MetaMember::ReferenceInfo>(array_size),
-                              make_referable<MetaEnum>(*enum_));
+                              make_referable<MetaEnum>(enum_));
         }
-        return MetaMember(name, enums, make_referable<MetaEnum>(*enum_));
+        return MetaMember(name, enums, make_referable<MetaEnum>(enum_));
     }
 
     std::optional<MetaMember> Template::loadMemberStruct(std::string_view name,
@@ -203,6 +222,11 @@ namespace Toolbox::Object {
         if (struct_ == m_struct_cache.end()) {
             return {};
         }
+        return loadMemberStruct(name, *struct_, array_size);
+    }
+
+    MetaMember Template::loadMemberStruct(std::string_view name, const MetaStruct &struct_,
+                                          MetaMember::size_type array_size) {
         std::vector<MetaStruct> structs;
 
         size_t asize = 1;
@@ -216,13 +240,13 @@ namespace Toolbox::Object {
         structs.reserve(asize);
 
         for (size_t i = 0; i < asize; ++i) {
-            structs.emplace_back(*struct_);
+            structs.emplace_back(struct_);
         }
         if (std::holds_alternative<MetaMember::ReferenceInfo>(array_size)) {
             return MetaMember(name, structs, std::get<MetaMember::ReferenceInfo>(array_size),
-                              make_referable<MetaStruct>(*struct_));
+                              make_referable<MetaStruct>(struct_));
         }
-        return MetaMember(name, structs, make_referable<MetaStruct>(*struct_));
+        return MetaMember(name, structs, make_referable<MetaStruct>(struct_));
     }
 
     std::optional<MetaMember> Template::loadMemberPrimitive(std::string_view name,
@@ -231,7 +255,11 @@ namespace Toolbox::Object {
         auto vtype = magic_enum::enum_cast<MetaType>(type);
         if (!vtype)
             return {};
+        return loadMemberPrimitive(name, vtype.value(), array_size);
+    }
 
+    MetaMember Template::loadMemberPrimitive(std::string_view name, MetaType type,
+                                             MetaMember::size_type array_size) {
         std::vector<MetaValue> values;
 
         size_t asize = 1;
@@ -245,13 +273,13 @@ namespace Toolbox::Object {
         values.reserve(asize);
 
         for (size_t i = 0; i < asize; ++i) {
-            values.emplace_back(MetaValue(vtype.value()));
+            values.emplace_back(MetaValue(type));
         }
         if (std::holds_alternative<MetaMember::ReferenceInfo>(array_size)) {
             return MetaMember(name, values, std::get<MetaMember::ReferenceInfo>(array_size),
-                              make_referable<MetaValue>(vtype.value()));
+                              make_referable<MetaValue>(type));
         }
-        return MetaMember(name, values, make_referable<MetaValue>(vtype.value()));
+        return MetaMember(name, values, make_referable<MetaValue>(type));
     }
 
     void Template::loadMembers(const json_t &members, std::vector<MetaMember> &out) {
@@ -321,7 +349,76 @@ namespace Toolbox::Object {
         }
     }
 
-    static MetaMember loadWizardMember(Template::json_t &member_json, MetaMember default_member) {
+    namespace {
+        // Wizard values are read either from the template json or from the
+        // precompiled cache, which stores them flattened in member order
+        struct CachedWizardSource {
+            Deserializer &m_in;
+            const TemplateStringTable &m_strings;
+        };
+
+        void WriteCachedValue(Serializer &out, TemplateStringTable &strings,
+                              const MetaValue &value) {
+            if (value.type() == MetaType::STRING) {
+                out.write<u32>(strings.intern(value.get<std::string>().value()));
+                return;
+            }
+            value.serialize(out);
+        }
+
+        void ReadCachedValue(Deserializer &in, const TemplateStringTable &strings,
+                             MetaValue &value) {
+            if (value.type() == MetaType::STRING) {
+                value.set(std::string(strings.get(in.read<u32>())));
+                return;
+            }
+            value.deserialize(in);
+        }
+
+        Template::json_t &GetWizardSource(Template::json_t &member_json,
+                                          const MetaMember &member) {
+            return member_json[member.name()];
+        }
+
+        CachedWizardSource &GetWizardSource(CachedWizardSource &source, const MetaMember &) {
+            return source;
+        }
+
+        void LoadWizardValue(Template::json_t &member_json, MetaValue &value) {
+            value.loadJSON(member_json);
+        }
+
+        void LoadWizardValue(CachedWizardSource &source, MetaValue &value) {
+            ReadCachedValue(source.m_in, source.m_strings, value);
+        }
+
+        void LoadWizardValue(Template::json_t &member_json, MetaEnum &value) {
+            value.loadJSON(member_json);
+        }
+
+        void LoadWizardValue(CachedWizardSource &source, MetaEnum &value) {
+            ReadCachedValue(source.m_in, source.m_strings, *value.value());
+        }
+
+        // Mirrors the read order of loadWizardMember
+        void SaveWizardValues(Serializer &out, TemplateStringTable &strings,
+                              const MetaMember &member) {
+            for (size_t i = 0; i < member.arraysize(); ++i) {
+                if (member.isTypeStruct()) {
+                    for (auto &child : member.value<MetaStruct>(i).value()->members()) {
+                        SaveWizardValues(out, strings, *child);
+                    }
+                } else if (member.isTypeEnum()) {
+                    WriteCachedValue(out, strings, *member.value<MetaEnum>(i).value()->value());
+                } else {
+                    WriteCachedValue(out, strings, *member.value<MetaValue>(i).value());
+                }
+            }
+        }
+    }  // namespace
+
+    template <typename _SourceT>
+    static MetaMember loadWizardMember(_SourceT &source, MetaMember default_member) {
         default_member.syncArray();
 
         if (default_member.isTypeStruct()) {
@@ -330,8 +427,8 @@ namespace Toolbox::Object {
                 std::vector<MetaMember> inst_struct_members;
                 auto struct_ = default_member.value<MetaStruct>(i).value();
                 for (auto &mbr : struct_->members()) {
-                    auto &mbr_json = member_json[mbr->name()];
-                    inst_struct_members.push_back(loadWizardMember(mbr_json, *mbr));
+                    auto &mbr_source = GetWizardSource(source, *mbr);
+                    inst_struct_members.push_back(loadWizardMember(mbr_source, *mbr));
                 }
                 inst_structs.emplace_back(struct_->name(), inst_struct_members);
             }
@@ -349,8 +446,9 @@ namespace Toolbox::Object {
         if (default_member.isTypeEnum()) {
             std::vector<MetaEnum> inst_enums;
             for (size_t i = 0; i < default_member.arraysize(); ++i) {
-                auto value = MetaEnum(*default_member.value<MetaEnum>(i).value());
-                value.loadJSON(member_json);
+                // A plain copy would share its value with the default
+                auto value = MetaEnum(*make_deep_clone(default_member.value<MetaEnum>(i).value()));
+                LoadWizardValue(source, value);
                 inst_enums.push_back(value);
             }
             MetaMember::size_type array_size = default_member.arraysize_();
@@ -365,7 +463,7 @@ namespace Toolbox::Object {
         std::vector<MetaValue> inst_values;
         for (size_t i = 0; i < default_member.arraysize(); ++i) {
             auto value = MetaValue(*default_member.value<MetaValue>(i).value());
-            value.loadJSON(member_json);
+            LoadWizardValue(source, value);
             inst_values.push_back(value);
         }
         MetaMember::size_type array_size = default_member.arraysize_();
@@ -413,209 +511,512 @@ namespace Toolbox::Object {
             }
             m_wizards.push_back(wizard);
         }
-    }
 
-    static std::mutex s_templates_mutex;
-    std::unordered_map<std::string, Template> g_template_cache;
+        indexWizards();
+    }
 
-    void Template::threadLoadTemplate(const std::string &type) {
-        Template template_;
-        try {
-            template_ = Template(type);
-        } catch (std::runtime_error &e) {
-            TOOLBOX_ERROR(e.what());
-            return;
+    void Template::indexWizards() {
+        m_wizard_indices.clear();
+        for (size_t i = 0; i < m_wizards.size(); ++i) {
+            // Lookups used to return the first match, keep it that way
+            m_wizard_indices.try_emplace(m_wizards[i].m_name, i);
         }
-        s_templates_mutex.lock();
-        g_template_cache[type] = template_;
-        s_templates_mutex.unlock();
-        return;
     }
 
-    void Template::threadLoadTemplateBlob(const std::string &type, const json_t &the_json) {
-        Template template_;
-        try {
-            template_.m_type = type;
-            template_.loadFromJSON(the_json);
-        } catch (std::runtime_error &e) {
-            TOOLBOX_ERROR(e.what());
-            return;
+    namespace {
+        enum class CachedMemberKind : u8 { VALUE, ENUM, STRUCT };
+
+        void WriteCachedString(Serializer &out, TemplateStringTable &strings,
+                               const std::optional<std::string> &str) {
+            out.write<bool>(str.has_value());
+            if (str) {
+                out.write<u32>(strings.intern(str.value()));
+            }
         }
-        s_templates_mutex.lock();
-        g_template_cache[type] = template_;
-        s_templates_mutex.unlock();
-        return;
-    }
 
-    Result<void, FSError> TemplateFactory::initialize() {
-        auto cwd_result = Toolbox::Filesystem::current_path();
-        if (!cwd_result) {
-            return std::unexpected(cwd_result.error());
+        std::optional<std::string> ReadCachedString(Deserializer &in,
+                                                    const TemplateStringTable &strings) {
+            if (!in.read<bool>()) {
+                return {};
+            }
+            return std::string(strings.get(in.read<u32>()));
+        }
+    }  // namespace
+
+    Result<void, SerialError> Template::serializeCached(Serializer &out,
+                                                        TemplateStringTable &strings) const {
+        out.write<u32>(strings.intern(m_type));
+
+        out.write<u32>(static_cast<u32>(m_enum_cache.size()));
+        for (const MetaEnum &enum_ : m_enum_cache) {
+            out.write<u32>(strings.intern(enum_.name()));
+            out.write<u8>(static_cast<u8>(enum_.type()));
+            out.write<bool>(enum_.isBitMasked());
+
+            std::vector<MetaEnum::enum_type> flags = enum_.enums();
+            out.write<u32>(static_cast<u32>(flags.size()));
+            for (const auto &[flag_name, flag_value] : flags) {
+                out.write<u32>(strings.intern(flag_name));
+                WriteCachedValue(out, strings, flag_value);
+            }
         }
 
-        AppSettings &settings = SettingsManager::instance().getCurrentProfile();
+        out.write<u32>(static_cast<u32>(m_struct_cache.size()));
+        for (const MetaStruct &struct_ : m_struct_cache) {
+            out.write<u32>(strings.intern(struct_.name()));
 
-        bool templates_preloaded = false;
-        if (settings.m_is_template_cache_allowed) {
-            templates_preloaded = loadFromCacheBlob().has_value();
+            std::vector<const MetaMember *> members;
+            for (const auto &member : struct_.members()) {
+                members.push_back(member.get());
+            }
+
+            auto result = serializeCachedMembers(out, strings, members);
+            if (!result) {
+                return result;
+            }
         }
 
-        if (!templates_preloaded) {
-            std::vector<std::thread> threads;
+        out.write<u32>(static_cast<u32>(m_wizards.size()));
+        for (size_t i = 0; i < m_wizards.size(); ++i) {
+            const TemplateWizard &wizard = m_wizards[i];
 
-            auto &cwd = cwd_result.value();
-            for (auto &subpath : std::filesystem::directory_iterator{cwd / "Templates"}) {
-                auto type_str = subpath.path().stem().string();
-                threads.push_back(std::thread(Template::threadLoadTemplate, type_str));
+            out.write<u32>(strings.intern(wizard.m_name));
+            WriteCachedString(out, strings, wizard.m_render_info.m_file_model);
+            WriteCachedString(out, strings, wizard.m_render_info.m_file_materials);
+            out.write<u32>(static_cast<u32>(wizard.m_render_info.m_file_animations.size()));
+            for (const std::string &anim_file : wizard.m_render_info.m_file_animations) {
+                out.write<u32>(strings.intern(anim_file));
             }
 
-            for (auto &th : threads) {
-                th.join();
+            // The default wizard defines the members, the others override their values
+            if (i == 0) {
+                std::vector<const MetaMember *> members;
+                for (const MetaMember &member : wizard.m_init_members) {
+                    members.push_back(&member);
+                }
+
+                auto result = serializeCachedMembers(out, strings, members);
+                if (!result) {
+                    return result;
+                }
+                continue;
             }
-        }
 
-        if (settings.m_is_template_cache_allowed && !templates_preloaded) {
-            return saveToCacheBlob();
+            const std::vector<MetaMember> &defaults = m_wizards[0].m_init_members;
+
+            out.write<u32>(static_cast<u32>(wizard.m_init_members.size()));
+            for (const MetaMember &member : wizard.m_init_members) {
+                auto default_it =
+                    std::find_if(defaults.begin(), defaults.end(),
+                                 [&](const auto &e) { return e.name() == member.name(); });
+                if (default_it == defaults.end()) {
+                    return make_serial_error<void>(
+                        out, std::format("Wizard member {} has no default", member.name()));
+                }
+
+                out.write<u32>(static_cast<u32>(std::distance(defaults.begin(), default_it)));
+                SaveWizardValues(out, strings, member);
+            }
         }
 
         return {};
     }
 
-    Result<void, FSError> TemplateFactory::loadFromCacheBlob() {
-        auto cwd_result = Toolbox::Filesystem::current_path();
-        if (!cwd_result) {
-            return std::unexpected(cwd_result.error());
+    Result<void, SerialError> Template::deserializeCached(Deserializer &in,
+                                                          const TemplateStringTable &strings) {
+        m_type = strings.get(in.read<u32>());
+
+        m_enum_cache.clear();
+        m_struct_cache.clear();
+        m_wizards.clear();
+
+        u32 enum_count = in.read<u32>();
+        for (u32 i = 0; i < enum_count && in.good(); ++i) {
+            std::string_view enum_name = strings.get(in.read<u32>());
+            MetaType enum_type         = static_cast<MetaType>(in.read<u8>());
+            bool enum_bitmask          = in.read<bool>();
+
+            std::vector<MetaEnum::enum_type> flags;
+
+            u32 flag_count = in.read<u32>();
+            for (u32 j = 0; j < flag_count && in.good(); ++j) {
+                std::string flag_name(strings.get(in.read<u32>()));
+                MetaValue flag_value(enum_type);
+                ReadCachedValue(in, strings, flag_value);
+                flags.emplace_back(std::move(flag_name), std::move(flag_value));
+            }
+
+            m_enum_cache.emplace_back(enum_name, enum_type, flags, enum_bitmask);
         }
 
-        auto &cwd      = cwd_result.value();
-        auto blob_path = cwd / "Templates/.cache/blob.json";
+        u32 struct_count = in.read<u32>();
+        for (u32 i = 0; i < struct_count && in.good(); ++i) {
+            std::string_view struct_name = strings.get(in.read<u32>());
+
+            std::vector<MetaMember> members;
+            auto result = deserializeCachedMembers(in, strings, members);
+            if (!result) {
+                return result;
+            }
 
-        auto path_result = Toolbox::Filesystem::is_regular_file(blob_path);
-        if (!path_result) {
-            return std::unexpected(path_result.error());
+            m_struct_cache.emplace_back(struct_name, members);
         }
 
-        if (!path_result.value()) {
-            return make_fs_error<void>(std::error_code(),
-                                       {"(TemplateFactory) blob.json not found!"});
+        u32 wizard_count = in.read<u32>();
+        for (u32 i = 0; i < wizard_count && in.good(); ++i) {
+            TemplateWizard wizard;
+
+            wizard.m_name                         = strings.get(in.read<u32>());
+            wizard.m_render_info.m_file_model     = ReadCachedString(in, strings);
+            wizard.m_render_info.m_file_materials = ReadCachedString(in, strings);
+
+            u32 anim_count = in.read<u32>();
+            for (u32 j = 0; j < anim_count && in.good(); ++j) {
+                wizard.m_render_info.m_file_animations.emplace_back(strings.get(in.read<u32>()));
+            }
+
+            if (i == 0) {
+                auto result = deserializeCachedMembers(in, strings, wizard.m_init_members);
+                if (!result) {
+                    return result;
+                }
+                m_wizards.push_back(wizard);
+                continue;
+            }
+
+            const std::vector<MetaMember> &defaults = m_wizards[0].m_init_members;
+            CachedWizardSource source               = {in, strings};
+
+            u32 member_count = in.read<u32>();
+            for (u32 j = 0; j < member_count && in.good(); ++j) {
+                u32 default_index = in.read<u32>();
+                if (default_index >= defaults.size()) {
+                    return make_serial_error<void>(in, "Wizard member has no default");
+                }
+                wizard.m_init_members.emplace_back(
+                    loadWizardMember(source, defaults[default_index]));
+            }
+
+            m_wizards.push_back(wizard);
         }
 
-        std::ifstream file(blob_path, std::ios::in);
-        if (!file.is_open()) {
-            return make_fs_error<void>(std::error_code(),
-                                       {"(TemplateFactory) failed to open cache blob!"});
+        if (!in.good()) {
+            return make_serial_error<void>(in, "Unexpected end of cached template");
         }
 
-        Deserializer in(file.rdbuf());
-        Template::json_t blob_json;
-        in.stream() >> blob_json;
+        indexWizards();
+        return {};
+    }
 
-        for (auto &item : blob_json.items()) {
-            Template::threadLoadTemplateBlob(item.key(), item.value());
+    Result<void, SerialError>
+    Template::serializeCachedMembers(Serializer &out, TemplateStringTable &strings,
+                                     const std::vector<const MetaMember *> &members) const {
+        out.write<u32>(static_cast<u32>(members.size()));
+        for (const MetaMember *member : members) {
+            out.write<u32>(strings.intern(member->name()));
+
+            MetaMember::value_type default_value = member->defaultValue();
+            if (member->isTypeStruct()) {
+                std::string_view struct_name = std::get<RefPtr<MetaStruct>>(default_value)->name();
+                auto struct_it =
+                    std::find_if(m_struct_cache.begin(), m_struct_cache.end(),
+                                 [&](const auto &e) { return e.name() == struct_name; });
+                if (struct_it == m_struct_cache.end()) {
+                    return make_serial_error<void>(
+                        out, std::format("Struct {} is missing from {}", struct_name, m_type));
+                }
+                out.write<u8>(static_cast<u8>(CachedMemberKind::STRUCT));
+                out.write<u32>(static_cast<u32>(std::distance(m_struct_cache.begin(), struct_it)));
+            } else if (member->isTypeEnum()) {
+                std::string_view enum_name = std::get<RefPtr<MetaEnum>>(default_value)->name();
+                auto enum_it = std::find_if(m_enum_cache.begin(), m_enum_cache.end(),
+                                            [&](const auto &e) { return e.name() == enum_name; });
+                if (enum_it == m_enum_cache.end()) {
+                    return make_serial_error<void>(
+                        out, std::format("Enum {} is missing from {}", enum_name, m_type));
+                }
+                out.write<u8>(static_cast<u8>(CachedMemberKind::ENUM));
+                out.write<u32>(static_cast<u32>(std::distance(m_enum_cache.begin(), enum_it)));
+            } else {
+                out.write<u8>(static_cast<u8>(CachedMemberKind::VALUE));
+                out.write<u32>(
+                    static_cast<u32>(std::get<RefPtr<MetaValue>>(default_value)->type()));
+            }
+
+            // Referenced sizes point back at an earlier member of the same list
+            MetaMember::size_type array_size = member->arraysize_();
+            if (std::holds_alternative<MetaMember::ReferenceInfo>(array_size)) {
+                const std::string &ref_name =
+                    std::get<MetaMember::ReferenceInfo>(array_size).m_name;
+                auto ref_it = std::find_if(members.begin(), members.end(),
+                                           [&](const auto &e) { return e->name() == ref_name; });
+                out.write<bool>(true);
+                out.write<u32>(static_cast<u32>(std::distance(members.begin(), ref_it)));
+            } else {
+                out.write<bool>(false);
+                out.write<u32>(std::get<u32>(array_size));
+            }
         }
 
         return {};
     }
 
-    Result<void, FSError> TemplateFactory::saveToCacheBlob() {
-        auto cwd_result = Toolbox::Filesystem::current_path();
-        if (!cwd_result) {
-            return std::unexpected(cwd_result.error());
+    Result<void, SerialError>
+    Template::deserializeCachedMembers(Deserializer &in, const TemplateStringTable &strings,
+                                       std::vector<MetaMember> &out) {
+        u32 member_count = in.read<u32>();
+        for (u32 i = 0; i < member_count && in.good(); ++i) {
+            std::string_view member_name = strings.get(in.read<u32>());
+            CachedMemberKind member_kind = static_cast<CachedMemberKind>(in.read<u8>());
+            u32 member_type              = in.read<u32>();
+            bool is_size_reference       = in.read<bool>();
+            u32 member_size_value        = in.read<u32>();
+
+            MetaMember::size_type member_size;
+            if (is_size_reference) {
+                if (member_size_value < out.size()) {
+                    const MetaMember &ref_member = out[member_size_value];
+                    auto value                   = ref_member.value<MetaValue>(0);
+                    if (value) {
+                        member_size = MetaMember::ReferenceInfo(value.value(), ref_member.name());
+                    }
+                }
+            } else {
+                member_size = member_size_value;
+            }
+
+            switch (member_kind) {
+            case CachedMemberKind::VALUE:
+                out.push_back(loadMemberPrimitive(member_name, static_cast<MetaType>(member_type),
+                                                  member_size));
+                break;
+            case CachedMemberKind::ENUM:
+                if (member_type >= m_enum_cache.size()) {
+                    return make_serial_error<void>(in, "Cached member has an invalid enum");
+                }
+                out.push_back(loadMemberEnum(member_name, m_enum_cache[member_type], member_size));
+                break;
+            case CachedMemberKind::STRUCT:
+                if (member_type >= m_struct_cache.size()) {
+                    return make_serial_error<void>(in, "Cached member has an invalid struct");
+                }
+                out.push_back(
+                    loadMemberStruct(member_name, m_struct_cache[member_type], member_size));
+                break;
+            default:
+                return make_serial_error<void>(in, "Cached member has an invalid kind");
+            }
         }
 
-        Template::json_t blob_json;
+        return {};
+    }
 
-        {
-            std::vector<std::thread> threads;
+    static std::mutex s_templates_mutex;
+    std::unordered_map<std::string, RefPtr<const Template>> g_template_cache;
 
-            auto &cwd = cwd_result.value();
-            for (auto &subpath : std::filesystem::directory_iterator{cwd / "Templates"}) {
-                auto type_str = subpath.path().stem().string();
-                threads.push_back(std::thread(
-                    [&](const std::string &type_str, const std::filesystem::path &path) {
-                        std::ifstream file(path, std::ios::in);
-                        if (!file.is_open()) {
-                            TOOLBOX_ERROR_V("(TemplateFactory) failed to open template json {}",
-                                            path.filename().string());
-                            return;
-                        }
+    namespace {
+        using template_map_t = std::unordered_map<std::string, RefPtr<const Template>>;
 
-                        Deserializer in(file.rdbuf());
-                        Template::json_t t_json;
-                        in.stream() >> t_json;
+        std::filesystem::path GetTemplateCachePath(const std::filesystem::path &cwd) {
+            return cwd / "Templates/.cache/templates.bin";
+        }
 
-                        s_templates_mutex.lock();
-                        for (auto &[key, value] : t_json.items()) {
-                            blob_json[key] = value;
-                        }
-                        s_templates_mutex.unlock();
+        std::vector<std::string> EnumerateTemplateTypes(const std::filesystem::path &folder) {
+            std::vector<std::string> types;
+            for (auto &subpath : std::filesystem::directory_iterator{folder}) {
+                // Skips the .cache folder among others
+                if (!subpath.is_regular_file() || subpath.path().extension() != ".json") {
+                    continue;
+                }
+                types.push_back(subpath.path().stem().string());
+            }
+            return types;
+        }
 
-                        file.close();
-                    },
-                    type_str, subpath.path()));
+        // Splits `count` loads between the pool's workers. Each worker collects
+        // into its own map, so nothing is locked until the maps are merged.
+        template <typename _MapT, typename _LoadFn>
+        std::vector<_MapT> LoadTemplatesParallel(size_t count, _LoadFn &&load) {
+            ThreadPool &pool = ThreadPool::instance();
+
+            std::atomic<size_t> next_index = 0;
+            auto worker_task               = [&]() {
+                _MapT local_map;
+                for (size_t i = next_index++; i < count; i = next_index++) {
+                    load(i, local_map);
+                }
+                return local_map;
+            };
+
+            std::vector<std::future<_MapT>> futures;
+            futures.reserve(pool.threadCount());
+            for (size_t i = 0; i < pool.threadCount(); ++i) {
+                futures.push_back(pool.submit(worker_task));
             }
 
-            for (auto &th : threads) {
-                th.join();
+            std::vector<_MapT> local_maps;
+            local_maps.reserve(futures.size());
+            for (auto &future : futures) {
+                local_maps.push_back(future.get());
             }
+            return local_maps;
         }
 
-        auto &cwd                = cwd_result.value();
-        auto blob_path           = cwd / "Templates/.cache/blob.json";
-        auto cache_folder_result = Toolbox::Filesystem::is_directory(blob_path.parent_path());
-        if (!cache_folder_result) {
-            return std::unexpected(cache_folder_result.error());
+        void MergeTemplates(std::vector<template_map_t> &local_maps) {
+            std::scoped_lock lock(s_templates_mutex);
+            for (auto &local_map : local_maps) {
+                g_template_cache.merge(local_map);
+            }
         }
+    }  // namespace
 
-        if (!cache_folder_result.value()) {
-            auto result = Toolbox::Filesystem::create_directory(blob_path.parent_path());
-            if (!result) {
-                return std::unexpected(result.error());
+    Result<void, FSError> TemplateFactory::initialize() {
+        auto cwd_result = Toolbox::Filesystem::current_path();
+        if (!cwd_result) {
+            return std::unexpected(cwd_result.error());
+        }
+
+        AppSettings &settings = SettingsManager::instance().getCurrentProfile();
+
+        bool templates_preloaded = false;
+        if (settings.m_is_template_cache_allowed) {
+            Result<void, FSError> cache_result;
+            double load_time = Timing::measure([&]() { cache_result = loadFromCacheBlob(); });
+
+            templates_preloaded = cache_result.has_value();
+            if (templates_preloaded) {
+                TOOLBOX_INFO_V("[TEMPLATE] Loaded {} templates from cache in {} seconds (warm)",
+                               g_template_cache.size(), load_time);
+            } else if (!cache_result.error().m_message.empty()) {
+                TOOLBOX_INFO(cache_result.error().m_message[0]);
             }
         }
 
-        std::ofstream file(blob_path, std::ios::out);
-        if (!file.is_open()) {
-            return make_fs_error<void>(std::error_code(),
-                                       {"(TemplateFactory) failed to open cache blob!"});
+        if (!templates_preloaded) {
+            auto &cwd = cwd_result.value();
+
+            std::vector<std::string> types;
+            std::vector<template_map_t> local_maps;
+            std::atomic<size_t> failed_count = 0;
+
+            double enumerate_time = Timing::measure(
+                [&]() { types = EnumerateTemplateTypes(cwd / "Templates"); });
+
+            double parse_time = Timing::measure([&]() {
+                local_maps = LoadTemplatesParallel<template_map_t>(
+                    types.size(), [&](size_t index, template_map_t &out) {
+                        try {
+                            out.emplace(types[index], make_referable<const Template>(types[index]));
+                        } catch (std::runtime_error &e) {
+                            TOOLBOX_ERROR(e.what());
+                            failed_count += 1;
+                        }
+                    });
+            });
+
+            double merge_time = Timing::measure([&]() { MergeTemplates(local_maps); });
+
+            TOOLBOX_INFO_V("[TEMPLATE] Loaded {} templates in {} seconds (cold, enumerate: {}, "
+                           "parse: {}, merge: {})",
+                           types.size(), enumerate_time + parse_time + merge_time,
+                           enumerate_time, parse_time, merge_time);
+
+            // The cache only records sources, so writing it now would
+            // validate without the failed types and hide their errors on
+            // every later run
+            if (failed_count > 0) {
+                TOOLBOX_INFO_V("[TEMPLATE] Not caching templates, {} failed to load",
+                               failed_count.load());
+                return {};
+            }
         }
 
-        Serializer out(file.rdbuf());
-        out.stream() << blob_json;
+        if (settings.m_is_template_cache_allowed && !templates_preloaded) {
+            return saveToCacheBlob();
+        }
 
-        file.close();
+        return {};
+    }
 
+    Result<void, FSError> TemplateFactory::loadFromCacheBlob() {
+        auto cwd_result = Toolbox::Filesystem::current_path();
+        if (!cwd_result) {
+            return std::unexpected(cwd_result.error());
+        }
+
+        auto &cwd = cwd_result.value();
+
+        TemplateCache cache;
+        auto open_result = cache.open(GetTemplateCachePath(cwd), cwd / "Templates");
+        if (!open_result) {
+            return std::unexpected(open_result.error());
+        }
+
+        std::atomic<bool> is_corrupt = false;
+
+        std::vector<template_map_t> local_maps = LoadTemplatesParallel<template_map_t>(
+            cache.templateCount(), [&](size_t index, template_map_t &out) {
+                auto result = cache.loadTemplate(index);
+                if (!result) {
+                    is_corrupt = true;
+                    return;
+                }
+                std::string type(result.value().type());
+                out.emplace(std::move(type),
+                            make_referable<const Template>(std::move(result.value())));
+            });
+
+        if (is_corrupt) {
+            return make_fs_error<void>(std::error_code(),
+                                       {"(TemplateFactory) template cache is corrupt!"});
+        }
+
+        MergeTemplates(local_maps);
         return {};
     }
 
-    TemplateFactory::create_t TemplateFactory::create(std::string_view type) {
-        auto type_str = std::string(type);
-        if (g_template_cache.contains(type_str)) {
-            return make_scoped<Template>(g_template_cache[type_str]);
+    Result<void, FSError> TemplateFactory::saveToCacheBlob() {
+        auto cwd_result = Toolbox::Filesystem::current_path();
+        if (!cwd_result) {
+            return std::unexpected(cwd_result.error());
         }
 
-        Template template_;
-        try {
-            template_ = Template(type);
-        } catch (std::runtime_error &e) {
-            return make_fs_error<ScopePtr<Template>>(std::error_code(), {e.what()});
+        auto &cwd = cwd_result.value();
+
+        std::scoped_lock lock(s_templates_mutex);
+        return TemplateCache::Save(GetTemplateCachePath(cwd), cwd / "Templates", g_template_cache);
+    }
+
+    TemplateFactory::create_t TemplateFactory::create(std::string_view type) {
+        std::string type_str(type);
+        {
+            std::scoped_lock lock(s_templates_mutex);
+            auto it = g_template_cache.find(type_str);
+            if (it != g_template_cache.end()) {
+                return it->second;
+            }
         }
 
-        TemplateFactory::create_ret_t template_ptr;
+        create_ret_t template_;
         try {
-            template_ptr = make_scoped<Template>(template_);
+            template_ = make_referable<const Template>(type);
         } catch (std::runtime_error &e) {
-            return make_fs_error<ScopePtr<Template>>(std::error_code(), {e.what()});
+            return make_fs_error<create_ret_t>(std::error_code(), {e.what()});
         }
 
-        g_template_cache[type_str] = template_;
-        return make_scoped<Template>(template_);
+        // Another thread may have loaded the same type meanwhile
+        std::scoped_lock lock(s_templates_mutex);
+        return g_template_cache.try_emplace(std::move(type_str), std::move(template_))
+            .first->second;
     }
 
     std::vector<TemplateFactory::create_ret_t> TemplateFactory::createAll() {
+        std::scoped_lock lock(s_templates_mutex);
+
         std::vector<TemplateFactory::create_ret_t> ret;
+        ret.reserve(g_template_cache.size());
         for (auto &item : g_template_cache) {
-            ret.push_back(make_scoped<Template>(item.second));
+            ret.push_back(item.second);
         }
         return ret;
     }
@@ -0,0 +1,378 @@
+#include <algorithm>
+#include <fstream>
+
+#include "objlib/templatecache.hpp"
+
+namespace Toolbox::Object {
+
+    namespace {
+        constexpr u64 c_fnv_offset_basis = 0xCBF29CE484222325;
+        constexpr u64 c_fnv_prime        = 0x100000001B3;
+    }  // namespace
+
+    u32 TemplateStringTable::intern(std::string_view str) {
+        auto it = m_lookup.find(std::string(str));
+        if (it != m_lookup.end()) {
+            return it->second;
+        }
+
+        u32 index = static_cast<u32>(size());
+        m_data.append(str);
+        m_offsets.push_back(static_cast<u32>(m_data.size()));
+        m_lookup.emplace(str, index);
+        return index;
+    }
+
+    std::string_view TemplateStringTable::get(u32 index) const {
+        if (index >= size()) {
+            return {};
+        }
+        return std::string_view(m_data).substr(m_offsets[index],
+                                               m_offsets[index + 1] - m_offsets[index]);
+    }
+
+    Result<void, SerialError> TemplateStringTable::serialize(Serializer &out) const {
+        out.write<u32>(static_cast<u32>(size()));
+        for (u32 offset : m_offsets) {
+            out.write<u32>(offset);
+        }
+        out.writeBytes(m_data);
+        return {};
+    }
+
+    Result<void, SerialError> TemplateStringTable::deserialize(Deserializer &in) {
+        u32 count = in.read<u32>();
+        if (!in.good() || static_cast<size_t>(count) * sizeof(u32) > in.size()) {
+            return make_serial_error<void>(in, "Corrupt string table size");
+        }
+
+        m_offsets.resize(static_cast<size_t>(count) + 1);
+        for (u32 &offset : m_offsets) {
+            offset = in.read<u32>();
+        }
+
+        if (m_offsets.front() != 0 || !std::is_sorted(m_offsets.begin(), m_offsets.end()) ||
+            m_offsets.back() > in.size()) {
+            return make_serial_error<void>(in, "Corrupt string table offsets");
+        }
+
+        m_data.resize(m_offsets.back());
+        in.readBytes(m_data);
+
+        if (!in.good()) {
+            return make_serial_error<void>(in, "Unexpected end of string table");
+        }
+
+        m_lookup.clear();
+        return {};
+    }
+
+    Result<std::vector<TemplateCache::SourceInfo>, FSError>
+    TemplateCache::ScanSources(const std::filesystem::path &folder, bool hash_files) {
+        std::vector<SourceInfo> sources;
+
+        std::error_code ec;
+        for (auto &subpath : std::filesystem::directory_iterator{folder, ec}) {
+            if (!subpath.is_regular_file() || subpath.path().extension() != ".json") {
+                continue;
+            }
+
+            SourceInfo source;
+            source.m_type = subpath.path().stem().string();
+
+            auto mtime_result = Filesystem::last_write_time(subpath.path());
+            if (!mtime_result) {
+                return std::unexpected(mtime_result.error());
+            }
+            source.m_mtime = static_cast<u64>(mtime_result.value().time_since_epoch().count());
+
+            auto size_result = Filesystem::file_size(subpath.path());
+            if (!size_result) {
+                return std::unexpected(size_result.error());
+            }
+            source.m_size = static_cast<u64>(size_result.value());
+
+            if (hash_files) {
+                auto hash_result = HashFile(subpath.path());
+                if (!hash_result) {
+                    return std::unexpected(hash_result.error());
+                }
+                source.m_hash = hash_result.value();
+            }
+
+            sources.emplace_back(std::move(source));
+        }
+
+        if (ec) {
+            return make_fs_error<std::vector<SourceInfo>>(ec);
+        }
+
+        return sources;
+    }
+
+    Result<u64, FSError> TemplateCache::HashFile(const std::filesystem::path &path) {
+        std::ifstream file(path, std::ios::in | std::ios::binary);
+        if (!file.is_open()) {
+            return make_fs_error<u64>(std::error_code(),
+                                      {std::format("(TemplateCache) failed to open {} for hashing",
+                                                   path.filename().string())});
+        }
+
+        u64 hash = c_fnv_offset_basis;
+
+        char chunk[0x10000];
+        while (file) {
+            file.read(chunk, sizeof(chunk));
+            for (std::streamsize i = 0; i < file.gcount(); ++i) {
+                hash ^= static_cast<u8>(chunk[i]);
+                hash *= c_fnv_prime;
+            }
+        }
+
+        return hash;
+    }
+
+    Result<void, FSError>
+    TemplateCache::Save(const std::filesystem::path &cache_path,
+                        const std::filesystem::path &folder,
+                        const std::unordered_map<std::string, RefPtr<const Template>> &templates) {
+        auto sources_result = ScanSources(folder, true);
+        if (!sources_result) {
+            return std::unexpected(sources_result.error());
+        }
+        const std::vector<SourceInfo> &sources = sources_result.value();
+
+        TemplateStringTable strings;
+        for (const SourceInfo &source : sources) {
+            strings.intern(source.m_type);
+        }
+
+        // Templates are written out first so the string table
+        // holds every string by the time it is written
+        std::vector<std::vector<char>> blobs;
+        blobs.reserve(templates.size());
+        for (const auto &[type, template_] : templates) {
+            std::vector<char> &blob = blobs.emplace_back();
+            Serializer blob_out(blob);
+
+            auto result = template_->serializeCached(blob_out, strings);
+            if (!result) {
+                return make_fs_error<void>(std::error_code(), result.error().m_message);
+            }
+        }
+
+        std::vector<char> cache_data;
+        Serializer out(cache_data);
+
+        out.write<u32>(c_magic);
+        out.write<u32>(c_version);
+
+        strings.serialize(out);
+
+        out.write<u32>(static_cast<u32>(sources.size()));
+        for (const SourceInfo &source : sources) {
+            out.write<u32>(strings.intern(source.m_type));
+            out.write<u64>(source.m_mtime);
+            out.write<u64>(source.m_size);
+            out.write<u64>(source.m_hash);
+        }
+
+        out.write<u32>(static_cast<u32>(blobs.size()));
+
+        u32 blob_offset = static_cast<u32>(out.tell()) + static_cast<u32>(blobs.size() * 4);
+        for (const std::vector<char> &blob : blobs) {
+            out.write<u32>(blob_offset);
+            blob_offset += static_cast<u32>(blob.size());
+        }
+
+        for (const std::vector<char> &blob : blobs) {
+            out.writeBytes(blob);
+        }
+
+        auto cache_folder_result = Filesystem::is_directory(cache_path.parent_path());
+        if (!cache_folder_result) {
+            return std::unexpected(cache_folder_result.error());
+        }
+
+        if (!cache_folder_result.value()) {
+            auto result = Filesystem::create_directory(cache_path.parent_path());
+            if (!result) {
+                return std::unexpected(result.error());
+            }
+        }
+
+        std::ofstream file(cache_path, std::ios::out | std::ios::binary);
+        if (!file.is_open()) {
+            return make_fs_error<void>(std::error_code(),
+                                       {"(TemplateCache) failed to open cache for writing!"});
+        }
+
+        // A truncated cache would be rejected as corrupt on every open, so
+        // don't leave one behind
+        if (!file.write(cache_data.data(), cache_data.size()).flush()) {
+            file.close();
+            (void)Filesystem::remove(cache_path);
+            return make_fs_error<void>(std::error_code(),
+                                       {"(TemplateCache) failed to write cache!"});
+        }
+        return {};
+    }
+
+    Result<void, FSError> TemplateCache::open(const std::filesystem::path &cache_path,
+                                              const std::filesystem::path &folder) {
+        m_offsets.clear();
+
+        auto map_result = m_mapping.open(cache_path);
+        if (!map_result) {
+            return make_fs_error<void>(std::error_code(), map_result.error().m_message);
+        }
+
+        Deserializer in(m_mapping.view(), cache_path.string());
+
+        if (in.read<u32>() != c_magic || in.read<u32>() != c_version) {
+            return make_fs_error<void>(std::error_code(),
+                                       {"(TemplateCache) cache is from another version"});
+        }
+
+        auto strings_result = m_strings.deserialize(in);
+        if (!strings_result) {
+            return make_fs_error<void>(std::error_code(), strings_result.error().m_message);
+        }
+
+        std::vector<mtime_patch_t> mtime_patches;
+
+        auto sources_result = validateSources(in, folder, mtime_patches);
+        if (!sources_result) {
+            return std::unexpected(sources_result.error());
+        }
+
+        u32 template_count = in.read<u32>();
+        if (!in.good() ||
+            static_cast<size_t>(template_count) * sizeof(u32) > m_mapping.size()) {
+            return make_fs_error<void>(std::error_code(), {"(TemplateCache) cache is corrupt"});
+        }
+
+        m_offsets.resize(template_count);
+        for (u32 &offset : m_offsets) {
+            offset = in.read<u32>();
+        }
+
+        if (!in.good() ||
+            std::any_of(m_offsets.begin(), m_offsets.end(),
+                        [&](u32 offset) { return offset >= m_mapping.size(); })) {
+            m_offsets.clear();
+            return make_fs_error<void>(std::error_code(), {"(TemplateCache) cache is corrupt"});
+        }
+
+        if (!mtime_patches.empty()) {
+            // Windows refuses to write a file while it is mapped. A failed
+            // patch only means the files get hashed again next time.
+            m_mapping.close();
+            (void)PatchSourceTimes(cache_path, mtime_patches);
+
+            auto remap_result = m_mapping.open(cache_path);
+            if (!remap_result) {
+                m_offsets.clear();
+                return make_fs_error<void>(std::error_code(), remap_result.error().m_message);
+            }
+        }
+
+        return {};
+    }
+
+    Result<Template, SerialError> TemplateCache::loadTemplate(size_t index) const {
+        Deserializer in(m_mapping.view().subspan(m_offsets[index]));
+
+        Template template_;
+        auto result = template_.deserializeCached(in, m_strings);
+        if (!result) {
+            return std::unexpected(result.error());
+        }
+
+        return template_;
+    }
+
+    Result<void, FSError>
+    TemplateCache::PatchSourceTimes(const std::filesystem::path &cache_path,
+                                    std::span<const mtime_patch_t> patches) {
+        std::fstream file(cache_path, std::ios::in | std::ios::out | std::ios::binary);
+        if (!file.is_open()) {
+            return make_fs_error<void>(std::error_code(),
+                                       {"(TemplateCache) failed to open cache for writing!"});
+        }
+
+        std::vector<char> mtime_data;
+        for (const auto &[offset, mtime] : patches) {
+            Serializer out(mtime_data);
+            out.write<u64>(mtime);
+
+            file.seekp(static_cast<std::streamoff>(offset));
+            file.write(mtime_data.data(), mtime_data.size());
+        }
+
+        if (!file) {
+            return make_fs_error<void>(std::error_code(),
+                                       {"(TemplateCache) failed to update source times!"});
+        }
+
+        return {};
+    }
+
+    Result<void, FSError>
+    TemplateCache::validateSources(Deserializer &in, const std::filesystem::path &folder,
+                                   std::vector<mtime_patch_t> &mtime_patches) const {
+        auto scan_result = ScanSources(folder, false);
+        if (!scan_result) {
+            return std::unexpected(scan_result.error());
+        }
+
+        std::unordered_map<std::string_view, const SourceInfo *> current_sources;
+        for (const SourceInfo &source : scan_result.value()) {
+            current_sources.emplace(source.m_type, &source);
+        }
+
+        auto make_stale_error = [](std::string_view reason) {
+            return make_fs_error<void>(std::error_code(),
+                                       {std::format("(TemplateCache) cache is stale: {}", reason)});
+        };
+
+        u32 source_count = in.read<u32>();
+        if (source_count != current_sources.size()) {
+            return make_stale_error("templates were added or removed");
+        }
+
+        for (u32 i = 0; i < source_count; ++i) {
+            std::string_view type = m_strings.get(in.read<u32>());
+            size_t mtime_offset   = static_cast<size_t>(in.tell());
+            u64 mtime             = in.read<u64>();
+            u64 size              = in.read<u64>();
+            u64 hash              = in.read<u64>();
+
+            auto it = current_sources.find(type);
+            if (it == current_sources.end()) {
+                return make_stale_error(std::format("{} was removed", type));
+            }
+
+            const SourceInfo &current = *it->second;
+            if (current.m_size != size) {
+                return make_stale_error(std::format("{} changed", type));
+            }
+
+            // Checkouts and copies touch mtimes without changing anything
+            if (current.m_mtime != mtime) {
+                auto hash_result = HashFile(folder / (current.m_type + ".json"));
+                if (!hash_result || hash_result.value() != hash) {
+                    return make_stale_error(std::format("{} changed", type));
+                }
+                mtime_patches.emplace_back(mtime_offset, current.m_mtime);
+            }
+        }
+
+        if (!in.good()) {
+            return make_fs_error<void>(std::error_code(), {"(TemplateCache) cache is corrupt"});
+        }
+
+        return {};
+    }
+
+}  // namespace Toolbox::Object
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include <format>
+
+#include "platform/filemap.hpp"
+
+#ifdef TOOLBOX_PLATFORM_WINDOWS
+#include <Windows.h>
+#elif defined(TOOLBOX_PLATFORM_LINUX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Toolbox::Platform {
+
+#ifdef TOOLBOX_PLATFORM_WINDOWS
+    Result<void> MappedFile::open(const std::filesystem::path &path) {
+        close();
+
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return make_error<void>("FILE_MAPPING",
+                                    std::format("Failed to open file \"{}\".", path.string()));
+        }
+
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+            CloseHandle(file);
+            return make_error<void>("FILE_MAPPING",
+                                    std::format("File \"{}\" is empty.", path.string()));
+        }
+
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) {
+            CloseHandle(file);
+            return make_error<void>("FILE_MAPPING",
+                                    std::format("Failed to map file \"{}\".", path.string()));
+        }
+
+        void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+        // The view holds its own reference to the mapping
+        CloseHandle(mapping);
+        CloseHandle(file);
+
+        if (!view) {
+            return make_error<void>(
+                "FILE_MAPPING", std::format("Failed to get view of file \"{}\".", path.string()));
+        }
+
+        m_view = static_cast<const char *>(view);
+        m_size = static_cast<size_t>(file_size.QuadPart);
+        return {};
+    }
+
+    void MappedFile::close() {
+        if (m_view) {
+            UnmapViewOfFile(m_view);
+        }
+        m_view = nullptr;
+        m_size = 0;
+    }
+#elif defined(TOOLBOX_PLATFORM_LINUX)
+    Result<void> MappedFile::open(const std::filesystem::path &path) {
+        close();
+
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd == -1) {
+            return make_error<void>("FILE_MAPPING",
+                                    std::format("Failed to open file \"{}\".", path.string()));
+        }
+
+        struct stat file_stat;
+        if (fstat(fd, &file_stat) == -1 || file_stat.st_size == 0) {
+            ::close(fd);
+            return make_error<void>("FILE_MAPPING",
+                                    std::format("File \"{}\" is empty.", path.string()));
+        }
+
+        const size_t size = static_cast<size_t>(file_stat.st_size);
+        void *view        = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        // The mapping holds its own reference to the file
+        ::close(fd);
+
+        if (view == MAP_FAILED) {
+            return make_error<void>(
+                "FILE_MAPPING", std::format("Failed to get view of file \"{}\".", path.string()));
+        }
+
+        m_view = static_cast<const char *>(view);
+        m_size = size;
+        return {};
+    }
+
+    void MappedFile::close() {
+        if (m_view) {
+            munmap(const_cast<char *>(m_view), m_size);
+        }
+        m_view = nullptr;
+        m_size = 0;
+    }
+#endif
+
+}  // namespace Toolbox::Platform
\ No newline at end of file
@@ -10,9 +10,8 @@
 #ifdef TOOLBOX_PLATFORM_WINDOWS
 #include <TlHelp32.h>
 #include <Windows.h>
-#elif TOOLBOX_PLATFORM_LINUX
+#elif defined(TOOLBOX_PLATFORM_LINUX)
 #include <limits>
-#include <process.h>
 #include <signal.h>
 #include <sys/types.h>
 #include <sys/wait.h>
@@ -184,11 +183,11 @@ namespace Toolbox::Platform {
         return UpdateWindow(window);
     }
 
-#elif TOOLBOX_PLATFORM_LINUX
+#elif defined(TOOLBOX_PLATFORM_LINUX)
     std::string GetLastErrorMessage() { return std::strerror(errno); }
 
     Result<ProcessInformation> CreateExProcess(const std::filesystem::path &program_path,
-                                               const std::string &cmdargs) {
+                                               std::string_view cmdargs) {
         std::string true_cmdargs =
             std::format("\"{}\" {}", program_path.string().c_str(), cmdargs.data());
 
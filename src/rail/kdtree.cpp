@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "rail/kdtree.hpp"
+
+namespace Toolbox::Rail {
+
+    static bool NeighborLess(const KDTree::neighbor_t &a, const KDTree::neighbor_t &b) {
+        return a.first < b.first;
+    }
+
+    void KDTree::build(const std::vector<glm::vec3> &points) {
+        clear();
+
+        m_indices.resize(points.size());
+        m_axes.resize(points.size(), 0);
+        std::iota(m_indices.begin(), m_indices.end(), static_cast<size_t>(0));
+
+        buildRange(points, 0, points.size());
+
+        // Kept in tree order so a search walks memory mostly forward
+        m_points.reserve(points.size());
+        for (size_t index : m_indices) {
+            m_points.push_back(points[index]);
+        }
+    }
+
+    void KDTree::clear() {
+        m_points.clear();
+        m_indices.clear();
+        m_axes.clear();
+    }
+
+    void KDTree::nearest(const glm::vec3 &point, size_t count, size_t exclude,
+                         std::vector<neighbor_t> &out) const {
+        out.clear();
+        if (count == 0) {
+            return;
+        }
+
+        // Searched as a max heap of squared distances so the farthest of
+        // the best so far is the one to beat
+        searchRange(0, m_points.size(), point, count, exclude, out);
+
+        std::sort_heap(out.begin(), out.end(), NeighborLess);
+        for (auto &neighbor : out) {
+            neighbor.first = std::sqrt(neighbor.first);
+        }
+    }
+
+    void KDTree::buildRange(const std::vector<glm::vec3> &points, size_t begin, size_t end) {
+        if (end - begin <= 1) {
+            return;
+        }
+
+        glm::vec3 min = points[m_indices[begin]];
+        glm::vec3 max = points[m_indices[begin]];
+        for (size_t i = begin + 1; i < end; ++i) {
+            min = glm::min(min, points[m_indices[i]]);
+            max = glm::max(max, points[m_indices[i]]);
+        }
+
+        glm::vec3 extent = max - min;
+        u8 axis          = 0;
+        if (extent.y > extent[axis]) {
+            axis = 1;
+        }
+        if (extent.z > extent[axis]) {
+            axis = 2;
+        }
+
+        size_t middle = begin + (end - begin) / 2;
+        std::nth_element(m_indices.begin() + begin, m_indices.begin() + middle,
+                         m_indices.begin() + end,
+                         [&](size_t a, size_t b) { return points[a][axis] < points[b][axis]; });
+
+        m_axes[middle] = axis;
+
+        buildRange(points, begin, middle);
+        buildRange(points, middle + 1, end);
+    }
+
+    void KDTree::searchRange(size_t begin, size_t end, const glm::vec3 &point, size_t count,
+                             size_t exclude, std::vector<neighbor_t> &heap) const {
+        if (begin >= end) {
+            return;
+        }
+
+        size_t middle            = begin + (end - begin) / 2;
+        const glm::vec3 &current = m_points[middle];
+
+        if (m_indices[middle] != exclude) {
+            glm::vec3 delta = current - point;
+            f32 distance_sq = glm::dot(delta, delta);
+            if (heap.size() < count) {
+                heap.emplace_back(distance_sq, m_indices[middle]);
+                std::push_heap(heap.begin(), heap.end(), NeighborLess);
+            } else if (distance_sq < heap.front().first) {
+                std::pop_heap(heap.begin(), heap.end(), NeighborLess);
+                heap.back() = {distance_sq, m_indices[middle]};
+                std::push_heap(heap.begin(), heap.end(), NeighborLess);
+            }
+        }
+
+        if (end - begin == 1) {
+            return;
+        }
+
+        u8 axis     = m_axes[middle];
+        f32 offset  = point[axis] - current[axis];
+        bool before = offset < 0.0f;
+
+        if (before) {
+            searchRange(begin, middle, point, count, exclude, heap);
+        } else {
+            searchRange(middle + 1, end, point, count, exclude, heap);
+        }
+
+        // The far side can only hold a nearer point when the splitting
+        // plane is closer than the farthest point kept
+        if (heap.size() < count || offset * offset < heap.front().first) {
+            if (before) {
+                searchRange(middle + 1, end, point, count, exclude, heap);
+            } else {
+                searchRange(begin, middle, point, count, exclude, heap);
+            }
+        }
+    }
+
+}  // namespace Toolbox::Rail
\ No newline at end of file
@@ -1,3 +1,7 @@
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
 #include "rail/rail.hpp"
 
 #include "objlib/meta/member.hpp"
@@ -7,38 +11,87 @@ using namespace Toolbox::Object;
 
 namespace Toolbox::Rail {
 
-    RailNode::RailNode() : RailNode(0, 0, 0, 0) {}
-    RailNode::RailNode(u32 flags) : RailNode(0, 0, 0, flags) {}
-    RailNode::RailNode(s16 x, s16 y, s16 z) : RailNode(x, y, z, 0) {}
+    template <typename T> static T LoadBigEndian(const char *data) {
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+        if constexpr (std::endian::native == std::endian::little) {
+            if constexpr (std::is_same_v<T, f32>) {
+                value = std::bit_cast<f32>(std::byteswap(std::bit_cast<u32>(value)));
+            } else {
+                value = std::byteswap(value);
+            }
+        }
+        return value;
+    }
 
-    RailNode::RailNode(s16 x, s16 y, s16 z, u32 flags) {
-        m_pos_x = make_referable<MetaMember>("PositionX", MetaValue(x));
-        m_pos_y = make_referable<MetaMember>("PositionY", MetaValue(y));
-        m_pos_z = make_referable<MetaMember>("PositionZ", MetaValue(z));
+    template <typename T> static void StoreBigEndian(char *data, T value) {
+        if constexpr (std::endian::native == std::endian::little) {
+            if constexpr (std::is_same_v<T, f32>) {
+                value = std::bit_cast<f32>(std::byteswap(std::bit_cast<u32>(value)));
+            } else {
+                value = std::byteswap(value);
+            }
+        }
+        std::memcpy(data, &value, sizeof(T));
+    }
 
-        m_flags = make_referable<MetaMember>("Flags", MetaValue(flags));
+    // Positions are stored as s16 by the game
+    static glm::vec3 TruncatePosition(const glm::vec3 &position) {
+        return glm::vec3(static_cast<s16>(std::clamp(position.x, -32768.0f, 32767.0f)),
+                         static_cast<s16>(std::clamp(position.y, -32768.0f, 32767.0f)),
+                         static_cast<s16>(std::clamp(position.z, -32768.0f, 32767.0f)));
+    }
 
-        MetaValue values_default = MetaValue(static_cast<s16>(-1));
+    RailNodeRecord RailNodeRecord::FromBytes(const char *data) {
+        RailNodeRecord record;
+        record.m_position = glm::vec3(LoadBigEndian<s16>(data + 0), LoadBigEndian<s16>(data + 2),
+                                      LoadBigEndian<s16>(data + 4));
 
-        std::vector<MetaValue> values;
-        values.push_back(values_default);
-        values.push_back(values_default);
-        values.push_back(values_default);
-        values.push_back(values_default);
+        s16 connection_count      = LoadBigEndian<s16>(data + 6);
+        record.m_connection_count = static_cast<u16>(
+            std::clamp<s16>(connection_count, 0, static_cast<s16>(c_max_connections)));
+
+        record.m_flags = LoadBigEndian<u32>(data + 8);
+
+        for (size_t i = 0; i < record.m_values.size(); ++i) {
+            record.m_values[i] = LoadBigEndian<s16>(data + 12 + i * sizeof(s16));
+        }
+
+        // Unused connection slots are padding
+        for (size_t i = 0; i < record.m_connection_count; ++i) {
+            record.m_connections[i] = LoadBigEndian<s16>(data + 20 + i * sizeof(s16));
+            record.m_distances[i]   = LoadBigEndian<f32>(data + 36 + i * sizeof(f32));
+        }
 
-        m_values = make_referable<MetaMember>("Values", values,
-                                                make_referable<MetaValue>(values_default));
+        return record;
+    }
+
+    void RailNodeRecord::toBytes(char *data) const {
+        std::memset(data, 0, c_data_size);
 
-        m_connection_count =
-            make_referable<MetaMember>("ConnectionCount", MetaValue(static_cast<u32>(0)));
+        StoreBigEndian<s16>(data + 0, static_cast<s16>(m_position.x));
+        StoreBigEndian<s16>(data + 2, static_cast<s16>(m_position.y));
+        StoreBigEndian<s16>(data + 4, static_cast<s16>(m_position.z));
+        StoreBigEndian<s16>(data + 6, static_cast<s16>(m_connection_count));
+        StoreBigEndian<u32>(data + 8, m_flags);
 
-        auto connection_value          = m_connection_count->value<MetaValue>(0).value();
-        MetaMember::ReferenceInfo info = {connection_value, "ConnectionCount"};
+        for (size_t i = 0; i < m_values.size(); ++i) {
+            StoreBigEndian<s16>(data + 12 + i * sizeof(s16), m_values[i]);
+        }
+
+        for (size_t i = 0; i < m_connection_count; ++i) {
+            StoreBigEndian<s16>(data + 20 + i * sizeof(s16), m_connections[i]);
+            StoreBigEndian<f32>(data + 36 + i * sizeof(f32), m_distances[i]);
+        }
+    }
+
+    RailNode::RailNode() : RailNode(0, 0, 0, 0) {}
+    RailNode::RailNode(u32 flags) : RailNode(0, 0, 0, flags) {}
+    RailNode::RailNode(s16 x, s16 y, s16 z) : RailNode(x, y, z, 0) {}
 
-        m_connections = make_referable<MetaMember>(
-            "Connections", info, make_referable<MetaValue>(MetaValue(static_cast<s16>(0))));
-        m_distances = make_referable<MetaMember>(
-            "Distances", info, make_referable<MetaValue>(MetaValue(static_cast<f32>(0))));
+    RailNode::RailNode(s16 x, s16 y, s16 z, u32 flags) {
+        m_record.m_position = glm::vec3(x, y, z);
+        m_record.m_flags    = flags;
     }
 
     RailNode::RailNode(glm::vec3 pos)
@@ -47,35 +100,47 @@ namespace Toolbox::Rail {
         : RailNode(static_cast<s16>(pos.x), static_cast<s16>(pos.y), static_cast<s16>(pos.z),
                    flags) {}
 
+    RailNode::RailNode(const RailNode &other)
+        : m_UUID64(other.m_UUID64), m_record(other.getRecord()) {}
+
+    RailNode &RailNode::operator=(const RailNode &other) {
+        if (this != &other) {
+            setRecord(other.getRecord());
+        }
+        return *this;
+    }
+
+    template <typename T>
+    T &RailNode::field(std::vector<T> Rail::*array, T RailNodeRecord::*member) {
+        return m_rail ? (m_rail->*array)[m_index] : m_record.*member;
+    }
+
+    template <typename T>
+    const T &RailNode::field(std::vector<T> Rail::*array, T RailNodeRecord::*member) const {
+        return m_rail ? (m_rail->*array)[m_index] : m_record.*member;
+    }
+
+    UUID64 RailNode::getRailUUID() const { return m_rail ? m_rail->getUUID() : UUID64(0); }
+
     glm::vec3 RailNode::getPosition() const {
-        RefPtr<MetaValue> value_x = m_pos_x->value<MetaValue>(0).value();
-        RefPtr<MetaValue> value_y = m_pos_y->value<MetaValue>(0).value();
-        RefPtr<MetaValue> value_z = m_pos_z->value<MetaValue>(0).value();
-        return glm::vec3(*value_x->get<s16>(), *value_y->get<s16>(), *value_z->get<s16>());
+        return field(&Rail::m_node_positions, &RailNodeRecord::m_position);
     }
 
     void RailNode::getPosition(s16 &x, s16 &y, s16 &z) const {
-        RefPtr<MetaValue> value_x = m_pos_x->value<MetaValue>(0).value();
-        RefPtr<MetaValue> value_y = m_pos_y->value<MetaValue>(0).value();
-        RefPtr<MetaValue> value_z = m_pos_z->value<MetaValue>(0).value();
-        x                                  = *value_x->get<s16>();
-        y                                  = *value_y->get<s16>();
-        z                                  = *value_z->get<s16>();
+        glm::vec3 position = getPosition();
+        x                  = static_cast<s16>(position.x);
+        y                  = static_cast<s16>(position.y);
+        z                  = static_cast<s16>(position.z);
     }
 
     void RailNode::setPosition(const glm::vec3 &position) {
-        RefPtr<MetaValue> value_x = m_pos_x->value<MetaValue>(0).value();
-        RefPtr<MetaValue> value_y = m_pos_y->value<MetaValue>(0).value();
-        RefPtr<MetaValue> value_z = m_pos_z->value<MetaValue>(0).value();
-        value_x->set(std::clamp<s16>(static_cast<s16>(position.x), -32768, 32767));
-        value_y->set(std::clamp<s16>(static_cast<s16>(position.y), -32768, 32767));
-        value_z->set(std::clamp<s16>(static_cast<s16>(position.z), -32768, 32767));
+        field(&Rail::m_node_positions, &RailNodeRecord::m_position) = TruncatePosition(position);
+        if (m_rail) {
+            m_rail->invalidateNodeTree();
+        }
     }
 
-    u32 RailNode::getFlags() const {
-        RefPtr<MetaValue> value = m_flags->value<MetaValue>(0).value();
-        return *value->get<u32>();
-    }
+    u32 RailNode::getFlags() const { return field(&Rail::m_node_flags, &RailNodeRecord::m_flags); }
 
     bool RailNode::operator==(const RailNode &other) const {
         return getPosition() == other.getPosition() && getFlags() == other.getFlags();
@@ -118,162 +183,161 @@ namespace Toolbox::Rail {
     }
 
     void RailNode::setFlags(u32 flags) {
-        RefPtr<MetaValue> value = m_flags->value<MetaValue>(0).value();
-        value->set<u32>(flags);
+        field(&Rail::m_node_flags, &RailNodeRecord::m_flags) = flags;
     }
 
     Result<s16, MetaError> RailNode::getValue(size_t index) const {
-        auto value = m_values->value<MetaValue>(index);
-        if (!value) {
-            return std::unexpected(value.error());
+        const auto &values = field(&Rail::m_node_values, &RailNodeRecord::m_values);
+        if (index >= values.size()) {
+            return make_meta_error<s16>("Error getting node value", index, values.size());
         }
-        return *value.value()->get<s16>();
+        return values[index];
     }
 
     Result<void, MetaError> RailNode::setValue(size_t index, s16 value) {
-        auto meta_value = m_values->value<MetaValue>(index);
-        if (!meta_value) {
-            return std::unexpected(meta_value.error());
+        auto &values = field(&Rail::m_node_values, &RailNodeRecord::m_values);
+        if (index >= values.size()) {
+            return make_meta_error<void>("Error setting node value", index, values.size());
         }
-        meta_value.value()->set<s16>(value);
+        values[index] = value;
         return {};
     }
 
     u16 RailNode::getConnectionCount() const {
-        auto value_count = m_connection_count->value<MetaValue>(0).value();
-        return static_cast<u16>(*value_count->get<u32>());
+        return field(&Rail::m_node_connection_counts, &RailNodeRecord::m_connection_count);
     }
 
     Result<s16, MetaError> RailNode::getConnectionValue(size_t index) const {
-        auto value = m_connections->value<MetaValue>(index);
-        if (!value) {
-            return std::unexpected(value.error());
+        u16 connection_count = getConnectionCount();
+        if (index >= connection_count) {
+            return make_meta_error<s16>("Error getting node connection", index, connection_count);
         }
-        return *value.value()->get<s16>();
+        return field(&Rail::m_node_connections, &RailNodeRecord::m_connections)[index];
     }
 
     Result<f32, MetaError> RailNode::getConnectionDistance(size_t index) const {
-        auto value = m_distances->value<MetaValue>(index);
-        if (!value) {
-            return std::unexpected(value.error());
+        u16 connection_count = getConnectionCount();
+        if (index >= connection_count) {
+            return make_meta_error<f32>("Error getting node distance", index, connection_count);
         }
-        return *value.value()->get<f32>();
+        return field(&Rail::m_node_distances, &RailNodeRecord::m_distances)[index];
     }
 
-    Result<void, SerialError> RailNode::serialize(Serializer &out) const {
-        auto connection_count = getConnectionCount();
-
-        {
-            s16 x, y, z;
-            getPosition(x, y, z);
+    RailNodeRecord RailNode::getRecord() const {
+        return m_rail ? m_rail->getNodeRecord(m_index) : m_record;
+    }
 
-            out.write<s16, std::endian::big>(x);
-            out.write<s16, std::endian::big>(y);
-            out.write<s16, std::endian::big>(z);
+    void RailNode::setRecord(const RailNodeRecord &record) {
+        if (!m_rail) {
+            m_record = record;
+            return;
         }
+        m_rail->m_node_positions[m_index]         = record.m_position;
+        m_rail->m_node_flags[m_index]             = record.m_flags;
+        m_rail->m_node_values[m_index]            = record.m_values;
+        m_rail->m_node_connection_counts[m_index] = record.m_connection_count;
+        m_rail->m_node_connections[m_index]       = record.m_connections;
+        m_rail->m_node_distances[m_index]         = record.m_distances;
+
+        m_rail->invalidateNodeTree();
+        m_rail->invalidateNodeReferrers();
+    }
 
-        out.write<s16, std::endian::big>(connection_count);
-        out.write<u32, std::endian::big>(getFlags());
+    std::vector<RefPtr<MetaMember>> RailNode::getMembers() const {
+        RailNodeRecord record = getRecord();
 
-        for (int i = 0; i < 4; ++i) {
-            auto value = getValue(i);
-            if (!value) {
-                return make_serial_error<void>(
-                    out, std::format(
-                             "Unexpected end of values in RailNode (expected 4 but only {} exist).",
-                             i + 1));
-            }
-            out.write<s16, std::endian::big>(*value);
-        }
+        s16 x, y, z;
+        getPosition(x, y, z);
 
-        size_t connection_skip = (8 - connection_count) * 2;
-        size_t distance_skip   = connection_skip * 2;
-
-        for (int i = 0; i < connection_count; ++i) {
-            auto connection = getConnectionValue(i);
-            if (!connection) {
-                return make_serial_error<void>(
-                    out, std::format(
-                             "Unexpected end of connections in RailNode (expected {} but only {} "
-                             "exist).",
-                             connection_count, i + 1));
-            }
-            out.write<s16, std::endian::big>(*connection);
-        }
+        std::vector<RefPtr<MetaMember>> members;
+        members.push_back(make_referable<MetaMember>("PositionX", MetaValue(x)));
+        members.push_back(make_referable<MetaMember>("PositionY", MetaValue(y)));
+        members.push_back(make_referable<MetaMember>("PositionZ", MetaValue(z)));
+        members.push_back(make_referable<MetaMember>("Flags", MetaValue(record.m_flags)));
 
-        for (int i = 0; i < connection_skip; ++i) {
-            out.write<u8>(0);
+        std::vector<MetaValue> values;
+        for (s16 value : record.m_values) {
+            values.push_back(MetaValue(value));
         }
-
-        for (int i = 0; i < connection_count; ++i) {
-            auto distance = getConnectionDistance(i);
-            if (!distance) {
-                return make_serial_error<void>(
-                    out,
-                    std::format("Unexpected end of distances in RailNode (expected {} but only {} "
-                                "exist).",
-                                connection_count, i + 1));
-            }
-            out.write<f32, std::endian::big>(*distance);
+        members.push_back(make_referable<MetaMember>(
+            "Values", values, make_referable<MetaValue>(MetaValue(static_cast<s16>(-1)))));
+
+        RefPtr<MetaMember> connection_count = make_referable<MetaMember>(
+            "ConnectionCount", MetaValue(static_cast<u32>(record.m_connection_count)));
+        members.push_back(connection_count);
+
+        std::vector<MetaValue> connections;
+        std::vector<MetaValue> distances;
+        for (size_t i = 0; i < record.m_connection_count; ++i) {
+            connections.push_back(MetaValue(record.m_connections[i]));
+            distances.push_back(MetaValue(record.m_distances[i]));
         }
 
-        for (size_t i = 0; i < distance_skip; ++i) {
-            out.write<u8>(0);
-        }
+        MetaMember::ReferenceInfo info = {connection_count->value<MetaValue>(0).value(),
+                                          "ConnectionCount"};
+        members.push_back(make_referable<MetaMember>(
+            "Connections", connections, info,
+            make_referable<MetaValue>(MetaValue(static_cast<s16>(0)))));
+        members.push_back(make_referable<MetaMember>(
+            "Distances", distances, info,
+            make_referable<MetaValue>(MetaValue(static_cast<f32>(0)))));
 
+        return members;
+    }
+
+    Result<void, SerialError> RailNode::serialize(Serializer &out) const {
+        std::array<char, RailNodeRecord::c_data_size> data;
+        getRecord().toBytes(data.data());
+        out.writeBytes(data);
         return {};
     }
 
     Result<void, SerialError> RailNode::deserialize(Deserializer &in) {
-        auto x = in.read<s16, std::endian::big>();
-        auto y = in.read<s16, std::endian::big>();
-        auto z = in.read<s16, std::endian::big>();
-        setPosition(x, y, z);
-
-        auto connection_count = in.read<s16, std::endian::big>();
-        setConnectionCount(connection_count);
-
-        auto flags = in.read<u32, std::endian::big>();
-        setFlags(flags);
+        std::array<char, RailNodeRecord::c_data_size> data;
+        in.readBytes(data);
+        setRecord(RailNodeRecord::FromBytes(data.data()));
+        return {};
+    }
 
-        for (int i = 0; i < 4; ++i) {
-            auto value = in.read<s16, std::endian::big>();
-            setValue(i, value);
-        }
+    void RailNode::setConnectionCount(u16 count) {
+        count = std::min<u16>(count, RailNodeRecord::c_max_connections);
 
-        size_t connection_skip = (8 - connection_count) * 2;
-        size_t distance_skip   = connection_skip * 2;
+        u16 &connection_count =
+            field(&Rail::m_node_connection_counts, &RailNodeRecord::m_connection_count);
+        auto &connections = field(&Rail::m_node_connections, &RailNodeRecord::m_connections);
+        auto &distances   = field(&Rail::m_node_distances, &RailNodeRecord::m_distances);
 
-        for (int i = 0; i < connection_count; ++i) {
-            auto connection = in.read<s16, std::endian::big>();
-            setConnectionValue(i, connection);
+        if (m_rail) {
+            for (u16 i = count; i < connection_count; ++i) {
+                m_rail->removeNodeReferrer(m_index, connections[i]);
+            }
         }
 
-        in.stream().seekg(connection_skip, std::ios_base::cur);
+        // Connections that come back into use start out cleared
+        std::fill(connections.begin() + count, connections.end(), 0);
+        std::fill(distances.begin() + count, distances.end(), 0.0f);
 
-        for (int i = 0; i < connection_count; ++i) {
-            auto distance = in.read<f32, std::endian::big>();
-            setConnectionDistance(i, distance);
+        if (m_rail) {
+            for (u16 i = connection_count; i < count; ++i) {
+                m_rail->addNodeReferrer(m_index, connections[i]);
+            }
         }
 
-        in.stream().seekg(distance_skip, std::ios_base::cur);
-
-        return {};
-    }
-
-    void RailNode::setConnectionCount(u16 count) {
-        auto value_count = m_connection_count->value<MetaValue>(0).value();
-        value_count->set<u32>(count);
-        m_connections->syncArray();
-        m_distances->syncArray();
+        connection_count = count;
     }
 
     Result<void, MetaError> RailNode::setConnectionValue(size_t index, s16 value) {
-        auto connection = m_connections->value<MetaValue>(index);
-        if (!connection) {
-            return std::unexpected(connection.error());
+        u16 connection_count = getConnectionCount();
+        if (index >= connection_count) {
+            return make_meta_error<void>("Error setting node connection", index,
+                                         connection_count);
         }
-        connection.value()->set<s16>(value);
+        s16 &connection = field(&Rail::m_node_connections, &RailNodeRecord::m_connections)[index];
+        if (m_rail) {
+            m_rail->removeNodeReferrer(m_index, connection);
+            m_rail->addNodeReferrer(m_index, value);
+        }
+        connection = value;
         return {};
     }
 
@@ -286,35 +350,18 @@ namespace Toolbox::Rail {
 
     Result<void, MetaError> RailNode::setConnectionDistance(size_t connection,
                                                                    f32 distance) {
-        auto meta_distance = m_distances->value<MetaValue>(connection);
-        if (!meta_distance) {
-            return std::unexpected(meta_distance.error());
+        u16 connection_count = getConnectionCount();
+        if (connection >= connection_count) {
+            return make_meta_error<void>("Error setting node distance", connection,
+                                         connection_count);
         }
-        meta_distance.value()->set<f32>(distance);
+        field(&Rail::m_node_distances, &RailNodeRecord::m_distances)[connection] = distance;
         return {};
     }
 
     ScopePtr<ISmartResource> RailNode::clone(bool deep) const {
-        auto node = make_scoped<RailNode>();
-        if (deep) {
-            node->m_pos_x            = make_deep_clone<MetaMember>(m_pos_x);
-            node->m_pos_y            = make_deep_clone<MetaMember>(m_pos_y);
-            node->m_pos_z            = make_deep_clone<MetaMember>(m_pos_z);
-            node->m_flags            = make_deep_clone<MetaMember>(m_flags);
-            node->m_values           = make_deep_clone<MetaMember>(m_values);
-            node->m_connection_count = make_deep_clone<MetaMember>(m_connection_count);
-            node->m_connections      = make_deep_clone<MetaMember>(m_connections);
-            node->m_distances        = make_deep_clone<MetaMember>(m_distances);
-        } else {
-            node->m_pos_x            = make_clone<MetaMember>(m_pos_x);
-            node->m_pos_y            = make_clone<MetaMember>(m_pos_y);
-            node->m_pos_z            = make_clone<MetaMember>(m_pos_z);
-            node->m_flags            = make_clone<MetaMember>(m_flags);
-            node->m_values           = make_clone<MetaMember>(m_values);
-            node->m_connection_count = make_clone<MetaMember>(m_connection_count);
-            node->m_connections      = make_clone<MetaMember>(m_connections);
-            node->m_distances        = make_clone<MetaMember>(m_distances);
-        }
+        auto node      = make_scoped<RailNode>();
+        node->m_record = getRecord();
         return node;
     }
 
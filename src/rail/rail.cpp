@@ -1,5 +1,8 @@
+#include <algorithm>
+#include <numeric>
 #include <unordered_set>
 
+#include "core/threadpool.hpp"
 #include "rail/node.hpp"
 #include "rail/rail.hpp"
 
@@ -10,46 +13,109 @@ using namespace Toolbox::Object;
 
 namespace Toolbox::Rail {
 
+    Rail::Rail(std::string_view name, std::vector<node_ptr_t> nodes) : m_name(name) {
+        for (auto &node : nodes) {
+            addNode(node);
+        }
+    }
+
+    Rail::Rail(const Rail &other)
+        : m_UUID64(other.m_UUID64), m_sibling_id(other.m_sibling_id), m_name(other.m_name) {
+        copyNodesFrom(other);
+    }
+
+    Rail::Rail(Rail &&other)
+        : m_UUID64(other.m_UUID64), m_sibling_id(other.m_sibling_id),
+          m_name(std::move(other.m_name)) {
+        moveNodesFrom(other);
+    }
+
+    Rail::~Rail() { detachNodes(); }
+
+    Rail &Rail::operator=(const Rail &other) {
+        if (this == &other) {
+            return *this;
+        }
+        m_UUID64     = other.m_UUID64;
+        m_sibling_id = other.m_sibling_id;
+        m_name       = other.m_name;
+        detachNodes();
+        copyNodesFrom(other);
+        return *this;
+    }
+
+    Rail &Rail::operator=(Rail &&other) {
+        if (this == &other) {
+            return *this;
+        }
+        m_UUID64     = other.m_UUID64;
+        m_sibling_id = other.m_sibling_id;
+        m_name       = std::move(other.m_name);
+        detachNodes();
+        moveNodesFrom(other);
+        return *this;
+    }
+
     Result<void, SerialError> Rail::serialize(Serializer &out) const {
         out.writeString<std::endian::big>(m_name);
         out.write<u16, std::endian::big>(static_cast<u16>(m_nodes.size()));
-        for (const auto &node : m_nodes) {
-            auto result = node->serialize(out);
-            if (!result) {
-                return std::unexpected(result.error());
-            }
-        }
-        return {};
+        return serializeNodes(out);
     }
 
     Result<void, SerialError> Rail::deserialize(Deserializer &in) {
-        m_name = in.readString<std::endian::big>();
-        m_nodes.clear();
+        m_name         = in.readString<std::endian::big>();
         u16 node_count = in.read<u16, std::endian::big>();
-        for (u16 i = 0; i < node_count; ++i) {
-            auto node   = make_referable<RailNode>();
-            auto result = node->deserialize(in);
-            if (!result) {
-                return std::unexpected(result.error());
-            }
-            addNode(node);
+        return deserializeNodes(in, node_count);
+    }
+
+    Result<void, SerialError> Rail::serializeNodes(Serializer &out) const {
+        std::vector<char> data(m_nodes.size() * RailNodeRecord::c_data_size);
+        for (size_t i = 0; i < m_nodes.size(); ++i) {
+            getNodeRecord(i).toBytes(data.data() + i * RailNodeRecord::c_data_size);
+        }
+        out.writeBytes(data);
+        return {};
+    }
+
+    Result<void, SerialError> Rail::deserializeNodes(Deserializer &in, size_t count) {
+        detachNodes();
+
+        // Every record is read in one go and decoded straight into the arrays
+        std::vector<char> data(count * RailNodeRecord::c_data_size);
+        in.readBytes(data);
+
+        m_nodes.reserve(count);
+        m_node_positions.reserve(count);
+        m_node_flags.reserve(count);
+        m_node_values.reserve(count);
+        m_node_connection_counts.reserve(count);
+        m_node_connections.reserve(count);
+        m_node_distances.reserve(count);
+
+        for (size_t i = 0; i < count; ++i) {
+            insertNodeRecord(
+                i, RailNodeRecord::FromBytes(data.data() + i * RailNodeRecord::c_data_size));
+
+            auto node     = make_referable<RailNode>();
+            node->m_rail  = this;
+            node->m_index = i;
+            m_nodes.push_back(node);
         }
         return {};
     }
 
     glm::vec3 Rail::getCenteroid() const {
-        size_t node_count = m_nodes.size();
+        size_t node_count = m_node_positions.size();
         if (node_count == 0)
             return glm::vec3();
         glm::vec3 accum =
-            std::accumulate(m_nodes.begin(), m_nodes.end(), glm::vec3(),
-                            [](glm::vec3 a, node_ptr_t node) { return a + node->getPosition(); });
+            std::accumulate(m_node_positions.begin(), m_node_positions.end(), glm::vec3());
         return accum / static_cast<float>(node_count);
     }
 
     Rail &Rail::translate(const glm::vec3 &t) {
         for (auto &node : m_nodes) {
-            node->setPosition(t);
+            node->setPosition(node->getPosition() + t);
         }
         return *this;
     }
@@ -95,17 +161,25 @@ namespace Toolbox::Rail {
         }
     }
 
-    void Rail::addNode(node_ptr_t node) {
-        node->m_rail_uuid = getUUID();
-        m_nodes.push_back(node);
-    }
+    void Rail::clearNodes() { detachNodes(); }
+
+    void Rail::addNode(node_ptr_t node) { insertNode(m_nodes.size(), node); }
 
     Result<void, MetaError> Rail::insertNode(size_t index, node_ptr_t node) {
         if (index > m_nodes.size()) {
             return make_meta_error<void>("Error inserting node", index, m_nodes.size());
         }
-        node->m_rail_uuid = getUUID();
+
+        // A node belongs to one rail at a time, one that already does is
+        // inserted as a copy
+        if (node->m_rail) {
+            node = make_deep_clone<RailNode>(node);
+        }
+
+        insertNodeRecord(index, node->m_record);
+        node->m_rail = this;
         m_nodes.insert(m_nodes.begin() + index, node);
+        reindexNodes(index);
         return {};
     }
 
@@ -113,18 +187,23 @@ namespace Toolbox::Rail {
         if (index >= m_nodes.size()) {
             return make_meta_error<void>("Error removing node", index, m_nodes.size());
         }
+
+        node_ptr_t node = m_nodes[index];
+        node->m_record  = getNodeRecord(index);
+        node->m_rail    = nullptr;
+
+        eraseNodeRecord(index);
         m_nodes.erase(m_nodes.begin() + index);
+        reindexNodes(index);
         return {};
     }
 
     bool Rail::removeNode(node_ptr_t node) {
-        auto it = std::find(m_nodes.begin(), m_nodes.end(), node);
-        if (it == m_nodes.end()) {
+        auto index = getNodeIndex(node);
+        if (!index) {
             return false;
         }
-        (*it)->m_rail_uuid = 0;
-        m_nodes.erase(it);
-        return true;
+        return removeNode(index.value()).has_value();
     }
 
     Result<void, MetaError> Rail::swapNodes(size_t index1, size_t index2) {
@@ -136,23 +215,34 @@ namespace Toolbox::Rail {
             return make_meta_error<void>("Error swapping node (2)", index2, m_nodes.size());
         }
 
-        std::iter_swap(m_nodes.begin() + index1, m_nodes.begin() + index2);
+        std::swap(m_node_positions[index1], m_node_positions[index2]);
+        std::swap(m_node_flags[index1], m_node_flags[index2]);
+        std::swap(m_node_values[index1], m_node_values[index2]);
+        std::swap(m_node_connection_counts[index1], m_node_connection_counts[index2]);
+        std::swap(m_node_connections[index1], m_node_connections[index2]);
+        std::swap(m_node_distances[index1], m_node_distances[index2]);
+
+        std::swap(m_nodes[index1], m_nodes[index2]);
+        m_nodes[index1]->m_index = index1;
+        m_nodes[index2]->m_index = index2;
+
+        invalidateNodeTree();
+        invalidateNodeReferrers();
         return {};
     }
 
     bool Rail::swapNodes(node_ptr_t node1, node_ptr_t node2) {
-        auto it1 = std::find(m_nodes.begin(), m_nodes.end(), node1);
-        if (it1 == m_nodes.end()) {
+        auto index1 = getNodeIndex(node1);
+        if (!index1) {
             return false;
         }
 
-        auto it2 = std::find(m_nodes.begin(), m_nodes.end(), node2);
-        if (it2 == m_nodes.end()) {
+        auto index2 = getNodeIndex(node2);
+        if (!index2) {
             return false;
         }
 
-        std::iter_swap(it1, it2);
-        return true;
+        return swapNodes(index1.value(), index2.value()).has_value();
     }
 
     bool Rail::isNodeConnectedToOther(size_t node_a, size_t node_b) const {
@@ -178,12 +268,10 @@ namespace Toolbox::Rail {
     }
 
     std::optional<size_t> Rail::getNodeIndex(node_ptr_t node) const {
-        for (size_t i = 0; i < m_nodes.size(); ++i) {
-            if (m_nodes[i] == node) {
-                return i;
-            }
+        if (!node || node->m_rail != this) {
+            return {};
         }
-        return {};
+        return node->m_index;
     }
 
     std::vector<Rail::node_ptr_t> Rail::getNodeConnections(size_t node) const {
@@ -358,27 +446,20 @@ namespace Toolbox::Rail {
     }
 
     Result<void, MetaError> Rail::connectNodeToNearest(node_ptr_t node, size_t count) {
-        std::vector<std::pair<f32, node_ptr_t>> nearest_nodes;
-        for (auto &n : m_nodes) {
-            if (n == node) {
-                continue;
-            }
-            f32 distance = glm::distance(node->getPosition(), n->getPosition());
-            nearest_nodes.emplace_back(distance, n);
-        }
-        std::sort(nearest_nodes.begin(), nearest_nodes.end(),
-                  [](const auto &a, const auto &b) { return a.first < b.first; });
+        size_t exclude = getNodeIndex(node).value_or(KDTree::c_no_point);
 
+        std::vector<KDTree::neighbor_t> nearest_nodes;
+        nodeTree().nearest(node->getPosition(), std::min(count, RailNodeRecord::c_max_connections),
+                           exclude, nearest_nodes);
+
+        count = nearest_nodes.size();
         node->setConnectionCount(static_cast<u16>(count));
-        for (size_t i = 0; i < count && i < nearest_nodes.size(); ++i) {
-            auto result = node->setConnectionValue(
-                i, static_cast<u16>(getNodeIndex(nearest_nodes[i].second).value()));
+        for (size_t i = 0; i < count; ++i) {
+            auto result = node->setConnectionValue(i, static_cast<s16>(nearest_nodes[i].second));
             if (!result) {
                 return result;
             }
-            f32 distance =
-                glm::distance(node->getPosition(), nearest_nodes[i].second->getPosition());
-            node->setConnectionDistance(i, distance);
+            node->setConnectionDistance(i, nearest_nodes[i].first);
         }
         return {};
     }
@@ -514,28 +595,83 @@ namespace Toolbox::Rail {
                                          std::numeric_limits<size_t>::max(), 0);
         }
         size_t node_index = result.value();
-        std::vector<node_ptr_t> referrers;
-        for (auto &n : m_nodes) {
-            for (size_t i = 0; i < n->getConnectionCount(); ++i) {
-                if (n->getConnectionValue(i) == getNodeIndex(node).value()) {
-                    referrers.push_back(n);
-                    break;
-                }
-            }
+
+        // A node referring through several connections is listed once per
+        // connection, and the list changes as this node's connections do
+        std::vector<u32> referrers = nodeReferrers(node_index);
+        std::sort(referrers.begin(), referrers.end());
+        referrers.erase(std::unique(referrers.begin(), referrers.end()), referrers.end());
+        if (referrers.size() > RailNodeRecord::c_max_connections) {
+            referrers.resize(RailNodeRecord::c_max_connections);
         }
+
         node->setConnectionCount(static_cast<u16>(referrers.size()));
         for (size_t i = 0; i < referrers.size(); ++i) {
-            auto result =
-                node->setConnectionValue(i, static_cast<s16>(getNodeIndex(referrers[i]).value()));
+            auto result = node->setConnectionValue(i, static_cast<s16>(referrers[i]));
             if (!result) {
                 return result;
             }
-            auto distance = glm::distance(node->getPosition(), referrers[i]->getPosition());
+            auto distance =
+                glm::distance(m_node_positions[node_index], m_node_positions[referrers[i]]);
             node->setConnectionDistance(i, distance);
         }
         return {};
     }
 
+    Result<void, MetaError> Rail::connectNodesToNearest(size_t count) {
+        const size_t node_count = m_nodes.size();
+        if (node_count == 0) {
+            return {};
+        }
+        count = std::min({count, node_count - 1, RailNodeRecord::c_max_connections});
+
+        const KDTree &tree = nodeTree();
+
+        // Each node only writes its own connections, so the workers never
+        // touch the same row
+        constexpr size_t c_batch_size  = 64;
+        std::atomic<size_t> next_index = 0;
+        auto worker_task               = [&]() {
+            std::vector<KDTree::neighbor_t> nearest_nodes;
+            for (size_t begin = next_index.fetch_add(c_batch_size); begin < node_count;
+                 begin = next_index.fetch_add(c_batch_size)) {
+                size_t end = std::min(begin + c_batch_size, node_count);
+                for (size_t i = begin; i < end; ++i) {
+                    tree.nearest(m_node_positions[i], count, i, nearest_nodes);
+
+                    auto &connections = m_node_connections[i];
+                    auto &distances   = m_node_distances[i];
+                    connections.fill(0);
+                    distances.fill(0.0f);
+                    for (size_t j = 0; j < nearest_nodes.size(); ++j) {
+                        connections[j] = static_cast<s16>(nearest_nodes[j].second);
+                        distances[j]   = nearest_nodes[j].first;
+                    }
+                    m_node_connection_counts[i] = static_cast<u16>(nearest_nodes.size());
+                }
+            }
+        };
+
+        // This thread takes batches too, small rails never leave it. A pool
+        // worker does all of them, waiting on helpers could deadlock it.
+        ThreadPool &pool = ThreadPool::instance();
+        std::vector<std::future<void>> futures;
+        if (node_count > c_batch_size && !pool.isWorkerThread()) {
+            size_t helper_count = std::min(pool.threadCount(), node_count / c_batch_size);
+            futures.reserve(helper_count);
+            for (size_t i = 0; i < helper_count; ++i) {
+                futures.push_back(pool.submit(worker_task));
+            }
+        }
+        worker_task();
+        for (auto &future : futures) {
+            future.get();
+        }
+
+        invalidateNodeReferrers();
+        return {};
+    }
+
     void Rail::dump(std::ostream &out, size_t indention, size_t indention_width) const {
         out << std::string(indention * indention_width, ' ') << "Rail: " << m_name << std::endl;
         for (const auto &node : m_nodes) {
@@ -545,15 +681,12 @@ namespace Toolbox::Rail {
 
     ScopePtr<ISmartResource> Rail::clone(bool deep) const {
         auto clone = make_scoped<Rail>(name());
+        clone->copyNodesFrom(*this);
 
+        // Shallow clones share the node identities, deep ones get new nodes
         if (deep) {
-            for (const auto &node : m_nodes) {
-                clone->m_nodes.push_back(make_deep_clone<RailNode>(node));
-            }
-        } else {
-            clone->m_nodes.clear();
-            for (auto &node : m_nodes) {
-                clone->m_nodes.push_back(node);
+            for (auto &node : clone->m_nodes) {
+                node->m_UUID64 = UUID64();
             }
         }
 
@@ -561,28 +694,26 @@ namespace Toolbox::Rail {
     }
 
     Result<void, MetaError> Rail::calcDistancesWithNode(node_ptr_t node) {
-        const s16 node_index = static_cast<s16>(
-            std::distance(m_nodes.begin(), std::find(m_nodes.begin(), m_nodes.end(), node)));
+        auto result = getNodeIndex(node);
+        if (!result) {
+            return make_meta_error<void>("Error calculating node distances (not from rail)",
+                                         std::numeric_limits<size_t>::max(), 0);
+        }
 
-        for (u16 i = 0; i < node->getConnectionCount(); ++i) {
-            auto result = node->getConnectionValue(i);
-            if (!result) {
-                return std::unexpected(result.error());
+        const size_t node_index  = result.value();
+        const glm::vec3 position = m_node_positions[node_index];
+
+        for (u16 i = 0; i < m_node_connection_counts[node_index]; ++i) {
+            size_t to = static_cast<size_t>(m_node_connections[node_index][i]);
+            if (to < m_node_positions.size()) {
+                m_node_distances[node_index][i] = glm::distance(position, m_node_positions[to]);
             }
-            node_ptr_t other = m_nodes[result.value()];
-            f32 distance     = glm::distance(other->getPosition(), node->getPosition());
-            other->setConnectionDistance(i, distance);
         }
 
-        for (auto &other : m_nodes) {
-            for (u16 i = 0; i < other->getConnectionCount(); ++i) {
-                auto result = other->getConnectionValue(i);
-                if (!result) {
-                    return std::unexpected(result.error());
-                }
-                if (result.value() == node_index) {
-                    f32 distance = glm::distance(other->getPosition(), node->getPosition());
-                    other->setConnectionDistance(i, distance);
+        for (u32 other : nodeReferrers(node_index)) {
+            for (u16 i = 0; i < m_node_connection_counts[other]; ++i) {
+                if (m_node_connections[other][i] == static_cast<s16>(node_index)) {
+                    m_node_distances[other][i] = glm::distance(m_node_positions[other], position);
                 }
             }
         }
@@ -591,4 +722,149 @@ namespace Toolbox::Rail {
 
     void Rail::chaikinSubdivide() {}
 
+    RailNodeRecord Rail::getNodeRecord(size_t index) const {
+        RailNodeRecord record;
+        record.m_position         = m_node_positions[index];
+        record.m_flags            = m_node_flags[index];
+        record.m_values           = m_node_values[index];
+        record.m_connection_count = m_node_connection_counts[index];
+        record.m_connections      = m_node_connections[index];
+        record.m_distances        = m_node_distances[index];
+        return record;
+    }
+
+    void Rail::insertNodeRecord(size_t index, const RailNodeRecord &record) {
+        m_node_positions.insert(m_node_positions.begin() + index, record.m_position);
+        m_node_flags.insert(m_node_flags.begin() + index, record.m_flags);
+        m_node_values.insert(m_node_values.begin() + index, record.m_values);
+        m_node_connection_counts.insert(m_node_connection_counts.begin() + index,
+                                        record.m_connection_count);
+        m_node_connections.insert(m_node_connections.begin() + index, record.m_connections);
+        m_node_distances.insert(m_node_distances.begin() + index, record.m_distances);
+
+        invalidateNodeTree();
+        invalidateNodeReferrers();
+    }
+
+    void Rail::eraseNodeRecord(size_t index) {
+        m_node_positions.erase(m_node_positions.begin() + index);
+        m_node_flags.erase(m_node_flags.begin() + index);
+        m_node_values.erase(m_node_values.begin() + index);
+        m_node_connection_counts.erase(m_node_connection_counts.begin() + index);
+        m_node_connections.erase(m_node_connections.begin() + index);
+        m_node_distances.erase(m_node_distances.begin() + index);
+
+        invalidateNodeTree();
+        invalidateNodeReferrers();
+    }
+
+    void Rail::reindexNodes(size_t index) {
+        for (size_t i = index; i < m_nodes.size(); ++i) {
+            m_nodes[i]->m_index = i;
+        }
+    }
+
+    void Rail::detachNodes() {
+        for (size_t i = 0; i < m_nodes.size(); ++i) {
+            m_nodes[i]->m_record = getNodeRecord(i);
+            m_nodes[i]->m_rail   = nullptr;
+        }
+
+        m_nodes.clear();
+        m_node_positions.clear();
+        m_node_flags.clear();
+        m_node_values.clear();
+        m_node_connection_counts.clear();
+        m_node_connections.clear();
+        m_node_distances.clear();
+
+        invalidateNodeTree();
+        invalidateNodeReferrers();
+    }
+
+    void Rail::copyNodesFrom(const Rail &other) {
+        m_node_positions         = other.m_node_positions;
+        m_node_flags             = other.m_node_flags;
+        m_node_values            = other.m_node_values;
+        m_node_connection_counts = other.m_node_connection_counts;
+        m_node_connections       = other.m_node_connections;
+        m_node_distances         = other.m_node_distances;
+
+        m_nodes.clear();
+        m_nodes.reserve(other.m_nodes.size());
+        for (size_t i = 0; i < other.m_nodes.size(); ++i) {
+            auto node     = make_referable<RailNode>(*other.m_nodes[i]);
+            node->m_rail  = this;
+            node->m_index = i;
+            m_nodes.push_back(node);
+        }
+
+        invalidateNodeTree();
+        invalidateNodeReferrers();
+    }
+
+    void Rail::moveNodesFrom(Rail &other) {
+        m_nodes                  = std::move(other.m_nodes);
+        m_node_positions         = std::move(other.m_node_positions);
+        m_node_flags             = std::move(other.m_node_flags);
+        m_node_values            = std::move(other.m_node_values);
+        m_node_connection_counts = std::move(other.m_node_connection_counts);
+        m_node_connections       = std::move(other.m_node_connections);
+        m_node_distances         = std::move(other.m_node_distances);
+
+        for (auto &node : m_nodes) {
+            node->m_rail = this;
+        }
+
+        invalidateNodeTree();
+        invalidateNodeReferrers();
+
+        other.detachNodes();
+    }
+
+    const KDTree &Rail::nodeTree() {
+        if (m_node_tree_dirty) {
+            m_node_tree.build(m_node_positions);
+            m_node_tree_dirty = false;
+        }
+        return m_node_tree;
+    }
+
+    const std::vector<u32> &Rail::nodeReferrers(size_t node) {
+        if (m_node_referrers_dirty) {
+            m_node_referrers.assign(m_nodes.size(), {});
+            for (size_t i = 0; i < m_nodes.size(); ++i) {
+                for (u16 j = 0; j < m_node_connection_counts[i]; ++j) {
+                    size_t to = static_cast<size_t>(m_node_connections[i][j]);
+                    if (to < m_node_referrers.size()) {
+                        m_node_referrers[to].push_back(static_cast<u32>(i));
+                    }
+                }
+            }
+            m_node_referrers_dirty = false;
+        }
+        return m_node_referrers[node];
+    }
+
+    void Rail::addNodeReferrer(size_t node, s16 to) {
+        if (m_node_referrers_dirty || to < 0 ||
+            static_cast<size_t>(to) >= m_node_referrers.size()) {
+            return;
+        }
+        m_node_referrers[to].push_back(static_cast<u32>(node));
+    }
+
+    void Rail::removeNodeReferrer(size_t node, s16 to) {
+        if (m_node_referrers_dirty || to < 0 ||
+            static_cast<size_t>(to) >= m_node_referrers.size()) {
+            return;
+        }
+        std::vector<u32> &referrers = m_node_referrers[to];
+        auto it = std::find(referrers.begin(), referrers.end(), static_cast<u32>(node));
+        if (it != referrers.end()) {
+            *it = referrers.back();
+            referrers.pop_back();
+        }
+    }
+
 }  // namespace Toolbox::Rail
\ No newline at end of file
@@ -2,9 +2,12 @@
 #include "objlib/nameref.hpp"
 #include "serial.hpp"
 #include "szs/szs.hpp"
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <unordered_map>
+#include <unordered_set>
 
 using namespace Toolbox::Object;
 
@@ -87,6 +90,10 @@ namespace Toolbox::RARC {
         std::vector<FSNode> fs_nodes;
         std::vector<char> string_data;  // One giant buffer
         std::vector<char> file_data;    // One giant buffer
+
+        // Views file_data, or the file region of a mapped archive
+        std::span<const char> file_view;
+        bool is_mapped = false;
     };
 
     static bool isLowNodeFolder(const FSNode &node) {
@@ -95,7 +102,7 @@ namespace Toolbox::RARC {
     static bool isSpecialPath(std::string_view name) { return name == "." || name == ".."; }
 
     static Result<ScopePtr<LowResourceArchive>, SerialError>
-    loadLowResourceArchive(Deserializer &in);
+    loadLowResourceArchive(Deserializer &in, bool read_file_data);
 
     static Result<void, SerialError>
     saveLowResourceArchive(const LowResourceArchive &low_archive, Serializer &out);
@@ -125,6 +132,8 @@ namespace Toolbox::RARC {
 
     static void removeSpecialDirs(std::vector<ResourceArchive::Node> &nodes);
 
+    static void recalculateFolderIDs(std::vector<ResourceArchive::Node> &nodes);
+
     static Result<void>
     sortNodesForSaveRecursive(const std::vector<ResourceArchive::Node> &src,
                               std::vector<ResourceArchive::Node> &out,
@@ -186,7 +195,9 @@ namespace Toolbox::RARC {
             }
             std::vector<char> data;
             if (!folder) {
-                auto fstrm = std::ifstream(path, std::ios::binary | std::ios::in);
+                auto fstrm = std::ifstream(path, std::ios::binary | std::ios::in | std::ios::ate);
+                data.resize(static_cast<size_t>(fstrm.tellg()));
+                fstrm.seekg(0, std::ios::beg);
                 fstrm.read(data.data(), data.size());
             }
 
@@ -264,13 +275,18 @@ namespace Toolbox::RARC {
                 node.flags |= ResourceAttribute::PRELOAD_TO_MRAM;
 
                 // TODO: Take YAY0 into account when it becomes supported
-                /*if (librii::szs::isDataYaz0Compressed(
-                        rsl::byte_view(p.data.data(), p.data.size()))) {
+                if (SZS::IsDataYaz0Compressed(p.data)) {
+                    auto decompress_result = SZS::Decompress(p.data);
+                    if (!decompress_result) {
+                        return make_fs_error<ResourceArchive>(
+                            std::error_code(), {std::format("Failed to decompress {}", p.str)});
+                    }
                     node.flags |= ResourceAttribute::COMPRESSED;
                     node.flags |= ResourceAttribute::YAZ0_COMPRESSED;
-                }*/
-
-                node.data = p.data;
+                    node.data = std::move(decompress_result.value());
+                } else {
+                    node.data = p.data;
+                }
             }
             node.name = p.name;
             result.m_nodes.push_back(node);
@@ -281,113 +297,434 @@ namespace Toolbox::RARC {
                                                   {"Failed to calculate the IDs"});
         }
 
+        result.rebuildIndex();
         return result;
     }
 
+    Result<ResourceArchive, SerialError>
+    ResourceArchive::createFromMappedFile(const std::filesystem::path &path) {
+        auto mapping = make_referable<Platform::MappedFile>();
+        {
+            auto result = mapping->open(path);
+            if (!result) {
+                return make_serial_error<ResourceArchive>("RARC", result.error().m_message.back(),
+                                                          0, path.string());
+            }
+        }
+
+        Deserializer in(mapping->view(), path.string());
+
+        ResourceArchive archive;
+
+        // Compressed archives have to be decoded into memory regardless
+        auto result = SZS::IsDataYaz0Compressed(mapping->view()) ? archive.deserialize(in)
+                                                                 : archive.loadArchive(in, mapping);
+        if (!result) {
+            return std::unexpected(result.error());
+        }
+
+        if (archive.isMapped()) {
+            archive.m_mapped_path = path;
+        }
+
+        return archive;
+    }
+
+    void ResourceArchive::unmap() {
+        for (Node &node : m_nodes) {
+            if (node.data.isMapped()) {
+                (void)node.data.mutableBytes();
+            }
+        }
+        m_mapping.reset();
+        m_mapped_path.clear();
+    }
+
     ResourceArchive::node_it ResourceArchive::findNode(std::string_view name) {
-        return std::find_if(m_nodes.begin(), m_nodes.end(),
-                            [&](const Node &node) { return node.name == name; });
+        if (m_index_dirty) {
+            rebuildIndex();
+        }
+        return m_nodes.begin() + findNodeIndex(name);
     }
 
     ResourceArchive::const_node_it ResourceArchive::findNode(std::string_view name) const {
-        return std::find_if(m_nodes.begin(), m_nodes.end(),
-                            [&](const Node &node) { return node.name == name; });
+        return m_nodes.begin() + findNodeIndex(name);
     }
 
     ResourceArchive::node_it ResourceArchive::findNode(s32 id) {
-        return std::find_if(m_nodes.begin(), m_nodes.end(),
-                            [&](const Node &node) { return node.id == id; });
+        if (m_index_dirty) {
+            rebuildIndex();
+        }
+        return m_nodes.begin() + findNodeIndex(id);
     }
 
     ResourceArchive::const_node_it ResourceArchive::findNode(s32 id) const {
-        return std::find_if(m_nodes.begin(), m_nodes.end(),
-                            [&](const Node &node) { return node.id == id; });
+        return m_nodes.begin() + findNodeIndex(id);
     }
 
     ResourceArchive::node_it ResourceArchive::findNode(const std::filesystem::path &path) {
-        if (path.empty() || m_nodes.empty()) {
-            return m_nodes.end();
+        if (m_index_dirty) {
+            rebuildIndex();
+        }
+        return m_nodes.begin() + findNodeIndex(path);
+    }
+
+    ResourceArchive::const_node_it
+    ResourceArchive::findNode(const std::filesystem::path &path) const {
+        return m_nodes.begin() + findNodeIndex(path);
+    }
+
+    size_t ResourceArchive::findNodeIndex(std::string_view name) const {
+        auto scan = [&]() {
+            auto it = std::find_if(m_nodes.begin(), m_nodes.end(),
+                                   [&](const Node &node) { return node.name == name; });
+            return static_cast<size_t>(std::distance(m_nodes.begin(), it));
+        };
+
+        if (m_index_dirty) {
+            return scan();
         }
 
-        std::vector<std::string> paths;
+        auto it = m_name_index.find(name);
+        if (it == m_name_index.end()) {
+            return m_nodes.size();
+        }
 
-        std::filesystem::path it_path = path;
-        while (!it_path.empty()) {
-            paths.push_back(it_path.filename().string());
-            it_path = path.parent_path();
+        // Catch nodes that were shifted or renamed behind our back
+        if (it->second >= m_nodes.size() || m_nodes[it->second].name != name) {
+            return scan();
         }
 
-        QualifiedName qual_path = QualifiedName(paths.rbegin(), paths.rend());
+        return it->second;
+    }
 
-        auto insert_index    = m_nodes.size();
-        auto dir_files_start = m_nodes.begin();
-        auto dir_files_end   = m_nodes.end();
+    size_t ResourceArchive::findNodeIndex(s32 id) const {
+        auto scan = [&]() {
+            auto it = std::find_if(m_nodes.begin(), m_nodes.end(),
+                                   [&](const Node &node) { return node.id == id; });
+            return static_cast<size_t>(std::distance(m_nodes.begin(), it));
+        };
 
-        auto current_node = dir_files_start;
-        while (dir_files_start != dir_files_end) {
-            if (qual_path[0] != current_node->name) {
-                if (current_node->is_folder())
-                    current_node = dir_files_start + current_node->folder.sibling_next;
-                else
-                    current_node++;
+        if (m_index_dirty) {
+            return scan();
+        }
+
+        auto it = m_id_index.find(id);
+        if (it == m_id_index.end()) {
+            return m_nodes.size();
+        }
+
+        if (it->second >= m_nodes.size() || m_nodes[it->second].id != id) {
+            return scan();
+        }
+
+        return it->second;
+    }
+
+    size_t ResourceArchive::findNodeIndex(const std::filesystem::path &path) const {
+        std::string key;
+        std::string leaf;
+        for (auto &part : path) {
+            leaf = part.string();
+            if (leaf.empty() || leaf == "." || leaf == "/" || leaf == "\\") {
                 continue;
             }
-            if (qual_path.depth() > 1) {
-                if (!current_node->is_folder())
-                    return m_nodes.end();
-                current_node++;
-                continue;
+            if (!key.empty()) {
+                key += '/';
             }
-            return current_node;
+            key += leaf;
+        }
+
+        if (key.empty()) {
+            return m_nodes.size();
+        }
+
+        auto scan = [&]() {
+            size_t found = m_nodes.size();
+            forEachNodePath(0, m_nodes.size(), {}, [&](size_t i, const std::string &node_path) {
+                if (node_path != key) {
+                    return true;
+                }
+                found = i;
+                return false;
+            });
+            return found;
+        };
+
+        if (m_index_dirty) {
+            return scan();
+        }
+
+        auto it = m_path_index.find(key);
+        if (it == m_path_index.end()) {
+            return m_nodes.size();
+        }
+
+        const std::string_view name = std::string_view(key).substr(key.rfind('/') + 1);
+        if (it->second >= m_nodes.size() || m_nodes[it->second].name != name) {
+            return scan();
         }
 
-        return m_nodes.end();
+        return it->second;
     }
 
-    ResourceArchive::const_node_it
-    ResourceArchive::findNode(const std::filesystem::path &path) const {
-        if (path.empty() || m_nodes.empty()) {
-            return m_nodes.end();
+    std::string ResourceArchive::nodePath(size_t index) const {
+        if (index >= m_nodes.size()) {
+            return {};
         }
 
-        std::vector<std::string> paths;
+        // Descend from the root into whichever child spans the node
+        std::string path = m_nodes[0].name;
+        size_t folder     = 0;
+        while (folder != index) {
+            const size_t end = std::min<size_t>(m_nodes[folder].folder.sibling_next, m_nodes.size());
+
+            size_t child = folder + 1;
+            while (child < end) {
+                const Node &node = m_nodes[child];
+                const size_t child_end =
+                    node.is_folder() ? std::max<size_t>(node.folder.sibling_next, child + 1)
+                                     : child + 1;
+                if (index < child_end) {
+                    break;
+                }
+                child = child_end;
+            }
+
+            if (child >= end) {
+                return {};
+            }
 
-        std::filesystem::path it_path = path;
-        while (!it_path.empty()) {
-            paths.push_back(it_path.filename().string());
-            it_path = path.parent_path();
+            path += '/';
+            path += m_nodes[child].name;
+            folder = child;
         }
 
-        QualifiedName qual_path = QualifiedName(paths.rbegin(), paths.rend());
+        return path;
+    }
 
-        auto insert_index    = m_nodes.size();
-        auto dir_files_start = m_nodes.begin();
-        auto dir_files_end   = m_nodes.end();
+    void ResourceArchive::rebuildIndex() {
+        m_name_index.clear();
+        m_id_index.clear();
+        m_path_index.clear();
 
-        auto current_node = dir_files_start;
-        while (dir_files_start != dir_files_end) {
-            if (qual_path[0] != current_node->name) {
-                if (current_node->is_folder())
-                    current_node = dir_files_start + current_node->folder.sibling_next;
-                else
-                    current_node++;
-                continue;
+        m_name_index.reserve(m_nodes.size());
+        m_id_index.reserve(m_nodes.size());
+        m_path_index.reserve(m_nodes.size());
+
+        m_index_dirty = false;
+        indexNodes(0, m_nodes.size());
+    }
+
+    void ResourceArchive::rebuildIdIndex() {
+        if (m_index_dirty) {
+            return;
+        }
+
+        m_id_index.clear();
+        for (size_t i = 0; i < m_nodes.size(); ++i) {
+            m_id_index.try_emplace(m_nodes[i].id, i);
+        }
+    }
+
+    template <typename RemapFn>
+    ResourceArchive::IndexOrphans ResourceArchive::remapIndex(RemapFn &&remap) {
+        IndexOrphans orphans;
+        if (m_index_dirty) {
+            return orphans;
+        }
+
+        auto remap_index = [&](auto &index, auto &orphaned) {
+            for (auto it = index.begin(); it != index.end();) {
+                const size_t to = remap(it->second);
+                if (to == std::string::npos) {
+                    orphaned.push_back(it->first);
+                    it = index.erase(it);
+                    continue;
+                }
+                it->second = to;
+                ++it;
             }
-            if (qual_path.depth() > 1) {
-                if (!current_node->is_folder())
-                    return m_nodes.end();
-                current_node++;
-                continue;
+        };
+
+        remap_index(m_name_index, orphans.names);
+        remap_index(m_id_index, orphans.ids);
+        remap_index(m_path_index, orphans.paths);
+        return orphans;
+    }
+
+    template <typename VisitFn>
+    void ResourceArchive::forEachNodePath(size_t begin, size_t end, std::string path,
+                                          VisitFn &&visit) const {
+        // Open folders as the index one past their last child and the
+        // length of the path before their name was appended
+        std::vector<std::pair<size_t, size_t>> folder_stack;
+
+        for (size_t i = begin; i < end; ++i) {
+            while (!folder_stack.empty() && i >= folder_stack.back().first) {
+                path.resize(folder_stack.back().second);
+                folder_stack.pop_back();
+            }
+
+            const Node &node = m_nodes[i];
+
+            const size_t prefix_size = path.size();
+            if (!path.empty()) {
+                path += '/';
+            }
+            path += node.name;
+
+            if (!visit(i, path)) {
+                return;
+            }
+
+            if (node.is_folder() && static_cast<size_t>(node.folder.sibling_next) > i + 1) {
+                folder_stack.emplace_back(node.folder.sibling_next, prefix_size);
+            } else {
+                path.resize(prefix_size);
+            }
+        }
+    }
+
+    void ResourceArchive::indexNodes(size_t begin, size_t end) {
+        if (m_index_dirty) {
+            return;
+        }
+
+        // Nodes may land ahead of the ones already indexed by their key
+        auto index_first = [](auto &index, const auto &key, size_t i) {
+            auto [it, inserted] = index.try_emplace(key, i);
+            if (!inserted && i < it->second) {
+                it->second = i;
+            }
+        };
+
+        std::string path;
+        if (begin != 0) {
+            path = nodePath(begin);
+            if (path.empty()) {
+                // The folder spans are broken, leave it to a full rebuild
+                m_index_dirty = true;
+                return;
             }
-            return current_node;
+            path.resize(path.rfind('/'));
         }
 
-        return m_nodes.end();
+        forEachNodePath(begin, end, std::move(path), [&](size_t i, const std::string &node_path) {
+            index_first(m_name_index, m_nodes[i].name, i);
+            index_first(m_id_index, m_nodes[i].id, i);
+            index_first(m_path_index, node_path, i);
+            return true;
+        });
+    }
+
+    void ResourceArchive::repairIndex(const IndexOrphans &orphans, size_t from) {
+        if (m_index_dirty) {
+            return;
+        }
+
+        std::unordered_set<std::string_view> names;
+        std::unordered_set<s32> ids;
+        std::unordered_set<std::string_view> paths;
+        std::unordered_set<std::string_view> path_leaves;
+
+        for (const std::string &name : orphans.names) {
+            if (!m_name_index.contains(name)) {
+                names.insert(name);
+            }
+        }
+        for (s32 id : orphans.ids) {
+            if (!m_id_index.contains(id)) {
+                ids.insert(id);
+            }
+        }
+        for (const std::string &path : orphans.paths) {
+            if (!m_path_index.contains(path)) {
+                paths.insert(path);
+                path_leaves.insert(std::string_view(path).substr(path.rfind('/') + 1));
+            }
+        }
+
+        // Orphans were the first of their key, so later nodes are the only
+        // ones that can take them over
+        for (size_t i = from; i < m_nodes.size(); ++i) {
+            if (names.empty() && ids.empty() && paths.empty()) {
+                break;
+            }
+
+            const Node &node = m_nodes[i];
+            if (names.erase(node.name)) {
+                m_name_index.try_emplace(node.name, i);
+            }
+            if (ids.erase(node.id)) {
+                m_id_index.try_emplace(node.id, i);
+            }
+            if (path_leaves.contains(node.name)) {
+                std::string path = nodePath(i);
+                if (paths.erase(path)) {
+                    m_path_index.try_emplace(std::move(path), i);
+                }
+            }
+        }
+    }
+
+    void ResourceArchive::adjustFolderSpans(size_t parent_index, size_t at, size_t inserted,
+                                            s32 delta) {
+        for (size_t i = 0; i < m_nodes.size(); ++i) {
+            Node &node = m_nodes[i];
+            if (!node.is_folder() || (i >= at && i < at + inserted)) {
+                continue;
+            }
+
+            // Folders up to the parent that reach the insertion contain it,
+            // the ones between the parent and the insertion end before it
+            if (i >= at + inserted ||
+                (i <= parent_index && static_cast<size_t>(node.folder.sibling_next) >= at)) {
+                node.folder.sibling_next += delta;
+            }
+        }
     }
 
     Result<void, FSError>
     ResourceArchive::extractToPath(const std::filesystem::path &path) const {
-        return Result<void, FSError>();
+        // Open folders as the index one past their last child and the
+        // directory they were opened from
+        std::vector<std::pair<size_t, std::filesystem::path>> folder_stack;
+        std::filesystem::path folder = path;
+
+        for (size_t i = 0; i < m_nodes.size(); ++i) {
+            while (!folder_stack.empty() && i >= folder_stack.back().first) {
+                folder = std::move(folder_stack.back().second);
+                folder_stack.pop_back();
+            }
+
+            const Node &node = m_nodes[i];
+            if (node.is_folder()) {
+                std::filesystem::path sub_folder = folder / node.name;
+
+                auto result = Toolbox::Filesystem::create_directories(sub_folder);
+                if (!result) {
+                    return std::unexpected(result.error());
+                }
+
+                if (static_cast<size_t>(node.folder.sibling_next) > i + 1) {
+                    folder_stack.emplace_back(node.folder.sibling_next, std::move(folder));
+                    folder = std::move(sub_folder);
+                }
+                continue;
+            }
+
+            auto dst_path = folder / node.name;
+            auto out      = std::ofstream(dst_path, std::ios::binary | std::ios::out);
+            if (!out.is_open()) {
+                return make_fs_error<void>(
+                    std::error_code(),
+                    {std::format("EXTRACT: Failed to open \"{}\" for writing!", dst_path.string())});
+            }
+            out.write(node.data.data(), node.data.size());
+        }
+
+        return {};
     }
 
     Result<void, FSError>
@@ -415,45 +752,51 @@ namespace Toolbox::RARC {
                                           .flags = ResourceAttribute::FILE |
                                                    ResourceAttribute::PRELOAD_TO_MRAM,
                                           .name = file_name,
-                                          .data = fdata};
-            new_nodes.push_back(node);
+                                          .data = std::move(fdata)};
+            new_nodes.push_back(std::move(node));
         }
 
-        auto parent_index = std::distance(m_nodes.begin(), parent);
-
-        // Manual sort is probably better because we can dodge DFS nonsense
-        // effectively Even with O(n^2) because there typically aren't many nodes
-        // anyway.
-        for (auto new_node = new_nodes.begin(); new_node != new_nodes.end(); new_node++) {
-            auto dir_files_start = m_nodes.begin() + parent_index + 1;
-            auto dir_files_end   = m_nodes.begin() + parent->folder.sibling_next +
-                                 std::distance(new_nodes.begin(), new_node);
-            for (auto child = dir_files_start; /*nothing*/; child++) {
-                // Always insert at the very end (alphabetically last)
-                if (child == dir_files_end) {
-                    m_nodes.insert(child, *new_node);
-                    break;
-                }
-                if (child->is_folder()) {
-                    // Always insert before the regular dirs
-                    m_nodes.insert(child, *new_node);
-                    break;
-                }
-                if (new_node->name < child->name) {
-                    m_nodes.insert(child, *new_node);
-                    break;
-                }
+        auto by_name = [](const Node &a, const Node &b) { return a.name < b.name; };
+        std::stable_sort(new_nodes.begin(), new_nodes.end(), by_name);
+
+        // Files sit sorted ahead of the subdirs of their folder, so the new
+        // files are appended to that run and merged into place in one pass.
+        const auto parent_index = std::distance(m_nodes.begin(), parent);
+        const auto dir_end      = m_nodes.begin() + parent->folder.sibling_next;
+        const auto files_begin  = parent + 1;
+        const auto files_end =
+            std::find_if(files_begin, dir_end, [](const Node &node) { return node.is_folder(); });
+
+        const auto files_begin_index = std::distance(m_nodes.begin(), files_begin);
+        const auto files_end_index   = std::distance(m_nodes.begin(), files_end);
+
+        // The merge shuffles the files of the folder, so they are reindexed
+        // as a whole while everything after them just moves along
+        IndexOrphans orphans = remapIndex([&](size_t index) {
+            if (index >= static_cast<size_t>(files_end_index)) {
+                return index + new_nodes.size();
             }
-        }
+            if (index >= static_cast<size_t>(files_begin_index)) {
+                return std::string::npos;
+            }
+            return index;
+        });
+
+        m_nodes.insert(files_end, std::make_move_iterator(new_nodes.begin()),
+                       std::make_move_iterator(new_nodes.end()));
+        std::inplace_merge(m_nodes.begin() + files_begin_index, m_nodes.begin() + files_end_index,
+                           m_nodes.begin() + files_end_index + new_nodes.size(), by_name);
 
         for (auto &node : m_nodes) {
             if (!node.is_folder())
                 continue;
             if (node.folder.sibling_next <= parent_index)
                 continue;
-            node.folder.sibling_next += static_cast<s32>(files.size());
+            node.folder.sibling_next += static_cast<s32>(new_nodes.size());
         }
 
+        indexNodes(files_begin_index, files_end_index + new_nodes.size());
+        repairIndex(orphans, files_begin_index);
         return {};
     }
 
@@ -506,31 +849,13 @@ namespace Toolbox::RARC {
             child = m_nodes.begin() + child->folder.sibling_next;
         }
 
-        for (auto node = m_nodes.begin(); node != m_nodes.end();) {
-            s32 index = static_cast<s32>(std::distance(m_nodes.begin(), node));
-            // Skip files and the special dirs (they get recalculated later)
-            if (!node->is_folder()) {
-                node++;
-                continue;
-            }
-            if (index == insert_index) {  // Skip inserted dir (already adjusted)
-                node = m_nodes.begin() + node->folder.sibling_next;
-                continue;
-            }
-            if (node->folder.sibling_next <
-                insert_index) {  // Skip dirs that come before insertion by span alone
-                node = m_nodes.begin() + node->folder.sibling_next;
-                continue;
-            }
-            // This is a directory adjacent but not beyond the insertion, ignore.
-            if (node->folder.parent >= parent->id && index < insert_index) {
-                node = m_nodes.begin() + node->folder.sibling_next;
-                continue;
-            }
-            node->folder.sibling_next += static_cast<s32>(tmp_rarc.m_nodes.size());
-            node++;
-        }
+        const size_t inserted = tmp_rarc.m_nodes.size();
+        adjustFolderSpans(parent_index, insert_index, inserted, static_cast<s32>(inserted));
 
+        remapIndex([&](size_t index) {
+            return index >= static_cast<size_t>(insert_index) ? index + inserted : index;
+        });
+        indexNodes(insert_index, insert_index + inserted);
         return {};
     }
 
@@ -538,7 +863,7 @@ namespace Toolbox::RARC {
     ResourceArchive::createFolder(node_it parent, std::string_view name) {
         auto parent_index = std::distance(m_nodes.begin(), parent);
 
-        std::string lower_name;
+        std::string lower_name(name.size(), '\0');
         std::transform(name.begin(), name.end(), lower_name.begin(),
                        [](char c) { return std::tolower(c); });
 
@@ -580,31 +905,12 @@ namespace Toolbox::RARC {
             child = m_nodes.begin() + child->folder.sibling_next;
         }
 
-        for (auto node = m_nodes.begin(); node != m_nodes.end();) {
-            auto index = std::distance(m_nodes.begin(), node);
-            // Skip files (they get recalculated later)
-            if (!node->is_folder()) {
-                node++;
-                continue;
-            }
-            if (index == insert_index) {  // Skip inserted dir (already adjusted)
-                node = m_nodes.begin() + node->folder.sibling_next;
-                continue;
-            }
-            if (node->folder.sibling_next <
-                insert_index) {  // Skip dirs that come before insertion by span alone
-                node = m_nodes.begin() + node->folder.sibling_next;
-                continue;
-            }
-            // This is a directory adjacent but not beyond the insertion, ignore.
-            if (node->folder.parent >= parent->id && index < insert_index) {
-                node = m_nodes.begin() + node->folder.sibling_next;
-                continue;
-            }
-            node->folder.sibling_next += 1;
-            node++;
-        }
+        adjustFolderSpans(parent_index, insert_index, 1, 1);
 
+        remapIndex([&](size_t index) {
+            return index >= static_cast<size_t>(insert_index) ? index + 1 : index;
+        });
+        indexNodes(insert_index, insert_index + 1);
         return {};
     }
 
@@ -617,51 +923,81 @@ namespace Toolbox::RARC {
         if (nodes.size() == 0)
             return {};
 
-        for (auto &to_delete : nodes) {
-            for (int i = 0; i < m_nodes.size(); i++) {
-                if (to_delete == m_nodes[i]) {
-                    if (!to_delete.is_folder()) {
-                        ResourceArchive::Node parent;
-                        int parent_index = 0;
-                        for (parent_index = i; parent_index >= 0; parent_index--) {
-                            parent = m_nodes[parent_index];
-                            if (!parent.is_folder())
-                                continue;
-                            // This folder should be the deepest parent
-                            if (parent.folder.sibling_next > i)
-                                break;
-                        }
-                        auto deleted_at =
-                            std::distance(m_nodes.begin(), m_nodes.erase(m_nodes.begin() + i));
-
-                        for (auto &node : m_nodes) {
-                            if (!node.is_folder())
-                                continue;
-                            if (node.folder.sibling_next <= deleted_at)
-                                continue;
-                            node.folder.sibling_next--;
-                        }
-                    } else {
-                        auto begin = m_nodes.begin() + i;
-                        auto end   = m_nodes.begin() + to_delete.folder.sibling_next;
-                        auto size  = std::distance(begin, end);
-
-                        auto deleted_at = std::distance(m_nodes.begin(), m_nodes.erase(begin, end));
-
-                        for (auto &node : m_nodes) {
-                            if (!node.is_folder())
-                                continue;
-                            if (node.folder.sibling_next <= deleted_at)
-                                continue;
-                            if (node.folder.parent > to_delete.id)
-                                node.folder.parent -= 1;
-                            node.folder.sibling_next -= static_cast<s32>(size);
-                        }
-                    }
-                }
+        ResourceArchiveNodeHasher hasher;
+
+        std::unordered_multimap<std::size_t, const Node *> targets;
+        targets.reserve(nodes.size());
+        for (auto &node : nodes) {
+            targets.emplace(hasher(node), &node);
+        }
+
+        // Mark each target, along with everything inside target folders
+        std::vector<bool> removed(m_nodes.size(), false);
+        for (size_t i = 0; i < m_nodes.size(); ++i) {
+            const Node &node = m_nodes[i];
+
+            auto [target_begin, target_end] = targets.equal_range(hasher(node));
+            if (std::none_of(target_begin, target_end,
+                             [&](const auto &target) { return *target.second == node; })) {
+                continue;
+            }
+
+            size_t end = i + 1;
+            if (node.is_folder()) {
+                end = std::clamp<size_t>(node.folder.sibling_next, i + 1, m_nodes.size());
             }
+            std::fill(removed.begin() + i, removed.begin() + end, true);
+            i = end - 1;
         }
 
+        // Folder ends are indices, so they move back by the number of
+        // removed nodes that came before them
+        std::vector<s32> removed_before(m_nodes.size() + 1, 0);
+        for (size_t i = 0; i < m_nodes.size(); ++i) {
+            removed_before[i + 1] = removed_before[i] + (removed[i] ? 1 : 0);
+        }
+
+        if (removed_before.back() == 0) {
+            return {};
+        }
+
+        const size_t first_removed = std::distance(
+            removed.begin(), std::find(removed.begin(), removed.end(), true));
+
+        IndexOrphans orphans = remapIndex([&](size_t index) {
+            if (index >= removed.size() || removed[index]) {
+                return std::string::npos;
+            }
+            return index - static_cast<size_t>(removed_before[index]);
+        });
+
+        size_t kept = 0;
+        for (size_t i = 0; i < m_nodes.size(); ++i) {
+            if (removed[i]) {
+                continue;
+            }
+
+            Node &node = m_nodes[i];
+            if (node.is_folder()) {
+                const size_t end = std::min<size_t>(node.folder.sibling_next, m_nodes.size());
+                node.folder.sibling_next -= removed_before[end];
+            }
+
+            if (kept != i) {
+                m_nodes[kept] = std::move(node);
+            }
+            kept += 1;
+        }
+        m_nodes.erase(m_nodes.begin() + kept, m_nodes.end());
+
+        repairIndex(orphans, first_removed);
+
+        if (m_ids_synced) {
+            return recalculateIDs();
+        }
+
+        recalculateFolderIDs(m_nodes);
+        rebuildIdIndex();
         return {};
     }
 
@@ -687,12 +1023,6 @@ namespace Toolbox::RARC {
                     return make_fs_error<node_it>(std::error_code(), {"REPLACE: Not a directory!"});
             }
 
-            auto begin    = old_node;
-            auto end      = m_nodes.begin() + old_node->folder.sibling_next;
-            auto old_size = std::distance(begin, end);
-
-            auto deleted_at = std::distance(m_nodes.begin(), m_nodes.erase(begin, end));
-
             // Generate an archive so we can steal the DFS structure.
             auto rarc_result = createFromPath(path);
             if (!rarc_result) {
@@ -706,6 +1036,23 @@ namespace Toolbox::RARC {
                 old_node->folder.parent;  // This repairs the insertion node which will
                                           // recursively regenerate later
 
+            // The closest folder spanning past the node is its parent
+            const size_t old_index = std::distance(m_nodes.begin(), old_node);
+            size_t parent_index    = 0;
+            for (size_t i = old_index; i > 0; --i) {
+                const Node &node = m_nodes[i - 1];
+                if (node.is_folder() && static_cast<size_t>(node.folder.sibling_next) > old_index) {
+                    parent_index = i - 1;
+                    break;
+                }
+            }
+
+            auto begin    = old_node;
+            auto end      = m_nodes.begin() + old_node->folder.sibling_next;
+            auto old_size = std::distance(begin, end);
+
+            auto deleted_at = std::distance(m_nodes.begin(), m_nodes.erase(begin, end));
+
             for (auto &new_node : tmp_rarc.m_nodes) {
                 if (new_node.is_folder())
                     new_node.folder.sibling_next += static_cast<s32>(deleted_at);
@@ -713,38 +1060,22 @@ namespace Toolbox::RARC {
             m_nodes.insert(m_nodes.begin() + deleted_at, tmp_rarc.m_nodes.begin(),
                            tmp_rarc.m_nodes.end());
 
-            auto parent =
-                std::find_if(m_nodes.begin(), m_nodes.end(), [&](ResourceArchive::Node node) {
-                    return node.id == old_node->folder.parent;
-                });
-
             s32 sibling_adjust = static_cast<s32>(tmp_rarc.m_nodes.size() - old_size);
-            if (sibling_adjust != 0) {
-                for (auto node = m_nodes.begin(); node != m_nodes.end();) {
-                    auto index = std::distance(m_nodes.begin(), node);
-                    // Skip files and the special dirs (they get recalculated later)
-                    if (!node->is_folder()) {
-                        node++;
-                        continue;
-                    }
-                    if (index == deleted_at) {  // Skip inserted dir (already adjusted)
-                        node = m_nodes.begin() + node->folder.sibling_next;
-                        continue;
-                    }
-                    if (node->folder.sibling_next < deleted_at) {  // Skip dirs that come before
-                                                                   // insertion by span alone
-                        node = m_nodes.begin() + node->folder.sibling_next;
-                        continue;
-                    }
-                    // This is a directory adjacent but not beyond the insertion, ignore.
-                    if (node->folder.parent >= parent->id && index < deleted_at) {
-                        node = m_nodes.begin() + node->folder.sibling_next;
-                        continue;
-                    }
-                    node->folder.sibling_next += sibling_adjust;
-                    node++;
+            adjustFolderSpans(parent_index, deleted_at, tmp_rarc.m_nodes.size(), sibling_adjust);
+
+            const size_t old_end  = deleted_at + old_size;
+            const size_t new_size = tmp_rarc.m_nodes.size();
+            IndexOrphans orphans  = remapIndex([&](size_t index) {
+                if (index >= old_end) {
+                    return index + new_size - old_size;
                 }
-            }
+                if (index >= static_cast<size_t>(deleted_at)) {
+                    return std::string::npos;
+                }
+                return index;
+            });
+            indexNodes(deleted_at, deleted_at + new_size);
+            repairIndex(orphans, deleted_at);
 
             return {};
         }
@@ -766,8 +1097,23 @@ namespace Toolbox::RARC {
         }
         auto fsize = size_result.value();
 
-        old_node->data.resize(fsize);
-        in.read((char *)old_node->data.data(), fsize);
+        std::vector<char> data(fsize);
+        in.read(data.data(), fsize);
+
+        // Compressed nodes are kept decoded and encoded again on save, so
+        // encoded input would end up compressed twice
+        if ((old_node->flags & ResourceAttribute::YAZ0_COMPRESSED) &&
+            SZS::IsDataYaz0Compressed(data)) {
+            auto decompress_result = SZS::Decompress(data);
+            if (!decompress_result) {
+                return make_fs_error<node_it>(
+                    std::error_code(),
+                    {std::format("REPLACE: Failed to decompress {}", path.string())});
+            }
+            data = std::move(decompress_result.value());
+        }
+
+        old_node->data = std::move(data);
 
         return {};
     }
@@ -836,6 +1182,37 @@ namespace Toolbox::RARC {
 
     void ResourceArchive::dump(std::ostream &out, size_t indention, size_t indention_width) const {}
 
+    Result<void, SerialError> ResourceArchive::saveToPath(const std::filesystem::path &path) {
+        std::error_code err;
+        if (m_mapping && std::filesystem::equivalent(path, m_mapped_path, err)) {
+            // Writing truncates the file beneath every view of the mapping
+            if (m_mapping.use_count() > 1) {
+                return make_serial_error<void>(
+                    "RARC", "Refusing to save over an archive still mapped by another copy", 0,
+                    path.string());
+            }
+            unmap();
+        }
+
+        std::vector<char> arena;
+        {
+            Serializer out(arena, path.string());
+
+            auto result = serialize(out);
+            if (!result) {
+                return std::unexpected(result.error());
+            }
+        }
+
+        std::ofstream file(path, std::ios::out | std::ios::binary);
+        if (!file.is_open()) {
+            return make_serial_error<void>("RARC", "Failed to open file for writing", 0,
+                                           path.string());
+        }
+        file.write(arena.data(), arena.size());
+        return {};
+    }
+
     Result<void, SerialError> ResourceArchive::serialize(Serializer &out) const {
         struct OffsetInfo {
             std::size_t string_offset;
@@ -852,6 +1229,13 @@ namespace Toolbox::RARC {
         }
         auto processed_nodes = result.value();
 
+        // Compressed files are kept decoded in memory
+        for (auto &node : processed_nodes) {
+            if (!node.is_folder() && (node.flags & ResourceAttribute::YAZ0_COMPRESSED)) {
+                node.data = SZS::Compress(node.data, 0);
+            }
+        }
+
         std::string strings_blob;
         {
             offsets_map["."]  = {0, 0};
@@ -1023,11 +1407,76 @@ namespace Toolbox::RARC {
                                        low_archive.meta_header.files.offset +
                                        low_archive.meta_header.files.size;
 
-        return saveLowResourceArchive(low_archive, out);
+        low_archive.dir_nodes = std::move(dir_nodes);
+        low_archive.fs_nodes  = std::move(fs_nodes);
+        low_archive.string_data.assign(strings_blob.begin(), strings_blob.end());
+        low_archive.string_data.resize(low_archive.node_header.string_table.size, '\0');
+        low_archive.file_data.assign(low_data.begin(), low_data.end());
+
+        if (!m_compressed) {
+            return saveLowResourceArchive(low_archive, out);
+        }
+
+        std::stringstream str_out;
+        Serializer raw_out(str_out.rdbuf(), out.filepath());
+
+        auto save_result = saveLowResourceArchive(low_archive, raw_out);
+        if (!save_result) {
+            return save_result;
+        }
+
+        const std::string raw_archive = std::move(str_out).str();
+        out.writeBytes(SZS::Compress(raw_archive, 0));
+        return {};
     }
 
     Result<void, SerialError> ResourceArchive::deserialize(Deserializer &in) {
-        auto result = loadLowResourceArchive(in);
+        // Compressed archives are decoded up front and parsed from memory
+        {
+            const auto start = in.tell();
+
+            char magic[4] = {};
+            in.readBytes(magic);
+            in.seek(start, std::ios::beg);
+
+            if (std::memcmp(magic, "Yaz0", 4) == 0) {
+                std::vector<char> compressed(in.size() - static_cast<size_t>(start));
+                in.readBytes(compressed);
+
+                auto size_result = SZS::GetDecompressedSize(compressed);
+                if (!size_result) {
+                    return make_serial_error<void>(in, size_result.error().m_message.back());
+                }
+
+                std::string raw_archive(size_result.value(), '\0');
+                auto decompress_result = SZS::DecompressInto(compressed, raw_archive);
+                if (!decompress_result) {
+                    return make_serial_error<void>(in, decompress_result.error().m_message.back());
+                }
+
+                Deserializer raw_in(std::span<const char>(raw_archive), in.filepath());
+
+                auto result = deserialize(raw_in);
+                if (!result) {
+                    return result;
+                }
+
+                m_compressed = true;
+                return {};
+            }
+        }
+
+        return loadArchive(in, nullptr);
+    }
+
+    Result<void, SerialError>
+    ResourceArchive::loadArchive(Deserializer &in, RefPtr<const Platform::MappedFile> mapping) {
+        m_nodes.clear();
+        m_compressed = false;
+        m_mapping    = mapping;
+        invalidateIndex();
+
+        auto result = loadLowResourceArchive(in, mapping == nullptr);
         if (!result) {
             return std::unexpected(result.error());
         }
@@ -1037,13 +1486,39 @@ namespace Toolbox::RARC {
             return make_serial_error<void>(in, "Archive has no directories");
         }
 
+        if (mapping) {
+            const size_t files_offset =
+                low_archive->meta_header.nodes.offset + low_archive->meta_header.files.offset;
+            if (files_offset + low_archive->meta_header.files.size > mapping->size()) {
+                return make_serial_error<void>(in, "File data extends past the end of the archive");
+            }
+            low_archive->file_view =
+                mapping->view().subspan(files_offset, low_archive->meta_header.files.size);
+            low_archive->is_mapped = true;
+        }
+
         m_ids_synced = low_archive->node_header.ids_synced;
 
         recurseLoadDirectory(*low_archive, low_archive->dir_nodes[0], std::nullopt, std::nullopt,
                              m_nodes, 0);
 
+        for (auto &node : m_nodes) {
+            if (node.is_folder() || !(node.flags & ResourceAttribute::YAZ0_COMPRESSED) ||
+                !SZS::IsDataYaz0Compressed(node.data)) {
+                continue;
+            }
+
+            auto decompress_result = SZS::Decompress(node.data);
+            if (!decompress_result) {
+                return make_serial_error<void>(
+                    in, std::format("Failed to decompress \"{}\"", node.name));
+            }
+            node.data = std::move(decompress_result.value());
+        }
+
         m_name = m_nodes[0].name;
 
+        rebuildIndex();
         return {};
     }
 
@@ -1052,57 +1527,44 @@ namespace Toolbox::RARC {
     }
 
     Result<void> ResourceArchive::recalculateIDs() {
-        std::vector<int> parent_stack = {
-            -1,
-        };
-        std::vector<int> walk_stack = {};
-        int folder_id               = 0;
-
-        for (auto node = m_nodes.begin(); node != m_nodes.end(); node++) {
-            for (auto walk = walk_stack.begin(); walk != walk_stack.end();) {
-                if ((*walk) == std::distance(m_nodes.begin(), node)) {
-                    walk = walk_stack.erase(walk);
-                    parent_stack.pop_back();
-                } else {
-                    walk++;
-                }
-            }
-            if (node->is_folder()) {
-                node->id            = folder_id++;
-                node->folder.parent = parent_stack.back();
-                walk_stack.push_back(node->folder.sibling_next);
-                parent_stack.push_back(node->id);
-            }
+        if (m_nodes.empty() || !m_nodes[0].is_folder()) {
+            return make_error<void>("RARC Middleware",
+                                    "RARC is missing nodes or the root is screwed up");
         }
 
-        children_info_type throwaway;
-        auto result = processNodesForSave(m_nodes, throwaway);
-        if (!result) {
-            return std::unexpected(result.error());
-        }
-
-        const std::vector<ResourceArchive::Node> &calc_list = result.value();
+        recalculateFolderIDs(m_nodes);
 
-        s16 file_id = -1;  // Adjust for root node
-        for (auto &node : calc_list) {
-            if (node.is_folder()) {
-                file_id++;
+        // File IDs follow the save order, where each folder (depth first)
+        // lists its files, then its subdirs and its two special dirs. Every
+        // entry below the root takes an ID.
+        s32 file_id = 0;
+        for (size_t i = 0; i < m_nodes.size(); ++i) {
+            if (!m_nodes[i].is_folder()) {
                 continue;
             }
 
-            for (auto &target : m_nodes) {
-                if (target.id == node.id && target.name == node.name) {
-                    target.id = file_id++;
-                    break;
+            const size_t end    = std::min<size_t>(m_nodes[i].folder.sibling_next, m_nodes.size());
+            size_t subdir_count = 0;
+            for (size_t child = i + 1; child < end;) {
+                Node &node = m_nodes[child];
+                if (node.is_folder()) {
+                    subdir_count += 1;
+                    child = std::max<size_t>(node.folder.sibling_next, child + 1);
+                } else {
+                    node.id = file_id++;
+                    child += 1;
                 }
             }
+
+            file_id += static_cast<s32>(subdir_count) + 2;
         }
 
+        rebuildIdIndex();
         return {};
     }
 
     static Result<ScopePtr<LowResourceArchive>, SerialError>
-    loadLowResourceArchive(Deserializer &in) {
+    loadLowResourceArchive(Deserializer &in, bool read_file_data) {
         auto low_archive = make_scoped<LowResourceArchive>();
 
         // Metaheader
@@ -1194,11 +1656,12 @@ namespace Toolbox::RARC {
             in.readBytes(low_archive->string_data);
         }
 
-        low_archive->file_data.resize(low_archive->meta_header.files.size);
-        {
+        if (read_file_data) {
+            low_archive->file_data.resize(low_archive->meta_header.files.size);
             in.seek(low_archive->meta_header.nodes.offset + low_archive->meta_header.files.offset,
                     std::ios::beg);
             in.readBytes(low_archive->file_data);
+            low_archive->file_view = low_archive->file_data;
         }
 
         return low_archive;
@@ -1428,6 +1891,27 @@ namespace Toolbox::RARC {
         }
     }
 
+    static void recalculateFolderIDs(std::vector<ResourceArchive::Node> &nodes) {
+        // Open folders as their ID and the index one past their last child
+        std::vector<std::pair<s32, size_t>> parent_stack;
+        s32 folder_id = 0;
+
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            while (!parent_stack.empty() && i >= parent_stack.back().second) {
+                parent_stack.pop_back();
+            }
+
+            auto &node = nodes[i];
+            if (!node.is_folder()) {
+                continue;
+            }
+
+            node.id            = folder_id++;
+            node.folder.parent = parent_stack.empty() ? -1 : parent_stack.back().first;
+            parent_stack.emplace_back(node.id, node.folder.sibling_next);
+        }
+    }
+
     static Result<void>
     sortNodesForSaveRecursive(const std::vector<ResourceArchive::Node> &src,
                               std::vector<ResourceArchive::Node> &out,
@@ -1551,8 +2035,12 @@ namespace Toolbox::RARC {
                                                .flags = static_cast<u16>(fs_node->type >> 8),
                                                .name  = low.string_data.data() + fs_node->name};
 
-                auto data_begin = low.file_data.begin() + fs_node->file.offset;
-                tmp_f.data.insert(tmp_f.data.end(), data_begin, data_begin + fs_node->file.size);
+                auto file_view = low.file_view.subspan(fs_node->file.offset, fs_node->file.size);
+                if (low.is_mapped) {
+                    tmp_f.data = file_view;
+                } else {
+                    tmp_f.data = std::vector<char>(file_view.begin(), file_view.end());
+                }
                 out.push_back(tmp_f);
             }
         }
@@ -117,13 +117,11 @@ namespace Toolbox {
             out.writeCString(rail->name());
 
             out.seek(data_start, std::ios::beg);
-            for (auto &node : rail->nodes()) {
-                node->serialize(out);
-            }
+            rail->serializeNodes(out);
 
             header_start += 12;
             name_start += rail->name().size() + 1;
-            data_start += 68 * rail->getNodeCount();
+            data_start += rail->getDataSize();
         }
 
         return {};
@@ -144,10 +142,9 @@ namespace Toolbox {
             auto rail = make_referable<Rail::Rail>(name);
 
             in.seek(data_pos, std::ios::beg);
-            for (size_t i = 0; i < node_count; ++i) {
-                auto node = make_referable<Rail::RailNode>();
-                node->deserialize(in);
-                rail->addNode(node);
+            auto result = rail->deserializeNodes(in, node_count);
+            if (!result) {
+                return std::unexpected(result.error());
             }
 
             m_rails.push_back(rail);
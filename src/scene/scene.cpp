@@ -1,8 +1,70 @@
 #include "scene/scene.hpp"
+#include "core/log.hpp"
+#include "core/threadpool.hpp"
+#include "core/timing.hpp"
+#include "platform/filemap.hpp"
 #include <fstream>
 
 namespace Toolbox {
 
+    namespace {
+        // Scene files are decoded straight out of a mapping, which spares
+        // the per read overhead of going through a stream
+        ObjectFactory::create_t
+        LoadObjectFile(const std::filesystem::path &path,
+                       std::vector<ObjectFactory::RenderDataRequest> &requests) {
+            Platform::MappedFile file;
+            auto map_result = file.open(path);
+            if (!map_result) {
+                return make_serial_error<ObjectFactory::create_ret_t>(
+                    "SCENE", map_result.error().m_message.back(), 0, path.string());
+            }
+
+            Deserializer in(file.view(), path.string());
+            return ObjectFactory::create(in, requests);
+        }
+
+        // Missing files are left empty
+        Result<void, SerialError> LoadSceneFile(const std::filesystem::path &path,
+                                                ISerializable &data) {
+            Platform::MappedFile file;
+            if (!file.open(path)) {
+                return {};
+            }
+
+            Deserializer in(file.view(), path.string());
+            return data.deserialize(in);
+        }
+
+        // The J3D loaders create GL resources while decoding, so models and
+        // materials can't be decoded on the pool; only their files are read
+        // there, having been queued during parsing. This runs on the calling
+        // thread, which must own the context.
+        Result<void, SerialError>
+        LoadRenderData(std::span<const ObjectFactory::RenderDataRequest> requests) {
+            for (const ObjectFactory::RenderDataRequest &request : requests) {
+                auto result = ObjectFactory::loadRenderData(request);
+                if (!result) {
+                    return result;
+                }
+            }
+            return {};
+        }
+
+        // Files are only opened once their contents serialized
+        // successfully, so a failed save leaves them intact
+        Result<void, SerialError> WriteSceneFile(const std::filesystem::path &path,
+                                                 std::span<const char> data) {
+            std::ofstream file(path, std::ios::out | std::ios::binary);
+            if (!file.is_open()) {
+                return make_serial_error<void>("SCENE", "Failed to open file for writing", 0,
+                                               path.string());
+            }
+            file.write(data.data(), data.size());
+            return {};
+        }
+    }  // namespace
+
     void ObjectHierarchy::dump(std::ostream &os, size_t indent, size_t indent_size) const {
         std::string indent_str(indent * indent_size, ' ');
         os << indent_str << "ObjectHierarchy (" << m_name << ") {\n";
@@ -12,35 +74,80 @@ namespace Toolbox {
 
     Result<ScopePtr<SceneInstance>, SerialError>
     SceneInstance::FromPath(const std::filesystem::path &root) {
-        ScopePtr<SceneInstance> scene         = make_scoped<SceneInstance>();
-        scene->m_root_path = root;
+        ScopePtr<SceneInstance> scene = make_scoped<SceneInstance>();
+        scene->m_root_path            = root;
 
         auto scene_bin   = root / "map/scene.bin";
         auto tables_bin  = root / "map/tables.bin";
         auto rail_bin    = root / "map/scene.ral";
         auto message_bin = root / "map/message.bmg";
 
+        ThreadPool &pool = ThreadPool::instance();
+
         ObjectFactory::create_t map_root_obj;
         ObjectFactory::create_t table_root_obj;
+        Result<void, SerialError> rails_result;
+        Result<void, SerialError> message_result;
+
+        std::vector<ObjectFactory::RenderDataRequest> map_requests;
+        std::vector<ObjectFactory::RenderDataRequest> table_requests;
+
+        double map_time     = 0.0;
+        double tables_time  = 0.0;
+        double rails_time   = 0.0;
+        double message_time = 0.0;
+
+        // Stage 1: The four files don't depend on each other. The map is
+        // read on this thread while the pool takes the rest.
+        double parse_time = Timing::measure([&]() {
+            auto tables_future = pool.submit([&]() {
+                tables_time = Timing::measure(
+                    [&]() { table_root_obj = LoadObjectFile(tables_bin, table_requests); });
+            });
+            auto rails_future = pool.submit([&]() {
+                rails_time = Timing::measure(
+                    [&]() { rails_result = LoadSceneFile(rail_bin, scene->m_rail_info); });
+            });
+            auto message_future = pool.submit([&]() {
+                message_time = Timing::measure([&]() {
+                    message_result = LoadSceneFile(message_bin, scene->m_message_data);
+                });
+            });
+
+            map_time = Timing::measure(
+                [&]() { map_root_obj = LoadObjectFile(scene_bin, map_requests); });
+
+            // The tasks reference this frame, so join them even on failure
+            tables_future.get();
+            rails_future.get();
+            message_future.get();
+        });
+
+        if (!map_root_obj) {
+            return std::unexpected(map_root_obj.error());
+        }
 
-        {
-            std::ifstream file(scene_bin, std::ios::in | std::ios::binary);
-            Deserializer in(file.rdbuf(), scene_bin.string());
+        if (!table_root_obj) {
+            return std::unexpected(table_root_obj.error());
+        }
 
-            map_root_obj = ObjectFactory::create(in);
-            if (!map_root_obj) {
-                return std::unexpected(map_root_obj.error());
-            }
+        if (!rails_result) {
+            return std::unexpected(rails_result.error());
         }
 
-        {
-            std::ifstream file(tables_bin, std::ios::in | std::ios::binary);
-            Deserializer in(file.rdbuf());
+        if (!message_result) {
+            return std::unexpected(message_result.error());
+        }
 
-            table_root_obj = ObjectFactory::create(in);
-            if (!table_root_obj) {
-                return std::unexpected(table_root_obj.error());
-            }
+        // Stage 2: Every physical object's render data
+        std::vector<ObjectFactory::RenderDataRequest> requests = std::move(map_requests);
+        requests.insert(requests.end(), table_requests.begin(), table_requests.end());
+
+        Result<void, SerialError> render_result;
+        double render_time =
+            Timing::measure([&]() { render_result = LoadRenderData(requests); });
+        if (!render_result) {
+            return std::unexpected(render_result.error());
         }
 
         RefPtr<Object::GroupSceneObject> map_root_obj_ptr =
@@ -53,19 +160,10 @@ namespace Toolbox {
         scene->m_map_objects   = ObjectHierarchy("Map", map_root_obj_ptr);
         scene->m_table_objects = ObjectHierarchy("Table", table_root_obj_ptr);
 
-        {
-            std::ifstream file(rail_bin, std::ios::in | std::ios::binary);
-            Deserializer in(file.rdbuf());
-
-            scene->m_rail_info.deserialize(in);
-        }
-
-        {
-            std::ifstream file(message_bin, std::ios::in | std::ios::binary);
-            Deserializer in(file.rdbuf());
-
-            scene->m_message_data.deserialize(in);
-        }
+        TOOLBOX_INFO_V("[SCENE] Opened {} in {} seconds (parse: {} [map: {}, tables: {}, rails: "
+                       "{}, messages: {}], render data: {} for {} objects)",
+                       root.filename().string(), parse_time + render_time, parse_time, map_time,
+                       tables_time, rails_time, message_time, render_time, requests.size());
 
         return scene;
     }
@@ -84,44 +182,62 @@ namespace Toolbox {
         auto rail_bin    = root / "map/scene.ral";
         auto message_bin = root / "map/message.bmg";
 
+        std::vector<char> arena;
+
         {
-            std::ofstream file(scene_bin, std::ios::out | std::ios::binary);
-            Serializer out(file.rdbuf(), scene_bin.string());
+            Serializer out(arena, scene_bin.string());
 
             auto result = m_map_objects.getRoot()->serialize(out);
             if (!result) {
                 return std::unexpected(result.error());
             }
+
+            result = WriteSceneFile(scene_bin, arena);
+            if (!result) {
+                return std::unexpected(result.error());
+            }
         }
 
         {
-            std::ofstream file(tables_bin, std::ios::out | std::ios::binary);
-            Serializer out(file.rdbuf(), scene_bin.string());
+            Serializer out(arena, tables_bin.string());
 
             auto result = m_table_objects.getRoot()->serialize(out);
             if (!result) {
                 return std::unexpected(result.error());
             }
+
+            result = WriteSceneFile(tables_bin, arena);
+            if (!result) {
+                return std::unexpected(result.error());
+            }
         }
 
         {
-            std::ofstream file(rail_bin, std::ios::out | std::ios::binary);
-            Serializer out(file.rdbuf(), scene_bin.string());
+            Serializer out(arena, rail_bin.string());
 
             auto result = m_rail_info.serialize(out);
             if (!result) {
                 return std::unexpected(result.error());
             }
+
+            result = WriteSceneFile(rail_bin, arena);
+            if (!result) {
+                return std::unexpected(result.error());
+            }
         }
 
         {
-            std::ofstream file(message_bin, std::ios::out | std::ios::binary);
-            Serializer out(file.rdbuf(), scene_bin.string());
+            Serializer out(arena, message_bin.string());
 
             auto result = m_message_data.serialize(out);
             if (!result) {
                 return std::unexpected(result.error());
             }
+
+            result = WriteSceneFile(message_bin, arena);
+            if (!result) {
+                return std::unexpected(result.error());
+            }
         }
 
         m_root_path = root;
@@ -0,0 +1,368 @@
+#include <cerrno>
+#include <iconv.h>
+#include <unordered_map>
+#include <vector>
+
+#include "core/types.hpp"
+#include "strutil.hpp"
+
+namespace Toolbox::String {
+
+    namespace {
+
+        constexpr char32_t c_unmapped_unicode = 0xFFFF;
+        constexpr u16 c_unmapped_sjis         = 0xFFFF;
+
+        Result<std::string, EncodingError> MakeConversionError(std::string_view from,
+                                                               std::string_view to) {
+            return make_encoding_error<std::string>(
+                "ICONV", std::format("Failed to convert string encoding from {} to {}", from, to),
+                from, to);
+        }
+
+        // Opening a converter costs far more than converting a name with
+        // it, so every thread keeps the ones it used open
+        class ConverterCache {
+        public:
+            ConverterCache() = default;
+            ConverterCache(const ConverterCache &) = delete;
+            ~ConverterCache() {
+                for (auto &[key, conv] : m_converters) {
+                    iconv_close(conv);
+                }
+            }
+
+            ConverterCache &operator=(const ConverterCache &) = delete;
+
+            iconv_t get(std::string_view from, std::string_view to) {
+                std::string key = std::format("{}>{}", from, to);
+
+                auto it = m_converters.find(key);
+                if (it != m_converters.end()) {
+                    // Drop any shift state left by a failed conversion
+                    iconv(it->second, nullptr, nullptr, nullptr, nullptr);
+                    return it->second;
+                }
+
+                iconv_t conv = iconv_open(std::string(to).c_str(), std::string(from).c_str());
+                if (conv != (iconv_t)(-1)) {
+                    m_converters.emplace(std::move(key), conv);
+                }
+                return conv;
+            }
+
+        private:
+            std::unordered_map<std::string, iconv_t> m_converters;
+        };
+
+        thread_local ConverterCache s_converters;
+
+        Result<std::string, EncodingError> ConvertWithIconv(std::string_view value,
+                                                            std::string_view from,
+                                                            std::string_view to) {
+            iconv_t conv = s_converters.get(from, to);
+            if (conv == (iconv_t)(-1)) {
+                return make_encoding_error<std::string>("ICONV", "Failed to open converter", from,
+                                                        to);
+            }
+
+            size_t inbytesleft = value.size();
+            char *inbuf        = const_cast<char *>(value.data());
+
+            std::string result(value.size() * 2 + 8, '\0');
+            size_t written = 0;
+            while (true) {
+                size_t outbytesleft = result.size() - written;
+                char *outbuf        = result.data() + written;
+
+                size_t status = iconv(conv, &inbuf, &inbytesleft, &outbuf, &outbytesleft);
+                written       = result.size() - outbytesleft;
+                if (status != (size_t)(-1)) {
+                    break;
+                }
+
+                if (errno != E2BIG) {
+                    return MakeConversionError(from, to);
+                }
+                result.resize(result.size() * 2);
+            }
+
+            result.resize(written);
+            return result;
+        }
+
+        // Backslash and tilde sit in JIS X 0201 as the yen sign and
+        // overline, so only the rest of ASCII is the same in both
+        bool IsPassthroughASCII(std::string_view value) {
+            for (char ch : value) {
+                u8 c = static_cast<u8>(ch);
+                if (c >= 0x80 || c == '\\' || c == '~') {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool IsShiftJISLeadByte(u8 c) {
+            return (c >= 0x81 && c <= 0x9F) || (c >= 0xE0 && c <= 0xFC);
+        }
+
+        bool IsShiftJISTrailByte(u8 c) { return c >= 0x40 && c <= 0xFC && c != 0x7F; }
+
+        void EncodeUTF8(char32_t cp, std::string &out) {
+            if (cp < 0x80) {
+                out.push_back(static_cast<char>(cp));
+            } else if (cp < 0x800) {
+                out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+                out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+            } else {
+                out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+                out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+            }
+        }
+
+        // Only decodes the BMP, which holds everything Shift-JIS can encode.
+        // Malformed, overlong and surrogate sequences are rejected.
+        bool DecodeUTF8(std::string_view value, size_t &pos, char32_t &cp) {
+            u8 c = static_cast<u8>(value[pos]);
+            if (c < 0x80) {
+                cp   = c;
+                pos += 1;
+                return true;
+            }
+
+            size_t length;
+            char32_t min_cp;
+            if ((c & 0xE0) == 0xC0) {
+                length = 2;
+                min_cp = 0x80;
+                cp     = c & 0x1F;
+            } else if ((c & 0xF0) == 0xE0) {
+                length = 3;
+                min_cp = 0x800;
+                cp     = c & 0x0F;
+            } else {
+                return false;
+            }
+
+            if (pos + length > value.size()) {
+                return false;
+            }
+
+            for (size_t i = 1; i < length; ++i) {
+                u8 cont = static_cast<u8>(value[pos + i]);
+                if ((cont & 0xC0) != 0x80) {
+                    return false;
+                }
+                cp = (cp << 6) | (cont & 0x3F);
+            }
+
+            if (cp < min_cp || (cp >= 0xD800 && cp <= 0xDFFF)) {
+                return false;
+            }
+
+            pos += length;
+            return true;
+        }
+
+        // Both directions of the Shift-JIS mapping, read out of iconv once
+        // so the table converts exactly like iconv would on this platform.
+        // Codes are the single byte, or the lead byte followed by the trail
+        // byte, which keeps the two ranges apart.
+        class ShiftJISTable {
+        public:
+            static const ShiftJISTable &instance() {
+                static ShiftJISTable s_table;
+                return s_table;
+            }
+
+            [[nodiscard]] bool isValid() const { return m_valid; }
+
+            [[nodiscard]] char32_t toUnicode(u16 code) const { return m_to_unicode[code]; }
+            [[nodiscard]] u16 fromUnicode(char32_t cp) const { return m_from_unicode[cp]; }
+
+        private:
+            ShiftJISTable()
+                : m_to_unicode(0x10000, c_unmapped_unicode),
+                  m_from_unicode(0x10000, c_unmapped_sjis) {
+                iconv_t to_utf8 = iconv_open(IMGUI_ENCODING, GAME_ENCODING);
+                if (to_utf8 == (iconv_t)(-1)) {
+                    return;
+                }
+
+                iconv_t from_utf8 = iconv_open(GAME_ENCODING, IMGUI_ENCODING);
+                if (from_utf8 == (iconv_t)(-1)) {
+                    iconv_close(to_utf8);
+                    return;
+                }
+
+                for (u16 c = 0; c < 0x100; ++c) {
+                    if (IsShiftJISLeadByte(static_cast<u8>(c))) {
+                        for (u16 trail = 0x40; trail <= 0xFC; ++trail) {
+                            if (IsShiftJISTrailByte(static_cast<u8>(trail))) {
+                                mapCode(to_utf8, (c << 8) | trail);
+                            }
+                        }
+                    } else {
+                        mapCode(to_utf8, c);
+                    }
+                }
+
+                // The reverse can't be derived from the above, iconv also
+                // accepts code points it never decodes to (plain backslash
+                // for the yen sign) and picks one code for duplicates
+                for (char32_t cp = 0; cp < 0x10000; ++cp) {
+                    if (cp < 0xD800 || cp > 0xDFFF) {
+                        mapCodePoint(from_utf8, cp);
+                    }
+                }
+
+                iconv_close(to_utf8);
+                iconv_close(from_utf8);
+                m_valid = true;
+            }
+
+            void mapCode(iconv_t to_utf8, u16 code) {
+                char sjis[2]       = {static_cast<char>(code >> 8), static_cast<char>(code)};
+                size_t sjis_length = code > 0xFF ? 2 : 1;
+
+                std::string utf8;
+                if (!convert(to_utf8, {code > 0xFF ? sjis : sjis + 1, sjis_length}, utf8)) {
+                    return;
+                }
+
+                size_t pos = 0;
+                char32_t cp;
+                if (!utf8.empty() && DecodeUTF8(utf8, pos, cp) && pos == utf8.size()) {
+                    m_to_unicode[code] = cp;
+                }
+            }
+
+            void mapCodePoint(iconv_t from_utf8, char32_t cp) {
+                std::string utf8;
+                EncodeUTF8(cp, utf8);
+
+                std::string encoded;
+                if (!convert(from_utf8, utf8, encoded)) {
+                    return;
+                }
+
+                if (encoded.size() == 1) {
+                    m_from_unicode[cp] = static_cast<u8>(encoded[0]);
+                } else if (encoded.size() == 2) {
+                    m_from_unicode[cp] = static_cast<u16>((static_cast<u8>(encoded[0]) << 8) |
+                                                          static_cast<u8>(encoded[1]));
+                }
+            }
+
+            static bool convert(iconv_t conv, std::string_view in, std::string &out) {
+                char buffer[8];
+
+                size_t inbytesleft  = in.size();
+                char *inbuf         = const_cast<char *>(in.data());
+                size_t outbytesleft = sizeof(buffer);
+                char *outbuf        = buffer;
+
+                iconv(conv, nullptr, nullptr, nullptr, nullptr);
+                if (iconv(conv, &inbuf, &inbytesleft, &outbuf, &outbytesleft) == (size_t)(-1)) {
+                    return false;
+                }
+
+                out.assign(buffer, sizeof(buffer) - outbytesleft);
+                return true;
+            }
+
+            bool m_valid = false;
+            std::vector<char32_t> m_to_unicode;
+            std::vector<u16> m_from_unicode;
+        };
+
+        Result<std::string, EncodingError> ShiftJISToUTF8(std::string_view value) {
+            const ShiftJISTable &table = ShiftJISTable::instance();
+            if (!table.isValid()) {
+                return ConvertWithIconv(value, GAME_ENCODING, IMGUI_ENCODING);
+            }
+
+            std::string result;
+            result.reserve(value.size() * 2);
+
+            for (size_t i = 0; i < value.size();) {
+                u16 code = static_cast<u8>(value[i]);
+                if (IsShiftJISLeadByte(static_cast<u8>(code))) {
+                    if (i + 1 >= value.size()) {
+                        return MakeConversionError(GAME_ENCODING, IMGUI_ENCODING);
+                    }
+                    code = (code << 8) | static_cast<u8>(value[i + 1]);
+                    i += 2;
+                } else {
+                    i += 1;
+                }
+
+                char32_t cp = table.toUnicode(code);
+                if (cp == c_unmapped_unicode) {
+                    return MakeConversionError(GAME_ENCODING, IMGUI_ENCODING);
+                }
+                EncodeUTF8(cp, result);
+            }
+
+            return result;
+        }
+
+        Result<std::string, EncodingError> UTF8ToShiftJIS(std::string_view value) {
+            const ShiftJISTable &table = ShiftJISTable::instance();
+            if (!table.isValid()) {
+                return ConvertWithIconv(value, IMGUI_ENCODING, GAME_ENCODING);
+            }
+
+            std::string result;
+            result.reserve(value.size());
+
+            for (size_t i = 0; i < value.size();) {
+                char32_t cp;
+                if (!DecodeUTF8(value, i, cp)) {
+                    return MakeConversionError(IMGUI_ENCODING, GAME_ENCODING);
+                }
+
+                u16 code = table.fromUnicode(cp);
+                if (code == c_unmapped_sjis) {
+                    return MakeConversionError(IMGUI_ENCODING, GAME_ENCODING);
+                }
+
+                if (code > 0xFF) {
+                    result.push_back(static_cast<char>(code >> 8));
+                }
+                result.push_back(static_cast<char>(code));
+            }
+
+            return result;
+        }
+
+    }  // namespace
+
+    Result<std::string, EncodingError> asEncoding(std::string_view value, std::string_view from,
+                                                  std::string_view to) {
+        if (from == GAME_ENCODING && to == IMGUI_ENCODING) {
+            return fromGameEncoding(value);
+        }
+        if (from == IMGUI_ENCODING && to == GAME_ENCODING) {
+            return toGameEncoding(value);
+        }
+        return ConvertWithIconv(value, from, to);
+    }
+
+    Result<std::string, EncodingError> fromGameEncoding(std::string_view value) {
+        if (IsPassthroughASCII(value)) {
+            return std::string(value);
+        }
+        return ShiftJISToUTF8(value);
+    }
+
+    Result<std::string, EncodingError> toGameEncoding(std::string_view value) {
+        if (IsPassthroughASCII(value)) {
+            return std::string(value);
+        }
+        return UTF8ToShiftJIS(value);
+    }
+
+}  // namespace Toolbox::String
\ No newline at end of file
@@ -0,0 +1,469 @@
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "szs/szs.hpp"
+
+namespace Toolbox::SZS {
+
+    namespace {
+        template <typename T> inline T seadMathMin(T a, T b) {
+            if (a < b)
+                return a;
+            else
+                return b;
+        }
+
+        size_t ReadChunkLength(const u8 *chunk) {
+            const size_t length = chunk[0] >> 4;
+            return length == 0 ? size_t(chunk[2]) + 0x12 : length + 2;
+        }
+
+        // Concatenates independently encoded windows into a single stream.
+        // Windows rarely end on a group boundary, so every chunk is moved
+        // into freshly built groups rather than copied verbatim.
+        class GroupWriter {
+        public:
+            explicit GroupWriter(std::vector<char> &out) : m_out(out) {}
+
+            void appendWindow(std::span<const char> encoded, size_t decoded_size) {
+                const u8 *in = reinterpret_cast<const u8 *>(encoded.data()) + c_header_size;
+
+                size_t produced = 0;
+                while (produced < decoded_size) {
+                    u8 group = *in++;
+                    for (int i = 0; i < 8 && produced < decoded_size; ++i, group <<= 1) {
+                        if (group & 0x80) {
+                            pushChunk(in, 1, true);
+                            in += 1;
+                            produced += 1;
+                            continue;
+                        }
+                        const size_t chunk_size = (in[0] >> 4) == 0 ? 3 : 2;
+                        produced += ReadChunkLength(in);
+                        pushChunk(in, chunk_size, false);
+                        in += chunk_size;
+                    }
+                }
+            }
+
+        private:
+            void pushChunk(const u8 *chunk, size_t size, bool literal) {
+                if (m_chunk_count == 8) {
+                    m_group_pos = m_out.size();
+                    m_out.push_back(0);
+                    m_chunk_count = 0;
+                }
+                if (literal) {
+                    m_out[m_group_pos] |= static_cast<char>(0x80 >> m_chunk_count);
+                }
+                m_out.insert(m_out.end(), chunk, chunk + size);
+                m_chunk_count += 1;
+            }
+
+            std::vector<char> &m_out;
+            size_t m_group_pos = 0;
+            int m_chunk_count  = 8;
+        };
+
+        void WriteHeader(std::vector<char> &out, u32 decoded_size) {
+            const char header[c_header_size] = {
+                'Y',
+                'a',
+                'z',
+                '0',
+                static_cast<char>(decoded_size >> 24),
+                static_cast<char>(decoded_size >> 16),
+                static_cast<char>(decoded_size >> 8),
+                static_cast<char>(decoded_size),
+            };
+            out.insert(out.end(), std::begin(header), std::end(header));
+        }
+    }  // namespace
+
+    bool IsDataYaz0Compressed(std::span<const char> data) {
+        return data.size() >= c_header_size && std::memcmp(data.data(), "Yaz0", 4) == 0;
+    }
+
+    Result<u32> GetDecompressedSize(std::span<const char> data) {
+        if (!IsDataYaz0Compressed(data)) {
+            return make_error<u32>("SZS", "Data is not Yaz0 compressed (Expected Yaz0)");
+        }
+        const u8 *header = reinterpret_cast<const u8 *>(data.data());
+        return (u32(header[4]) << 24) | (u32(header[5]) << 16) | (u32(header[6]) << 8) |
+               u32(header[7]);
+    }
+
+    size_t GetMaxCompressedSize(size_t src_size) {
+        // Every group of 8 literals costs one extra byte, and the encoder
+        // zeroes 8 bytes past the header before it starts writing groups
+        return c_header_size + src_size + (src_size + 7) / 8 + 8;
+    }
+
+    Result<void> DecompressInto(std::span<const char> src, std::span<char> dst) {
+        auto size_result = GetDecompressedSize(src);
+        if (!size_result) {
+            return std::unexpected(size_result.error());
+        }
+
+        const size_t dst_size = size_result.value();
+        if (dst.size() < dst_size) {
+            return make_error<void>("SZS", "Destination is smaller than the decompressed size");
+        }
+
+        const u8 *in     = reinterpret_cast<const u8 *>(src.data()) + c_header_size;
+        const u8 *in_end = reinterpret_cast<const u8 *>(src.data()) + src.size();
+
+        u8 *out_begin = reinterpret_cast<u8 *>(dst.data());
+        u8 *out       = out_begin;
+        u8 *out_end   = out_begin + dst_size;
+
+        while (out < out_end) {
+            if (in >= in_end) [[unlikely]] {
+                return make_error<void>("SZS", "Unexpected end of compressed data");
+            }
+
+            u8 group = *in++;
+
+            // Whole groups of literals dominate poorly compressible data
+            if (group == 0xFF && in_end - in >= 8 && out_end - out >= 8) {
+                std::memcpy(out, in, 8);
+                in += 8;
+                out += 8;
+                continue;
+            }
+
+            for (int i = 0; i < 8 && out < out_end; ++i, group <<= 1) {
+                if (group & 0x80) {
+                    if (in >= in_end) [[unlikely]] {
+                        return make_error<void>("SZS", "Unexpected end of compressed data");
+                    }
+                    *out++ = *in++;
+                    continue;
+                }
+
+                const size_t chunk_size = (in_end - in >= 1 && (in[0] >> 4) == 0) ? 3 : 2;
+                if (in_end - in < static_cast<ptrdiff_t>(chunk_size)) [[unlikely]] {
+                    return make_error<void>("SZS", "Unexpected end of compressed data");
+                }
+
+                const size_t distance = (size_t(in[0] & 0xF) << 8 | in[1]) + 1;
+                const size_t length =
+                    std::min<size_t>(ReadChunkLength(in), static_cast<size_t>(out_end - out));
+                in += chunk_size;
+
+                if (distance > static_cast<size_t>(out - out_begin)) [[unlikely]] {
+                    return make_error<void>("SZS", "Back reference precedes the start of data");
+                }
+
+                const u8 *ref = out - distance;
+                if (distance >= length) {
+                    std::memcpy(out, ref, length);
+                    out += length;
+                } else {
+                    // Overlapping references repeat the last `distance` bytes
+                    for (u8 *end = out + length; out < end;) {
+                        *out++ = *ref++;
+                    }
+                }
+            }
+        }
+
+        return {};
+    }
+
+    Result<std::vector<char>> Decompress(std::span<const char> src) {
+        auto size_result = GetDecompressedSize(src);
+        if (!size_result) {
+            return std::unexpected(size_result.error());
+        }
+
+        std::vector<char> out(size_result.value());
+        auto result = DecompressInto(src, out);
+        if (!result) {
+            return std::unexpected(result.error());
+        }
+        return out;
+    }
+
+    std::vector<char> Compress(std::span<const char> src, size_t thread_count) {
+        if (thread_count == 0) {
+            thread_count = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+        }
+
+        const size_t window_count =
+            std::max<size_t>((src.size() + c_parallel_window_size - 1) / c_parallel_window_size, 1);
+        thread_count = std::min(thread_count, window_count);
+
+        if (thread_count == 1) {
+            std::vector<char> out(GetMaxCompressedSize(src.size()));
+            std::vector<u8> work(CompressorFast::getRequiredMemorySize());
+            out.resize(CompressorFast::encode(reinterpret_cast<u8 *>(out.data()),
+                                              reinterpret_cast<const u8 *>(src.data()),
+                                              static_cast<u32>(src.size()), work.data()));
+            return out;
+        }
+
+        std::vector<std::vector<char>> windows(window_count);
+        std::atomic<size_t> next_window = 0;
+
+        auto encode_windows = [&]() {
+            std::vector<u8> work(CompressorFast::getRequiredMemorySize());
+            for (size_t i = next_window++; i < window_count; i = next_window++) {
+                const size_t start = i * c_parallel_window_size;
+                const size_t size  = std::min(c_parallel_window_size, src.size() - start);
+
+                std::vector<char> &encoded = windows[i];
+                encoded.resize(GetMaxCompressedSize(size));
+                encoded.resize(CompressorFast::encode(reinterpret_cast<u8 *>(encoded.data()),
+                                                      reinterpret_cast<const u8 *>(src.data()) +
+                                                          start,
+                                                      static_cast<u32>(size), work.data()));
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (size_t i = 1; i < thread_count; ++i) {
+            threads.push_back(std::thread(encode_windows));
+        }
+        encode_windows();
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        size_t total_size = c_header_size;
+        for (auto &encoded : windows) {
+            total_size += encoded.size();
+        }
+
+        std::vector<char> out;
+        out.reserve(total_size);
+        WriteHeader(out, static_cast<u32>(src.size()));
+
+        GroupWriter writer(out);
+        for (size_t i = 0; i < window_count; ++i) {
+            const size_t start = i * c_parallel_window_size;
+            writer.appendWindow(windows[i], std::min(c_parallel_window_size, src.size() - start));
+        }
+
+        return out;
+    }
+
+    u32 CompressorFast::getRequiredMemorySize() { return cWorkSize0 + cWorkSize1 + cWorkSize2; }
+
+    bool CompressorFast::search(Match &match, s32 pos, const Context &context) {
+        const u8 *cmp2 = context.p_buffer + context._4;
+
+        s32 v0 = context._4 > 0x1000 ? s32(context._4 - 0x1000) : -1;
+
+        s32 cmp_pos = 2;
+        match.len   = cmp_pos;
+
+        if (context._4 - pos <= 0x1000) {
+            for (u32 i = 0; i < 0x1000; i++) {
+                const u8 *cmp1 = context.p_buffer + pos;
+                if (cmp1[0] == cmp2[0] && cmp1[1] == cmp2[1] && cmp1[cmp_pos] == cmp2[cmp_pos]) {
+                    s32 len;
+
+                    for (len = 2; len < 0x111; len++)
+                        if (cmp1[len] != cmp2[len])
+                            break;
+
+                    if (len > cmp_pos) {
+                        match.len = len;
+                        match.pos = cmp2 - cmp1;
+
+                        cmp_pos = context.buffer_size;
+                        if (len <= cmp_pos)
+                            cmp_pos = match.len;
+                        else
+                            match.len = cmp_pos;
+
+                        if (len >= 0x111)
+                            break;
+                    }
+                }
+
+                pos = context.p_work_2[pos & 0xfff];
+                if (pos <= v0)
+                    break;
+            }
+
+            if (cmp_pos >= 3)
+                return true;
+        }
+
+        return false;
+    }
+
+    u32 CompressorFast::encode(u8 *p_dst, const u8 *p_src, u32 src_size, u8 *p_work) {
+        u8 temp_buffer[24];
+        u32 temp_size = 0;
+
+        s32 pos = -1;
+        s32 v1  = 0;
+        s32 bit = 8;
+
+        Context context;
+
+        context.p_buffer = p_work;
+
+        context.p_work_1 = (s32 *)(p_work + cWorkSize0);
+        memset(context.p_work_1, u8(-1), cWorkSize1);
+
+        context.p_work_2 = (s32 *)(p_work + (cWorkSize0 + cWorkSize1));
+        memset(context.p_work_2, u8(-1), cWorkSize2);
+
+        context._4 = 0;
+
+        u32 out_size = 0x10;  // Header size
+        u32 flag     = 0;
+
+        memcpy(p_dst, "Yaz0", 4);
+        p_dst[4] = (src_size >> 24) & 0xff;
+        p_dst[5] = (src_size >> 16) & 0xff;
+        p_dst[6] = (src_size >> 8) & 0xff;
+        p_dst[7] = (src_size >> 0) & 0xff;
+        memset(p_dst + 8, 0, 0x10);  // They probably meant to put 8 in the size here?
+
+        PosIndex v2;
+
+        context.buffer_size = seadMathMin<u32>(cWorkSize0, src_size);
+        memcpy(context.p_buffer, p_src, context.buffer_size);
+
+        v2.pushBack(context.p_buffer[0]);
+        v2.pushBack(context.p_buffer[1]);
+
+        Match match, next_match;
+        match.len = 2;
+
+        s32 buffer_size_0 = context.buffer_size;
+        s32 buffer_size_1;
+
+        while (context.buffer_size > 0) {
+            while (true) {
+                if (v1 == 0) {
+                    v2.pushBack(context.p_buffer[context._4 + 2]);
+
+                    context.p_work_2[context._4 & 0xfff] = context.p_work_1[v2.value()];
+                    context.p_work_1[v2.value()]         = context._4;
+
+                    pos = context.p_work_2[context._4 & 0xfff];
+                } else {
+                    v1 = 0;
+                }
+
+                if (pos != -1) {
+                    search(match, pos, context);
+                    if (2 < match.len && match.len < 0x111) {
+                        context._4++;
+                        context.buffer_size--;
+
+                        v2.pushBack(context.p_buffer[context._4 + 2]);
+
+                        context.p_work_2[context._4 & 0xfff] = context.p_work_1[v2.value()];
+                        context.p_work_1[v2.value()]         = context._4;
+
+                        pos = context.p_work_2[context._4 & 0xfff];
+                        search(next_match, pos, context);
+                        if (match.len < next_match.len)
+                            match.len = 2;
+
+                        v1 = 1;
+                    }
+                }
+
+                if (match.len > 2) {
+                    flag = (flag & 0x7f) << 1;
+
+                    u8 low  = match.pos - 1;
+                    u8 high = (match.pos - 1) >> 8;
+
+                    if (match.len < 18) {
+                        temp_buffer[temp_size++] = u8((match.len - 2) << 4) | high;
+                        temp_buffer[temp_size++] = low;
+                    } else {
+                        temp_buffer[temp_size++] = high;
+                        temp_buffer[temp_size++] = low;
+                        temp_buffer[temp_size++] = u8(match.len) - 18;
+                    }
+
+                    context.buffer_size -= match.len - v1;
+                    match.len -= v1 + 1;
+
+                    do {
+                        context._4++;
+
+                        v2.pushBack(context.p_buffer[context._4 + 2]);
+
+                        context.p_work_2[context._4 & 0xfff] = context.p_work_1[v2.value()];
+                        context.p_work_1[v2.value()]         = context._4;
+
+                        pos = context.p_work_2[context._4 & 0xfff];
+                    } while (--match.len != 0);
+
+                    context._4++;
+                    v1        = 0;
+                    match.len = 0;
+                } else {
+                    flag = (flag & 0x7f) << 1 | 1;
+
+                    temp_buffer[temp_size++] = context.p_buffer[context._4 - v1];
+
+                    if (v1 == 0) {
+                        context._4++;
+                        context.buffer_size--;
+                    }
+                }
+
+                if (--bit == 0) {
+                    p_dst[out_size++] = flag;
+
+                    memcpy(p_dst + out_size, temp_buffer, temp_size);
+                    out_size += temp_size;
+
+                    flag      = 0;
+                    temp_size = 0;
+                    bit       = 8;
+                }
+
+                if (context.buffer_size < 0x111 + 2)
+                    break;
+            }
+
+            s32 v3 = context._4 - 0x1000;
+            s32 v4 = cWorkSize0 - v3;
+
+            buffer_size_1 = buffer_size_0;
+
+            if (context._4 >= 0x1000 + 14 * 0x111) {
+                memcpy(context.p_buffer, context.p_buffer + v3, v4);
+
+                s32 v5        = cWorkSize0 - v4;
+                buffer_size_1 = buffer_size_0 + v5;
+                if (src_size < u32(buffer_size_1)) {
+                    v5            = src_size - buffer_size_0;
+                    buffer_size_1 = src_size;
+                }
+                memcpy(context.p_buffer + v4, p_src + buffer_size_0, v5);
+                context.buffer_size += v5;
+                context._4 -= v3;
+
+                for (u32 i = 0; i < cWorkNum1; i++)
+                    context.p_work_1[i] = context.p_work_1[i] >= v3 ? context.p_work_1[i] - v3 : -1;
+
+                for (u32 i = 0; i < cWorkNum2; i++)
+                    context.p_work_2[i] = context.p_work_2[i] >= v3 ? context.p_work_2[i] - v3 : -1;
+            }
+            buffer_size_0 = buffer_size_1;
+        }
+
+        p_dst[out_size++] = flag << (bit & 0x3f);
+
+        memcpy(p_dst + out_size, temp_buffer, temp_size);
+        out_size += temp_size;
+
+        return out_size;
+    }
+
+}  // namespace Toolbox::SZS
\ No newline at end of file
@@ -0,0 +1,149 @@
+#include <cstdio>
+#include <limits>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "gui/scene/bvh.hpp"
+#include "testing.hpp"
+
+// Casts 2000 picking rays into 10000 boxes scattered over a stage, through
+// the BVH and by testing every box as findSelection used to. Then drags a
+// tenth of the boxes a short way, refits their leaves and checks the picks
+// again. Both must find the same nearest box for every ray.
+
+using namespace Toolbox;
+using namespace Toolbox::UI;
+using namespace Toolbox::Test;
+
+namespace {
+
+    constexpr size_t c_box_count = 10000;
+    constexpr size_t c_ray_count = 2000;
+    constexpr float c_stage_size = 20000.0f;
+
+    struct Ray {
+        glm::vec3 m_origin;
+        glm::vec3 m_direction;
+    };
+
+    BVHBounds MakeBox(std::mt19937 &rng) {
+        std::uniform_real_distribution<float> position(-c_stage_size, c_stage_size);
+        std::uniform_real_distribution<float> extent(20.0f, 400.0f);
+
+        glm::mat4x4 transform = glm::mat4x4(1.0f);
+        transform[3] = glm::vec4(position(rng), position(rng) * 0.1f, position(rng), 1.0f);
+
+        const glm::vec3 half = glm::vec3(extent(rng), extent(rng), extent(rng));
+        return BVHBounds::FromBox(-half, half, transform);
+    }
+
+    // From a camera above the stage, down through a random point on it
+    std::vector<Ray> MakeRays(std::mt19937 &rng) {
+        std::uniform_real_distribution<float> position(-c_stage_size, c_stage_size);
+
+        std::vector<Ray> rays;
+        for (size_t i = 0; i < c_ray_count; ++i) {
+            const glm::vec3 origin = glm::vec3(0.0f, 8000.0f, -c_stage_size * 1.5f);
+            const glm::vec3 target = glm::vec3(position(rng), 0.0f, position(rng));
+            rays.push_back({origin, glm::normalize(target - origin)});
+        }
+        return rays;
+    }
+
+    std::optional<size_t> PickLinear(const std::vector<BVHBounds> &boxes, const Ray &ray) {
+        const glm::vec3 inv_direction = 1.0f / ray.m_direction;
+
+        std::optional<size_t> nearest;
+        float nearest_distance = std::numeric_limits<float>::max();
+        for (size_t i = 0; i < boxes.size(); ++i) {
+            float distance;
+            if (boxes[i].intersectRay(ray.m_origin, inv_direction, nearest_distance, distance) &&
+                distance < nearest_distance) {
+                nearest          = i;
+                nearest_distance = distance;
+            }
+        }
+        return nearest;
+    }
+
+    std::optional<size_t> PickBVH(const BoundingVolumeHierarchy &bvh,
+                                  const std::vector<BVHBounds> &boxes, const Ray &ray) {
+        const glm::vec3 inv_direction = 1.0f / ray.m_direction;
+
+        float distance = std::numeric_limits<float>::max();
+        return bvh.raycast(
+            ray.m_origin, ray.m_direction,
+            [&](size_t item, float &item_distance) {
+                return boxes[item].intersectRay(ray.m_origin, inv_direction,
+                                                std::numeric_limits<float>::max(), item_distance);
+            },
+            distance);
+    }
+
+    void Measure(const char *name, const BoundingVolumeHierarchy &bvh,
+                 const std::vector<BVHBounds> &boxes, const std::vector<Ray> &rays) {
+        std::vector<std::optional<size_t>> linear_picks(rays.size());
+        std::vector<std::optional<size_t>> bvh_picks(rays.size());
+
+        double linear_ms = TimeMilliseconds([&]() {
+            for (size_t i = 0; i < rays.size(); ++i) {
+                linear_picks[i] = PickLinear(boxes, rays[i]);
+            }
+        });
+        double bvh_ms = TimeMilliseconds([&]() {
+            for (size_t i = 0; i < rays.size(); ++i) {
+                bvh_picks[i] = PickBVH(bvh, boxes, rays[i]);
+            }
+        });
+
+        Report(name, linear_ms, bvh_ms);
+
+        size_t hits       = 0;
+        size_t mismatches = 0;
+        for (size_t i = 0; i < rays.size(); ++i) {
+            hits += linear_picks[i].has_value();
+            mismatches += linear_picks[i] != bvh_picks[i];
+        }
+        std::printf("%-40s %zu of %zu\n", "rays hitting a box", hits, rays.size());
+
+        TOOLBOX_CHECK(hits > 0);
+        TOOLBOX_CHECK(mismatches == 0);
+        TOOLBOX_CHECK(bvh_ms < linear_ms);
+    }
+
+}  // namespace
+
+int main() {
+    std::mt19937 rng(0xB0C5);
+
+    std::vector<BVHBounds> boxes;
+    for (size_t i = 0; i < c_box_count; ++i) {
+        boxes.push_back(MakeBox(rng));
+    }
+    const std::vector<Ray> rays = MakeRays(rng);
+
+    BoundingVolumeHierarchy bvh;
+    double build_ms = TimeMilliseconds([&]() { bvh.build(boxes); });
+    std::printf("%-40s %10.3f ms\n", "build, 10000 boxes", build_ms);
+    TOOLBOX_CHECK(bvh.size() == c_box_count);
+
+    Measure("2000 picks, 10000 boxes", bvh, boxes, rays);
+
+    std::uniform_real_distribution<float> nudge(-500.0f, 500.0f);
+    double refit_ms = TimeMilliseconds(
+        [&]() {
+            for (size_t i = 0; i < c_box_count; i += 10) {
+                const glm::vec3 offset = glm::vec3(nudge(rng), nudge(rng), nudge(rng));
+                boxes[i].m_min += offset;
+                boxes[i].m_max += offset;
+                bvh.refit(i, boxes[i]);
+            }
+        },
+        1);
+    std::printf("%-40s %10.3f ms\n", "refit 1000 dragged boxes", refit_ms);
+
+    Measure("2000 picks after refitting", bvh, boxes, rays);
+
+    return Finish();
+}
@@ -0,0 +1,186 @@
+#include <cstdio>
+#include <cstring>
+#include <format>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "dolphin/sharedmem.hpp"
+#include "dolphin_standin.hpp"
+#include "testing.hpp"
+
+// Hooks the memory of a dolphin_standin process in each of its modes. The
+// segment is read through whatever OpenProcessMemory settles on, and
+// through a process_vm handle, and a write through either must be seen by
+// the other.
+
+using namespace Toolbox;
+using namespace Toolbox::Dolphin;
+using namespace Toolbox::Test;
+
+namespace {
+
+    struct Standin {
+        pid_t m_pid  = -1;
+        int m_stdin  = -1;
+        int m_stdout = -1;
+    };
+
+    bool StartStandin(const char *standin_path, const char *mode, Standin &standin) {
+        int in_pipe[2], out_pipe[2];
+        if (pipe(in_pipe) == -1 || pipe(out_pipe) == -1) {
+            return false;
+        }
+
+        pid_t pid = fork();
+        if (pid == 0) {
+            dup2(in_pipe[0], STDIN_FILENO);
+            dup2(out_pipe[1], STDOUT_FILENO);
+            close(in_pipe[1]);
+            close(out_pipe[0]);
+            execl(standin_path, standin_path, mode, nullptr);
+            _exit(127);
+        }
+
+        close(in_pipe[0]);
+        close(out_pipe[1]);
+        standin = {pid, in_pipe[1], out_pipe[0]};
+        if (pid == -1) {
+            return false;
+        }
+
+        char ready[6] = {};
+        size_t got    = 0;
+        while (got < 6) {
+            ssize_t n = read(standin.m_stdout, ready + got, 6 - got);
+            if (n <= 0) {
+                return false;
+            }
+            got += static_cast<size_t>(n);
+        }
+        return std::memcmp(ready, "ready\n", 6) == 0;
+    }
+
+    int StopStandin(Standin &standin) {
+        close(standin.m_stdin);
+        close(standin.m_stdout);
+
+        int status = 0;
+        waitpid(standin.m_pid, &status, 0);
+        return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    }
+
+    // Reads through the view when there is one, through process_vm otherwise
+    Result<void> ReadMemory(Platform::LowHandle handle, void *view, u32 address, char *buf,
+                            u32 size) {
+        if (view) {
+            std::memcpy(buf, static_cast<char *>(view) + (address & 0x7FFFFFFF), size);
+            return {};
+        }
+        MemorySpan span = {address, size, buf};
+        return TransferProcessSpans(handle, {}, {&span, 1});
+    }
+
+    Result<void> WriteMemory(Platform::LowHandle handle, void *view, u32 address,
+                             const char *buf, u32 size) {
+        if (view) {
+            std::memcpy(static_cast<char *>(view) + (address & 0x7FFFFFFF), buf, size);
+            return {};
+        }
+        MemorySpan span = {address, size, const_cast<char *>(buf)};
+        return TransferProcessSpans(handle, {&span, 1}, {});
+    }
+
+    void TestMode(const char *standin_path, const char *mode) {
+        std::printf("standin mode: %s\n", mode);
+
+        Standin standin;
+        if (!TOOLBOX_CHECK(StartStandin(standin_path, mode, standin))) {
+            if (standin.m_pid > 0) {
+                StopStandin(standin);
+            }
+            return;
+        }
+
+        auto pid_result = FindProcessPID("dolphin_standin");
+        TOOLBOX_CHECK(pid_result && pid_result.value() == standin.m_pid);
+
+        const std::string memory_name = std::format("dolphin-emu.{}", standin.m_pid);
+
+        auto handle_result = OpenProcessMemory(standin.m_pid, memory_name);
+        auto remote_result = OpenRemoteProcessMemory(standin.m_pid, memory_name);
+        if (TOOLBOX_CHECK(handle_result) && TOOLBOX_CHECK(remote_result)) {
+            Platform::LowHandle handle = handle_result.value();
+            Platform::LowHandle remote = remote_result.value();
+
+            auto view_result = OpenMemoryView(handle);
+            TOOLBOX_CHECK(view_result);
+            void *view = view_result ? view_result.value() : nullptr;
+            std::printf("  opened %s\n", view ? "a mapped view" : "through process_vm");
+
+            // The whole segment through the hook
+            std::vector<char> memory(c_standin_memory_size);
+            TOOLBOX_CHECK(ReadMemory(handle, view, 0x80000000, memory.data(),
+                                     static_cast<u32>(memory.size())));
+            size_t mismatches = 0;
+            for (size_t i = 0; i < memory.size(); ++i) {
+                mismatches += static_cast<u8>(memory[i]) != StandinPattern(i);
+            }
+            TOOLBOX_CHECK(mismatches == 0);
+
+            // Scattered words through process_vm, more than IOV_MAX of them
+            // so the transfer is split into batches
+            constexpr size_t span_count = 3000;
+            std::vector<u32> words(span_count);
+            std::vector<MemorySpan> spans(span_count);
+            for (size_t i = 0; i < span_count; ++i) {
+                spans[i] = {static_cast<u32>(0x80000000 + i * 0x1000 + (i & 0xFF) * 4), 4,
+                            reinterpret_cast<char *>(&words[i])};
+            }
+            TOOLBOX_CHECK(TransferProcessSpans(remote, {}, spans));
+            mismatches = 0;
+            for (size_t i = 0; i < span_count; ++i) {
+                const size_t offset = spans[i].m_address & 0x7FFFFFFF;
+                mismatches += std::memcmp(&words[i], memory.data() + offset, 4) != 0;
+            }
+            TOOLBOX_CHECK(mismatches == 0);
+
+            // A write through one handle is seen through the other
+            const char hook_bytes[]   = "TOOLBOX";
+            const char remote_bytes[] = "STANDIN";
+            char read_back[8]         = {};
+
+            TOOLBOX_CHECK(WriteMemory(handle, view, 0x80001000, hook_bytes, 8));
+            MemorySpan read_span = {0x80001000, 8, read_back};
+            TOOLBOX_CHECK(TransferProcessSpans(remote, {}, {&read_span, 1}));
+            TOOLBOX_CHECK(std::memcmp(read_back, hook_bytes, 8) == 0);
+
+            MemorySpan write_span = {0x80002000, 8, const_cast<char *>(remote_bytes)};
+            TOOLBOX_CHECK(TransferProcessSpans(remote, {&write_span, 1}, {}));
+            TOOLBOX_CHECK(ReadMemory(handle, view, 0x80002000, read_back, 8));
+            TOOLBOX_CHECK(std::memcmp(read_back, remote_bytes, 8) == 0);
+
+            TOOLBOX_CHECK(CloseMemoryView(handle, view));
+            TOOLBOX_CHECK(CloseProcessMemory(handle));
+            TOOLBOX_CHECK(CloseProcessMemory(remote));
+        }
+
+        TOOLBOX_CHECK(StopStandin(standin) == 0);
+    }
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <path to dolphin_standin>\n", argv[0]);
+        return 2;
+    }
+
+    for (const char *mode : {"unlinked", "named", "mapped"}) {
+        TestMode(argv[1], mode);
+    }
+
+    return Finish();
+}
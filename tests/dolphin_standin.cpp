@@ -0,0 +1,81 @@
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <unistd.h>
+
+#include "dolphin_standin.hpp"
+
+// Stands in for Dolphin in the hook test. It creates the emulated memory
+// segment the way Dolphin does, fills it with a known pattern, reports
+// "ready" on stdout and keeps the segment alive until stdin is closed.
+//
+//   unlinked  the name is removed but the descriptor stays open, which
+//             is what Dolphin does
+//   named     the name stays linked, as in older Dolphin builds
+//   mapped    the descriptor is closed too, only the mapping is left
+
+using namespace Toolbox::Test;
+
+int main(int argc, char **argv) {
+    const std::string mode = argc > 1 ? argv[1] : "unlinked";
+    if (mode != "unlinked" && mode != "named" && mode != "mapped") {
+        std::fprintf(stderr, "usage: %s [unlinked|named|mapped]\n", argv[0]);
+        return 2;
+    }
+
+    // Don't outlive a test that crashed
+    prctl(PR_SET_PDEATHSIG, SIGTERM);
+
+    char name[64];
+    std::snprintf(name, sizeof(name), "/dolphin-emu.%d", static_cast<int>(getpid()));
+
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd == -1) {
+        std::perror("shm_open");
+        return 1;
+    }
+
+    if (ftruncate(fd, c_standin_memory_size) == -1) {
+        std::perror("ftruncate");
+        shm_unlink(name);
+        return 1;
+    }
+
+    void *memory =
+        mmap(nullptr, c_standin_memory_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (memory == MAP_FAILED) {
+        std::perror("mmap");
+        shm_unlink(name);
+        return 1;
+    }
+
+    uint8_t *bytes = static_cast<uint8_t *>(memory);
+    for (size_t i = 0; i < c_standin_memory_size; ++i) {
+        bytes[i] = StandinPattern(i);
+    }
+
+    if (mode != "named") {
+        shm_unlink(name);
+    }
+    if (mode == "mapped") {
+        close(fd);
+    }
+
+    std::printf("ready\n");
+    std::fflush(stdout);
+
+    char c;
+    while (read(STDIN_FILENO, &c, 1) > 0) {
+    }
+
+    if (mode == "named") {
+        shm_unlink(name);
+    }
+    munmap(memory, c_standin_memory_size);
+    return 0;
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Toolbox::Test {
+
+    // Same size as the MEM1 region the hook maps
+    constexpr size_t c_standin_memory_size = 0x1800000;
+
+    // The byte the stand-in writes at each offset of its segment
+    constexpr uint8_t StandinPattern(size_t offset) {
+        return static_cast<uint8_t>((offset * 31) ^ (offset >> 9));
+    }
+
+}  // namespace Toolbox::Test
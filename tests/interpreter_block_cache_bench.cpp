@@ -0,0 +1,108 @@
+#include <bit>
+#include <cstdio>
+#include <vector>
+
+#include "dolphin/interpreter/system.hpp"
+#include "testing.hpp"
+
+// Reports instructions per second for a loop-heavy guest function, with
+// the decoded block cache and with every instruction fetched and decoded
+// as it runs. The function is called repeatedly like the game functions
+// the tools call, so the cache is warm after the first call.
+
+using namespace Toolbox;
+using namespace Toolbox::Interpreter;
+using namespace Toolbox::Test;
+
+namespace {
+
+    constexpr u32 c_function_ptr = 0x80100000;
+    constexpr u32 c_array_ptr    = 0x80400000;
+    constexpr u32 c_stack_ptr    = 0x81000000;
+    constexpr u32 c_array_length = 100000;
+    constexpr int c_call_count   = 10;
+
+    // Instructions one call runs, see the code below
+    constexpr double c_call_instructions = 4.0 + 4.0 * c_array_length;
+
+    void WriteWord(SystemDolphin &interpreter, u32 address, u32 value) {
+        interpreter.write<u32>(address, value);
+    }
+
+    void LoadProgram(SystemDolphin &interpreter) {
+        interpreter.getMemoryStorage().initialize(0x1800000);
+
+        // r3: word count, r4: words, returns their sum
+        const u32 code[] = {
+            0x38A00000,  //       li    r5, 0
+            0x7C6903A6,  //       mtctr r3
+            0x80C40000,  // loop: lwz   r6, 0(r4)
+            0x7CA53214,  //       add   r5, r5, r6
+            0x38840004,  //       addi  r4, r4, 4
+            0x4200FFF4,  //       bdnz  loop
+            0x7CA32B78,  //       mr    r3, r5
+            0x4E800020,  //       blr
+        };
+        for (size_t i = 0; i < std::size(code); ++i) {
+            WriteWord(interpreter, c_function_ptr + static_cast<u32>(i * 4), code[i]);
+        }
+
+        for (u32 i = 0; i < c_array_length; ++i) {
+            WriteWord(interpreter, c_array_ptr + i * 4, i);
+        }
+    }
+
+    u32 Sum(SystemDolphin &interpreter) {
+        interpreter.setStackPointer(c_stack_ptr);
+        u32 argv[2]   = {c_array_length, c_array_ptr};
+        auto snapshot = interpreter.evaluateFunction(c_function_ptr, 2, argv, 0, nullptr);
+        return static_cast<u32>(snapshot.m_gpr[3]);
+    }
+
+    double RunCalls(SystemDolphin &interpreter, std::vector<u32> &results) {
+        results.clear();
+        return TimeMilliseconds(
+            [&]() {
+                for (int i = 0; i < c_call_count; ++i) {
+                    results.push_back(Sum(interpreter));
+                }
+            },
+            3);
+    }
+
+    double InstructionsPerSecond(double milliseconds) {
+        return c_call_instructions * c_call_count / (milliseconds / 1000.0);
+    }
+
+}  // namespace
+
+int main() {
+    SystemDolphin interpreter;
+    LoadProgram(interpreter);
+
+    std::vector<u32> uncached_results;
+    std::vector<u32> cached_results;
+
+    interpreter.setBlockCacheEnabled(false);
+    double uncached_ms = RunCalls(interpreter, uncached_results);
+
+    interpreter.setBlockCacheEnabled(true);
+    double cached_ms = RunCalls(interpreter, cached_results);
+
+    Report("10 calls of a 100k iteration loop", uncached_ms, cached_ms);
+    std::printf("%-40s old %10.2f M/s  new %10.2f M/s\n", "instructions per second",
+                InstructionsPerSecond(uncached_ms) / 1e6, InstructionsPerSecond(cached_ms) / 1e6);
+
+    const u32 expected_sum = static_cast<u32>(u64(c_array_length) * (c_array_length - 1) / 2);
+    TOOLBOX_CHECK(uncached_results.size() == cached_results.size());
+    for (size_t i = 0; i < cached_results.size(); ++i) {
+        TOOLBOX_CHECK(uncached_results[i] == expected_sum);
+        TOOLBOX_CHECK(cached_results[i] == expected_sum);
+    }
+
+    // The loop body is one block, so everything after the first call hits
+    TOOLBOX_CHECK(interpreter.getBlockCacheMisses() <= 3);
+    TOOLBOX_CHECK(cached_ms < uncached_ms);
+
+    return Finish();
+}
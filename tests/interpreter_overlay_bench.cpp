@@ -0,0 +1,125 @@
+#include <bit>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "core/memory.hpp"
+#include "dolphin/interpreter/system.hpp"
+#include "testing.hpp"
+
+// Times 1000 getActorPtr style lookups against a synthetic 24 MiB memory
+// image. Each lookup gets a fresh interpreter, as TaskCommunicator creates
+// one per call, and runs a guest function that walks a linked list of
+// actors for a key. The old path copied the whole image into a private
+// buffer first, the overlay only builds page tables and privatizes the
+// pages the function writes.
+
+using namespace Toolbox;
+using namespace Toolbox::Interpreter;
+using namespace Toolbox::Test;
+
+namespace {
+
+    constexpr size_t c_memory_size  = 0x1800000;
+    constexpr u32 c_function_ptr    = 0x80100000;
+    constexpr u32 c_actor_list      = 0x80400000;
+    constexpr u32 c_stack_ptr       = 0x81000000;
+    constexpr u32 c_actor_count     = 1000;
+    constexpr u32 c_actor_node_size = 16;
+
+    void WriteWord(std::vector<u8> &image, u32 address, u32 value) {
+        u32 swapped = std::byteswap(value);
+        std::memcpy(image.data() + (address - 0x80000000), &swapped, sizeof(u32));
+    }
+
+    std::vector<u8> BuildImage() {
+        std::vector<u8> image(c_memory_size);
+
+        // Fill the rest so untouched pages aren't trivially zero
+        for (size_t i = 0; i < image.size(); ++i) {
+            image[i] = static_cast<u8>(i * 131);
+        }
+
+        // r3: list head, r4: key, returns the node holding the key or 0
+        const u32 code[] = {
+            0x9421FFF0,  // stwu  r1, -16(r1)
+            0x2C030000,  // loop: cmpwi r3, 0
+            0x41820018,  //       beq   done
+            0x80A30004,  //       lwz   r5, 4(r3)
+            0x7C052000,  //       cmpw  r5, r4
+            0x4182000C,  //       beq   done
+            0x80630000,  //       lwz   r3, 0(r3)
+            0x4BFFFFE8,  //       b     loop
+            0x38210010,  // done: addi  r1, r1, 16
+            0x4E800020,  //       blr
+        };
+        for (size_t i = 0; i < std::size(code); ++i) {
+            WriteWord(image, c_function_ptr + static_cast<u32>(i * 4), code[i]);
+        }
+
+        for (u32 i = 0; i < c_actor_count; ++i) {
+            u32 node = c_actor_list + i * c_actor_node_size;
+            u32 next = i + 1 < c_actor_count ? node + c_actor_node_size : 0;
+            WriteWord(image, node, next);
+            WriteWord(image, node + 4, 0x1000 + i);
+        }
+
+        return image;
+    }
+
+    u32 Lookup(SystemDolphin &interpreter, u32 key) {
+        interpreter.setStackPointer(c_stack_ptr);
+        u32 argv[2]   = {c_actor_list, key};
+        auto snapshot = interpreter.evaluateFunction(c_function_ptr, 2, argv, 0, nullptr);
+        return static_cast<u32>(snapshot.m_gpr[3]);
+    }
+
+}  // namespace
+
+int main() {
+    const std::vector<u8> image = BuildImage();
+
+    std::vector<u32> copied_results(c_actor_count);
+    std::vector<u32> overlay_results(c_actor_count);
+
+    double copy_ms = TimeMilliseconds(
+        [&]() {
+            for (u32 i = 0; i < c_actor_count; ++i) {
+                Buffer snapshot;
+                snapshot.alloc(image.size());
+                std::memcpy(snapshot.buf<u8>(), image.data(), image.size());
+
+                SystemDolphin interpreter;
+                interpreter.setMemoryBuffer(snapshot.buf<u8>(), snapshot.size());
+                copied_results[i] = Lookup(interpreter, 0x1000 + i);
+            }
+        },
+        3);
+
+    size_t private_pages = 0;
+    double overlay_ms    = TimeMilliseconds(
+        [&]() {
+            for (u32 i = 0; i < c_actor_count; ++i) {
+                SystemDolphin interpreter;
+                interpreter.applyMemory(image.data(), image.size());
+                overlay_results[i] = Lookup(interpreter, 0x1000 + i);
+                private_pages      = interpreter.getMemoryStorage().privatePageCount();
+            }
+        },
+        3);
+
+    Report("1000 getActorPtr lookups (24 MiB)", copy_ms, overlay_ms);
+    std::printf("%-40s %zu of %zu pages\n", "pages privatized per lookup", private_pages,
+                c_memory_size / MemoryStorage::c_page_size);
+
+    for (u32 i = 0; i < c_actor_count; ++i) {
+        TOOLBOX_CHECK(overlay_results[i] == c_actor_list + i * c_actor_node_size);
+        TOOLBOX_CHECK(overlay_results[i] == copied_results[i]);
+    }
+
+    // The stack frame is the only write
+    TOOLBOX_CHECK(private_pages == 1);
+    TOOLBOX_CHECK(overlay_ms < copy_ms);
+
+    return Finish();
+}
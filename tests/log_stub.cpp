@@ -0,0 +1,24 @@
+#include <cstdio>
+
+#include "core/log.hpp"
+
+// The app logger reads the GUI settings, so tests link this instead. It
+// prints every message straight away, as nothing ever flushes.
+
+namespace Toolbox::Log {
+
+    AppLogger::AppLogger() {}
+
+    AppLogger &AppLogger::instance() {
+        static AppLogger s_logger;
+        return s_logger;
+    }
+
+    void AppLogger::log(ReportLevel level, const std::string &message) {
+        std::fprintf(level == ReportLevel::REPORT_ERROR ? stderr : stdout, "%s\n",
+                     message.c_str());
+    }
+
+    void AppLogger::flush() {}
+
+}  // namespace Toolbox::Log
@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <future>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/threadpool.hpp"
+#include "rail/node.hpp"
+#include "rail/rail.hpp"
+#include "testing.hpp"
+
+// Connects every node of large synthetic rails to its nearest nodes, once
+// through the k-d tree and once by sorting every other node by distance
+// for each node, as connectNodeToNearest used to. Both must pick nodes at
+// the same distances. The batch is also run from a pool worker, which has
+// to finish without waiting on the pool.
+
+using namespace Toolbox;
+using namespace Toolbox::Test;
+
+namespace {
+
+    constexpr size_t c_connection_count = 4;
+
+    Rail::Rail MakeRail(size_t node_count) {
+        std::mt19937 rng(static_cast<u32>(node_count));
+        std::uniform_int_distribution<int> position(-30000, 30000);
+
+        Rail::Rail rail("rail_" + std::to_string(node_count));
+        for (size_t i = 0; i < node_count; ++i) {
+            rail.addNode(make_referable<Rail::RailNode>(static_cast<s16>(position(rng)),
+                                                        static_cast<s16>(position(rng) / 10),
+                                                        static_cast<s16>(position(rng))));
+        }
+        return rail;
+    }
+
+    // Distances of the nodes each node was connected to, nearest first
+    std::vector<std::vector<f32>> ConnectedDistances(const Rail::Rail &rail) {
+        std::vector<std::vector<f32>> distances;
+        for (const Rail::Rail::node_ptr_t &node : rail.nodes()) {
+            std::vector<f32> &node_distances = distances.emplace_back();
+            for (u16 i = 0; i < node->getConnectionCount(); ++i) {
+                node_distances.push_back(node->getConnectionDistance(i).value_or(-1.0f));
+            }
+        }
+        return distances;
+    }
+
+    std::vector<std::vector<f32>> SortedDistances(const Rail::Rail &rail) {
+        const std::vector<Rail::Rail::node_ptr_t> &nodes = rail.nodes();
+
+        std::vector<std::vector<f32>> distances;
+        for (const Rail::Rail::node_ptr_t &node : nodes) {
+            std::vector<std::pair<f32, size_t>> nearest_nodes;
+            for (size_t i = 0; i < nodes.size(); ++i) {
+                if (nodes[i] == node) {
+                    continue;
+                }
+                nearest_nodes.emplace_back(
+                    glm::distance(node->getPosition(), nodes[i]->getPosition()), i);
+            }
+            std::sort(nearest_nodes.begin(), nearest_nodes.end(),
+                      [](const auto &a, const auto &b) { return a.first < b.first; });
+
+            std::vector<f32> &node_distances = distances.emplace_back();
+            for (size_t i = 0; i < c_connection_count && i < nearest_nodes.size(); ++i) {
+                node_distances.push_back(nearest_nodes[i].first);
+            }
+        }
+        return distances;
+    }
+
+    bool SameDistances(const std::vector<std::vector<f32>> &a,
+                       const std::vector<std::vector<f32>> &b) {
+        if (a.size() != b.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (a[i].size() != b[i].size()) {
+                return false;
+            }
+            for (size_t j = 0; j < a[i].size(); ++j) {
+                if (std::abs(a[i][j] - b[i][j]) > 0.01f) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    void Measure(size_t node_count) {
+        Rail::Rail rail = MakeRail(node_count);
+
+        std::vector<std::vector<f32>> sorted;
+        double sorted_ms = TimeMilliseconds([&]() { sorted = SortedDistances(rail); }, 1);
+
+        double tree_ms = TimeMilliseconds(
+            [&]() { TOOLBOX_CHECK(rail.connectNodesToNearest(c_connection_count)); }, 3);
+
+        Report((std::to_string(node_count) + " nodes, 4 nearest each").c_str(), sorted_ms,
+               tree_ms);
+
+        TOOLBOX_CHECK(SameDistances(ConnectedDistances(rail), sorted));
+        TOOLBOX_CHECK(tree_ms < sorted_ms);
+    }
+
+}  // namespace
+
+int main() {
+    Measure(500);
+    Measure(2000);
+    Measure(4000);
+
+    {
+        Rail::Rail rail = MakeRail(2000);
+
+        std::future<bool> task = ThreadPool::instance().submit(
+            [&]() { return rail.connectNodesToNearest(c_connection_count).has_value(); });
+        if (!TOOLBOX_CHECK(task.wait_for(std::chrono::seconds(30)) ==
+                           std::future_status::ready)) {
+            // The stuck worker still holds the rail, so don't unwind past it
+            std::_Exit(Finish());
+        }
+        TOOLBOX_CHECK(task.get());
+        TOOLBOX_CHECK(SameDistances(ConnectedDistances(rail), SortedDistances(rail)));
+    }
+
+    return Finish();
+}
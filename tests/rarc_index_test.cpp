@@ -0,0 +1,225 @@
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+#include "rarc/rarc.hpp"
+#include "testing.hpp"
+
+// Applies random inserts, removals, replacements and renames to an archive
+// and checks after each one that every node is still found by name, id and
+// path at the same place a full scan finds it. Const lookups are also run
+// from several threads at once, which must not touch the index.
+
+using namespace Toolbox;
+using namespace Toolbox::RARC;
+using namespace Toolbox::Test;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+    void WriteFile(const fs::path &path, std::string_view data) {
+        std::ofstream(path, std::ios::binary).write(data.data(), data.size());
+    }
+
+    // Every folder must end past itself and within its parent
+    bool HasValidSpans(const ResourceArchive &archive) {
+        const std::vector<ResourceArchive::Node> &nodes = archive.getNodes();
+
+        std::vector<size_t> folder_ends = {nodes.size()};
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            while (i >= folder_ends.back()) {
+                folder_ends.pop_back();
+            }
+            if (nodes[i].is_folder()) {
+                const size_t end = static_cast<size_t>(nodes[i].folder.sibling_next);
+                if (end <= i || end > folder_ends.back()) {
+                    return false;
+                }
+                folder_ends.push_back(end);
+            }
+        }
+        return true;
+    }
+
+    std::vector<std::string> NodePaths(const ResourceArchive &archive) {
+        const std::vector<ResourceArchive::Node> &nodes = archive.getNodes();
+
+        std::vector<std::string> paths(nodes.size());
+        std::vector<std::pair<size_t, size_t>> folder_stack;
+        std::string path;
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            while (!folder_stack.empty() && i >= folder_stack.back().first) {
+                path.resize(folder_stack.back().second);
+                folder_stack.pop_back();
+            }
+
+            const size_t prefix_size = path.size();
+            if (!path.empty()) {
+                path += '/';
+            }
+            path += nodes[i].name;
+            paths[i] = path;
+
+            if (nodes[i].is_folder() && static_cast<size_t>(nodes[i].folder.sibling_next) > i + 1) {
+                folder_stack.emplace_back(nodes[i].folder.sibling_next, prefix_size);
+            } else {
+                path.resize(prefix_size);
+            }
+        }
+        return paths;
+    }
+
+    // Compares indexed lookups against a copy whose index is dirty, which
+    // makes its const lookups scan
+    size_t CountIndexMismatches(ResourceArchive &archive) {
+        ResourceArchive scanned = archive;
+        scanned.invalidateIndex();
+        const ResourceArchive &reference = scanned;
+
+        const std::vector<std::string> paths = NodePaths(archive);
+
+        size_t mismatches = 0;
+        for (size_t i = 0; i < paths.size(); ++i) {
+            const ResourceArchive::Node &node = std::as_const(archive).getNodes()[i];
+
+            auto indexed = [&](auto it) { return std::distance(archive.begin(), it); };
+            auto scanned = [&](auto it) { return std::distance(reference.begin(), it); };
+
+            mismatches += indexed(archive.findNode(std::string_view(node.name))) !=
+                          scanned(reference.findNode(std::string_view(node.name)));
+            mismatches += indexed(archive.findNode(node.id)) != scanned(reference.findNode(node.id));
+            mismatches += indexed(archive.findNode(fs::path(paths[i]))) !=
+                          scanned(reference.findNode(fs::path(paths[i])));
+        }
+        return mismatches;
+    }
+
+    void CheckArchive(ResourceArchive &archive, const char *operation) {
+        if (!Check(HasValidSpans(archive), operation, __FILE__, __LINE__)) {
+            return;
+        }
+        Check(CountIndexMismatches(archive) == 0, operation, __FILE__, __LINE__);
+    }
+
+}  // namespace
+
+int main() {
+    const fs::path work_dir =
+        fs::temp_directory_path() / ("toolbox_rarc_index_test." + std::to_string(getpid()));
+    const fs::path root       = work_dir / "scene";
+    const fs::path import_dir = work_dir / "import";
+
+    fs::remove_all(work_dir);
+    fs::create_directories(root / "map" / "map");
+    fs::create_directories(root / "mapobj");
+    fs::create_directories(root / "a" / "b" / "c");
+    fs::create_directories(import_dir / "folder" / "sub");
+
+    for (int i = 0; i < 20; ++i) {
+        WriteFile(root / "mapobj" / ("f" + std::to_string(i) + ".bmd"), "x");
+        WriteFile(root / "a" / "b" / ("g" + std::to_string(i)), "y");
+    }
+    WriteFile(root / "map" / "scene.bin", "S");
+    WriteFile(root / "a" / "b" / "c" / "dup.bmd", "D");
+    WriteFile(root / "a" / "dup.bmd", "D");
+    WriteFile(import_dir / "folder" / "sub" / "k.bin", "K");
+    WriteFile(import_dir / "folder" / "dup.bmd", "Q");
+
+    auto archive_result = ResourceArchive::createFromPath(root);
+    if (!TOOLBOX_CHECK(archive_result)) {
+        fs::remove_all(work_dir);
+        return Finish();
+    }
+
+    ResourceArchive &archive = archive_result.value();
+    CheckArchive(archive, "create");
+
+    std::mt19937 rng(1);
+    for (int step = 0; step < 300; ++step) {
+        const std::vector<ResourceArchive::Node> &nodes = std::as_const(archive).getNodes();
+
+        std::vector<size_t> folders;
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            if (nodes[i].is_folder()) {
+                folders.push_back(i);
+            }
+        }
+        const size_t folder = folders[rng() % folders.size()];
+
+        switch (rng() % 5) {
+        case 0:
+        case 1: {
+            // Duplicate names make later nodes take over index entries
+            const std::string name =
+                rng() % 3 == 0 ? "dup.bmd" : "n" + std::to_string(step) + ".bin";
+            WriteFile(import_dir / name, "z");
+            TOOLBOX_CHECK(archive.importFiles({import_dir / name}, archive.begin() + folder));
+            CheckArchive(archive, "importFiles");
+            break;
+        }
+        case 2:
+            if (nodes.size() > 5) {
+                std::vector<ResourceArchive::Node> victims = {nodes[1 + rng() % (nodes.size() - 1)]};
+                TOOLBOX_CHECK(archive.removeNodes(victims));
+                CheckArchive(archive, "removeNodes");
+            }
+            break;
+        case 3:
+            TOOLBOX_CHECK(
+                archive.createFolder(archive.begin() + folder, "zz" + std::to_string(step)));
+            CheckArchive(archive, "createFolder");
+            break;
+        case 4: {
+            // Renaming through an iterator needs the index invalidated
+            auto node = archive.begin() + 1 + rng() % (nodes.size() - 1);
+            node->name = "renamed" + std::to_string(step);
+            archive.invalidateIndex();
+            CheckArchive(archive, "rename");
+            break;
+        }
+        }
+    }
+
+    {
+        auto folder = archive.findNode(fs::path("scene/a"));
+        if (folder != archive.end()) {
+            TOOLBOX_CHECK(archive.replaceNode(folder, import_dir / "folder"));
+            CheckArchive(archive, "replaceNode");
+        }
+    }
+
+    {
+        // Const lookups on a dirty index scan instead of rebuilding it
+        archive.invalidateIndex();
+        const ResourceArchive &shared = archive;
+        const std::vector<std::string> paths = NodePaths(shared);
+
+        std::vector<std::thread> threads;
+        std::vector<size_t> misses(4, 0);
+        for (size_t t = 0; t < misses.size(); ++t) {
+            threads.emplace_back([&, t]() {
+                for (size_t i = t; i < paths.size(); i += misses.size()) {
+                    misses[t] += shared.findNode(fs::path(paths[i])) == shared.end();
+                    misses[t] += shared.findNode(shared.getNodes()[i].id) == shared.end();
+                }
+            });
+        }
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+
+        for (size_t miss_count : misses) {
+            TOOLBOX_CHECK(miss_count == 0);
+        }
+    }
+
+    fs::remove_all(work_dir);
+    return Finish();
+}
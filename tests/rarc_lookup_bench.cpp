@@ -0,0 +1,134 @@
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+#include "rarc/rarc.hpp"
+#include "testing.hpp"
+
+// Imports a folder of 10000 files into an archive, then times path and id
+// lookups of every tenth file through the index against the scan the
+// archive falls back to while its index is dirty.
+
+using namespace Toolbox;
+using namespace Toolbox::RARC;
+using namespace Toolbox::Test;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+    constexpr int c_folder_count = 100;
+    constexpr int c_file_count   = 100;
+    constexpr int c_lookup_step  = 10;
+
+    std::string FileName(int folder, int file) {
+        return "d" + std::to_string(folder) + "/f" + std::to_string(file) + ".bin";
+    }
+
+}  // namespace
+
+int main() {
+    const fs::path work_dir =
+        fs::temp_directory_path() / ("toolbox_rarc_lookup_bench." + std::to_string(getpid()));
+    const fs::path root       = work_dir / "scene";
+    const fs::path import_dir = work_dir / "import";
+
+    fs::remove_all(work_dir);
+    fs::create_directories(root);
+    std::ofstream(root / "scene.bin", std::ios::binary) << "scene";
+
+    for (int folder = 0; folder < c_folder_count; ++folder) {
+        fs::create_directories(import_dir / ("d" + std::to_string(folder)));
+        for (int file = 0; file < c_file_count; ++file) {
+            std::ofstream(import_dir / FileName(folder, file), std::ios::binary) << file;
+        }
+    }
+
+    auto archive_result = ResourceArchive::createFromPath(root);
+    if (!TOOLBOX_CHECK(archive_result)) {
+        fs::remove_all(work_dir);
+        return Finish();
+    }
+    ResourceArchive &archive = archive_result.value();
+
+    bool imported    = false;
+    double import_ms = TimeMilliseconds(
+        [&]() { imported = archive.importFolder(import_dir, archive.begin()).has_value(); }, 1);
+    if (!TOOLBOX_CHECK(imported)) {
+        fs::remove_all(work_dir);
+        return Finish();
+    }
+
+    std::vector<fs::path> paths;
+    for (int folder = 0; folder < c_folder_count; ++folder) {
+        for (int file = 0; file < c_file_count; file += c_lookup_step) {
+            paths.push_back(fs::path("scene/import") / FileName(folder, file));
+        }
+    }
+
+    // Rebuild the index outside the timed loop
+    TOOLBOX_CHECK(archive.findNode(paths.front()) != archive.end());
+
+    std::vector<s32> ids;
+    for (const fs::path &path : paths) {
+        auto node = archive.findNode(path);
+        ids.push_back(node == archive.end() ? -1 : node->id);
+    }
+
+    std::vector<ptrdiff_t> indexed_found(paths.size());
+    std::vector<ptrdiff_t> scanned_found(paths.size());
+
+    double indexed_ms = TimeMilliseconds([&]() {
+        for (size_t i = 0; i < paths.size(); ++i) {
+            indexed_found[i] = std::distance(archive.begin(), archive.findNode(paths[i]));
+        }
+    });
+
+    ResourceArchive scanned = archive;
+    scanned.invalidateIndex();
+    const ResourceArchive &reference = scanned;
+
+    double scanned_ms = TimeMilliseconds([&]() {
+        for (size_t i = 0; i < paths.size(); ++i) {
+            scanned_found[i] = std::distance(reference.begin(), reference.findNode(paths[i]));
+        }
+    });
+
+    std::vector<ptrdiff_t> indexed_ids(ids.size());
+    std::vector<ptrdiff_t> scanned_ids(ids.size());
+
+    double indexed_id_ms = TimeMilliseconds([&]() {
+        for (size_t i = 0; i < ids.size(); ++i) {
+            indexed_ids[i] = std::distance(archive.begin(), archive.findNode(ids[i]));
+        }
+    });
+    double scanned_id_ms = TimeMilliseconds([&]() {
+        for (size_t i = 0; i < ids.size(); ++i) {
+            scanned_ids[i] = std::distance(reference.begin(), reference.findNode(ids[i]));
+        }
+    });
+
+    std::printf("%-40s %10.3f ms (%zu nodes)\n", "importFolder, 10000 files", import_ms,
+                std::as_const(archive).getNodes().size());
+    Report("1000 path lookups", scanned_ms, indexed_ms);
+    Report("1000 id lookups", scanned_id_ms, indexed_id_ms);
+
+    const ptrdiff_t node_count = static_cast<ptrdiff_t>(std::as_const(archive).getNodes().size());
+    for (size_t i = 0; i < paths.size(); ++i) {
+        TOOLBOX_CHECK(indexed_found[i] < node_count);
+        TOOLBOX_CHECK(indexed_found[i] == scanned_found[i]);
+        TOOLBOX_CHECK(indexed_ids[i] == indexed_found[i]);
+        TOOLBOX_CHECK(scanned_ids[i] == scanned_found[i]);
+    }
+
+    TOOLBOX_CHECK(indexed_ms < scanned_ms);
+    TOOLBOX_CHECK(indexed_id_ms < scanned_id_ms);
+
+    fs::remove_all(work_dir);
+    return Finish();
+}
@@ -0,0 +1,196 @@
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "rarc/rarc.hpp"
+#include "testing.hpp"
+
+// Opens a large archive once read into memory and once mapped, then finds
+// and reads one file as opening a stage for a single model does. Each mode
+// runs in a freshly exec'd child, which reports its own VmHWM, so the peak
+// RSS is that mode's alone rather than inherited from the parent's fork.
+// Pass an archive to measure it instead of the synthetic one.
+
+using namespace Toolbox;
+using namespace Toolbox::RARC;
+using namespace Toolbox::Test;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+    constexpr const char *c_probe_path = "scene/mapobj/probe.bmd";
+
+    struct OpenResult {
+        double m_milliseconds = 0.0;
+        u64 m_checksum        = 0;
+        long m_peak_rss_kib   = 0;
+    };
+
+    u64 Checksum(std::span<const char> data) {
+        u64 sum = 0xCBF29CE484222325;
+        for (char c : data) {
+            sum = (sum ^ static_cast<u8>(c)) * 0x100000001B3;
+        }
+        return sum;
+    }
+
+    // 64 MiB of payloads, with one small file to look up among them
+    bool BuildArchive(const fs::path &work_dir, const fs::path &archive_path) {
+        const fs::path root = work_dir / "scene";
+        fs::create_directories(root / "map");
+        fs::create_directories(root / "mapobj");
+
+        std::mt19937 rng(0xA5C3);
+        std::vector<char> payload(1024 * 1024);
+        for (int i = 0; i < 64; ++i) {
+            for (char &c : payload) {
+                c = static_cast<char>(rng());
+            }
+            std::ofstream(root / "map" / ("model" + std::to_string(i) + ".bmd"), std::ios::binary)
+                .write(payload.data(), payload.size());
+        }
+        std::ofstream(root / "mapobj" / "probe.bmd", std::ios::binary) << "probe model";
+
+        auto archive = ResourceArchive::createFromPath(root);
+        if (!archive) {
+            return false;
+        }
+        return archive.value().saveToPath(archive_path).has_value();
+    }
+
+    // Peak resident set of this process image, reset by exec
+    long PeakResidentKiB() {
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line)) {
+            if (line.starts_with("VmHWM:")) {
+                return std::stol(line.substr(6));
+            }
+        }
+        return 0;
+    }
+
+    // Runs in the child, prints "<milliseconds> <checksum> <peak RSS KiB>"
+    int OpenArchive(const char *mode, const char *path, const char *probe) {
+        std::optional<ResourceArchive> archive;
+        double ms = TimeMilliseconds(
+            [&]() {
+                if (std::strcmp(mode, "mapped") == 0) {
+                    auto result = ResourceArchive::createFromMappedFile(path);
+                    if (result) {
+                        archive.emplace(std::move(result.value()));
+                    }
+                    return;
+                }
+
+                std::ifstream file(path, std::ios::binary);
+                Deserializer in(file.rdbuf(), path);
+                archive.emplace(fs::path(path).stem().string());
+                if (!archive->deserialize(in)) {
+                    archive.reset();
+                }
+            },
+            1);
+        if (!archive) {
+            return 1;
+        }
+
+        auto node = archive->findNode(fs::path(probe));
+        if (node == archive->end()) {
+            return 1;
+        }
+
+        u64 checksum = Checksum(node->data.view());
+        std::printf("%f %llu %ld\n", ms, static_cast<unsigned long long>(checksum),
+                    PeakResidentKiB());
+        return 0;
+    }
+
+    bool RunMode(const char *self, const char *mode, const fs::path &archive_path,
+                 const char *probe, OpenResult &result) {
+        int out_pipe[2];
+        if (pipe(out_pipe) == -1) {
+            return false;
+        }
+
+        const std::string path_str = archive_path.string();
+        pid_t pid                  = fork();
+        if (pid == 0) {
+            dup2(out_pipe[1], STDOUT_FILENO);
+            close(out_pipe[0]);
+            close(out_pipe[1]);
+            execl(self, self, "--open", mode, path_str.c_str(), probe, nullptr);
+            _exit(127);
+        }
+        close(out_pipe[1]);
+
+        char line[128] = {};
+        ssize_t length = read(out_pipe[0], line, sizeof(line) - 1);
+        close(out_pipe[0]);
+
+        int status = 0;
+        waitpid(pid, &status, 0);
+        if (length <= 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            return false;
+        }
+
+        unsigned long long checksum = 0;
+        if (std::sscanf(line, "%lf %llu %ld", &result.m_milliseconds, &checksum,
+                        &result.m_peak_rss_kib) != 3) {
+            return false;
+        }
+        result.m_checksum = checksum;
+        return true;
+    }
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    if (argc == 5 && std::strcmp(argv[1], "--open") == 0) {
+        return OpenArchive(argv[2], argv[3], argv[4]);
+    }
+
+    const fs::path work_dir =
+        fs::temp_directory_path() / ("toolbox_rarc_mapped_bench." + std::to_string(getpid()));
+    fs::remove_all(work_dir);
+    fs::create_directories(work_dir);
+
+    fs::path archive_path = work_dir / "scene.arc";
+    const char *probe     = c_probe_path;
+    if (argc == 3) {
+        archive_path = argv[1];
+        probe        = argv[2];
+    } else if (!TOOLBOX_CHECK(BuildArchive(work_dir, archive_path))) {
+        fs::remove_all(work_dir);
+        return Finish();
+    }
+
+    OpenResult read_result;
+    OpenResult mapped_result;
+    bool read_ok   = TOOLBOX_CHECK(RunMode(argv[0], "read", archive_path, probe, read_result));
+    bool mapped_ok = TOOLBOX_CHECK(RunMode(argv[0], "mapped", archive_path, probe, mapped_result));
+
+    if (read_ok && mapped_ok) {
+        Report("open archive and read one file", read_result.m_milliseconds,
+               mapped_result.m_milliseconds);
+        std::printf("%-40s old %10ld KiB new %10ld KiB\n", "peak RSS", read_result.m_peak_rss_kib,
+                    mapped_result.m_peak_rss_kib);
+
+        TOOLBOX_CHECK(read_result.m_checksum == mapped_result.m_checksum);
+        TOOLBOX_CHECK(mapped_result.m_peak_rss_kib < read_result.m_peak_rss_kib);
+        TOOLBOX_CHECK(mapped_result.m_milliseconds < read_result.m_milliseconds);
+    }
+
+    fs::remove_all(work_dir);
+    return Finish();
+}
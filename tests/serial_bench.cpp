@@ -0,0 +1,158 @@
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "bmg/bmg.hpp"
+#include "rail/node.hpp"
+#include "rail/rail.hpp"
+#include "scene/raildata.hpp"
+#include "serial.hpp"
+#include "testing.hpp"
+
+// Loads and saves scene.ral and message.bmg files through the iostream
+// Serializer and Deserializer and through the span and arena ones, as the
+// scene did before and does now. Pass .ral and .bmg files to round-trip
+// real stages; without any, synthetic ones are generated. Both paths must
+// write the same bytes. scene.bin isn't covered, its objects need the
+// template library.
+
+using namespace Toolbox;
+using namespace Toolbox::Test;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+    std::vector<char> ReadFile(const fs::path &path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(file), {});
+    }
+
+    std::vector<char> MakeRails(size_t rail_count, size_t node_count) {
+        RailData rails;
+        for (size_t i = 0; i < rail_count; ++i) {
+            Rail::Rail rail("rail_" + std::to_string(i));
+            for (size_t j = 0; j < node_count; ++j) {
+                s16 x = static_cast<s16>(i * 100);
+                s16 z = static_cast<s16>(j * 50);
+                rail.addNode(make_referable<Rail::RailNode>(x, 0, z));
+            }
+            for (size_t j = 0; j + 1 < node_count; ++j) {
+                rail.addConnection(j, j + 1);
+            }
+            rails.addRail(rail);
+        }
+
+        std::vector<char> arena;
+        Serializer out(arena);
+        TOOLBOX_CHECK(rails.serialize(out));
+        return arena;
+    }
+
+    std::vector<char> MakeMessages(size_t entry_count) {
+        BMG::MessageData messages;
+        for (size_t i = 0; i < entry_count; ++i) {
+            BMG::MessageData::Entry entry;
+            entry.m_name        = "message_" + std::to_string(i);
+            entry.m_message     = BMG::CmdMessage("Thanks for cleaning up Delfino Plaza! #" +
+                                                  std::to_string(i));
+            entry.m_start_frame = static_cast<u16>(i);
+            entry.m_end_frame   = static_cast<u16>(i + 60);
+            messages.addEntry(entry);
+        }
+
+        std::vector<char> arena;
+        Serializer out(arena);
+        TOOLBOX_CHECK(messages.serialize(out));
+        return arena;
+    }
+
+    template <typename _Data>
+    void Measure(const std::string &name, const fs::path &input, const fs::path &work_dir,
+                 bool expect_faster) {
+        const fs::path stream_output = work_dir / "stream.out";
+        const fs::path span_output   = work_dir / "span.out";
+
+        double stream_ms = TimeMilliseconds([&]() {
+            _Data data;
+            {
+                std::ifstream file(input, std::ios::binary);
+                Deserializer in(file.rdbuf(), input.string());
+                TOOLBOX_CHECK(data.deserialize(in));
+            }
+
+            std::ofstream file(stream_output, std::ios::binary);
+            Serializer out(file.rdbuf(), stream_output.string());
+            TOOLBOX_CHECK(data.serialize(out));
+        });
+
+        double span_ms = TimeMilliseconds([&]() {
+            _Data data;
+            {
+                const std::vector<char> bytes = ReadFile(input);
+                Deserializer in(std::span<const char>(bytes), input.string());
+                TOOLBOX_CHECK(data.deserialize(in));
+            }
+
+            std::vector<char> arena;
+            Serializer out(arena, span_output.string());
+            TOOLBOX_CHECK(data.serialize(out));
+            std::ofstream(span_output, std::ios::binary).write(arena.data(), arena.size());
+        });
+
+        Report(name.c_str(), stream_ms, span_ms);
+
+        TOOLBOX_CHECK(ReadFile(stream_output) == ReadFile(span_output));
+        if (expect_faster) {
+            TOOLBOX_CHECK(span_ms < stream_ms);
+        }
+    }
+
+    void MeasureFile(const fs::path &input, const fs::path &work_dir) {
+        const std::string name = input.filename().string() + " round trip";
+        if (input.extension() == ".ral") {
+            // Creating the nodes costs about as much as reading them, so
+            // the two backends land within noise of each other
+            Measure<RailData>(name, input, work_dir, false);
+        } else if (input.extension() == ".bmg") {
+            Measure<BMG::MessageData>(name, input, work_dir, true);
+        } else {
+            std::fprintf(stderr, "%s: expected a .ral or .bmg file\n", input.string().c_str());
+            FailureCount() += 1;
+        }
+    }
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    const fs::path work_dir =
+        fs::temp_directory_path() / ("toolbox_serial_bench." + std::to_string(getpid()));
+    fs::remove_all(work_dir);
+    fs::create_directories(work_dir);
+
+    if (argc < 2) {
+        const std::vector<char> rails    = MakeRails(200, 32);
+        const std::vector<char> messages = MakeMessages(2000);
+        std::ofstream(work_dir / "scene.ral", std::ios::binary).write(rails.data(), rails.size());
+        std::ofstream(work_dir / "message.bmg", std::ios::binary)
+            .write(messages.data(), messages.size());
+
+        MeasureFile(work_dir / "scene.ral", work_dir);
+        MeasureFile(work_dir / "message.bmg", work_dir);
+
+        // The synthetic files are written by the span path to begin with
+        TOOLBOX_CHECK(ReadFile(work_dir / "span.out") == messages);
+    } else {
+        for (int i = 1; i < argc; ++i) {
+            MeasureFile(argv[i], work_dir);
+        }
+    }
+
+    fs::remove_all(work_dir);
+    return Finish();
+}
@@ -0,0 +1,165 @@
+#include <cstdio>
+#include <fstream>
+#include <iconv.h>
+#include <iterator>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/types.hpp"
+#include "strutil.hpp"
+#include "testing.hpp"
+
+// Round-trips object names between the game and UI encodings, as loading
+// and saving scene.bin does. Pass scene.bin files to use their names;
+// without any, a synthetic list of mostly ASCII names with some kana is
+// used. The old path opened and closed an iconv converter per call.
+
+using namespace Toolbox;
+using namespace Toolbox::Test;
+
+namespace {
+
+    // What asEncoding did before converters were cached
+    std::optional<std::string> ConvertOpeningIconv(const std::string &value, const char *from,
+                                                   const char *to) {
+        iconv_t conv = iconv_open(to, from);
+        if (conv == (iconv_t)(-1)) {
+            return std::nullopt;
+        }
+
+        size_t inbytesleft  = value.size();
+        char *inbuf         = const_cast<char *>(value.data());
+        std::string result(value.size() * 4 + 8, '\0');
+        size_t outbytesleft = result.size();
+        char *outbuf        = result.data();
+
+        size_t status = iconv(conv, &inbuf, &inbytesleft, &outbuf, &outbytesleft);
+        iconv_close(conv);
+        if (status == (size_t)(-1)) {
+            return std::nullopt;
+        }
+
+        result.resize(result.size() - outbytesleft);
+        return result;
+    }
+
+    // Same hash as NameRef::calcKeyCode
+    u16 KeyCode(std::string_view str) {
+        u32 code = 0;
+        for (char ch : str) {
+            code = ch + (code * 3);
+        }
+        return code & 0xFFFF;
+    }
+
+    // Every object name in scene.bin is stored as its key code, a length
+    // and the string, so names can be found without parsing the objects
+    std::vector<std::string> ScanNames(const char *path) {
+        std::ifstream file(path, std::ios::binary);
+        const std::string data(std::istreambuf_iterator<char>(file), {});
+
+        std::vector<std::string> names;
+        for (size_t i = 0; i + 4 < data.size(); ++i) {
+            const u16 hash   = (static_cast<u8>(data[i]) << 8) | static_cast<u8>(data[i + 1]);
+            const u16 length = (static_cast<u8>(data[i + 2]) << 8) | static_cast<u8>(data[i + 3]);
+            if (length < 2 || length > 64 || i + 4 + length > data.size()) {
+                continue;
+            }
+
+            std::string_view name(data.data() + i + 4, length);
+            if (KeyCode(name) != hash) {
+                continue;
+            }
+
+            // Anything iconv rejects was a false match
+            std::string candidate(name);
+            if (ConvertOpeningIconv(candidate, GAME_ENCODING, IMGUI_ENCODING)) {
+                names.push_back(std::move(candidate));
+                i += 3 + length;
+            }
+        }
+        return names;
+    }
+
+    void AppendUTF8(char32_t cp, std::string &out) {
+        out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    }
+
+    // Actor and manager names, one in ten of them in katakana
+    std::vector<std::string> MakeSyntheticNames(size_t count) {
+        const char *ascii_names[] = {"Mario",      "NozzleBox",  "MapObjBase", "CoinManager",
+                                     "Conductor",  "MarScene",   "Strategy",   "GateKeeper",
+                                     "BathWaterManager", "Manhole", "Shine 3", "red coin 8"};
+
+        std::mt19937 rng(0x10);
+        std::vector<std::string> names;
+        for (size_t i = 0; i < count; ++i) {
+            if (i % 10 != 9) {
+                names.push_back(std::string(ascii_names[rng() % std::size(ascii_names)]) + " " +
+                                std::to_string(i));
+                continue;
+            }
+
+            std::string utf8;
+            for (u32 k = 0, length = 2 + rng() % 6; k < length; ++k) {
+                AppendUTF8(0x30A1 + rng() % 0x56, utf8);
+            }
+            names.push_back(
+                ConvertOpeningIconv(utf8, IMGUI_ENCODING, GAME_ENCODING).value_or("(null)"));
+        }
+        return names;
+    }
+
+    void Measure(const std::string &name, const std::vector<std::string> &game_names) {
+        std::vector<std::string> old_utf8(game_names.size());
+        std::vector<std::string> new_utf8(game_names.size());
+        std::vector<std::string> new_game(game_names.size());
+
+        double old_ms = TimeMilliseconds([&]() {
+            for (size_t i = 0; i < game_names.size(); ++i) {
+                old_utf8[i] =
+                    ConvertOpeningIconv(game_names[i], GAME_ENCODING, IMGUI_ENCODING).value_or("");
+                ConvertOpeningIconv(old_utf8[i], IMGUI_ENCODING, GAME_ENCODING);
+            }
+        });
+
+        double new_ms = TimeMilliseconds([&]() {
+            for (size_t i = 0; i < game_names.size(); ++i) {
+                new_utf8[i] = String::fromGameEncoding(game_names[i]).value_or("");
+                new_game[i] = String::toGameEncoding(new_utf8[i]).value_or("");
+            }
+        });
+
+        Report((name + ", " + std::to_string(game_names.size()) + " names").c_str(), old_ms,
+               new_ms);
+
+        size_t mismatches = 0;
+        for (size_t i = 0; i < game_names.size(); ++i) {
+            mismatches += new_utf8[i] != old_utf8[i] || new_game[i] != game_names[i];
+        }
+        TOOLBOX_CHECK(mismatches == 0);
+        TOOLBOX_CHECK(new_ms < old_ms);
+    }
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        Measure("synthetic round trip", MakeSyntheticNames(5000));
+        return Finish();
+    }
+
+    for (int i = 1; i < argc; ++i) {
+        std::vector<std::string> names = ScanNames(argv[i]);
+        if (!TOOLBOX_CHECK(!names.empty())) {
+            continue;
+        }
+        Measure(argv[i], names);
+    }
+
+    return Finish();
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <utility>
+
+// Minimal checks and timing shared by the test and benchmark executables.
+// A failed check is reported and counted, and Finish turns the count into
+// the exit code CTest looks at.
+
+namespace Toolbox::Test {
+
+    inline int &FailureCount() {
+        static int s_failures = 0;
+        return s_failures;
+    }
+
+    inline bool Check(bool condition, const char *expression, const char *file, int line) {
+        if (!condition) {
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+            FailureCount() += 1;
+        }
+        return condition;
+    }
+
+    // Milliseconds taken by the fastest of `runs` calls of `fn`
+    template <typename _Fn> double TimeMilliseconds(_Fn &&fn, int runs = 5) {
+        double best = 0.0;
+        for (int i = 0; i < runs; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            fn();
+            std::chrono::duration<double, std::milli> elapsed =
+                std::chrono::steady_clock::now() - start;
+            if (i == 0 || elapsed.count() < best) {
+                best = elapsed.count();
+            }
+        }
+        return best;
+    }
+
+    // Benchmarks print one line per measurement so runs can be compared
+    inline void Report(const char *name, double old_ms, double new_ms) {
+        std::printf("%-40s old %10.3f ms  new %10.3f ms  (%.1fx)\n", name, old_ms, new_ms,
+                    new_ms > 0.0 ? old_ms / new_ms : 0.0);
+    }
+
+    inline int Finish() {
+        if (FailureCount() != 0) {
+            std::fprintf(stderr, "%d check(s) failed\n", FailureCount());
+            return 1;
+        }
+        return 0;
+    }
+
+}  // namespace Toolbox::Test
+
+#define TOOLBOX_CHECK(expr) ::Toolbox::Test::Check(static_cast<bool>(expr), #expr, __FILE__, __LINE__)
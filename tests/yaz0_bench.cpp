@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "szs/szs.hpp"
+#include "testing.hpp"
+
+// Yaz0 throughput in MB/s of uncompressed data. Pass scene.szs files to
+// measure real stages; without any, a synthetic archive-like payload is
+// used so the benchmark runs anywhere. Every result must decode back to
+// its input.
+
+using namespace Toolbox;
+using namespace Toolbox::Test;
+
+namespace {
+
+    // Vertex-like runs of floats, repeated strings and incompressible bytes
+    std::vector<char> MakeSyntheticPayload(size_t size) {
+        std::vector<char> data;
+        data.reserve(size);
+
+        std::mt19937 rng(0x5A5A);
+        std::uniform_int_distribution<int> byte(0, 255);
+        std::uniform_real_distribution<float> jitter(-1.0f, 1.0f);
+
+        const std::string names = "map/map/pollution/sky/bianco/mario/nozzlebox/"
+                                  "coin/goop/manta/shine/";
+        while (data.size() < size) {
+            switch (data.size() / 4096 % 3) {
+            case 0:
+                for (int i = 0; i < 1024; ++i) {
+                    float value = static_cast<float>(i % 64) * 10.0f + jitter(rng);
+                    const char *bytes = reinterpret_cast<const char *>(&value);
+                    data.insert(data.end(), bytes, bytes + sizeof(float));
+                }
+                break;
+            case 1:
+                for (int i = 0; i < 64; ++i) {
+                    data.insert(data.end(), names.begin() + (i * 7) % 40, names.end());
+                }
+                break;
+            default:
+                for (int i = 0; i < 2048; ++i) {
+                    data.push_back(static_cast<char>(byte(rng)));
+                }
+                break;
+            }
+        }
+        data.resize(size);
+        return data;
+    }
+
+    std::vector<char> ReadFile(const char *path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(file), {});
+    }
+
+    double MegabytesPerSecond(size_t bytes, double milliseconds) {
+        return (static_cast<double>(bytes) / (1024.0 * 1024.0)) / (milliseconds / 1000.0);
+    }
+
+    void Measure(const std::string &name, const std::vector<char> &payload) {
+        const size_t hardware_threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+        std::vector<char> compressed;
+        double single_ms = 0.0;
+
+        for (size_t thread_count : {size_t(1), size_t(4), hardware_threads}) {
+            double ms = TimeMilliseconds(
+                [&]() { compressed = SZS::Compress(payload, thread_count); }, 3);
+            if (thread_count == 1) {
+                single_ms = ms;
+            }
+
+            auto decoded = SZS::Decompress(compressed);
+            TOOLBOX_CHECK(decoded && decoded.value() == payload);
+
+            std::printf("%-24s compress %2zu thread(s) %8.2f MB/s  (%.1f%% of input)\n",
+                        name.c_str(), thread_count, MegabytesPerSecond(payload.size(), ms),
+                        100.0 * compressed.size() / payload.size());
+
+            // More threads only pay off when there are cores to run them
+            if (thread_count == 4 && hardware_threads >= 4) {
+                TOOLBOX_CHECK(ms < single_ms);
+            }
+        }
+
+        std::vector<char> decoded(payload.size());
+        double decode_ms = TimeMilliseconds(
+            [&]() { TOOLBOX_CHECK(SZS::DecompressInto(compressed, decoded)); }, 5);
+        TOOLBOX_CHECK(decoded == payload);
+
+        std::printf("%-24s decompress          %8.2f MB/s\n", name.c_str(),
+                    MegabytesPerSecond(payload.size(), decode_ms));
+    }
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        Measure("synthetic (8 MiB)", MakeSyntheticPayload(8 * 1024 * 1024));
+        return Finish();
+    }
+
+    for (int i = 1; i < argc; ++i) {
+        std::vector<char> file = ReadFile(argv[i]);
+        if (!SZS::IsDataYaz0Compressed(file)) {
+            std::fprintf(stderr, "%s: not Yaz0 compressed\n", argv[i]);
+            FailureCount() += 1;
+            continue;
+        }
+
+        auto payload = SZS::Decompress(file);
+        if (!TOOLBOX_CHECK(payload)) {
+            continue;
+        }
+        Measure(argv[i], payload.value());
+    }
+
+    return Finish();
+}
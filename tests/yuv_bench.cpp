@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "core/memory.hpp"
+#include "image/yuv.hpp"
+#include "testing.hpp"
+
+// Converts 640x528 XFB frames of YUV 4:2:2 in frames per second, through
+// the fixed point kernel into a reused buffer and through the double
+// precision converter that allocated a new RGB buffer every frame. The
+// vector path must match the scalar one exactly, and both converters are
+// held to exactly rounded BT.601.
+
+using namespace Toolbox;
+using namespace Toolbox::Test;
+
+namespace {
+
+    constexpr int c_width       = 640;
+    constexpr int c_height      = 528;
+    constexpr int c_frame_count = 60;
+
+    // What the capture used before the fixed point kernel
+    Buffer YUV422ToRGB888(const u8 *yuv, int width, int height) {
+        Buffer out;
+        out.alloc(width * height * 3);
+
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; x += 2) {
+                int base_index = (y * width + x) * 2;
+
+                int y0 = static_cast<int>((yuv[base_index] - 16) * 255 / 219);
+                int y1 = static_cast<int>((yuv[base_index + 2] - 16) * 255 / 219);
+                int u  = static_cast<int>((yuv[base_index + 1] - 128) * 255 / 224);
+                int v  = static_cast<int>((yuv[base_index + 3] - 128) * 255 / 224);
+
+                int r0 = std::clamp(static_cast<int>(y0 + 1.402 * v), 0, 255);
+                int g0 = std::clamp(static_cast<int>(y0 - 0.344136 * u - 0.714136 * v), 0, 255);
+                int b0 = std::clamp(static_cast<int>(y0 + 1.772 * u), 0, 255);
+
+                int r1 = std::clamp(static_cast<int>(y1 + 1.402 * v), 0, 255);
+                int g1 = std::clamp(static_cast<int>(y1 - 0.344136 * u - 0.714136 * v), 0, 255);
+                int b1 = std::clamp(static_cast<int>(y1 + 1.772 * u), 0, 255);
+
+                size_t rgb_index = static_cast<size_t>((y * width + x) * 3);
+
+                out.set(rgb_index, static_cast<u8>(r0));
+                out.set(rgb_index + 1, static_cast<u8>(g0));
+                out.set(rgb_index + 2, static_cast<u8>(b0));
+
+                out.set(rgb_index + 3, static_cast<u8>(r1));
+                out.set(rgb_index + 4, static_cast<u8>(g1));
+                out.set(rgb_index + 5, static_cast<u8>(b1));
+            }
+        }
+
+        return out;
+    }
+
+    // Exactly rounded channel `channel` of pixel `pixel`
+    int ExactChannel(const u8 *yuv, size_t pixel, size_t channel) {
+        const u8 *pair = yuv + (pixel & ~size_t(1)) * 2;
+
+        double y = (pair[(pixel & 1) * 2] - 16) * 255.0 / 219.0;
+        double u = (pair[1] - 128) * 255.0 / 224.0;
+        double v = (pair[3] - 128) * 255.0 / 224.0;
+
+        double value = channel == 0   ? y + 1.402 * v
+                       : channel == 1 ? y - 0.344136 * u - 0.714136 * v
+                                      : y + 1.772 * u;
+        return static_cast<int>(std::lround(std::clamp(value, 0.0, 255.0)));
+    }
+
+    double FramesPerSecond(double milliseconds) {
+        return c_frame_count / (milliseconds / 1000.0);
+    }
+
+}  // namespace
+
+int main() {
+    const size_t pixel_count = static_cast<size_t>(c_width) * c_height;
+
+    // Every byte value shows up, so clamping on both ends is covered
+    std::mt19937 rng(0x422);
+    std::vector<u8> yuv(pixel_count * 2);
+    for (u8 &byte : yuv) {
+        byte = static_cast<u8>(rng());
+    }
+
+    Buffer rgb;
+    double old_ms = TimeMilliseconds(
+        [&]() {
+            for (int frame = 0; frame < c_frame_count; ++frame) {
+                rgb = YUV422ToRGB888(yuv.data(), c_width, c_height);
+            }
+        },
+        3);
+
+    std::vector<u8> rgba(pixel_count * 4);
+    double new_ms = TimeMilliseconds([&]() {
+        for (int frame = 0; frame < c_frame_count; ++frame) {
+            YUV422ToRGBA8(yuv.data(), rgba.data(), pixel_count);
+        }
+    });
+
+    Report("60 frames, 640x528", old_ms, new_ms);
+    std::printf("%-40s old %10.1f fps new %10.1f fps\n", "throughput", FramesPerSecond(old_ms),
+                FramesPerSecond(new_ms));
+
+    // Two pixels at a time never reach the vector path
+    std::vector<u8> scalar(pixel_count * 4);
+    for (size_t i = 0; i < pixel_count; i += 2) {
+        YUV422ToRGBA8(yuv.data() + i * 2, scalar.data() + i * 4, 2);
+    }
+    TOOLBOX_CHECK(scalar == rgba);
+
+    int old_error = 0;
+    int new_error = 0;
+    for (size_t i = 0; i < pixel_count; ++i) {
+        for (size_t channel = 0; channel < 3; ++channel) {
+            int exact = ExactChannel(yuv.data(), i, channel);
+            old_error = std::max(old_error, std::abs(rgb.get<u8>(i * 3 + channel) - exact));
+            new_error = std::max(new_error, std::abs(rgba[i * 4 + channel] - exact));
+        }
+        TOOLBOX_CHECK(rgba[i * 4 + 3] == 255);
+    }
+    std::printf("%-40s old %10d     new %10d\n", "largest error vs exact BT.601", old_error,
+                new_error);
+
+    // 6 bit coefficients are off by up to 3 at the ends of the range
+    TOOLBOX_CHECK(new_error <= 3);
+    TOOLBOX_CHECK(new_error <= old_error);
+    TOOLBOX_CHECK(new_ms < old_ms);
+
+    return Finish();
+}